@@ -54,3 +54,19 @@ function (link_gtest TARGET)
         target_link_libraries(${TARGET} PRIVATE GTest::gtest_main GTest::gmock_main)
     endif ()
 endfunction()
+
+function (link_gbenchmark TARGET)
+    find_package(benchmark QUIET)
+    if (NOT ${benchmark_FOUND} AND NOT TARGET benchmark::benchmark_main)
+        FetchContent_Declare(
+            googlebenchmark
+            GIT_REPOSITORY https://github.com/google/benchmark
+            GIT_TAG v1.9.1
+        )
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        FetchContent_MakeAvailable(googlebenchmark)
+    endif ()
+
+    target_link_libraries(${TARGET} PRIVATE benchmark::benchmark benchmark::benchmark_main)
+endfunction()
@@ -29,6 +29,13 @@ namespace trc
 
         // The maximum number of glyph maps that may exist in the descriptor.
         ui32 maxFonts{ 100 };
+
+        // Device memory in bytes that unreferenced textures and geometries,
+        // respectively, may keep occupied so that they don't have to be
+        // reloaded when they are requested again. See
+        // `DeviceDataCache::setRetentionBudget`.
+        size_t textureRetentionBudget{ 0 };
+        size_t geometryRetentionBudget{ 0 };
     };
 
     /**
@@ -1,14 +1,38 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "trc/TransformHierarchy.h"
 #include "trc/Transformation.h"
 
 namespace trc
 {
+    /**
+     * @brief Tags the storage of nodes' global transforms
+     *
+     * Keeps global transforms apart from the local transformations of
+     * `Transformation::ID`.
+     */
+    struct GlobalTransformTag {};
+
+    /**
+     * @brief A transformation in a tree of transformations
+     *
+     * Updating a node computes the global transforms of all of its
+     * descendants with a flattened copy of the subtree (see
+     * `TransformHierarchy`). The node builds this copy the first time it
+     * is updated and rebuilds it after a node in the subtree has been
+     * attached or detached.
+     *
+     * Changing a node's local transformation marks it as changed. Updates
+     * skip all nodes that are unchanged and have no changed ancestor.
+     */
     class Node : public trc::Transformation
     {
     public:
+        using GlobalTransformID = data::ExternalStorage<mat4, GlobalTransformTag>::ID;
+
         Node();
         Node(Node&& other) noexcept;
         ~Node();
@@ -19,16 +43,41 @@ namespace trc
         auto operator=(const Node& rhs) -> Node& = delete;
 
         auto getGlobalTransform() const noexcept -> mat4;
-        auto getGlobalTransformID() const noexcept -> ID;
+        /**
+         * Global transforms live in a storage separate from local
+         * transformations.
+         */
+        auto getGlobalTransformID() const noexcept -> GlobalTransformID;
 
-        void update() noexcept;
-        void update(const mat4& parentTransform) noexcept;
+        /**
+         * May allocate to (re)build the flattened subtree.
+         *
+         * @throw std::bad_alloc
+         */
+        void update();
+        void update(const mat4& parentTransform);
         /**
          * @brief Updates children without a parent transformation
          *
          * This saves a matrix multiplication per child.
          */
-        void updateAsRoot() noexcept;
+        void updateAsRoot();
+
+        /**
+         * @brief Updates children without a parent transformation on a
+         *        thread pool
+         *
+         * Nodes at the same depth are updated in parallel.
+         */
+        void updateAsRoot(async::ThreadPool& threads);
+
+        /**
+         * @brief Get the number of descendants that the most recent
+         *        update of this node recomputed and skipped
+         *
+         * Counts only updates through `update` and `updateAsRoot`.
+         */
+        auto getLastUpdateStats() const -> TransformUpdateStats;
 
         void attach(Node& child);
         void detach(Node& child);
@@ -38,9 +87,37 @@ namespace trc
         void onLocalMatrixUpdate() override;
 
     private:
-        data::ExternalStorage<mat4> globalTransformIndex;
+        friend class TransformHierarchy;
+
+        /**
+         * @brief Get the flattened subtree, rebuilding it if necessary
+         */
+        auto getHierarchy() -> TransformHierarchy&;
+
+        /**
+         * @brief Mark the flattened subtrees of this node and of all its
+         *        ancestors as outdated
+         */
+        void invalidateHierarchy() noexcept;
+
+        /**
+         * @brief Update the subtree after a structural change
+         *
+         * Walks the tree directly instead of through a flattened subtree,
+         * so that it never allocates and nodes that are only ever updated
+         * through their ancestors don't keep a copy of their subtree.
+         */
+        void updateSubtree(const mat4& parentTransform) noexcept;
+
+        data::ExternalStorage<mat4, GlobalTransformTag> globalTransformIndex;
 
         Node* parent{ nullptr };
         std::vector<Node*> children;
+
+        std::unique_ptr<TransformHierarchy> hierarchy;
+        bool hierarchyValid{ false };
+
+        /** Set when the local transformation changes, cleared by updates */
+        bool localTransformChanged{ true };
     };
 } // namespace trc
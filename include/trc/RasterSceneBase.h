@@ -2,11 +2,15 @@
 
 #include <functional>
 #include <generator>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <trc_util/data/IndexMap.h>
+#include <trc_util/math/FrustumCulling.h>
 
 #include "trc/Types.h"
 #include "trc/core/Pipeline.h"
@@ -15,6 +19,8 @@
 
 namespace trc
 {
+    class Camera;
+
     struct DrawEnvironment
     {
         Pipeline* currentPipeline;
@@ -22,6 +28,27 @@ namespace trc
 
     using DrawableFunction = std::function<void(const DrawEnvironment&, vk::CommandBuffer)>;
 
+    /**
+     * @brief Computes the world-space bounding sphere of a draw call
+     *
+     * Returns the sphere's center in `xyz` and its radius in `w`.
+     */
+    using DrawableBoundsFunction = std::function<vec4()>;
+
+    /**
+     * @brief Results of frustum culling for one view
+     */
+    struct DrawCullingStats
+    {
+        ui32 numVisible{ 0 };
+        ui32 numCulled{ 0 };
+    };
+
+    /**
+     * @brief Compute the world-space view frustum of a camera
+     */
+    auto makeViewFrustum(const Camera& camera) -> math::Frustum;
+
     /**
      * @brief A basis of all scene-like structures
      *
@@ -83,13 +110,15 @@ namespace trc
              */
             DrawableExecutionRegistration(
                 std::unique_ptr<RegistrationIndex> indexStruct,
-                DrawableFunction func);
+                DrawableFunction func,
+                DrawableBoundsFunction bounds);
 
             // Allows me to modify pointer of all ID structs remotely
             std::unique_ptr<RegistrationIndex> indexInRegistrationArray;
 
             // Entry data
             DrawableFunction recordFunction;
+            DrawableBoundsFunction boundsFunction;
         };
 
         /**
@@ -164,6 +193,10 @@ namespace trc
          * remove the draw call from the scene, or use the unique handle
          * which takes care of this automatically.
          *
+         * Draw calls with a bounds function are subject to frustum culling
+         * (see `iterVisibleDrawFunctions`). Draw calls without one are
+         * always recorded.
+         *
          * @return MaybeUniqueRegistrationId An ID which can be used to
          *         reference this specific draw call. Can be converted to
          *         either a plain ID or a handle with self-managed lifetime
@@ -174,7 +207,8 @@ namespace trc
             RenderStage::ID stage,
             SubPass::ID subpass,
             Pipeline::ID usedPipeline,
-            DrawableFunction commandBufferRecordingFunction
+            DrawableFunction commandBufferRecordingFunction,
+            DrawableBoundsFunction boundsFunction = {}
         ) -> MaybeUniqueRegistrationId;
 
         /**
@@ -204,6 +238,52 @@ namespace trc
                                Pipeline::ID pipelineId) const
             -> std::generator<const DrawableFunction&>;
 
+        /**
+         * @brief Retrieve the draw functions that are visible in a view
+         *
+         * Evaluates the bounds of all draw functions registered for a
+         * specific combination of render stage, subpass, and pipeline,
+         * tests them against a view frustum in one batch, and yields only
+         * the draw functions whose bounds intersect the frustum. Draw
+         * functions without bounds are always yielded.
+         *
+         * @param const math::Frustum& frustum A world-space view frustum.
+         *        See `makeViewFrustum`.
+         * @param DrawCullingStats& stats The numbers of visible and culled
+         *        draw functions are added to this object.
+         */
+        auto iterVisibleDrawFunctions(RenderStage::ID renderStage,
+                                      SubPass::ID subPass,
+                                      Pipeline::ID pipelineId,
+                                      const math::Frustum& frustum,
+                                      DrawCullingStats& stats) const
+            -> std::generator<const DrawableFunction&>;
+
+        /**
+         * @brief Store the culling results of a view
+         *
+         * Draw tasks report their results here after each culling pass.
+         * Replaces any previous results for the same camera.
+         */
+        void setCullingStats(const Camera& view, DrawCullingStats stats);
+
+        /**
+         * @brief Remove the culling results of all views
+         *
+         * The raster plugin calls this once per frame before any draw task
+         * runs, so results are only kept for cameras that were drawn in the
+         * most recent frame. This bounds the storage when cameras are
+         * destroyed.
+         */
+        void clearCullingStats();
+
+        /**
+         * @return std::optional<DrawCullingStats> The most recent culling
+         *         results for a view. Nothing if no draw task has culled
+         *         draw functions for the view yet.
+         */
+        auto getCullingStats(const Camera& view) const -> std::optional<DrawCullingStats>;
+
     private:
         template<typename T>
         class LockedStorage
@@ -270,5 +350,8 @@ namespace trc
         mutable std::shared_mutex uniquePipelinesVectorMutex;
         PerRenderStage<PerSubpass<std::unordered_set<Pipeline::ID>>> uniquePipelines;
         PerRenderStage<PerSubpass<std::vector<Pipeline::ID>>> uniquePipelinesVector;
+
+        mutable std::mutex cullingStatsMutex;
+        std::unordered_map<const Camera*, DrawCullingStats> cullingStats;
     };
 } // namespace trc
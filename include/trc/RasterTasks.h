@@ -14,6 +14,9 @@ namespace trc
      * @brief A task that draws classical drawables registered at a
      *        RasterSceneBase for a specific render stage within a specific
      *        instance of a render pass
+     *
+     * Culls draw functions against the viewport camera's frustum and
+     * reports the results via `RasterSceneBase::setCullingStats`.
      */
     class RenderPassDrawTask : public ViewportDrawTask
     {
@@ -29,6 +32,9 @@ namespace trc
     };
 
     /**
+     * Culls draw functions against the shadow camera's frustum and reports
+     * the results via `RasterSceneBase::setCullingStats`.
+     *
      * Always uploads the shadow matrix index as a push constant to the byte
      * range `[64, 68)` with `vk::ShaderStageFlagBits::eVertex`.
      */
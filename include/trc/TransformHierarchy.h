@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <trc_util/async/ThreadPool.h>
+#include <trc_util/data/ExternalStorage.h>
+
+#include "trc/Transformation.h"
+#include "trc/Types.h"
+
+namespace trc
+{
+    class Node;
+
+    /**
+     * @brief Number of nodes processed by an update of a
+     *        `TransformHierarchy`
+     */
+    struct TransformUpdateStats
+    {
+        /** Nodes whose global transform was recomputed */
+        uint32_t numUpdated{ 0 };
+
+        /** Nodes that had not changed and had no changed ancestor */
+        uint32_t numSkipped{ 0 };
+    };
+
+    /**
+     * @brief A flattened copy of a node tree's structure
+     *
+     * Stores the descendants of a root node in breadth-first order, so
+     * that every node's parent precedes it and the nodes of one depth are
+     * adjacent. Global transforms are computed level by level from an
+     * array of parent indices and an array of global matrices instead of
+     * by recursing through the nodes' child lists. The nodes of a level
+     * don't depend on each other, so large levels are updated in parallel.
+     *
+     * The hierarchy does not observe changes to the tree's structure; call
+     * `build` again after nodes have been attached, detached, or moved.
+     *
+     * Updates are incremental: a node's global transform is recomputed
+     * only if its local transform has changed since it was last updated,
+     * if an ancestor's global transform has been recomputed, or if the
+     * root transform differs from the previous update's. The first
+     * update after `build` recomputes all nodes.
+     */
+    class TransformHierarchy
+    {
+    public:
+        /**
+         * @brief Rebuild the hierarchy from a node's descendants
+         *
+         * The node itself is not part of the hierarchy.
+         */
+        void build(const Node& root);
+
+        /**
+         * @brief Compute the global transforms of all nodes
+         *
+         * @param const mat4& rootTransform Global transform of the root.
+         */
+        void update(const mat4& rootTransform);
+
+        /**
+         * @brief Compute the global transforms of all nodes on a thread pool
+         *
+         * Levels are processed one after another. The nodes of a level are
+         * split into batches that run in parallel.
+         */
+        void update(const mat4& rootTransform, async::ThreadPool& threads);
+
+        /**
+         * @brief Compute global transforms without a root transformation
+         *
+         * This saves a matrix multiplication per child of the root.
+         */
+        void updateAsRoot();
+
+        /**
+         * @brief Compute global transforms without a root transformation
+         *        on a thread pool
+         */
+        void updateAsRoot(async::ThreadPool& threads);
+
+        /**
+         * @return size_t The number of nodes in the hierarchy
+         */
+        auto size() const -> size_t;
+
+        /**
+         * @return size_t The number of distinct depths in the hierarchy
+         */
+        auto getNumLevels() const -> size_t;
+
+        /**
+         * @return TransformUpdateStats The number of nodes that the most
+         *         recent update recomputed and skipped
+         */
+        auto getLastUpdateStats() const -> TransformUpdateStats;
+
+    private:
+        /** Parent index of the root's children */
+        static constexpr uint32_t kRoot{ UINT32_MAX };
+
+        /** Number of nodes per parallel batch */
+        static constexpr uint32_t kBatchSize{ 2048 };
+
+        template<bool kHasRootTransform>
+        void updateLevels(const mat4& rootTransform, async::ThreadPool* threads);
+
+        /**
+         * @return uint32_t The number of nodes that were recomputed
+         */
+        template<bool kHasRootTransform>
+        auto updateRange(uint32_t begin, uint32_t end, const mat4& rootTransform, bool rootChanged)
+            -> uint32_t;
+
+        std::vector<Node*> nodes;
+        std::vector<uint32_t> parents;
+        std::vector<Transformation::ID> localTransforms;
+        std::vector<mat4> globalTransforms;
+
+        /** Whether a node's global transform was recomputed in the current update */
+        std::vector<uint8_t> changed;
+
+        /** Level `i` spans the indices `[levelOffsets[i], levelOffsets[i + 1])` */
+        std::vector<uint32_t> levelOffsets{ 0 };
+
+        bool needsFullUpdate{ true };
+        mat4 lastRootTransform{ 1.0f };
+        TransformUpdateStats lastStats;
+    };
+} // namespace trc
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <span>
+#include <vector>
+
+#include <glm/gtc/type_precision.hpp>
+
 #include "trc/Types.h"
 
 namespace trc
@@ -23,4 +28,116 @@ namespace trc
         uvec4 boneIndices{ UINT32_MAX };
         vec4 boneWeights{ 0.0f };
     };
+
+    enum class VertexFormat : ui8
+    {
+        /** Vertices are stored as `MeshVertex` */
+        eFull,
+
+        /** Vertices are stored as `PackedMeshVertex` */
+        ePacked,
+    };
+
+    /**
+     * @brief A compact variant of `MeshVertex`
+     *
+     * Positions are 16-bit unsigned normalized values relative to a
+     * per-geometry `VertexQuantization` transform. Normals and tangents
+     * are octahedral-encoded 16-bit signed normalized values, UVs are half
+     * floats.
+     *
+     * Shader attribute formats: `[rgba16u, rg16i, rg16f, rg16i]`.
+     */
+    struct PackedMeshVertex
+    {
+        glm::u16vec4 position;  // w is unused
+        glm::i16vec2 normal;
+        glm::u16vec2 uv;
+        glm::i16vec2 tangent;
+    };
+
+    static_assert(sizeof(PackedMeshVertex) == 20);
+
+    /**
+     * @brief Dequantization transform of packed vertex positions
+     *
+     * A packed position `p` corresponds to the object-space position
+     * `offset + vec3(p) / 65535 * scale`.
+     */
+    struct VertexQuantization
+    {
+        vec3 offset{ 0.0f };
+        vec3 scale{ 1.0f };
+
+        /**
+         * @brief Compute the quantization transform that covers all
+         *        positions of a vertex array
+         */
+        static auto fromBounds(std::span<const MeshVertex> vertices) -> VertexQuantization;
+
+        auto quantize(vec3 position) const -> glm::u16vec4;
+        auto dequantize(glm::u16vec4 position) const -> vec3;
+    };
+
+    /**
+     * @brief Object-space extents of a geometry
+     */
+    struct GeometryBounds
+    {
+        /** Corners of the axis-aligned bounding box */
+        vec3 min{ 0.0f };
+        vec3 max{ 0.0f };
+
+        /** Bounding sphere */
+        vec3 center{ 0.0f };
+        float radius{ 0.0f };
+
+        /**
+         * @brief Compute the bounds of all positions of a vertex array
+         *
+         * The sphere is centered on the box and just large enough to
+         * contain all positions.
+         */
+        static auto fromVertices(std::span<const MeshVertex> vertices) -> GeometryBounds;
+
+        /**
+         * @brief Compute the bounds of the dequantized positions of a
+         *        packed vertex array
+         */
+        static auto fromVertices(std::span<const PackedMeshVertex> vertices,
+                                 const VertexQuantization& quant) -> GeometryBounds;
+
+        /**
+         * @brief Create bounds from a box and the box's circumsphere
+         */
+        static auto fromBox(vec3 min, vec3 max) -> GeometryBounds;
+    };
+
+    static_assert(sizeof(GeometryBounds) == 40);
+
+    /**
+     * @brief Encode a unit vector in the 16-bit octahedral encoding
+     */
+    auto packOctahedral(vec3 dir) -> glm::i16vec2;
+
+    /**
+     * @return vec3 A normalized vector.
+     */
+    auto unpackOctahedral(glm::i16vec2 packed) -> vec3;
+
+    auto packVertex(const MeshVertex& vertex, const VertexQuantization& quant) -> PackedMeshVertex;
+    auto unpackVertex(const PackedMeshVertex& vertex, const VertexQuantization& quant) -> MeshVertex;
+
+    /**
+     * @brief Pack an array of vertices
+     *
+     * @param const VertexQuantization& quant The quantization transform for
+     *        positions. All positions must lie within its bounds, which is
+     *        guaranteed by `VertexQuantization::fromBounds(vertices)`.
+     */
+    auto packVertices(std::span<const MeshVertex> vertices, const VertexQuantization& quant)
+        -> std::vector<PackedMeshVertex>;
+
+    auto unpackVertices(std::span<const PackedMeshVertex> vertices, const VertexQuantization& quant)
+        -> std::vector<MeshVertex>;
 } // namespace trc
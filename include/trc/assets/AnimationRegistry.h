@@ -2,6 +2,7 @@
 
 #include <iosfwd>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "trc/assets/AssetManagerBase.h"  // For asset ID types
 #include "trc/assets/AssetRegistryModule.h"
 #include "trc/assets/AssetSource.h"
+#include "trc/assets/CompressedAnimation.h"
 #include "trc/assets/SharedDescriptorSet.h"
 
 namespace trc
@@ -44,6 +46,16 @@ namespace trc
         float frameTimeMs{ 0.0f };
         std::vector<Keyframe> keyframes;
 
+        /**
+         * A compressed representation of the bone matrices. If this is
+         * set, `keyframes` is ignored and may be empty.
+         *
+         * See `compressAnimation` in `trc/assets/import/AnimationCompression.h`.
+         */
+        std::optional<CompressedAnimation> compressed;
+
+        auto getBoneCount() const -> ui32;
+
         void serialize(std::ostream& os) const;
         void deserialize(std::istream& is);
     };
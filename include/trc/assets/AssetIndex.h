@@ -0,0 +1,119 @@
+#pragma once
+
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "trc/Types.h"
+#include "trc/assets/AssetPath.h"
+#include "trc/assets/AssetSource.h"
+#include "trc/util/DataStorage.h"
+
+namespace trc
+{
+    /**
+     * @brief A persistent index of the assets in a data storage
+     *
+     * Holds the metadata, the data size, and a hash of the serialized data
+     * of every asset in a storage so that queries don't have to open and
+     * parse the assets' metadata files.
+     *
+     * The index is persisted as a single item in the storage it describes.
+     * Modifications invalidate the persisted index immediately and are
+     * written back on `flush` or on destruction, so an index that was not
+     * flushed (for example after a crash) is rebuilt rather than used in an
+     * outdated state.
+     *
+     * Is thread-safe.
+     */
+    class AssetIndex
+    {
+    public:
+        struct Entry
+        {
+            AssetMetadata metadata;
+
+            /** Size of the asset's serialized data in bytes */
+            ui64 dataSize{ 0 };
+
+            /** Hash of the asset's serialized data, see `hashContent` */
+            ui64 contentHash{ 0 };
+        };
+
+        /** Location of the persisted index in its data storage */
+        static constexpr std::string_view kIndexPath{ ".asset_index" };
+
+        /**
+         * @brief Create an empty index for a data storage
+         *
+         * @param s_ptr<DataStorage> storage The storage to which the index
+         *        is persisted. Must not be nullptr.
+         */
+        explicit AssetIndex(s_ptr<DataStorage> storage);
+
+        /**
+         * Calls `flush`.
+         */
+        ~AssetIndex() noexcept;
+
+        AssetIndex(const AssetIndex&) = delete;
+        AssetIndex(AssetIndex&&) noexcept = delete;
+        AssetIndex& operator=(const AssetIndex&) = delete;
+        AssetIndex& operator=(AssetIndex&&) noexcept = delete;
+
+        /**
+         * @brief Load an index that has been persisted to a data storage
+         *
+         * @return u_ptr<AssetIndex> Nullptr if `storage` does not contain
+         *         a valid index.
+         */
+        static auto load(s_ptr<DataStorage> storage) -> u_ptr<AssetIndex>;
+
+        /**
+         * @brief Compute the content hash of an asset's serialized data
+         */
+        static auto hashContent(std::string_view data) -> ui64;
+
+        auto find(const AssetPath& path) const -> std::optional<Entry>;
+        bool contains(const AssetPath& path) const;
+        auto size() const -> size_t;
+
+        /**
+         * @return std::vector<AssetPath> The paths of all assets in the
+         *         index in sorted order.
+         */
+        auto getPaths() const -> std::vector<AssetPath>;
+
+        /**
+         * @brief Insert or overwrite an entry
+         */
+        void insert(const AssetPath& path, Entry entry);
+
+        /**
+         * @return bool True if an entry at `path` has been removed.
+         */
+        bool erase(const AssetPath& path);
+
+        void clear();
+
+        /**
+         * @brief Write the index to its data storage if it has been
+         *        modified
+         *
+         * Does nothing if the storage is not writable.
+         */
+        void flush();
+
+    private:
+        /** Requires a unique lock on `mutex` */
+        void markModified();
+
+        s_ptr<DataStorage> storage;
+
+        mutable std::shared_mutex mutex;
+        std::unordered_map<AssetPath, Entry> entries;
+        bool modified{ false };
+    };
+} // namespace trc
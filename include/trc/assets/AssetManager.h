@@ -333,6 +333,10 @@ namespace trc
                 return source->getMetadata();
             }
 
+            auto mapData() -> std::optional<DataStorage::MappedData> override {
+                return source->mapData();
+            }
+
         private:
             AssetManager* manager;
             u_ptr<AssetSource<T>> source;
@@ -350,7 +354,7 @@ namespace trc
         TraitStorage assetTraits;
 
         std::unordered_map<AssetPath, AssetID> pathsToAssets;
-        util::SafeVector<AssetPath> assetsToPaths;
+        util::ReadOptimizedSafeVector<AssetPath> assetsToPaths;
     };
 
 
@@ -12,6 +12,7 @@
 #include "trc/assets/AssetBase.h"
 #include "trc/assets/AssetPath.h"
 #include "trc/assets/AssetType.h"
+#include "trc/util/DataStorage.h"
 
 namespace trc
 {
@@ -36,6 +37,20 @@ namespace trc
 
         virtual auto load() -> AssetData<T> = 0;
         virtual auto getMetadata() -> AssetMetadata = 0;
+
+        /**
+         * @brief Access the asset's serialized data in-place
+         *
+         * Optional. Allows registries to read suitable data formats directly
+         * from memory instead of going through `load`. Note that asset
+         * references in mapped data are not resolved.
+         *
+         * @return std::optional<DataStorage::MappedData> The serialized asset
+         *         data. Nullopt if the source does not support mapping.
+         */
+        virtual auto mapData() -> std::optional<DataStorage::MappedData> {
+            return std::nullopt;
+        }
     };
 
     template<AssetBaseType T>
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <optional>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #include <trc_util/Exception.h>
 
 #include "trc/Types.h"
+#include "trc/assets/AssetIndex.h"
 #include "trc/assets/AssetPath.h"
 #include "trc/assets/AssetSource.h"
 #include "trc/assets/AssetType.h"
@@ -26,7 +29,20 @@ namespace trc
     };
 
     /**
-     * @brief
+     * @brief Stores assets in a data storage
+     *
+     * Maintains an `AssetIndex` of the stored assets, so metadata queries
+     * and enumeration of assets do not access the underlying storage. The
+     * index is loaded from the storage on construction, or built from the
+     * stored metadata if the storage does not contain a valid index.
+     *
+     * A loaded index is validated against the storage's listing of asset
+     * data and the data's sizes (see `DataStorage::getSize`). Entries of
+     * assets that no longer exist are removed, and entries of new or
+     * resized assets are rebuilt. Data that was modified without changing
+     * its size is not detected; call `rebuildIndex` in that case.
+     *
+     * Copies of an AssetStorage share the same index.
      */
     class AssetStorage
     {
@@ -35,6 +51,27 @@ namespace trc
 
         auto getMetadata(const AssetPath& path) -> std::optional<AssetMetadata>;
 
+        /**
+         * @return const AssetIndex& Information about all stored assets.
+         */
+        auto getIndex() const -> const AssetIndex&;
+
+        /**
+         * @brief Rebuild the asset index from the data storage
+         *
+         * Reads every asset's metadata and data. Call this if the data
+         * storage has been modified by other means than this object.
+         */
+        void rebuildIndex();
+
+        /**
+         * @brief Write the asset index to the data storage
+         *
+         * The index is also written when the last AssetStorage that
+         * refers to it is destroyed.
+         */
+        void flushIndex();
+
         template<AssetBaseType T>
         auto load(const AssetPath& path) -> AssetParseResult<T>;
 
@@ -45,8 +82,7 @@ namespace trc
          * The created asset source must outlive the AssetStorage by which
          * it was created.
          *
-         * Temporarily loads the metadata at `path` into memory to check whether
-         * asset exists and it has the requested type.
+         * Checks whether the asset exists and has the requested type.
          *
          * @return optional<u_ptr<AssetSource<T>>> A source object that allows
          *         loading the asset at `path` at a later time.
@@ -56,6 +92,17 @@ namespace trc
         template<AssetBaseType T>
         auto loadDeferred(const AssetPath& path) -> std::optional<u_ptr<AssetSource<T>>>;
 
+        /**
+         * @brief Map an asset's serialized data into memory
+         *
+         * Does not check the asset's type.
+         *
+         * @return std::optional<DataStorage::MappedData> Nullopt if the
+         *         underlying data storage does not support mapping or no data
+         *         exists at `path`.
+         */
+        auto mapData(const AssetPath& path) -> std::optional<DataStorage::MappedData>;
+
         template<AssetBaseType T>
         bool store(const AssetPath& path, const AssetData<T>& data);
 
@@ -68,12 +115,18 @@ namespace trc
          */
         bool remove(const AssetPath& path);
 
+        /**
+         * @brief Iterates over a snapshot of the asset index
+         *
+         * Assets are enumerated in sorted order. Modifications of the
+         * storage during iteration are not reflected by the iterator.
+         */
         struct AssetIterator
         {
             using const_reference = const AssetPath&;
             using const_pointer = const AssetPath*;
 
-            AssetIterator(DataStorage::iterator begin, DataStorage::iterator end);
+            AssetIterator(s_ptr<const std::vector<AssetPath>> paths, size_t index);
 
             auto operator*() const -> const_reference;
             auto operator->() const -> const_pointer;
@@ -84,12 +137,10 @@ namespace trc
             bool operator!=(const AssetIterator& other) const = default;
 
         private:
-            static bool isMetaFile(const util::Pathlet& path);
-            void step();
+            bool atEnd() const;
 
-            DataStorage::iterator iter;
-            DataStorage::iterator end;
-            std::optional<AssetPath> currentPath;
+            s_ptr<const std::vector<AssetPath>> paths;
+            size_t index;
         };
 
         using iterator = AssetIterator;
@@ -103,7 +154,27 @@ namespace trc
         static void serializeMetadata(const AssetMetadata& meta, std::ostream& os);
         static auto deserializeMetadata(std::istream& is) -> AssetMetadata;
 
+        /**
+         * @brief Write an asset's serialized data and metadata and update
+         *        the index
+         */
+        bool storeSerialized(const AssetPath& path, AssetType type, std::string_view data);
+
+        /**
+         * @brief Update the index to the current state of the storage
+         */
+        void validateIndex();
+
+        /**
+         * @brief Read an asset's metadata and data and insert it into the
+         *        index
+         *
+         * @return bool False if the asset's metadata or data is missing.
+         */
+        bool indexAsset(const AssetPath& path);
+
         s_ptr<DataStorage> storage;
+        s_ptr<AssetIndex> index;
     };
 
     /**
@@ -113,13 +184,13 @@ namespace trc
     class AssetStorageSource : public AssetSource<T>
     {
     public:
-        AssetStorageSource(AssetPath path, const s_ptr<DataStorage>& storage)
-            : path(std::move(path)), storage(storage)
+        AssetStorageSource(AssetPath path, AssetStorage storage)
+            : path(std::move(path)), storage(std::move(storage))
         {}
 
         auto load() -> AssetData<T> override
         {
-            auto data = AssetStorage{storage}.load<T>(path);
+            auto data = storage.load<T>(path);
             if (!data.has_value())
             {
                 log::error << "Unable to load asset at " << path.string()
@@ -133,7 +204,7 @@ namespace trc
 
         auto getMetadata() -> AssetMetadata override
         {
-            auto meta = AssetStorage{storage}.getMetadata(path);
+            auto meta = storage.getMetadata(path);
             if (!meta.has_value())
             {
                 log::error << "Unable to load asset metadata from " << path.string()
@@ -143,9 +214,13 @@ namespace trc
             return std::move(*meta);
         }
 
+        auto mapData() -> std::optional<DataStorage::MappedData> override {
+            return storage.mapData(path);
+        }
+
     private:
         const AssetPath path;
-        s_ptr<DataStorage> storage;
+        AssetStorage storage;
     };
 
     template<AssetBaseType T>
@@ -183,36 +258,16 @@ namespace trc
             return std::nullopt;
         }
 
-        return std::make_unique<AssetStorageSource<T>>(path, this->storage);
+        return std::make_unique<AssetStorageSource<T>>(path, *this);
     }
 
     template<AssetBaseType T>
     bool AssetStorage::store(const AssetPath& path, const AssetData<T>& data)
     {
-        auto dataStream = storage->write(makeDataPath(path));
-        auto metaStream = storage->write(makeMetaPath(path));
-        if (dataStream == nullptr || metaStream == nullptr)
-        {
-            if (dataStream != metaStream)
-            {
-                log::debug << "[In AssetStorage::store]: If the data path of an asset does not"
-                    " exist in the data storage, then the metadata path should not exist either,"
-                    " and vice-versa. However, this is not the case. [For asset path "
-                    << path.string() << std::boolalpha
-                    << ": <meta-path> -> " << !!metaStream
-                    << ", <data-path> -> " << !!dataStream << "]"
-                    ". Investigate whether this is an issue.";
-            }
-            return false;
-        }
-
-        serializeMetadata(AssetMetadata{
-            .name=path.getAssetName(),
-            .type=AssetType::make<T>(),
-            .path=path
-        }, *metaStream);
-        AssetSerializerTraits<T>::serialize(data, *dataStream);
+        // Serialize to memory first to compute the index entry's content hash
+        std::ostringstream ss;
+        AssetSerializerTraits<T>::serialize(data, ss);
 
-        return true;
+        return storeSerialized(path, AssetType::make<T>(), ss.view());
     }
 } // namespace trc
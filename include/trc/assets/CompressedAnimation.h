@@ -0,0 +1,88 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "trc/Types.h"
+
+namespace trc
+{
+    /**
+     * @brief A skeletal animation clip stored as quantized per-bone tracks
+     *
+     * Every bone has separate translation, rotation, and scale tracks. A
+     * track stores keys only at a subset of the clip's frames; values
+     * between two keys are interpolated linearly (normalized-linearly for
+     * rotations).
+     *
+     * Translations and scales are quantized to 16 bits per component
+     * relative to the track's value range. Rotations are stored in the
+     * smallest-three encoding: the largest component of the normalized
+     * quaternion is dropped and the remaining three are stored with 15
+     * bits each. The index of the dropped component occupies the top bits
+     * of the first two values.
+     *
+     * Create compressed animations with `compressAnimation` from
+     * `trc/assets/import/AnimationCompression.h`.
+     */
+    struct CompressedAnimation
+    {
+        struct Track
+        {
+            /** Sorted frame indices of all keys. Never empty. */
+            std::vector<ui16> frames;
+
+            /** Three quantized components per key */
+            std::vector<ui16> values;
+
+            /** Dequantization range. Unused for rotation tracks. */
+            vec3 rangeMin{ 0.0f };
+            vec3 rangeExtent{ 0.0f };
+        };
+
+        struct BoneTracks
+        {
+            Track translation;
+            Track rotation;
+            Track scale;
+        };
+
+        ui32 frameCount{ 0 };
+        std::vector<BoneTracks> bones;
+
+        auto getBoneCount() const -> ui32;
+
+        /**
+         * @return size_t The size of the compressed track data in bytes
+         */
+        auto getSize() const -> size_t;
+
+        /**
+         * @brief Compute a single bone's transformation at a point in time
+         *
+         * @param ui32 bone
+         * @param float frame Fractional frame index in [0, frameCount - 1].
+         *
+         * @return mat4 The bone matrix, equivalent to an element of
+         *         `AnimationData::Keyframe::boneMatrices`.
+         */
+        auto sampleBone(ui32 bone, float frame) const -> mat4;
+
+        /**
+         * @brief Compute all bone matrices of a frame
+         *
+         * @param ui32 frame Must be less than `frameCount`.
+         * @param std::span<mat4> out Must have at least `getBoneCount()`
+         *        elements.
+         */
+        void sampleFrame(ui32 frame, std::span<mat4> out) const;
+
+        static auto quantizeRange(float value, float min, float extent) -> ui16;
+        static auto dequantizeRange(ui16 value, float min, float extent) -> float;
+        static void quantizeRotation(quat rotation, ui16* out);
+        static auto dequantizeRotation(const ui16* values) -> quat;
+
+        static auto sampleVector(const Track& track, float frame) -> vec3;
+        static auto sampleRotation(const Track& track, float frame) -> quat;
+    };
+} // namespace trc
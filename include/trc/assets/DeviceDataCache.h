@@ -1,20 +1,66 @@
 #pragma once
 
+#include <atomic>
 #include <concepts>
+#include <condition_variable>
+#include <functional>
+#include <future>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
+#include <trc_util/async/ThreadPool.h>
 #include <trc_util/data/SafeVector.h>
 
 #include "trc/Types.h"
 
 namespace trc
 {
+    /**
+     * @brief Usage statistics of a DeviceDataCache
+     */
+    struct DeviceDataCacheStats
+    {
+        /** Number of requests that did not have to load the entry */
+        size_t hits{ 0 };
+        /** Number of requests that had to load the entry */
+        size_t misses{ 0 };
+        /** Number of retained entries that were freed to stay within the budget */
+        size_t evictions{ 0 };
+
+        /** Number of unreferenced entries currently kept in memory */
+        size_t retainedEntries{ 0 };
+        /** Estimated size of all unreferenced entries currently kept in memory */
+        size_t retainedBytes{ 0 };
+    };
+
+    /**
+     * @brief A reference-counted cache for device data
+     *
+     * Entries are loaded on first access and freed once no handles to them
+     * exist anymore.
+     *
+     * If a retention budget is set, entries without handles are not freed
+     * immediately. They are kept in memory until the estimated size of all
+     * such entries exceeds the budget, at which point the least recently
+     * used ones are freed. This avoids reloading data that is dropped and
+     * requested again shortly after, e.g. when streaming a scene.
+     *
+     * Loading can either happen synchronously in `get`, or asynchronously
+     * on a thread pool via `getAsync`. The latter returns immediately with
+     * a handle in a 'loading' state that refers to a fallback entry (such
+     * as a default texture) until the actual data is available.
+     */
     template<typename DeviceData>
     class DeviceDataCache
     {
     private:
         class ReferenceCounter;
         class SharedRef;
+        struct CacheEntry;
 
         using Self = DeviceDataCache<DeviceData>;
 
@@ -26,6 +72,11 @@ namespace trc
          *
          * Is reference counted. The entry is removed from the cache when no
          * handles exist anymore.
+         *
+         * Handles created by `DeviceDataCache::getAsync` may refer to an
+         * entry that is still being loaded. Such handles give access to
+         * the fallback entry's data until loading has completed, or to
+         * nothing (nullptr) if no fallback was specified.
          */
         struct CacheEntryHandle
         {
@@ -36,21 +87,56 @@ namespace trc
             CacheEntryHandle& operator=(CacheEntryHandle&&) noexcept = default;
             ~CacheEntryHandle() noexcept = default;
 
-            auto operator->() -> DeviceData* { return data; }
-            auto operator->() const -> const DeviceData* { return data; }
-            auto operator*() -> DeviceData& { return *data; }
-            auto operator*() const -> const DeviceData& { return *data; }
+            auto operator->() -> DeviceData* { return entry->get(); }
+            auto operator->() const -> const DeviceData* { return entry->get(); }
+            auto operator*() -> DeviceData& { return *entry->get(); }
+            auto operator*() const -> const DeviceData& { return *entry->get(); }
+
+            /**
+             * @return bool True if the entry's own data is available, false
+             *              if it is still loading or if loading has failed.
+             */
+            bool isLoaded() const {
+                return entry->state.load(std::memory_order_acquire) == LoadState::eLoaded;
+            }
+
+            /**
+             * @brief Block until the entry has been loaded
+             *
+             * @throw Any exception thrown by `Loader::loadDeviceData`.
+             */
+            void wait() const {
+                loadResult.get();
+            }
+
+            /**
+             * @return std::shared_future<void> A future that becomes ready
+             *         when the entry has been loaded. Holds the loader's
+             *         exception if loading has failed.
+             */
+            auto getFuture() const -> std::shared_future<void> {
+                return loadResult;
+            }
 
         private:
             friend Self;
-            CacheEntryHandle(DeviceData& data, ReferenceCounter& counter)
-                : data(&data), refCount(counter)
+            CacheEntryHandle(CacheEntry& entry, std::shared_future<void> loadResult)
+                : entry(&entry), loadResult(std::move(loadResult)), refCount(*entry.refCount)
             {}
 
-            DeviceData* data;
+            CacheEntry* entry;
+            std::shared_future<void> loadResult;
             SharedRef refCount;
         };
 
+        /**
+         * @brief Invoked when an asynchronous load has completed
+         *
+         * @param ui32 id The loaded entry.
+         * @param bool success False if the loader has thrown an exception.
+         */
+        using LoadCallback = std::function<void(ui32 id, bool success)>;
+
         /**
          * @brief An interface to the cache owner
          *
@@ -64,6 +150,16 @@ namespace trc
 
             virtual auto loadDeviceData(ui32 id) -> DeviceData = 0;
             virtual void freeDeviceData(ui32 id, DeviceData data) = 0;
+
+            /**
+             * @brief Estimate the memory footprint of an entry's data
+             *
+             * Is counted against the cache's retention budget. Must be safe
+             * to call from the same threads as `loadDeviceData`.
+             */
+            virtual auto getDeviceDataSize(ui32 /*id*/, const DeviceData& /*data*/) -> size_t {
+                return sizeof(DeviceData);
+            }
         };
 
         /**
@@ -74,15 +170,98 @@ namespace trc
          */
         explicit DeviceDataCache(s_ptr<Loader> dataLoader);
 
+        /**
+         * @brief Construct a device data cache object that supports
+         *        asynchronous loading
+         *
+         * @param s_ptr<Loader> An implementation of the `Loader` interface.
+         *                      Must not be nullptr. Must be safe to call
+         *                      from threads in `threadPool`.
+         * @param s_ptr<async::ThreadPool> threadPool Executes asynchronous
+         *                                            loads. Must not be
+         *                                            nullptr.
+         */
+        DeviceDataCache(s_ptr<Loader> dataLoader, s_ptr<async::ThreadPool> threadPool);
+
+        DeviceDataCache(const DeviceDataCache&) = delete;
+        DeviceDataCache(DeviceDataCache&&) noexcept = delete;
+        DeviceDataCache& operator=(const DeviceDataCache&) = delete;
+        DeviceDataCache& operator=(DeviceDataCache&&) noexcept = delete;
+
+        /**
+         * Waits for all pending asynchronous loads to complete and frees
+         * all retained entries.
+         */
+        ~DeviceDataCache() noexcept;
+
         /**
          * @brief Retrieve an entry from the cache
          *
-         * Loads the item lazily if it is not currently cached.
+         * Loads the item lazily if it is not currently cached. Blocks until
+         * the item has been loaded, even if it is currently being loaded
+         * asynchronously.
          *
          * @param ui32 id The item to retrieve
+         *
+         * @throw Any exception thrown by `Loader::loadDeviceData`.
          */
         auto get(ui32 id) -> CacheEntryHandle;
 
+        /**
+         * @brief Retrieve an entry from the cache without blocking
+         *
+         * If the item is not currently cached, schedules it to be loaded
+         * on the cache's thread pool and returns a handle in the 'loading'
+         * state. Loads synchronously if the cache has no thread pool.
+         *
+         * A failed load is retried on the next call to `get` or `getAsync`.
+         *
+         * @param ui32 id The item to retrieve
+         * @param std::optional<CacheEntryHandle> fallback The returned
+         *        handle refers to this entry's data while the requested
+         *        entry is loading. Is only used if the entry is not already
+         *        in the cache.
+         * @param LoadCallback onLoaded Called when loading has completed,
+         *        possibly on a thread pool thread. Called immediately if the
+         *        item is already loaded.
+         */
+        auto getAsync(ui32 id,
+                      std::optional<CacheEntryHandle> fallback = std::nullopt,
+                      LoadCallback onLoaded = {})
+            -> CacheEntryHandle;
+
+        /**
+         * @brief Block until all pending asynchronous loads have completed
+         */
+        void waitIdle();
+
+        /**
+         * @brief Set the maximum size of entries that are kept in memory
+         *        after their last handle has been dropped
+         *
+         * Frees the least recently used retained entries until the new
+         * budget is met. Entries that are larger than the budget on their
+         * own are never retained.
+         *
+         * @param size_t bytes Budget in bytes as estimated by
+         *                     `Loader::getDeviceDataSize`. The default
+         *                     budget of 0 frees entries immediately.
+         */
+        void setRetentionBudget(size_t bytes);
+        auto getRetentionBudget() const -> size_t;
+
+        /**
+         * @brief Free an entry immediately if it is retained
+         *
+         * Must be called when the data an entry was loaded from changes,
+         * e.g. when its ID is reused for a different item.
+         *
+         * @return bool True if a retained entry has been freed.
+         */
+        bool evict(ui32 id);
+
+        auto getStats() const -> DeviceDataCacheStats;
+
         /**
          * @brief Create an ad-hoc implementation of the `Loader` interface
          */
@@ -93,6 +272,18 @@ namespace trc
             }
         static auto makeLoader(LoadFunc load, FreeFunc free) -> u_ptr<Loader>;
 
+        /**
+         * @brief Create an ad-hoc implementation of the `Loader` interface
+         *        with a custom size estimate
+         */
+        template<typename LoadFunc, typename FreeFunc, typename SizeFunc>
+            requires requires (LoadFunc load, FreeFunc free, SizeFunc size, ui32 id, DeviceData data) {
+                { load(id) } -> std::convertible_to<DeviceData>;
+                { free(id, std::move(data)) } -> std::same_as<void>;
+                { size(id, std::as_const(data)) } -> std::convertible_to<size_t>;
+            }
+        static auto makeLoader(LoadFunc load, FreeFunc free, SizeFunc size) -> u_ptr<Loader>;
+
     private:
         /**
          * @brief A reference counter
@@ -116,21 +307,36 @@ namespace trc
 
             void incRefCount()
             {
-                assert(count < std::numeric_limits<decltype(count)>::max());
-                ++count;
+                [[maybe_unused]] const ui32 prev = count.fetch_add(1, std::memory_order_relaxed);
+                assert(prev < std::numeric_limits<ui32>::max());
             }
 
+            /**
+             * The entry may be revived by another thread after the count
+             * has dropped to zero, so `unload` checks the count again.
+             *
+             * Once the count is zero, another thread may also release the
+             * entry and destroy this counter. Nothing on `this` is accessed
+             * after the decrement.
+             */
             void decRefCount()
             {
-                assert(count > 0);
                 assert(cache != nullptr);
-                if (--count == 0) {
-                    cache->unload(asset);
+                Self* const owningCache = cache;
+                const ui32 id = asset;
+                const ui32 prev = count.fetch_sub(1, std::memory_order_acq_rel);
+                assert(prev > 0);
+                if (prev == 1) {
+                    owningCache->unload(id);
                 }
             }
 
+            auto getRefCount() const -> ui32 {
+                return count.load(std::memory_order_acquire);
+            }
+
         private:
-            ui32 count{ 0 };
+            std::atomic<ui32> count{ 0 };
             ui32 asset;
             Self* cache;
         };
@@ -156,16 +362,111 @@ namespace trc
             ReferenceCounter* counter;
         };
 
+        enum class LoadState
+        {
+            eLoading,
+            eLoaded,
+            eFailed,
+        };
+
         struct CacheEntry
         {
+            CacheEntry(ui32 id, Self& cache, std::optional<CacheEntryHandle> fallback)
+                : refCount(std::make_unique<ReferenceCounter>(id, cache)),
+                  fallback(std::move(fallback))
+            {}
+
+            /**
+             * @return DeviceData* The entry's data if it has been loaded,
+             *         otherwise the fallback's data. Nullptr if neither is
+             *         available.
+             */
+            auto get() -> DeviceData*
+            {
+                if (state.load(std::memory_order_acquire) == LoadState::eLoaded) {
+                    return &*data;
+                }
+                return fallback ? &**fallback : nullptr;
+            }
+
             u_ptr<ReferenceCounter> refCount;
-            DeviceData data;
+            std::optional<DeviceData> data;
+            std::atomic<LoadState> state{ LoadState::eLoading };
+
+            // Not modified after construction, so it can be read without
+            // synchronization
+            std::optional<CacheEntryHandle> fallback;
+
+            // Guarded by `DeviceDataCache::asyncLock`
+            std::promise<void> loadPromise;
+            std::shared_future<void> loadResult;
+            std::vector<LoadCallback> callbacks;
+            bool orphaned{ false };
+
+            // Guarded by `DeviceDataCache::asyncLock`
+            size_t size{ 0 };
+            std::optional<std::list<ui32>::iterator> retainedPos;
         };
 
+        /**
+         * @brief Find or create an entry and start loading it if necessary
+         *
+         * @return bool True if the caller must execute `runLoad` for the
+         *              entry.
+         */
+        auto acquireEntry(ui32 id,
+                          std::optional<CacheEntryHandle> fallback,
+                          LoadCallback onLoaded)
+            -> std::pair<CacheEntryHandle, bool>;
+
+        /**
+         * @brief Load an entry and publish the result
+         *
+         * Can be called on any thread. Does not throw.
+         */
+        void runLoad(ui32 id);
+
         void unload(ui32 id);
 
+        /**
+         * @brief Retain or free an entry that has no handles anymore
+         *
+         * Requires `asyncLock` to be held.
+         *
+         * @param std::vector<CacheEntryHandle>& releasedFallbacks Receives
+         *        the fallback handles of freed entries. They must be
+         *        destroyed after the lock has been released because they
+         *        might trigger another unload.
+         */
+        void release(ui32 id, std::vector<CacheEntryHandle>& releasedFallbacks);
+
+        /**
+         * @brief Free least recently used entries until the budget is met
+         *
+         * Requires `asyncLock` to be held.
+         */
+        void enforceRetentionBudget(std::vector<CacheEntryHandle>& releasedFallbacks);
+
+        /**
+         * @brief Free an entry's data and remove it from the cache
+         *
+         * Requires `asyncLock` to be held.
+         */
+        void freeEntry(ui32 id, std::vector<CacheEntryHandle>& releasedFallbacks);
+
         s_ptr<Loader> dataLoader;
-        util::SafeVector<CacheEntry> entries;
+        s_ptr<async::ThreadPool> threadPool;
+        util::ReadOptimizedSafeVector<CacheEntry> entries;
+
+        mutable std::mutex asyncLock;
+        std::condition_variable loadsCompleted;
+        size_t numPendingLoads{ 0 };
+
+        // Guarded by `asyncLock`. Retained entries in order of last use,
+        // least recently used first.
+        std::list<ui32> retained;
+        size_t retentionBudget{ 0 };
+        DeviceDataCacheStats stats;
     };
 
 
@@ -179,19 +480,195 @@ namespace trc
         assert(this->dataLoader != nullptr);
     }
 
+    template<typename DeviceData>
+    DeviceDataCache<DeviceData>::DeviceDataCache(
+        s_ptr<Loader> dataLoader,
+        s_ptr<async::ThreadPool> threadPool)
+        :
+        dataLoader(dataLoader),
+        threadPool(threadPool)
+    {
+        assert(this->dataLoader != nullptr);
+        assert(this->threadPool != nullptr);
+    }
+
+    template<typename DeviceData>
+    DeviceDataCache<DeviceData>::~DeviceDataCache() noexcept
+    {
+        waitIdle();
+        setRetentionBudget(0);
+    }
+
     template<typename DeviceData>
     auto DeviceDataCache<DeviceData>::get(ui32 id) -> CacheEntryHandle
     {
-        if (!entries.contains(id))
+        auto [handle, mustLoad] = acquireEntry(id, std::nullopt, {});
+        if (mustLoad) {
+            runLoad(id);
+        }
+
+        handle.wait();
+        return handle;
+    }
+
+    template<typename DeviceData>
+    auto DeviceDataCache<DeviceData>::getAsync(
+        ui32 id,
+        std::optional<CacheEntryHandle> fallback,
+        LoadCallback onLoaded)
+        -> CacheEntryHandle
+    {
+        auto [handle, mustLoad] = acquireEntry(id, std::move(fallback), onLoaded);
+        if (mustLoad)
         {
-            entries.emplace(id, CacheEntry{
-                .refCount=std::make_unique<ReferenceCounter>(id, *this),
-                .data=dataLoader->loadDeviceData(id)
-            });
+            if (threadPool != nullptr) {
+                threadPool->execute([this, id]{ runLoad(id); });
+            }
+            else {
+                runLoad(id);
+            }
+        }
+        else if (onLoaded && handle.isLoaded()) {
+            onLoaded(id, true);
+        }
+
+        return handle;
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::waitIdle()
+    {
+        std::unique_lock lock(asyncLock);
+        loadsCompleted.wait(lock, [this]{ return numPendingLoads == 0; });
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::setRetentionBudget(size_t bytes)
+    {
+        std::vector<CacheEntryHandle> releasedFallbacks;
+        std::scoped_lock lock(asyncLock);
+        retentionBudget = bytes;
+        enforceRetentionBudget(releasedFallbacks);
+    }
+
+    template<typename DeviceData>
+    auto DeviceDataCache<DeviceData>::getRetentionBudget() const -> size_t
+    {
+        std::scoped_lock lock(asyncLock);
+        return retentionBudget;
+    }
+
+    template<typename DeviceData>
+    bool DeviceDataCache<DeviceData>::evict(ui32 id)
+    {
+        std::vector<CacheEntryHandle> releasedFallbacks;
+        std::scoped_lock lock(asyncLock);
+        if (!entries.contains(id) || !entries.at(id).retainedPos) {
+            return false;
+        }
+
+        CacheEntry& entry = entries.at(id);
+        retained.erase(*entry.retainedPos);
+        stats.retainedBytes -= entry.size;
+        --stats.retainedEntries;
+        freeEntry(id, releasedFallbacks);
+
+        return true;
+    }
+
+    template<typename DeviceData>
+    auto DeviceDataCache<DeviceData>::getStats() const -> DeviceDataCacheStats
+    {
+        std::scoped_lock lock(asyncLock);
+        return stats;
+    }
+
+    template<typename DeviceData>
+    auto DeviceDataCache<DeviceData>::acquireEntry(
+        ui32 id,
+        std::optional<CacheEntryHandle> fallback,
+        LoadCallback onLoaded)
+        -> std::pair<CacheEntryHandle, bool>
+    {
+        std::scoped_lock lock(asyncLock);
+
+        auto [ref, created] = entries.try_emplace(id, id, *this, std::move(fallback));
+        CacheEntry& entry = ref.get();
+        entry.orphaned = false;
+
+        // Revive a retained entry
+        if (entry.retainedPos)
+        {
+            retained.erase(*entry.retainedPos);
+            entry.retainedPos.reset();
+            stats.retainedBytes -= entry.size;
+            --stats.retainedEntries;
+        }
+
+        const bool mustLoad = created || entry.state == LoadState::eFailed;
+        ++(mustLoad ? stats.misses : stats.hits);
+        if (mustLoad)
+        {
+            entry.state = LoadState::eLoading;
+            entry.loadPromise = {};
+            entry.loadResult = entry.loadPromise.get_future().share();
+            ++numPendingLoads;
+        }
+        if (onLoaded && entry.state == LoadState::eLoading) {
+            entry.callbacks.emplace_back(std::move(onLoaded));
+        }
+
+        return { CacheEntryHandle{ entry, entry.loadResult }, mustLoad };
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::runLoad(ui32 id)
+    {
+        std::optional<DeviceData> data;
+        size_t size{ 0 };
+        std::exception_ptr error;
+        try {
+            data.emplace(dataLoader->loadDeviceData(id));
+            size = dataLoader->getDeviceDataSize(id, *data);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::vector<CacheEntryHandle> releasedFallbacks;
+        std::vector<LoadCallback> callbacks;
+        {
+            std::scoped_lock lock(asyncLock);
+            CacheEntry& entry = entries.at(id);
+            callbacks = std::move(entry.callbacks);
+            entry.callbacks.clear();
+
+            if (error)
+            {
+                entry.state = LoadState::eFailed;
+                entry.loadPromise.set_exception(error);
+            }
+            else
+            {
+                entry.data.emplace(std::move(*data));
+                entry.size = size;
+                entry.state.store(LoadState::eLoaded, std::memory_order_release);
+                entry.loadPromise.set_value();
+            }
+
+            // All handles were dropped while the entry was loading
+            if (entry.orphaned) {
+                release(id, releasedFallbacks);
+            }
         }
 
-        auto& [refCount, data] = entries.at(id);
-        return CacheEntryHandle{ data, *refCount };
+        for (auto& callback : callbacks) {
+            callback(id, error == nullptr);
+        }
+
+        std::scoped_lock lock(asyncLock);
+        --numPendingLoads;
+        loadsCompleted.notify_all();
     }
 
     template<typename DeviceData>
@@ -216,10 +693,113 @@ namespace trc
         return std::make_unique<LoaderImpl>(std::move(load), std::move(free));
     }
 
+    template<typename DeviceData>
+    template<typename LoadFunc, typename FreeFunc, typename SizeFunc>
+        requires requires (LoadFunc load, FreeFunc free, SizeFunc size, ui32 id, DeviceData data) {
+            { load(id) } -> std::convertible_to<DeviceData>;
+            { free(id, std::move(data)) } -> std::same_as<void>;
+            { size(id, std::as_const(data)) } -> std::convertible_to<size_t>;
+        }
+    auto DeviceDataCache<DeviceData>::makeLoader(LoadFunc load, FreeFunc free, SizeFunc size)
+        -> u_ptr<Loader>
+    {
+        struct LoaderImpl : public Loader
+        {
+            LoaderImpl(LoadFunc l, FreeFunc f, SizeFunc s)
+                : _load(std::move(l)), _free(std::move(f)), _size(std::move(s)) {}
+
+            auto loadDeviceData(ui32 id) -> DeviceData override { return _load(id); }
+            void freeDeviceData(ui32 id, DeviceData data) override { _free(id, std::move(data)); }
+            auto getDeviceDataSize(ui32 id, const DeviceData& data) -> size_t override {
+                return _size(id, data);
+            }
+
+            LoadFunc _load;
+            FreeFunc _free;
+            SizeFunc _size;
+        };
+
+        return std::make_unique<LoaderImpl>(std::move(load), std::move(free), std::move(size));
+    }
+
     template<typename DeviceData>
     void DeviceDataCache<DeviceData>::unload(ui32 id)
     {
-        dataLoader->freeDeviceData(id, std::move(entries.at(id).data));
+        std::vector<CacheEntryHandle> releasedFallbacks;
+
+        std::scoped_lock lock(asyncLock);
+
+        // Another thread may have acquired the entry since its last handle
+        // was dropped, and may even have released it again. The count only
+        // rises from zero while `asyncLock` is held, so the checks are stable.
+        if (!entries.contains(id)) {
+            return;
+        }
+        CacheEntry& entry = entries.at(id);
+        if (entry.refCount->getRefCount() > 0 || entry.retainedPos) {
+            return;
+        }
+
+        if (entry.state == LoadState::eLoading)
+        {
+            // Released by `runLoad` once loading has completed
+            entry.orphaned = true;
+            return;
+        }
+
+        release(id, releasedFallbacks);
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::release(
+        ui32 id,
+        std::vector<CacheEntryHandle>& releasedFallbacks)
+    {
+        CacheEntry& entry = entries.at(id);
+        entry.orphaned = false;
+        if (entry.state != LoadState::eLoaded
+            || retentionBudget == 0
+            || entry.size > retentionBudget)
+        {
+            freeEntry(id, releasedFallbacks);
+            return;
+        }
+
+        entry.retainedPos = retained.insert(retained.end(), id);
+        stats.retainedBytes += entry.size;
+        ++stats.retainedEntries;
+        enforceRetentionBudget(releasedFallbacks);
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::enforceRetentionBudget(
+        std::vector<CacheEntryHandle>& releasedFallbacks)
+    {
+        while (!retained.empty() && stats.retainedBytes > retentionBudget)
+        {
+            const ui32 id = retained.front();
+            retained.pop_front();
+
+            CacheEntry& entry = entries.at(id);
+            stats.retainedBytes -= entry.size;
+            --stats.retainedEntries;
+            ++stats.evictions;
+            freeEntry(id, releasedFallbacks);
+        }
+    }
+
+    template<typename DeviceData>
+    void DeviceDataCache<DeviceData>::freeEntry(
+        ui32 id,
+        std::vector<CacheEntryHandle>& releasedFallbacks)
+    {
+        CacheEntry& entry = entries.at(id);
+        if (entry.state == LoadState::eLoaded) {
+            dataLoader->freeDeviceData(id, std::move(*entry.data));
+        }
+        if (entry.fallback) {
+            releasedFallbacks.emplace_back(*entry.fallback);
+        }
         entries.erase(id);
     }
 
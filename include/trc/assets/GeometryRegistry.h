@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <unordered_set>
 
 #include <trc_util/data/IdPool.h>
@@ -41,8 +42,49 @@ namespace trc
         std::vector<SkeletalVertex> skeletalVertices;
         std::vector<VertexIndex> indices;
 
+        /**
+         * Vertices in the compact format. A geometry stores its vertices
+         * either in `vertices` or in `packedVertices`, but never in both.
+         * See `packVertexData`.
+         */
+        std::vector<PackedMeshVertex> packedVertices{};
+
+        /** Dequantization transform for positions in `packedVertices` */
+        VertexQuantization quantization{};
+
         AssetReference<Rig> rig{};
 
+        /**
+         * True if `indices` have already been reordered for vertex cache
+         * efficiency (see `optimizeTriangleOrder`). The geometry registry
+         * skips its own optimization pass for such geometries.
+         */
+        bool triangleOrderOptimized{ false };
+
+        /**
+         * Object-space bounds of the vertices in their rest pose. Computed
+         * during import (see `computeBounds`) and stored with the asset.
+         * Deserialized geometries always have bounds.
+         */
+        std::optional<GeometryBounds> bounds{};
+
+        /**
+         * Bounds that contain a skinned geometry in every pose of its rig's
+         * animations (see `computeAnimatedBounds`). Empty for geometries
+         * without a skeleton, and for skinned geometries that were not
+         * imported with animations, such as legacy protobuf assets.
+         */
+        std::optional<GeometryBounds> animatedBounds{};
+
+        auto getVertexFormat() const -> VertexFormat;
+        auto getVertexCount() const -> size_t;
+
+        /**
+         * @return GeometryBounds `bounds` if it is set, otherwise bounds
+         *         computed from the vertices.
+         */
+        auto getBounds() const -> GeometryBounds;
+
         void resolveReferences(AssetManager& man);
 
         void serialize(std::ostream& os) const;
@@ -60,6 +102,9 @@ namespace trc
 
         ui32 memoryPoolChunkSize{ 200000000 };  // 200 MiB
         size_t maxGeometries{ 5000 };
+
+        // See `DeviceDataCache::setRetentionBudget`
+        size_t retentionBudget{ 0 };
     };
 
     /**
@@ -79,6 +124,8 @@ namespace trc
 
         auto getHandle(LocalID id) -> AssetHandle<Geometry> override;
 
+        auto getCacheStats() const -> DeviceDataCacheStats;
+
     private:
         friend class AssetHandle<Geometry>;
 
@@ -98,9 +145,15 @@ namespace trc
             ui32 numIndices{ 0 };
             ui32 numVertices{ 0 };
 
+            VertexFormat vertexFormat{ VertexFormat::eFull };
+            VertexQuantization quantization{};
+
             bool hasSkeleton{ false };
             std::optional<RigID> rig{ std::nullopt };
 
+            GeometryBounds bounds{};
+            std::optional<GeometryBounds> animatedBounds{};
+
             // Must be a unique_ptr instead of std::optional because rt::BLAS is
             // not move-constructible.
             u_ptr<rt::BottomLevelAccelerationStructure> blas{ nullptr };
@@ -108,8 +161,32 @@ namespace trc
 
         auto loadDeviceData(LocalID id) -> DeviceData;
         void freeDeviceData(LocalID id, DeviceData data);
+        static auto getDeviceDataSize(const DeviceData& data) -> size_t;
 
-        void postProcess(LocalID id, AssetData<Geometry>& data);
+        /**
+         * @brief Create device buffers and enqueue uploads of geometry data
+         *
+         * The source data only has to be valid for the duration of the call.
+         *
+         * At most one of `vertices` and `packedVertices` may be non-empty.
+         * Packed vertices are unpacked if ray tracing is enabled because
+         * acceleration structure builds and ray shaders read the full
+         * vertex format.
+         */
+        auto makeDeviceData(LocalID id,
+                            std::span<const VertexIndex> indices,
+                            std::span<const MeshVertex> vertices,
+                            std::span<const PackedMeshVertex> packedVertices,
+                            const VertexQuantization& quantization,
+                            std::span<const SkeletalVertex> skeletalVertices,
+                            std::optional<RigID> rig)
+            -> DeviceData;
+
+        /**
+         * Runtime fallback for geometries that were not optimized during
+         * import (see `GeometryData::triangleOrderOptimized`).
+         */
+        void postProcess(LocalID id, std::vector<VertexIndex>& indices);
 
         static auto makeAccelerationStructureGeometryInfo(const Device& device,
                                                           const DeviceData& data)
@@ -123,16 +200,19 @@ namespace trc
         DeviceLocalDataWriter dataWriter;
         AccelerationStructureBuilder accelerationStructureBuilder;
 
-        util::SafeVector<u_ptr<AssetSource<Geometry>>> dataSources;
-        DeviceDataCache<DeviceData> deviceDataStorage;
-
         /**
          * Assets scheduled for removal from memory.
          * Buffers must only be destroyed after any deferred copy operations
          * have completed.
+         *
+         * Declared before the cache because the cache frees its retained
+         * entries on destruction.
          */
         std::vector<DeviceData> pendingUnloads;
 
+        util::ReadOptimizedSafeVector<u_ptr<AssetSource<Geometry>>> dataSources;
+        DeviceDataCache<DeviceData> deviceDataStorage;
+
         SharedDescriptorSet::Binding indexDescriptorBinding;
         SharedDescriptorSet::Binding vertexDescriptorBinding;
     };
@@ -176,6 +256,35 @@ namespace trc
         auto getVertexSize() const noexcept -> size_t;
         auto getSkeletalVertexSize() const noexcept -> size_t;
 
+        /**
+         * @return VertexFormat The format of the vertices in the vertex
+         *         buffer. Always VertexFormat::eFull if ray tracing is
+         *         enabled.
+         */
+        auto getVertexFormat() const noexcept -> VertexFormat;
+
+        /**
+         * @return const VertexQuantization& The transform with which packed
+         *         vertex positions are dequantized. Only meaningful if the
+         *         vertex format is VertexFormat::ePacked.
+         */
+        auto getVertexQuantization() const noexcept -> const VertexQuantization&;
+
+        /**
+         * @return const GeometryBounds& Object-space bounds of the
+         *         geometry in its rest pose.
+         */
+        auto getBounds() const noexcept -> const GeometryBounds&;
+
+        /**
+         * @return const std::optional<GeometryBounds>& Object-space bounds
+         *         that contain the geometry in every pose of its rig's
+         *         animations. Equal to `getBounds()` for geometries without
+         *         a skeleton. Empty if the geometry has a skeleton, but its
+         *         animated bounds are unknown.
+         */
+        auto getAnimatedBounds() const noexcept -> const std::optional<GeometryBounds>&;
+
         bool hasSkeleton() const;
         bool hasRig() const;
         auto getRig() -> RigID;
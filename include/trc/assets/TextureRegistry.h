@@ -32,12 +32,74 @@ namespace trc
         }
     };
 
+    /**
+     * @brief Encoding of pre-processed texture data
+     *
+     * Block-compressed formats store 4x4 pixel blocks and require the
+     * `textureCompressionBC` device feature.
+     */
+    enum class TextureFormat : ui32
+    {
+        eRGBA8,  // 4 bytes per pixel
+        eBC1,    // 8 bytes per block; RGB with 1-bit alpha
+        eBC3,    // 16 bytes per block; RGBA
+        eBC5,    // 16 bytes per block; two channels (RG)
+        eBC7,    // 16 bytes per block; RGBA
+    };
+
+    /**
+     * @brief Size of a single image of a texture format in bytes
+     */
+    auto getTextureDataSize(TextureFormat format, uvec2 size) -> size_t;
+
+    /**
+     * @brief Size of a mip level of an image
+     *
+     * @return uvec2 `max(1, baseSize >> level)` in both dimensions
+     */
+    auto getMipLevelSize(uvec2 baseSize, ui32 level) -> uvec2;
+
+    /**
+     * @brief Number of levels of a full mip chain of an image
+     *
+     * @return ui32 `floor(log2(max(size.x, size.y))) + 1`, or 0 for an
+     *              empty image.
+     */
+    auto getMaxMipLevelCount(uvec2 size) -> ui32;
+
+    struct TextureMipLevel
+    {
+        uvec2 size;
+        std::vector<ui8> data;
+    };
+
+    /**
+     * @brief Check that pre-encoded texture data forms a valid mip chain
+     *
+     * The base level must be non-empty, level `i` must have the size
+     * `getMipLevelSize(base, i)` and contain exactly as many bytes as its
+     * format requires, and there must be at most `getMaxMipLevelCount`
+     * levels.
+     *
+     * @throw std::runtime_error if any of these conditions is violated.
+     */
+    void validateMipChain(TextureFormat format, const std::vector<TextureMipLevel>& levels);
+
     template<>
     struct AssetData<Texture>
     {
         uvec2 size;
         std::vector<glm::u8vec4> pixels;
 
+        /**
+         * Optional pre-encoded image data, ordered from the base level to
+         * the smallest mip level. If not empty, the texture registry uploads
+         * all levels as-is and ignores `pixels`. The base level's size must
+         * be equal to `size`.
+         */
+        TextureFormat format{ TextureFormat::eRGBA8 };
+        std::vector<TextureMipLevel> mipLevels{};
+
         void serialize(std::ostream& os) const;
         void deserialize(std::istream& is);
     };
@@ -46,6 +108,9 @@ namespace trc
     {
         const Device& device;
         SharedDescriptorSet::Binding textureDescBinding;
+
+        // See `DeviceDataCache::setRetentionBudget`
+        size_t retentionBudget{ 0 };
     };
 
     class TextureRegistry : public AssetRegistryModuleInterface<Texture>
@@ -63,6 +128,8 @@ namespace trc
 
         auto getHandle(LocalID id) -> AssetHandle<Texture> override;
 
+        auto getCacheStats() const -> DeviceDataCacheStats;
+
     private:
         struct DeviceData
         {
@@ -70,6 +137,8 @@ namespace trc
 
             Image image;
             vk::UniqueImageView imageView;
+
+            size_t memorySize{ 0 };
         };
 
         template<typename T>
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "trc/Types.h"
+#include "trc/assets/Animation.h"
+#include "trc/assets/CompressedAnimation.h"
+
+namespace trc
+{
+    struct AnimationCompressionSettings
+    {
+        /** Maximum deviation of a bone's translation in model units */
+        float translationTolerance{ 0.0005f };
+
+        /** Maximum deviation of a bone's rotation in radians */
+        float rotationTolerance{ 0.001f };
+
+        /** Maximum deviation of a bone's scale per axis */
+        float scaleTolerance{ 0.0005f };
+    };
+
+    struct AnimationCompressionStats
+    {
+        /** Size of the uncompressed bone matrices in bytes */
+        size_t originalSize{ 0 };
+
+        /** Size of the compressed tracks in bytes */
+        size_t compressedSize{ 0 };
+
+        /** Number of keys per track if no keys were removed */
+        ui32 frameCount{ 0 };
+
+        /** Number of keys in all tracks of the compressed animation */
+        size_t keyCount{ 0 };
+
+        /**
+         * Largest absolute difference between any element of an original
+         * bone matrix and the decoded one
+         */
+        float maxError{ 0.0f };
+
+        auto getRatio() const -> float;
+    };
+
+    /**
+     * @brief Compress an animation's bone matrices into quantized tracks
+     *
+     * Decomposes every bone matrix into translation, rotation, and scale,
+     * quantizes the components, and removes all keys that can be
+     * interpolated from their neighbours within the tolerances specified
+     * in `settings`.
+     *
+     * Matrices that contain shear can't be represented exactly. The
+     * resulting error is reported in `AnimationCompressionStats::maxError`.
+     *
+     * @param const AnimationData& anim An animation with uncompressed
+     *        keyframes.
+     * @param AnimationCompressionStats* stats If not nullptr, receives
+     *        statistics about the compression.
+     *
+     * @throw std::invalid_argument if the animation has no keyframes, has
+     *        more than 65536 frames, or if its keyframes have different
+     *        numbers of bones.
+     */
+    auto compressAnimation(const AnimationData& anim,
+                           const AnimationCompressionSettings& settings = {},
+                           AnimationCompressionStats* stats = nullptr)
+        -> CompressedAnimation;
+
+    /**
+     * @brief Compress an animation in place
+     *
+     * Replaces `anim.keyframes` with a compressed representation.
+     *
+     * @throw std::invalid_argument, see `compressAnimation`.
+     */
+    auto compressAnimationInPlace(AnimationData& anim,
+                                  const AnimationCompressionSettings& settings = {})
+        -> AnimationCompressionStats;
+} // namespace trc
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "trc/Types.h"
+#include "trc/Vertex.h"
+#include "trc/assets/Geometry.h"
+
+namespace trc::internal
+{
+    /**
+     * @brief Header of the binary geometry container
+     *
+     * The container is laid out as follows:
+     *
+     *     [header] [bounds] [mesh vertices] [skeletal vertices] [indices] [rig path]
+     *
+     * Each blob begins at an offset (relative to the start of the header)
+     * that is a multiple of `kBinaryGeometryAlignment`. Vertex and index
+     * blobs are tightly packed arrays of `MeshVertex`, `SkeletalVertex`, and
+     * `VertexIndex`, respectively, in the host's native byte order. This
+     * allows a reader to access them in-place, e.g. from a memory-mapped
+     * file.
+     *
+     * If the `kBinaryGeometryPackedVertices` flag is set, the mesh vertex
+     * blob begins with the geometry's `VertexQuantization`, padded to
+     * `kBinaryGeometryQuantizationSize` bytes, followed by a tightly
+     * packed array of `PackedMeshVertex`.
+     *
+     * If the `kBinaryGeometryBounds` flag is set, the header is followed
+     * by the geometry's `bounds` and `animatedBounds` as two
+     * `GeometryBounds` objects. The second one is only meaningful if the
+     * `kBinaryGeometryAnimatedBounds` flag is set as well. Readers that
+     * don't know the flags skip the bounds via the blob offsets.
+     */
+    struct BinaryGeometryHeader
+    {
+        char magic[8];
+        ui32 version;
+        ui32 flags;
+
+        ui32 vertexSize;
+        ui32 skeletalVertexSize;
+        ui32 indexSize;
+        ui32 _padding{ 0 };
+
+        ui64 numVertices;
+        ui64 numSkeletalVertices;
+        ui64 numIndices;
+        ui64 rigPathLength;
+
+        ui64 vertexOffset;
+        ui64 skeletalVertexOffset;
+        ui64 indexOffset;
+        ui64 rigPathOffset;
+    };
+
+    static_assert(sizeof(BinaryGeometryHeader) == 96);
+
+    constexpr char kBinaryGeometryMagic[8]{ 'T', 'R', 'C', 'G', 'E', 'O', '\0', '\0' };
+    constexpr ui32 kBinaryGeometryVersion{ 1 };
+    constexpr size_t kBinaryGeometryAlignment{ 16 };
+
+    /** Flag bits in `BinaryGeometryHeader::flags` */
+    constexpr ui32 kBinaryGeometryTriangleOrderOptimized{ 1 << 0 };
+    constexpr ui32 kBinaryGeometryPackedVertices{ 1 << 1 };
+    constexpr ui32 kBinaryGeometryBounds{ 1 << 2 };
+    constexpr ui32 kBinaryGeometryAnimatedBounds{ 1 << 3 };
+
+    /** Size of the quantization transform that precedes packed vertices */
+    constexpr size_t kBinaryGeometryQuantizationSize{ 32 };
+    static_assert(sizeof(VertexQuantization) <= kBinaryGeometryQuantizationSize);
+
+    /** Size of the bounds blob that follows the header */
+    constexpr size_t kBinaryGeometryBoundsSize{ 2 * sizeof(GeometryBounds) };
+
+    /**
+     * @brief Write geometry data in the binary geometry format
+     */
+    void writeBinaryGeometry(const GeometryData& data, std::ostream& os);
+
+    /**
+     * @brief Test whether a chunk of memory begins with a binary geometry
+     *        header
+     */
+    bool isBinaryGeometry(std::span<const std::byte> data);
+
+    /**
+     * @brief Read geometry data in the binary geometry format from a stream
+     *
+     * Reads vertex and index blobs directly into the result's arrays.
+     *
+     * @param std::istream& is The input stream. Must be positioned after the
+     *                         header.
+     * @param const BinaryGeometryHeader& header The header previously read
+     *                                           from `is`.
+     *
+     * @throw std::runtime_error if the header is invalid, if it describes
+     *        more data than the stream contains, or if the stream is not
+     *        seekable.
+     */
+    auto readBinaryGeometry(std::istream& is, const BinaryGeometryHeader& header)
+        -> GeometryData;
+
+    /**
+     * @brief A non-owning view of geometry data in the binary format
+     *
+     * Provides direct access to the vertex and index arrays without any
+     * parsing or copying.
+     */
+    class BinaryGeometryView
+    {
+    public:
+        /**
+         * @brief Create a view of binary geometry data
+         *
+         * @return std::optional<BinaryGeometryView> Nullopt if `data` does not
+         *         contain a valid binary geometry, if its version is not
+         *         supported, or if its blobs are not correctly aligned in
+         *         memory.
+         */
+        static auto make(std::span<const std::byte> data) -> std::optional<BinaryGeometryView>;
+
+        auto getHeader() const -> const BinaryGeometryHeader&;
+
+        auto getVertexFormat() const -> VertexFormat;
+
+        /**
+         * @return std::span<const MeshVertex> Empty if the geometry's
+         *         vertices are packed.
+         */
+        auto getVertices() const -> std::span<const MeshVertex>;
+
+        /**
+         * @return std::span<const PackedMeshVertex> Empty if the geometry's
+         *         vertices are not packed.
+         */
+        auto getPackedVertices() const -> std::span<const PackedMeshVertex>;
+
+        /**
+         * @return VertexQuantization The identity transform if the
+         *         geometry's vertices are not packed.
+         */
+        auto getVertexQuantization() const -> VertexQuantization;
+
+        auto getSkeletalVertices() const -> std::span<const SkeletalVertex>;
+        auto getIndices() const -> std::span<const VertexIndex>;
+
+        bool hasRig() const;
+        bool isTriangleOrderOptimized() const;
+
+        /**
+         * @return GeometryBounds The stored bounds, or bounds computed from
+         *         the vertices if the data was written without bounds.
+         */
+        auto getBounds() const -> GeometryBounds;
+
+        auto getAnimatedBounds() const -> std::optional<GeometryBounds>;
+
+        /**
+         * @return std::string_view Empty if the geometry has no rig.
+         */
+        auto getRigPath() const -> std::string_view;
+
+        /**
+         * @brief Copy the viewed data into an owning geometry data object
+         */
+        auto toGeometryData() const -> GeometryData;
+
+    private:
+        explicit BinaryGeometryView(std::span<const std::byte> data);
+
+        std::span<const std::byte> data;
+    };
+} // namespace trc::internal
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "trc/assets/Geometry.h"
 
 namespace trc
@@ -16,4 +18,64 @@ namespace trc
      *        vertices will be overwritten with the computed values.
      */
     void computeTangents(GeometryData& result);
+
+    /**
+     * @brief Reorder a geometry's triangles for vertex cache efficiency
+     *
+     * Applies Forsyth's algorithm to the index buffer and sets
+     * `GeometryData::triangleOrderOptimized` on success. Does nothing if
+     * the flag is already set.
+     *
+     * The geometry must be triangulated.
+     *
+     * @return bool True if the triangle order is optimized after the call,
+     *              false if the mesh is not supported by the algorithm.
+     */
+    bool optimizeTriangleOrder(GeometryData& geo);
+
+    /**
+     * @brief Convert a geometry's vertices to the compact vertex format
+     *
+     * Quantizes positions relative to the geometry's bounding box and
+     * moves the packed vertices to `GeometryData::packedVertices`. Does
+     * nothing if the vertices are already packed.
+     *
+     * Packing is lossy. Apply all other transformations, in particular
+     * `computeTangents`, before packing the vertices.
+     */
+    void packVertexData(GeometryData& geo);
+
+    /**
+     * @brief Convert a geometry's packed vertices back to `MeshVertex`
+     *
+     * Does nothing if the vertices are not packed.
+     */
+    void unpackVertexData(GeometryData& geo);
+
+    /**
+     * @brief Compute a geometry's rest-pose bounds
+     *
+     * Sets `GeometryData::bounds` to an axis-aligned box and a bounding
+     * sphere that contain all vertex positions. Works with both full and
+     * packed vertices.
+     */
+    void computeBounds(GeometryData& geo);
+
+    /**
+     * @brief Compute bounds that contain a skinned geometry in all poses
+     *
+     * Transforms, for every bone, the box around the vertices that the
+     * bone influences with the bone's matrix in every keyframe of every
+     * animation. Skinning blends these transforms linearly, so the union
+     * of the transformed boxes and the rest-pose bounds is a conservative
+     * bound of the animated geometry.
+     *
+     * Sets `GeometryData::animatedBounds`. Does nothing if the geometry
+     * has no skeletal vertices.
+     *
+     * @param GeometryData& geo
+     * @param std::span<const AnimationData> animations The animations of
+     *        the geometry's rig.
+     */
+    void computeAnimatedBounds(GeometryData& geo, std::span<const AnimationData> animations);
 } // namespace trc
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "trc/Types.h"
+#include "trc/assets/Texture.h"
+
+namespace trc
+{
+    /**
+     * @brief Compute a full mip chain for an RGBA8 image
+     *
+     * Each level is computed from the previous one with a 2x2 box filter.
+     * The chain ends with a 1x1 level.
+     *
+     * @return std::vector<TextureMipLevel> All levels, including the base
+     *         level, in the eRGBA8 format.
+     */
+    auto generateMipChain(uvec2 size, const std::vector<glm::u8vec4>& pixels)
+        -> std::vector<TextureMipLevel>;
+
+    /**
+     * @brief Encode a single RGBA8 image in a texture format
+     *
+     * @throw std::invalid_argument if no encoder exists for `format`. This
+     *        is currently the case for TextureFormat::eBC7.
+     */
+    auto encodeImage(TextureFormat format, uvec2 size, const ui8* rgbaPixels)
+        -> std::vector<ui8>;
+
+    /**
+     * @brief Pre-process a texture for storage
+     *
+     * Computes a mip chain (if requested) and encodes all levels in
+     * `format`. The result does not need any CPU-side processing before
+     * it can be uploaded to the device.
+     *
+     * @param const TextureData& tex A texture with RGBA8 pixel data.
+     *
+     * @throw std::invalid_argument if no encoder exists for `format`.
+     */
+    auto encodeTexture(const TextureData& tex, TextureFormat format, bool generateMipmaps)
+        -> TextureData;
+} // namespace trc
@@ -7,6 +7,7 @@
 #include <thread>
 #include <vector>
 
+#include <trc_util/data/BoundedQueue.h>
 #include <trc_util/data/DeferredInsertVector.h>
 #include <trc_util/data/ThreadsafeQueue.h>
 
@@ -15,6 +16,44 @@
 namespace trc
 {
     class Swapchain;
+    struct MouseMoveEvent;
+
+    /**
+     * @brief The queue that transports events of a type to the event
+     *        thread
+     *
+     * Specialize to choose a different queue type for an event type. The
+     * type must provide `try_pop` like `data::ThreadsafeQueue`, and the
+     * specialization must provide a static `push` function that inserts
+     * an event into the queue. `push` is called on the notifying thread
+     * and must never block.
+     */
+    template<typename EventType>
+    struct EventQueue
+    {
+        using Type = data::ThreadsafeQueue<EventType>;
+
+        static void push(Type& queue, EventType&& event) {
+            queue.emplace(std::move(event));
+        }
+    };
+
+    /**
+     * Mouse movement is reported at a high rate from the window thread.
+     * A lock-free queue avoids lock convoys between the window and event
+     * threads.
+     *
+     * If the queue is full, because the event thread is not running or a
+     * listener stalls, the oldest movement is dropped in favour of the new
+     * one. Only the most recent mouse positions matter to listeners.
+     */
+    template<>
+    struct EventQueue<MouseMoveEvent>
+    {
+        using Type = data::BoundedQueue<MouseMoveEvent>;
+
+        static void push(Type& queue, MouseMoveEvent&& event);
+    };
 
     /**
      * @brief An input processor that generates events at the `EventHandler`
@@ -47,11 +86,18 @@ namespace trc
          */
         static void notifyActiveHandler(void(*pollFunc)());
 
+        /**
+         * Each handler has at most one poll function in the queue at any
+         * time, so the queue's capacity bounds the number of event types
+         * that can be pending at once.
+         */
+        static constexpr size_t kMaxPendingHandlers{ 1024 };
+
     private:
         static inline bool shouldStop{ false };
         static inline std::thread thread;
 
-        static inline trc::data::ThreadsafeQueue<void(*)(void)> pollFuncs;
+        static inline trc::data::BoundedQueue<void(*)(void)> pollFuncs{ kMaxPendingHandlers };
     };
 
     template<typename EventType>
@@ -75,7 +121,7 @@ namespace trc
         static inline std::mutex removedListenersListLock;
         static inline std::vector<ListenerId> removedListeners;
 
-        static inline trc::data::ThreadsafeQueue<EventType> eventQueue;
+        static inline typename EventQueue<EventType>::Type eventQueue;
     };
 
     /**
@@ -111,7 +157,7 @@ namespace trc
         if (listeners.empty() && listeners.none_pending()) return;
 
         // Add event to queue
-        eventQueue.emplace(std::move(event));
+        EventQueue<EventType>::push(eventQueue, std::move(event));
 
         // Notify the event thread that the handler has new events and is
         // ready to be processed
@@ -168,5 +214,11 @@ namespace trc
         }
 
         isBeingPolled.clear();
+
+        // An event may have been pushed after the last pop, but before the
+        // flag was cleared. Its `notify` did not schedule a poll.
+        if (!eventQueue.empty() && !isBeingPolled.test_and_set()) {
+            EventThread::notifyActiveHandler(pollEvents);
+        }
     }
 } // namespace trc
@@ -2,7 +2,7 @@
 
 #include "trc/AnimationEngine.h"
 #include "trc/DrawablePipelines.h"
-#include "trc/Transformation.h"
+#include "trc/Node.h"
 #include "trc/assets/GeometryRegistry.h"
 #include "trc/assets/MaterialRegistry.h"
 #include "trc/RasterSceneBase.h"
@@ -13,6 +13,7 @@ namespace trc
     {
         bool animated;
         bool transparent;
+        bool packedVertices{ false };
 
         auto toPipelineFlags() const -> pipelines::DrawableBasePipelineTypeFlags;
         auto determineShadowPipeline() const -> Pipeline::ID;
@@ -24,10 +25,22 @@ namespace trc
         MaterialHandle mat;
         MaterialRuntime matRuntime;
 
-        Transformation::ID modelMatrixId;
+        Node::GlobalTransformID modelMatrixId;
         AnimationEngine::ID anim;
     };
 
     auto makeGBufferDrawFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> DrawableFunction;
     auto makeShadowDrawFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> DrawableFunction;
+
+    /**
+     * @brief Compute a drawable's world-space bounding sphere for culling
+     *
+     * Uses the geometry's animated bounds, so the sphere contains the
+     * drawable in every pose of its animations.
+     *
+     * @return DrawableBoundsFunction An empty function if the geometry has
+     *         a skeleton, but no known animated bounds. Such drawables are
+     *         never culled.
+     */
+    auto makeBoundsFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> DrawableBoundsFunction;
 } // namespace trc
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <componentlib/ComponentStorage.h>
+#include <trc_util/async/JobGraph.h>
 #include <trc_util/data/IdPool.h>
 #include <trc_util/data/IndexMap.h>
 
@@ -49,8 +50,29 @@ namespace trc
     public:
         DrawableScene();
 
+        // The update graph's jobs refer to the scene
+        DrawableScene(const DrawableScene&) = delete;
+        DrawableScene(DrawableScene&&) noexcept = delete;
+        DrawableScene& operator=(const DrawableScene&) = delete;
+        DrawableScene& operator=(DrawableScene&&) noexcept = delete;
+        ~DrawableScene() noexcept = default;
+
+        /**
+         * @brief Update transformations, animations, and ray instances
+         */
         void update(float timeDeltaMs);
 
+        /**
+         * @brief Update the scene on a thread pool
+         *
+         * Runs independent parts of the update in parallel. Does not
+         * allocate memory in the steady state.
+         *
+         * Opt-in: the engine does not update scenes itself. Call this
+         * instead of `update(float)` from the application's frame loop.
+         */
+        void update(float timeDeltaMs, async::ThreadPool& threads);
+
         auto getRasterModule() -> RasterSceneModule&;
         auto getRayModule() -> RaySceneModule&;
         auto getLights() -> LightSceneModule&;
@@ -78,6 +100,14 @@ namespace trc
             deleteObject(drawable);
         }
 
+        /**
+         * @brief Update global transformations in the node tree
+         *
+         * Updates nodes of the same depth in parallel if the scene is
+         * updated on a thread pool.
+         */
+        void updateTransforms();
+
         void updateAnimations(float timeDelta);
 
         /**
@@ -86,5 +116,13 @@ namespace trc
         void updateRayInstances();
 
         Node root;
+
+        /**
+         * Animations are independent of the node tree; ray instances
+         * read the updated global transforms.
+         */
+        async::JobGraph updateGraph;
+        float currentTimeDelta{ 0.0f };
+        async::ThreadPool* currentThreads{ nullptr };
     };
 } // namespace trc
@@ -5,7 +5,7 @@
 #include <componentlib/ComponentStorage.h>
 
 #include "trc/AnimationEngine.h"
-#include "trc/Transformation.h"
+#include "trc/Node.h"
 #include "trc/Types.h"
 #include "trc/assets/Geometry.h"
 #include "trc/assets/Material.h"
@@ -20,7 +20,7 @@ namespace trc
         GeometryID geo;
         MaterialID mat;
 
-        Transformation::ID modelMatrixId;
+        Node::GlobalTransformID modelMatrixId;
         AnimationEngine::ID anim;
     };
 
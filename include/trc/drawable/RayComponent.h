@@ -2,7 +2,7 @@
 
 #include <componentlib/ComponentStorage.h>
 
-#include "trc/Transformation.h"
+#include "trc/Node.h"
 #include "trc/assets/Geometry.h"
 #include "trc/assets/Material.h"
 #include "trc/drawable/DrawableScene.h"
@@ -14,7 +14,7 @@ namespace trc
         GeometryID geo;
         MaterialID mat;
 
-        Transformation::ID transformation;
+        Node::GlobalTransformID transformation;
     };
 
     struct RayComponent
@@ -25,7 +25,7 @@ namespace trc
          */
         RayComponent(const RayComponentCreateInfo& info);
 
-        Transformation::ID modelMatrix;
+        Node::GlobalTransformID modelMatrix;
         GeometryHandle geo;  // Keep the geometry alive
         MaterialHandle mat;
         ui32 materialIndex;
@@ -27,6 +27,7 @@ namespace trc
     struct MaterialSpecializationInfo
     {
         bool animated;
+        bool packedVertices{ false };
     };
 
     /**
@@ -38,11 +39,13 @@ namespace trc
         struct Flags
         {
             enum class Animated{ eFalse, eTrue, eMaxEnum };
+            enum class PackedVertices{ eFalse, eTrue, eMaxEnum };
             // enum class ...
         };
 
         using MaterialSpecializationFlags = FlagCombination<
-            Flags::Animated
+            Flags::Animated,
+            Flags::PackedVertices
             //, ...
         >;
 
@@ -56,6 +59,7 @@ namespace trc
         constexpr MaterialKey(const MaterialSpecializationInfo& info)
         {
             if (info.animated) flags |= Flags::Animated::eTrue;
+            if (info.packedVertices) flags |= Flags::PackedVertices::eTrue;
         }
 
         explicit
@@ -72,7 +76,8 @@ namespace trc
         constexpr auto toSpecializationInfo() const -> MaterialSpecializationInfo
         {
             return {
-                .animated=flags & Flags::Animated::eTrue
+                .animated=flags & Flags::Animated::eTrue,
+                .packedVertices=flags & Flags::PackedVertices::eTrue,
             };
         }
 
@@ -119,6 +124,9 @@ namespace trc
      * When creating a specialization cache from a base material description,
      * it creates specializations lazily. Serializing the specialization cache
      * requires all specializations to be pre-computed.
+     *
+     * A deserialized cache cannot create specializations. It only contains
+     * the ones that were serialized.
      */
     struct MaterialSpecializationCache
     {
@@ -133,26 +141,37 @@ namespace trc
         explicit MaterialSpecializationCache(const serial::MaterialProgramSpecializations& serial,
                                              shader::ShaderRuntimeConstantDeserializer& des);
 
+        /**
+         * @throw std::out_of_range if the cache was deserialized and does
+         *        not contain the specialization. This is the case for
+         *        materials serialized before the specialization existed.
+         */
         auto getSpecialization(const MaterialKey& key) -> const shader::ShaderProgramData&;
 
         /**
          * Force all specializations to be computed immediately.
+         *
+         * @throw std::out_of_range (see `getSpecialization`)
          */
         void createAllSpecializations();
 
         /**
          * Will force-create all lazy specializations.
+         *
+         * @throw std::out_of_range (see `getSpecialization`)
          */
         auto iterSpecializations()
             -> std::generator<std::pair<MaterialKey, const shader::ShaderProgramData&>>;
 
         /**
-         * Always pre-computes and outputs all specializations.
+         * Always pre-computes and outputs all specializations. A
+         * deserialized cache outputs the specializations it contains.
          */
         auto serialize() const -> serial::MaterialProgramSpecializations;
 
         /**
-         * Always pre-computes and outputs all specializations.
+         * Always pre-computes and outputs all specializations. A
+         * deserialized cache outputs the specializations it contains.
          */
         void serialize(serial::MaterialProgramSpecializations& out) const;
 
@@ -34,18 +34,25 @@ namespace trc
         eMaterialData,
         eModelMatrix,
         eAnimationData,
+        eVertexDequantization,
     };
 
     class VertexModule
     {
     public:
-        explicit VertexModule(bool animated);
+        /**
+         * @param bool animated
+         * @param bool packedVertices Read vertex attributes in the compact
+         *        `PackedMeshVertex` format.
+         */
+        explicit VertexModule(bool animated, bool packedVertices = false);
 
         auto build(const shader::ShaderModule& fragment) && -> shader::ShaderModule;
 
     private:
-        static auto makeVertexCapabilityConfig() -> shader::CapabilityConfig;
+        static auto makeVertexCapabilityConfig(bool packedVertices) -> shader::CapabilityConfig;
 
+        bool packedVertices;
         shader::ShaderModuleBuilder builder;
 
         std::unordered_map<shader::Capability, code::Value> fragmentInputProviders;
@@ -100,6 +100,12 @@ namespace trc
         MemoryPool memoryPool;
         DeviceLocalBuffer vertexBuffer;
 
+        // Scratch storage for the batched matrix computation
+        std::vector<vec3> tickPositions;
+        std::vector<quat> tickOrientations;
+        std::vector<vec3> tickScalings;
+        std::vector<mat4> tickTransforms;
+
         // GPU resources
         std::vector<Particle> particles;
         Buffer particleDeviceDataStagingBuffer;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <istream>
+#include <optional>
 #include <ostream>
+#include <span>
 
 #include "trc/Types.h"
 #include "trc/util/Pathlet.h"
@@ -19,6 +22,17 @@ namespace trc
         struct iterator;
         using const_iterator = const iterator;
 
+        /**
+         * @brief A read-only view of data in the storage
+         *
+         * The viewed memory stays valid for as long as `owner` is alive.
+         */
+        struct MappedData
+        {
+            std::span<const std::byte> data;
+            s_ptr<const void> owner;
+        };
+
         DataStorage() = default;
         virtual ~DataStorage() = default;
 
@@ -48,6 +62,33 @@ namespace trc
          */
         virtual bool remove(const path& path) = 0;
 
+        /**
+         * @brief Map data at a location into memory
+         *
+         * Optional operation that allows readers to access data in-place
+         * without copying it through a stream. The default implementation
+         * does not support mapping and always returns nullopt.
+         *
+         * @return std::optional<MappedData> A view of the data at `path`.
+         *         Nullopt if the data cannot be mapped or does not exist.
+         */
+        virtual auto map(const path& /*path*/) -> std::optional<MappedData> {
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Query the size of the data at a location
+         *
+         * Optional operation that must not read the data. The default
+         * implementation always returns nullopt.
+         *
+         * @return std::optional<size_t> The size of the data at `path` in
+         *         bytes. Nullopt if the size is unknown or no data exists.
+         */
+        virtual auto getSize(const path& /*path*/) -> std::optional<size_t> {
+            return std::nullopt;
+        }
+
         virtual auto begin() -> iterator {
             return end();
         }
@@ -24,6 +24,12 @@ namespace trc
 
         bool remove(const path& path) override;
 
+        /**
+         * Maps the file at `path` into memory via util::MappedFile.
+         */
+        auto map(const path& path) -> std::optional<MappedData> override;
+        auto getSize(const path& path) -> std::optional<size_t> override;
+
         auto begin() -> iterator override;
         auto end() -> iterator override;
 
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "trc/util/DataStorage.h"
+
+namespace trc
+{
+    namespace fs = std::filesystem;
+
+    namespace util {
+        class MappedFile;
+    }
+
+    /**
+     * @brief Read-only DataStorage implementation that reads from a single
+     *        archive file
+     *
+     * The archive is memory-mapped as a whole. Its table of contents is
+     * sorted by path, so lookups are a binary search on the mapped memory
+     * and do not touch the filesystem. Uncompressed entries are accessed
+     * in-place: both `read` and `map` return views of the mapped archive
+     * without copying any data.
+     *
+     * Archives are created with `PackedArchiveWriter`.
+     */
+    class PackedDataStorage : public DataStorage
+    {
+    public:
+        /**
+         * @throw std::runtime_error if `archiveFile` cannot be opened or is
+         *        not a valid archive.
+         */
+        explicit PackedDataStorage(const fs::path& archiveFile);
+
+        /**
+         * Entries are compressed on a per-entry basis. Uncompressed entries
+         * are read in-place, compressed entries are decompressed into a
+         * new buffer on every access.
+         */
+        auto read(const path& path) -> s_ptr<std::istream> override;
+
+        /**
+         * The archive is read-only.
+         *
+         * @return nullptr
+         */
+        auto write(const path& path) -> s_ptr<std::ostream> override;
+
+        /**
+         * The archive is read-only.
+         *
+         * @return false
+         */
+        bool remove(const path& path) override;
+
+        auto map(const path& path) -> std::optional<MappedData> override;
+
+        /**
+         * @return std::optional<size_t> The uncompressed size of the entry
+         *         at `path`.
+         */
+        auto getSize(const path& path) -> std::optional<size_t> override;
+
+        auto begin() -> iterator override;
+        auto end() -> iterator override;
+
+        /**
+         * @return size_t The number of entries in the archive
+         */
+        auto size() const -> size_t;
+
+    private:
+        /** A table of contents entry as stored in the archive */
+        struct Entry
+        {
+            ui64 pathOffset;  // Offset into the string table
+            ui64 pathLength;
+            ui64 dataOffset;  // Offset from the start of the archive
+            ui64 storedSize;  // Size of the (possibly compressed) data in the archive
+            ui64 size;        // Size of the uncompressed data
+            ui32 compression;
+            ui32 _padding{ 0 };
+        };
+
+        friend class PackedArchiveWriter;
+
+        class TocIterator : public DataStorage::EntryIterator
+        {
+        public:
+            TocIterator(const PackedDataStorage* storage, size_t index);
+
+            auto operator*() -> reference override;
+            auto operator*() const -> const_reference override;
+            auto operator->() -> pointer override;
+            auto operator->() const -> const_pointer override;
+
+            auto operator++() -> EntryIterator& override;
+
+            bool operator==(const EntryIterator& other) const override;
+
+        private:
+            void updateCurrent();
+
+            const PackedDataStorage* storage;
+            size_t index;
+            std::optional<util::Pathlet> current;
+        };
+
+        auto findEntry(const path& path) const -> const Entry*;
+        auto getEntryPath(const Entry& entry) const -> std::string_view;
+        auto getEntryData(const Entry& entry) const -> std::span<const std::byte>;
+
+        /**
+         * @return s_ptr<std::vector<std::byte>> The uncompressed data of a
+         *         compressed entry.
+         * @throw std::runtime_error if decompression fails
+         */
+        auto decompress(const Entry& entry) const -> s_ptr<std::vector<std::byte>>;
+
+        s_ptr<util::MappedFile> file;
+        std::span<const Entry> toc;
+        std::span<const char> strings;
+    };
+
+    /**
+     * @brief Creates archives for PackedDataStorage
+     *
+     * Entry data is streamed to the output file as entries are added. The
+     * table of contents is written by `finish`.
+     */
+    class PackedArchiveWriter
+    {
+    public:
+        enum class Compression : ui32
+        {
+            eNone = 0,
+            eZlib = 1,
+        };
+
+        /** Alignment of entry data relative to the start of the archive */
+        static constexpr size_t kEntryAlignment{ 16 };
+
+        /**
+         * @throw std::runtime_error if the output file cannot be opened
+         */
+        explicit PackedArchiveWriter(const fs::path& archiveFile);
+
+        /**
+         * Calls `finish` if it has not been called yet.
+         */
+        ~PackedArchiveWriter() noexcept;
+
+        PackedArchiveWriter(const PackedArchiveWriter&) = delete;
+        PackedArchiveWriter(PackedArchiveWriter&&) noexcept = delete;
+        auto operator=(const PackedArchiveWriter&) -> PackedArchiveWriter& = delete;
+        auto operator=(PackedArchiveWriter&&) noexcept -> PackedArchiveWriter& = delete;
+
+        /**
+         * @brief Add an entry to the archive
+         *
+         * If compression is requested but does not reduce the entry's size,
+         * the entry is stored uncompressed.
+         *
+         * @throw std::invalid_argument if an entry at `path` already exists.
+         * @throw std::logic_error if `finish` has been called.
+         */
+        void add(const util::Pathlet& path,
+                 std::span<const std::byte> data,
+                 Compression compression = Compression::eNone);
+
+        /**
+         * @brief Write the table of contents and close the file
+         *
+         * @throw std::runtime_error if writing fails
+         */
+        void finish();
+
+    private:
+        struct PendingEntry
+        {
+            std::string path;
+            ui32 compression;
+            ui64 offset;
+            ui64 storedSize;
+            ui64 size;
+        };
+
+        void writePadded(const void* data, size_t size);
+
+        std::ofstream file;
+        ui64 pos{ 0 };
+        std::vector<PendingEntry> entries;
+        std::unordered_set<std::string> paths;
+        bool finished{ false };
+    };
+} // namespace trc
@@ -0,0 +1,36 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+
+#define BONE_INDICES_INPUT_LOCATION 4
+#define BONE_WEIGHTS_INPUT_LOCATION 5
+#define ASSET_DESCRIPTOR_SET_BINDING 1
+#include "animation.glsl"
+#include "material_utils/vertex_packing.glsl"
+
+layout (location = 0) in uvec4 vertexPosition;
+
+layout (set = 0, binding = 0, std430) buffer ShadowMatrices
+{
+    // These are the view-proj matrices
+    mat4 shadowMatrices[];
+};
+
+layout (push_constant) uniform PushConstants
+{
+    mat4 modelMatrix;
+    uint shadowIndex;  // Index into shadow matrix buffer
+
+    AnimationPushConstantData animData;
+
+    layout (offset = 96) VertexDequantization dequant;
+};
+
+void main()
+{
+    mat4 viewProj = shadowMatrices[shadowIndex];
+    vec4 vertPos = vec4(unpackPosition(vertexPosition, dequant), 1.0);
+    vertPos = applyAnimation(animData.animation, vertPos, animData.keyframes, animData.keyframeWeigth);
+    vertPos.w = 1.0;
+
+    gl_Position = viewProj * modelMatrix * vertPos;
+}
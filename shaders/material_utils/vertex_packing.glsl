@@ -0,0 +1,41 @@
+// Decoding of the compact vertex format (trc::PackedMeshVertex)
+
+#ifndef TRC_MATUTILS_VERTEX_PACKING_H
+#define TRC_MATUTILS_VERTEX_PACKING_H
+
+struct VertexDequantization
+{
+    vec4 positionOffset;  // w is unused
+    vec4 positionScale;   // w is unused
+};
+
+/**
+ * Positions are stored as 16-bit unsigned normalized integers relative to
+ * the geometry's bounding box.
+ */
+vec3 unpackPosition(uvec4 packed, vec4 offset, vec4 scale)
+{
+    return offset.xyz + vec3(packed.xyz) / 65535.0 * scale.xyz;
+}
+
+vec3 unpackPosition(uvec4 packed, VertexDequantization dequant)
+{
+    return unpackPosition(packed, dequant.positionOffset, dequant.positionScale);
+}
+
+/**
+ * Normals and tangents are stored as 16-bit signed normalized integers in
+ * the octahedral encoding.
+ */
+vec3 unpackOctahedral(ivec2 packed)
+{
+    vec2 f = max(vec2(packed) / 32767.0, vec2(-1.0));
+    vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+
+    return normalize(n);
+}
+
+#endif
@@ -65,8 +65,9 @@ auto makeAssetDescriptor(
         registry.addModule<Material>(std::make_unique<MaterialRegistry>());
         registry.addModule<Texture>(std::make_unique<TextureRegistry>(
             TextureRegistryCreateInfo{
-                device,
-                desc->getBinding(AssetDescriptorBinding::eTextureSamplers)
+                .device             = device,
+                .textureDescBinding = desc->getBinding(AssetDescriptorBinding::eTextureSamplers),
+                .retentionBudget    = descriptorCreateInfo.textureRetentionBudget,
             }
         ));
         registry.addModule<Geometry>(std::make_unique<GeometryRegistry>(
@@ -76,6 +77,7 @@ auto makeAssetDescriptor(
                 .vertexDescriptorBinding = desc->getBinding(AssetDescriptorBinding::eGeometryVertexBuffers),
                 .geometryBufferUsage     = config.geometryBufferUsage,
                 .enableRayTracing        = instance.hasRayTracing(),
+                .retentionBudget         = descriptorCreateInfo.geometryRetentionBudget,
             }
         ));
         registry.addModule<Rig>(std::make_unique<RigRegistry>());
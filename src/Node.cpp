@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "trc/TransformHierarchy.h"
+
 
 
 trc::Node::Node()
@@ -22,6 +24,7 @@ trc::Node::Node(Node&& other) noexcept
         parent->attach(*this);
     }
     other.parent = nullptr;
+    other.invalidateHierarchy();
 
     for (auto c : children) {
         c->parent = this;
@@ -56,6 +59,8 @@ auto trc::Node::operator=(Node&& rhs) noexcept -> Node&
     for (auto c : children) {
         c->parent = this;
     }
+    rhs.invalidateHierarchy();
+    invalidateHierarchy();
 
     return *this;
 }
@@ -65,35 +70,49 @@ auto trc::Node::getGlobalTransform() const noexcept -> mat4
     return globalTransformIndex.get();
 }
 
-auto trc::Node::getGlobalTransformID() const noexcept -> ID
+auto trc::Node::getGlobalTransformID() const noexcept -> GlobalTransformID
 {
     return globalTransformIndex;
 }
 
-void trc::Node::update() noexcept
+void trc::Node::update()
 {
-    globalTransformIndex.set(getTransformationMatrix());
-    for (Node* child : children)
-    {
-        child->update(getGlobalTransform());
+    const mat4 global = getTransformationMatrix();
+    globalTransformIndex.set(global);
+    if (!children.empty()) {
+        getHierarchy().update(global);
     }
 }
 
-void trc::Node::update(const mat4& parentTransform) noexcept
+void trc::Node::update(const mat4& parentTransform)
 {
-    globalTransformIndex.set(parentTransform * getTransformationMatrix());
-    for (Node* child : children)
-    {
-        child->update(getGlobalTransform());
+    const mat4 global = parentTransform * getTransformationMatrix();
+    globalTransformIndex.set(global);
+    if (!children.empty()) {
+        getHierarchy().update(global);
     }
 }
 
-void trc::Node::updateAsRoot() noexcept
+void trc::Node::updateAsRoot()
 {
-    for (Node* child : children)
-    {
-        child->update();
+    if (!children.empty()) {
+        getHierarchy().updateAsRoot();
+    }
+}
+
+void trc::Node::updateAsRoot(async::ThreadPool& threads)
+{
+    if (!children.empty()) {
+        getHierarchy().updateAsRoot(threads);
+    }
+}
+
+auto trc::Node::getLastUpdateStats() const -> TransformUpdateStats
+{
+    if (hierarchy == nullptr) {
+        return {};
     }
+    return hierarchy->getLastUpdateStats();
 }
 
 void trc::Node::attach(Node& child)
@@ -105,7 +124,8 @@ void trc::Node::attach(Node& child)
 
     children.push_back(&child);
     child.parent = this;
-    child.update(getGlobalTransform());
+    invalidateHierarchy();
+    child.updateSubtree(getGlobalTransform());
 }
 
 void trc::Node::detach(Node& child)
@@ -115,7 +135,8 @@ void trc::Node::detach(Node& child)
         children.erase(it);
     }
     child.parent = nullptr;
-    child.update();
+    invalidateHierarchy();
+    child.updateSubtree(mat4(1.0f));
 }
 
 void trc::Node::detachFromParent()
@@ -129,7 +150,38 @@ void trc::Node::detachFromParent()
 
 void trc::Node::onLocalMatrixUpdate()
 {
+    localTransformChanged = true;
     if (parent == nullptr) {
         globalTransformIndex.set(getTransformationMatrix());
     }
 }
+
+auto trc::Node::getHierarchy() -> TransformHierarchy&
+{
+    if (hierarchy == nullptr) {
+        hierarchy = std::make_unique<TransformHierarchy>();
+    }
+    if (!hierarchyValid)
+    {
+        hierarchy->build(*this);
+        hierarchyValid = true;
+    }
+
+    return *hierarchy;
+}
+
+void trc::Node::invalidateHierarchy() noexcept
+{
+    for (Node* node = this; node != nullptr; node = node->parent) {
+        node->hierarchyValid = false;
+    }
+}
+
+void trc::Node::updateSubtree(const mat4& parentTransform) noexcept
+{
+    const mat4 global = parentTransform * getTransformationMatrix();
+    globalTransformIndex.set(global);
+    for (Node* child : children) {
+        child->updateSubtree(global);
+    }
+}
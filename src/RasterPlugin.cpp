@@ -3,6 +3,7 @@
 #include "trc/GBufferDepthReader.h"
 #include "trc/GBufferPass.h"
 #include "trc/LightSceneModule.h"
+#include "trc/RasterSceneModule.h"
 #include "trc/RasterTasks.h"
 #include "trc/SceneDescriptor.h"
 #include "trc/ShadowPool.h"
@@ -205,6 +206,9 @@ void RasterPlugin::SceneConfig::registerResources(ResourceStorage& resources)
 
 void RasterPlugin::SceneConfig::hostUpdate(SceneContext& ctx)
 {
+    // Draw tasks of this frame report new culling results
+    ctx.scene().getModule<RasterSceneModule>().clearCullingStats();
+
     shadowPool.update();
     shadowDescriptorSet->update(ctx.device(), shadowPool);
 }
@@ -1,5 +1,21 @@
 #include "trc/RasterSceneBase.h"
 
+#include <cstring>
+
+#include "trc/Camera.h"
+
+
+
+auto trc::makeViewFrustum(const Camera& camera) -> math::Frustum
+{
+    static_assert(sizeof(mat4) == sizeof(math::Mat4f));
+
+    const mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
+    math::Mat4f m;
+    std::memcpy(m.data(), &viewProj, sizeof(m));
+
+    return math::Frustum::fromViewProjection(m);
+}
 
 
 trc::RasterSceneBase::UniqueDrawableRegistrationId::UniqueDrawableRegistrationId(
@@ -40,9 +56,12 @@ auto trc::RasterSceneBase::UniqueDrawableRegistrationId::operator=(UniqueDrawabl
 
 trc::RasterSceneBase::DrawableExecutionRegistration::DrawableExecutionRegistration(
     std::unique_ptr<RegistrationIndex> indexStruct,
-    DrawableFunction func)
+    DrawableFunction func,
+    DrawableBoundsFunction bounds)
     :
-    indexInRegistrationArray(std::move(indexStruct)), recordFunction(func)
+    indexInRegistrationArray(std::move(indexStruct)),
+    recordFunction(std::move(func)),
+    boundsFunction(std::move(bounds))
 {}
 
 trc::RasterSceneBase::DrawableExecutionRegistration::RegistrationIndex::RegistrationIndex(
@@ -143,11 +162,83 @@ auto trc::RasterSceneBase::iterDrawFunctions(
     }
 }
 
+auto trc::RasterSceneBase::iterVisibleDrawFunctions(
+    RenderStage::ID renderStage,
+    SubPass::ID subPass,
+    Pipeline::ID pipelineId,
+    const math::Frustum& frustum,
+    DrawCullingStats& stats) const
+    -> std::generator<const DrawableFunction&>
+{
+    auto [drawCalls, _] = readDrawCalls(renderStage, subPass, pipelineId);
+
+    // Gather the bounding spheres of all bounded draw calls in
+    // structure-of-arrays layout
+    size_t numBounded{ 0 };
+    for (const auto& f : drawCalls) {
+        numBounded += static_cast<bool>(f.boundsFunction);
+    }
+
+    std::vector<float> spheres(numBounded * 4);
+    std::span<float> x{ spheres.data(), numBounded };
+    std::span<float> y{ spheres.data() + numBounded, numBounded };
+    std::span<float> z{ spheres.data() + numBounded * 2, numBounded };
+    std::span<float> r{ spheres.data() + numBounded * 3, numBounded };
+    for (size_t i = 0; const auto& f : drawCalls)
+    {
+        if (f.boundsFunction)
+        {
+            const vec4 sphere = f.boundsFunction();
+            x[i] = sphere.x;
+            y[i] = sphere.y;
+            z[i] = sphere.z;
+            r[i] = sphere.w;
+            ++i;
+        }
+    }
+
+    std::vector<ui8> visible(numBounded);
+    const size_t numVisible = math::cullSpheres(frustum, x, y, z, r, visible);
+    stats.numVisible += static_cast<ui32>(drawCalls.size() - numBounded + numVisible);
+    stats.numCulled += static_cast<ui32>(numBounded - numVisible);
+
+    for (size_t i = 0; const auto& f : drawCalls)
+    {
+        if (f.boundsFunction && !visible[i++]) {
+            continue;
+        }
+        co_yield f.recordFunction;
+    }
+}
+
+void trc::RasterSceneBase::setCullingStats(const Camera& view, DrawCullingStats stats)
+{
+    std::scoped_lock lock(cullingStatsMutex);
+    cullingStats[&view] = stats;
+}
+
+void trc::RasterSceneBase::clearCullingStats()
+{
+    std::scoped_lock lock(cullingStatsMutex);
+    cullingStats.clear();
+}
+
+auto trc::RasterSceneBase::getCullingStats(const Camera& view) const
+    -> std::optional<DrawCullingStats>
+{
+    std::scoped_lock lock(cullingStatsMutex);
+    if (auto it = cullingStats.find(&view); it != cullingStats.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
 auto trc::RasterSceneBase::registerDrawFunction(
     RenderStage::ID stage,
     SubPass::ID subPass,
     Pipeline::ID pipeline,
-    DrawableFunction commandBufferRecordingFunction
+    DrawableFunction commandBufferRecordingFunction,
+    DrawableBoundsFunction boundsFunction
     ) -> MaybeUniqueRegistrationId
 {
     tryInsertPipeline(stage, subPass, pipeline);
@@ -157,7 +248,8 @@ auto trc::RasterSceneBase::registerDrawFunction(
         std::make_unique<DrawableExecutionRegistration::RegistrationIndex>(
             stage, subPass, pipeline, currentRegistrationArray.size()
         ),
-        std::move(commandBufferRecordingFunction)
+        std::move(commandBufferRecordingFunction),
+        std::move(boundsFunction)
     );
 
     return { DrawableExecutionRegistration::ID(reg), *this };
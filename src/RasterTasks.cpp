@@ -27,6 +27,8 @@ RenderPassDrawTask::RenderPassDrawTask(
 void RenderPassDrawTask::record(vk::CommandBuffer cmdBuf, ViewportDrawContext& ctx)
 {
     auto& scene = ctx.scene().getModule<RasterSceneModule>();
+    const auto frustum = makeViewFrustum(ctx.camera());
+    DrawCullingStats stats;
 
     renderPass->begin(cmdBuf, vk::SubpassContents::eInline, ctx.frame());
 
@@ -42,13 +44,16 @@ void RenderPassDrawTask::record(vk::CommandBuffer cmdBuf, ViewportDrawContext& c
             // Record commands for all objects with this pipeline
             const DrawEnvironment env{ .currentPipeline = &p };
 
-            for (auto& func : scene.iterDrawFunctions(renderStage, subpass, pipeline)) {
+            for (auto& func : scene.iterVisibleDrawFunctions(renderStage, subpass, pipeline,
+                                                             frustum, stats))
+            {
                 func(env, cmdBuf);
             }
         }
     }
 
     renderPass->end(cmdBuf);
+    scene.setCullingStats(ctx.camera(), stats);
 }
 
 
@@ -63,6 +68,8 @@ void ShadowMapDrawTask::record(vk::CommandBuffer cmdBuf, SceneUpdateContext& ctx
 {
     auto& scene = ctx.scene().getModule<RasterSceneModule>();
     auto& renderPass = shadowMap->getRenderPass();
+    const auto frustum = makeViewFrustum(shadowMap->getCamera());
+    DrawCullingStats stats;
 
     renderPass.begin(cmdBuf, vk::SubpassContents::eInline, ctx.frame());
 
@@ -82,13 +89,16 @@ void ShadowMapDrawTask::record(vk::CommandBuffer cmdBuf, SceneUpdateContext& ctx
             // Record commands for all objects with this pipeline
             const DrawEnvironment env{ .currentPipeline = &p };
 
-            for (auto& func : scene.iterDrawFunctions(renderStage, subpass, pipeline)) {
+            for (auto& func : scene.iterVisibleDrawFunctions(renderStage, subpass, pipeline,
+                                                             frustum, stats))
+            {
                 func(env, cmdBuf);
             }
         }
     }
 
     renderPass.end(cmdBuf);
+    scene.setCullingStats(shadowMap->getCamera(), stats);
 }
 
 } // namespace trc
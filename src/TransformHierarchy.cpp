@@ -0,0 +1,158 @@
+#include "trc/TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "trc/Node.h"
+
+
+
+void trc::TransformHierarchy::build(const Node& root)
+{
+    nodes.clear();
+    parents.clear();
+    localTransforms.clear();
+    levelOffsets.assign(1, 0);
+
+    auto push = [&](Node* node, uint32_t parent) {
+        nodes.push_back(node);
+        parents.push_back(parent);
+        localTransforms.push_back(node->getMatrixId());
+    };
+
+    for (Node* child : root.children) {
+        push(child, kRoot);
+    }
+
+    // Breadth-first traversal; each pass appends the next level
+    size_t levelBegin{ 0 };
+    while (levelBegin < nodes.size())
+    {
+        const size_t levelEnd = nodes.size();
+        levelOffsets.push_back(static_cast<uint32_t>(levelEnd));
+        for (size_t i = levelBegin; i < levelEnd; ++i)
+        {
+            for (Node* child : nodes[i]->children) {
+                push(child, static_cast<uint32_t>(i));
+            }
+        }
+        levelBegin = levelEnd;
+    }
+
+    globalTransforms.resize(nodes.size());
+    changed.resize(nodes.size());
+    needsFullUpdate = true;
+}
+
+void trc::TransformHierarchy::update(const mat4& rootTransform)
+{
+    updateLevels<true>(rootTransform, nullptr);
+}
+
+void trc::TransformHierarchy::update(const mat4& rootTransform, async::ThreadPool& threads)
+{
+    updateLevels<true>(rootTransform, &threads);
+}
+
+void trc::TransformHierarchy::updateAsRoot()
+{
+    updateLevels<false>(mat4(1.0f), nullptr);
+}
+
+void trc::TransformHierarchy::updateAsRoot(async::ThreadPool& threads)
+{
+    updateLevels<false>(mat4(1.0f), &threads);
+}
+
+auto trc::TransformHierarchy::size() const -> size_t
+{
+    return parents.size();
+}
+
+auto trc::TransformHierarchy::getNumLevels() const -> size_t
+{
+    return levelOffsets.size() - 1;
+}
+
+auto trc::TransformHierarchy::getLastUpdateStats() const -> TransformUpdateStats
+{
+    return lastStats;
+}
+
+template<bool kHasRootTransform>
+void trc::TransformHierarchy::updateLevels(const mat4& rootTransform, async::ThreadPool* threads)
+{
+    const bool rootChanged = needsFullUpdate || rootTransform != lastRootTransform;
+    needsFullUpdate = false;
+    lastRootTransform = rootTransform;
+
+    uint32_t numUpdated{ 0 };
+    for (size_t level = 0; level + 1 < levelOffsets.size(); ++level)
+    {
+        const uint32_t begin = levelOffsets[level];
+        const uint32_t end = levelOffsets[level + 1];
+        if (threads == nullptr || end - begin < 2 * kBatchSize)
+        {
+            numUpdated += updateRange<kHasRootTransform>(begin, end, rootTransform, rootChanged);
+            continue;
+        }
+
+        std::atomic<uint32_t> levelUpdated{ 0 };
+        const uint32_t numBatches = (end - begin + kBatchSize - 1) / kBatchSize;
+        threads->parallelFor(uint32_t{ 0 }, numBatches, uint32_t{ 1 }, [&](uint32_t batch) {
+            const uint32_t first = begin + batch * kBatchSize;
+            const uint32_t last = std::min(first + kBatchSize, end);
+            levelUpdated.fetch_add(
+                updateRange<kHasRootTransform>(first, last, rootTransform, rootChanged),
+                std::memory_order_relaxed
+            );
+        });
+        numUpdated += levelUpdated.load(std::memory_order_relaxed);
+    }
+
+    lastStats = {
+        .numUpdated=numUpdated,
+        .numSkipped=static_cast<uint32_t>(nodes.size()) - numUpdated,
+    };
+}
+
+template<bool kHasRootTransform>
+auto trc::TransformHierarchy::updateRange(
+    const uint32_t begin,
+    const uint32_t end,
+    const mat4& rootTransform,
+    const bool rootChanged) -> uint32_t
+{
+    uint32_t numUpdated{ 0 };
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        Node& node = *nodes[i];
+        const bool parentChanged = parents[i] == kRoot ? rootChanged : changed[parents[i]];
+        changed[i] = parentChanged || node.localTransformChanged;
+        if (!changed[i]) {
+            continue;
+        }
+        node.localTransformChanged = false;
+
+        // A skipped parent's cached matrix may be stale if the parent was
+        // updated through another hierarchy, so read it from the node.
+        const mat4 local = localTransforms[i].get();
+        if (parents[i] != kRoot)
+        {
+            const uint32_t p = parents[i];
+            globalTransforms[i] = (changed[p] ? globalTransforms[p] : nodes[p]->getGlobalTransform())
+                                  * local;
+        }
+        else if constexpr (kHasRootTransform) {
+            globalTransforms[i] = rootTransform * local;
+        }
+        else {
+            globalTransforms[i] = local;
+        }
+
+        node.globalTransformIndex.set(globalTransforms[i]);
+        ++numUpdated;
+    }
+
+    return numUpdated;
+}
@@ -0,0 +1,188 @@
+#include "trc/Vertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+#include <glm/gtc/packing.hpp>
+
+
+
+namespace trc
+{
+
+namespace
+{
+    constexpr float kMaxUnorm16{ 65535.0f };
+    constexpr float kMaxSnorm16{ 32767.0f };
+
+    auto signNotZero(vec2 v) -> vec2
+    {
+        return { v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f };
+    }
+
+    /**
+     * @param getPosition Maps a vertex to its object-space position
+     */
+    template<typename Vertex, std::invocable<const Vertex&> F>
+    auto computeBounds(std::span<const Vertex> vertices, F&& getPosition) -> GeometryBounds
+    {
+        if (vertices.empty()) {
+            return {};
+        }
+
+        vec3 min{ getPosition(vertices.front()) };
+        vec3 max{ min };
+        for (const auto& v : vertices)
+        {
+            const vec3 p = getPosition(v);
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+
+        const vec3 center = (min + max) * 0.5f;
+        float radius2{ 0.0f };
+        for (const auto& v : vertices)
+        {
+            const vec3 d = getPosition(v) - center;
+            radius2 = std::max(radius2, glm::dot(d, d));
+        }
+
+        return { .min=min, .max=max, .center=center, .radius=std::sqrt(radius2) };
+    }
+} // anonymous namespace
+
+
+
+auto VertexQuantization::fromBounds(std::span<const MeshVertex> vertices) -> VertexQuantization
+{
+    if (vertices.empty()) {
+        return {};
+    }
+
+    vec3 min{ vertices.front().position };
+    vec3 max{ vertices.front().position };
+    for (const auto& v : vertices)
+    {
+        min = glm::min(min, v.position);
+        max = glm::max(max, v.position);
+    }
+
+    return { .offset=min, .scale=max - min };
+}
+
+auto VertexQuantization::quantize(vec3 position) const -> glm::u16vec4
+{
+    glm::u16vec4 res{ 0 };
+    for (int i = 0; i < 3; ++i)
+    {
+        if (scale[i] > 0.0f)
+        {
+            const float normalized = std::clamp((position[i] - offset[i]) / scale[i], 0.0f, 1.0f);
+            res[i] = static_cast<ui16>(std::lround(normalized * kMaxUnorm16));
+        }
+    }
+
+    return res;
+}
+
+auto VertexQuantization::dequantize(glm::u16vec4 position) const -> vec3
+{
+    return offset + vec3(position) / kMaxUnorm16 * scale;
+}
+
+auto GeometryBounds::fromVertices(std::span<const MeshVertex> vertices) -> GeometryBounds
+{
+    return computeBounds(vertices, [](const MeshVertex& v) { return v.position; });
+}
+
+auto GeometryBounds::fromVertices(
+    std::span<const PackedMeshVertex> vertices,
+    const VertexQuantization& quant) -> GeometryBounds
+{
+    return computeBounds(vertices, [&](const PackedMeshVertex& v) {
+        return quant.dequantize(v.position);
+    });
+}
+
+auto GeometryBounds::fromBox(vec3 min, vec3 max) -> GeometryBounds
+{
+    return {
+        .min=min,
+        .max=max,
+        .center=(min + max) * 0.5f,
+        .radius=glm::length(max - min) * 0.5f,
+    };
+}
+
+auto packOctahedral(vec3 dir) -> glm::i16vec2
+{
+    const float l1 = std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z);
+    if (l1 == 0.0f) {
+        return { 0, 0 };
+    }
+
+    vec2 p = vec2(dir) / l1;
+    if (dir.z < 0.0f) {
+        p = (1.0f - glm::abs(vec2(p.y, p.x))) * signNotZero(p);
+    }
+
+    return glm::i16vec2(glm::round(glm::clamp(p, -1.0f, 1.0f) * kMaxSnorm16));
+}
+
+auto unpackOctahedral(glm::i16vec2 packed) -> vec3
+{
+    const vec2 f = glm::max(vec2(packed) / kMaxSnorm16, vec2(-1.0f));
+    vec3 n(f, 1.0f - std::abs(f.x) - std::abs(f.y));
+    const float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+
+    return glm::normalize(n);
+}
+
+auto packVertex(const MeshVertex& vertex, const VertexQuantization& quant) -> PackedMeshVertex
+{
+    return {
+        .position=quant.quantize(vertex.position),
+        .normal=packOctahedral(vertex.normal),
+        .uv={ glm::packHalf1x16(vertex.uv.x), glm::packHalf1x16(vertex.uv.y) },
+        .tangent=packOctahedral(vertex.tangent),
+    };
+}
+
+auto unpackVertex(const PackedMeshVertex& vertex, const VertexQuantization& quant) -> MeshVertex
+{
+    return MeshVertex{
+        quant.dequantize(vertex.position),
+        unpackOctahedral(vertex.normal),
+        vec2(glm::unpackHalf1x16(vertex.uv.x), glm::unpackHalf1x16(vertex.uv.y)),
+        unpackOctahedral(vertex.tangent),
+    };
+}
+
+auto packVertices(std::span<const MeshVertex> vertices, const VertexQuantization& quant)
+    -> std::vector<PackedMeshVertex>
+{
+    std::vector<PackedMeshVertex> res;
+    res.reserve(vertices.size());
+    for (const auto& v : vertices) {
+        res.emplace_back(packVertex(v, quant));
+    }
+
+    return res;
+}
+
+auto unpackVertices(std::span<const PackedMeshVertex> vertices, const VertexQuantization& quant)
+    -> std::vector<MeshVertex>
+{
+    std::vector<MeshVertex> res;
+    res.reserve(vertices.size());
+    for (const auto& v : vertices) {
+        res.emplace_back(unpackVertex(v, quant));
+    }
+
+    return res;
+}
+
+} // namespace trc
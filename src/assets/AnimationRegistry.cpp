@@ -21,6 +21,17 @@ void AssetData<Animation>::deserialize(std::istream& is)
     *this = internal::deserializeAssetData(anim);
 }
 
+auto AssetData<Animation>::getBoneCount() const -> ui32
+{
+    if (compressed) {
+        return compressed->getBoneCount();
+    }
+    if (keyframes.empty()) {
+        return 0;
+    }
+    return static_cast<ui32>(keyframes.front().boneMatrices.size());
+}
+
 
 
 AssetHandle<Animation>::AssetHandle(const AnimationData& data, ui32 deviceIndex)
@@ -106,7 +117,7 @@ auto trc::AnimationRegistry::getHandle(LocalID id) -> Handle
 
 auto trc::AnimationRegistry::makeAnimation(const AnimationData& data) -> ui32
 {
-    if (data.keyframes.empty())
+    if (data.frameCount == 0 || (!data.compressed && data.keyframes.empty()))
     {
         throw std::invalid_argument(
             "[In AnimationRegistry::makeAnimation]: Argument of type AnimationData"
@@ -120,9 +131,10 @@ auto trc::AnimationRegistry::makeAnimation(const AnimationData& data) -> ui32
     AnimationMeta newMeta{
         .offset = animationBufferOffset,
         .frameCount = data.frameCount,
-        .boneCount = static_cast<ui32>(data.keyframes[0].boneMatrices.size())
+        .boneCount = data.getBoneCount()
     };
-    assert(data.frameCount == data.keyframes.size());
+    assert(data.compressed ? data.frameCount == data.compressed->frameCount
+                           : data.frameCount == data.keyframes.size());
 
     auto metaBuf = animationMetaDataBuffer.map<AnimationMeta*>();
     metaBuf[numAnimations] = newMeta;
@@ -147,12 +159,25 @@ auto trc::AnimationRegistry::makeAnimation(const AnimationData& data) -> ui32
 
     // Copy animation into buffer
     auto animBuf = animationBuffer.map(animationBufferOffset * sizeof(mat4));
-    for (size_t offset = 0; const auto& kf : data.keyframes)
+    if (data.compressed)
+    {
+        // Decode compressed tracks directly into the buffer
+        auto dst = reinterpret_cast<mat4*>(animBuf);
+        for (ui32 frame = 0; frame < data.frameCount; ++frame)
+        {
+            data.compressed->sampleFrame(frame, { dst, newMeta.boneCount });
+            dst += newMeta.boneCount;
+        }
+    }
+    else
     {
-        const size_t copySize = kf.boneMatrices.size() * sizeof(mat4);
+        for (size_t offset = 0; const auto& kf : data.keyframes)
+        {
+            const size_t copySize = kf.boneMatrices.size() * sizeof(mat4);
 
-        memcpy(animBuf + offset, kf.boneMatrices.data(), copySize);
-        offset += copySize;
+            memcpy(animBuf + offset, kf.boneMatrices.data(), copySize);
+            offset += copySize;
+        }
     }
     animationBuffer.unmap();
 
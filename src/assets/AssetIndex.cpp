@@ -0,0 +1,196 @@
+#include "trc/assets/AssetIndex.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "trc/base/Logging.h"
+
+#include "asset.pb.h"
+
+
+
+namespace trc
+{
+
+namespace
+{
+    constexpr ui32 kIndexVersion{ 1 };
+
+    auto getIndexPath() -> util::Pathlet
+    {
+        return util::Pathlet(fs::path(AssetIndex::kIndexPath));
+    }
+} // anonymous namespace
+
+
+
+AssetIndex::AssetIndex(s_ptr<DataStorage> _storage)
+    :
+    storage(std::move(_storage))
+{
+    assert(storage != nullptr);
+}
+
+AssetIndex::~AssetIndex() noexcept
+{
+    try {
+        flush();
+    }
+    catch (const std::exception& err) {
+        log::warn << log::here() << ": Unable to persist asset index: " << err.what();
+    }
+}
+
+auto AssetIndex::load(s_ptr<DataStorage> storage) -> u_ptr<AssetIndex>
+{
+    auto is = storage->read(getIndexPath());
+    if (is == nullptr) {
+        return nullptr;
+    }
+
+    serial::AssetIndex serial;
+    if (!serial.ParseFromIstream(is.get()) || serial.version() != kIndexVersion) {
+        return nullptr;
+    }
+
+    auto index = std::make_unique<AssetIndex>(std::move(storage));
+    try {
+        for (const auto& entry : serial.entries())
+        {
+            AssetMetadata meta{
+                .name=entry.metadata().name(),
+                .type=AssetType::make(entry.metadata().type().name()),
+            };
+            if (entry.metadata().has_path()) {
+                meta.path = AssetPath(entry.metadata().path());
+            }
+
+            index->entries.try_emplace(AssetPath(entry.path()), Entry{
+                .metadata=std::move(meta),
+                .dataSize=entry.data_size(),
+                .contentHash=entry.content_hash(),
+            });
+        }
+    }
+    catch (const std::invalid_argument&) {
+        return nullptr;  // Invalid path in the index
+    }
+
+    return index;
+}
+
+auto AssetIndex::hashContent(std::string_view data) -> ui64
+{
+    // 64-bit FNV-1a
+    ui64 hash{ 0xcbf29ce484222325 };
+    for (const char c : data)
+    {
+        hash ^= static_cast<ui8>(c);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+auto AssetIndex::find(const AssetPath& path) const -> std::optional<Entry>
+{
+    std::shared_lock lock(mutex);
+    if (auto it = entries.find(path); it != entries.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+bool AssetIndex::contains(const AssetPath& path) const
+{
+    std::shared_lock lock(mutex);
+    return entries.contains(path);
+}
+
+auto AssetIndex::size() const -> size_t
+{
+    std::shared_lock lock(mutex);
+    return entries.size();
+}
+
+auto AssetIndex::getPaths() const -> std::vector<AssetPath>
+{
+    std::vector<AssetPath> paths;
+    {
+        std::shared_lock lock(mutex);
+        paths.reserve(entries.size());
+        for (const auto& [path, _] : entries) {
+            paths.emplace_back(path);
+        }
+    }
+
+    std::ranges::sort(paths);
+    return paths;
+}
+
+void AssetIndex::insert(const AssetPath& path, Entry entry)
+{
+    std::scoped_lock lock(mutex);
+    entries.insert_or_assign(path, std::move(entry));
+    markModified();
+}
+
+bool AssetIndex::erase(const AssetPath& path)
+{
+    std::scoped_lock lock(mutex);
+    if (entries.erase(path) == 0) {
+        return false;
+    }
+
+    markModified();
+    return true;
+}
+
+void AssetIndex::clear()
+{
+    std::scoped_lock lock(mutex);
+    entries.clear();
+    markModified();
+}
+
+void AssetIndex::flush()
+{
+    std::scoped_lock lock(mutex);
+    if (!modified) {
+        return;
+    }
+
+    serial::AssetIndex serial;
+    serial.set_version(kIndexVersion);
+    for (const auto& [path, entry] : entries)
+    {
+        auto newEntry = serial.add_entries();
+        newEntry->set_path(path.string());
+        newEntry->mutable_metadata()->set_name(entry.metadata.name);
+        newEntry->mutable_metadata()->mutable_type()->set_name(entry.metadata.type.getName());
+        if (entry.metadata.path.has_value()) {
+            newEntry->mutable_metadata()->set_path(entry.metadata.path->string());
+        }
+        newEntry->set_data_size(entry.dataSize);
+        newEntry->set_content_hash(entry.contentHash);
+    }
+
+    // Read-only storages can't persist the index. Don't try again until
+    // the next modification.
+    modified = false;
+    if (auto os = storage->write(getIndexPath())) {
+        serial.SerializeToOstream(os.get());
+    }
+}
+
+void AssetIndex::markModified()
+{
+    // Remove the persisted index until the modification is flushed so
+    // that it is rebuilt instead of being read in an outdated state.
+    if (!modified) {
+        storage->remove(getIndexPath());
+    }
+    modified = true;
+}
+
+} // namespace trc
@@ -1,5 +1,8 @@
 #include "trc/assets/AssetStorage.h"
 
+#include <iterator>
+#include <unordered_map>
+
 #include "asset.pb.h"
 
 
@@ -9,27 +12,155 @@ namespace trc
 
 AssetStorage::AssetStorage(s_ptr<DataStorage> storage)
     :
-    storage(storage)
+    storage(storage),
+    index(AssetIndex::load(storage))
 {
     assert(this->storage != nullptr);
+
+    if (index == nullptr)
+    {
+        index = std::make_shared<AssetIndex>(storage);
+        rebuildIndex();
+    }
+    else {
+        validateIndex();
+    }
 }
 
 auto AssetStorage::getMetadata(const AssetPath& path) -> std::optional<AssetMetadata>
 {
-    auto metaStream = storage->read(makeMetaPath(path));
-    if (metaStream != nullptr) {
-        return deserializeMetadata(*metaStream);
+    if (auto entry = index->find(path)) {
+        return std::move(entry->metadata);
     }
     return std::nullopt;
 }
 
+auto AssetStorage::getIndex() const -> const AssetIndex&
+{
+    return *index;
+}
+
+void AssetStorage::rebuildIndex()
+{
+    index->clear();
+    for (const util::Pathlet& file : *storage)
+    {
+        if (file.filename().extension() != ".meta") {
+            continue;
+        }
+
+        indexAsset(AssetPath(file.replaceExtension("")));
+    }
+
+    index->flush();
+}
+
+void AssetStorage::validateIndex()
+{
+    // Collect the assets' data files. Their metadata is not read, so
+    // assets whose data is unchanged are not accessed at all.
+    std::unordered_map<AssetPath, std::optional<size_t>> dataSizes;
+    for (const util::Pathlet& file : *storage)
+    {
+        if (file.filename().extension() == ".data") {
+            dataSizes.try_emplace(AssetPath(file.replaceExtension("")), storage->getSize(file));
+        }
+    }
+
+    for (const AssetPath& path : index->getPaths())
+    {
+        if (!dataSizes.contains(path)) {
+            index->erase(path);
+        }
+    }
+    for (const auto& [path, size] : dataSizes)
+    {
+        const auto entry = index->find(path);
+        if (!entry || (size && *size != entry->dataSize))
+        {
+            if (!indexAsset(path)) {
+                index->erase(path);
+            }
+        }
+    }
+}
+
+bool AssetStorage::indexAsset(const AssetPath& path)
+{
+    auto metaStream = storage->read(makeMetaPath(path));
+    auto dataStream = storage->read(makeDataPath(path));
+    if (metaStream == nullptr || dataStream == nullptr) {
+        return false;
+    }
+
+    const std::string data(std::istreambuf_iterator<char>(*dataStream), {});
+    index->insert(path, AssetIndex::Entry{
+        .metadata=deserializeMetadata(*metaStream),
+        .dataSize=data.size(),
+        .contentHash=AssetIndex::hashContent(data),
+    });
+
+    return true;
+}
+
+void AssetStorage::flushIndex()
+{
+    index->flush();
+}
+
+auto AssetStorage::mapData(const AssetPath& path) -> std::optional<DataStorage::MappedData>
+{
+    return storage->map(makeDataPath(path));
+}
+
 bool AssetStorage::remove(const AssetPath& path)
 {
+    index->erase(path);
+
     const bool res1 = storage->remove(makeMetaPath(path));
     const bool res2 = storage->remove(makeDataPath(path));
     return res1 && res2;
 }
 
+bool AssetStorage::storeSerialized(
+    const AssetPath& path,
+    AssetType type,
+    std::string_view data)
+{
+    auto dataStream = storage->write(makeDataPath(path));
+    auto metaStream = storage->write(makeMetaPath(path));
+    if (dataStream == nullptr || metaStream == nullptr)
+    {
+        if (dataStream != metaStream)
+        {
+            log::debug << "[In AssetStorage::store]: If the data path of an asset does not"
+                " exist in the data storage, then the metadata path should not exist either,"
+                " and vice-versa. However, this is not the case. [For asset path "
+                << path.string() << std::boolalpha
+                << ": <meta-path> -> " << !!metaStream
+                << ", <data-path> -> " << !!dataStream << "]"
+                ". Investigate whether this is an issue.";
+        }
+        return false;
+    }
+
+    AssetMetadata meta{
+        .name=path.getAssetName(),
+        .type=std::move(type),
+        .path=path
+    };
+    serializeMetadata(meta, *metaStream);
+    dataStream->write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    index->insert(path, AssetIndex::Entry{
+        .metadata=std::move(meta),
+        .dataSize=data.size(),
+        .contentHash=AssetIndex::hashContent(data),
+    });
+
+    return true;
+}
+
 auto AssetStorage::makeMetaPath(const AssetPath& path) -> util::Pathlet
 {
     return util::Pathlet(path.string() + ".meta");
@@ -70,59 +201,52 @@ auto AssetStorage::deserializeMetadata(std::istream& is) -> AssetMetadata
 
 auto AssetStorage::begin() -> iterator
 {
-    return { storage->begin(), storage->end() };
+    return { std::make_shared<const std::vector<AssetPath>>(index->getPaths()), 0 };
 }
 
 auto AssetStorage::end() -> iterator
 {
-    return { storage->end(), storage->end() };
+    return { nullptr, 0 };
 }
 
 
 
 AssetStorage::AssetIterator::AssetIterator(
-    DataStorage::iterator _begin,
-    DataStorage::iterator _end)
+    s_ptr<const std::vector<AssetPath>> paths,
+    size_t index)
     :
-    iter(std::move(_begin)),
-    end(std::move(_end))
+    paths(std::move(paths)),
+    index(index)
 {
-    step();
 }
 
 auto AssetStorage::AssetIterator::operator*() const -> const_reference
 {
-    return *currentPath;
+    return paths->at(index);
 }
 
 auto AssetStorage::AssetIterator::operator->() const -> const_pointer
 {
-    return &*currentPath;
+    return &paths->at(index);
 }
 
 auto AssetStorage::AssetIterator::operator++() -> AssetIterator&
 {
-    ++iter;
-    step();
+    ++index;
     return *this;
 }
 
 bool AssetStorage::AssetIterator::operator==(const AssetIterator& other) const
 {
-    return iter == other.iter;
-}
-
-bool AssetStorage::AssetIterator::isMetaFile(const util::Pathlet& path)
-{
-    return path.filename().extension() == ".meta";
+    if (atEnd() || other.atEnd()) {
+        return atEnd() && other.atEnd();
+    }
+    return paths == other.paths && index == other.index;
 }
 
-void AssetStorage::AssetIterator::step()
+bool AssetStorage::AssetIterator::atEnd() const
 {
-    while (iter != end && !isMetaFile(*iter)) ++iter;
-    if (iter != end) {
-        currentPath = AssetPath(iter->replaceExtension(""));
-    }
+    return paths == nullptr || index >= paths->size();
 }
 
 } // namespace trc
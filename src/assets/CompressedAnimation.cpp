@@ -0,0 +1,206 @@
+#include "trc/assets/CompressedAnimation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+
+namespace trc
+{
+
+namespace
+{
+    constexpr float kMaxRange{ 65535.0f };
+
+    /** Components other than the largest one are in [-1/sqrt(2), 1/sqrt(2)] */
+    constexpr float kMaxSmallComponent{ 0.70710678f };
+    constexpr float kMaxRotationValue{ 32767.0f };
+    constexpr ui16 kRotationValueMask{ 0x7fff };
+
+    struct KeyRange
+    {
+        size_t first;
+        size_t second;
+        float t;
+    };
+
+    /**
+     * @brief Find the keys between which a frame is interpolated
+     */
+    auto findKeys(const CompressedAnimation::Track& track, float frame) -> KeyRange
+    {
+        assert(!track.frames.empty());
+
+        const auto& frames = track.frames;
+        const auto it = std::upper_bound(frames.begin(), frames.end(), frame,
+                                         [](float f, ui16 key){ return f < static_cast<float>(key); });
+        if (it == frames.begin()) {
+            return { 0, 0, 0.0f };
+        }
+        if (it == frames.end()) {
+            return { frames.size() - 1, frames.size() - 1, 0.0f };
+        }
+
+        const size_t second = it - frames.begin();
+        const size_t first = second - 1;
+        const float t = (frame - static_cast<float>(frames[first]))
+                      / static_cast<float>(frames[second] - frames[first]);
+        return { first, second, t };
+    }
+
+    auto dequantizeVector(const CompressedAnimation::Track& track, size_t key) -> vec3
+    {
+        const ui16* values = track.values.data() + key * 3;
+        return {
+            CompressedAnimation::dequantizeRange(values[0], track.rangeMin.x, track.rangeExtent.x),
+            CompressedAnimation::dequantizeRange(values[1], track.rangeMin.y, track.rangeExtent.y),
+            CompressedAnimation::dequantizeRange(values[2], track.rangeMin.z, track.rangeExtent.z),
+        };
+    }
+} // anonymous namespace
+
+
+
+auto CompressedAnimation::getBoneCount() const -> ui32
+{
+    return static_cast<ui32>(bones.size());
+}
+
+auto CompressedAnimation::getSize() const -> size_t
+{
+    size_t size{ 0 };
+    for (const auto& bone : bones)
+    {
+        for (const Track* track : { &bone.translation, &bone.rotation, &bone.scale })
+        {
+            size += (track->frames.size() + track->values.size()) * sizeof(ui16)
+                  + sizeof(Track::rangeMin) + sizeof(Track::rangeExtent);
+        }
+    }
+
+    return size;
+}
+
+auto CompressedAnimation::sampleBone(ui32 boneIndex, float frame) const -> mat4
+{
+    assert(boneIndex < bones.size());
+
+    const auto& bone = bones[boneIndex];
+    const vec3 translation = sampleVector(bone.translation, frame);
+    const quat rotation = sampleRotation(bone.rotation, frame);
+    const vec3 scale = sampleVector(bone.scale, frame);
+
+    mat4 m = glm::mat4_cast(rotation);
+    m[0] *= scale.x;
+    m[1] *= scale.y;
+    m[2] *= scale.z;
+    m[3] = vec4(translation, 1.0f);
+
+    return m;
+}
+
+void CompressedAnimation::sampleFrame(ui32 frame, std::span<mat4> out) const
+{
+    assert(frame < frameCount);
+    assert(out.size() >= bones.size());
+
+    for (ui32 i = 0; i < bones.size(); ++i) {
+        out[i] = sampleBone(i, static_cast<float>(frame));
+    }
+}
+
+auto CompressedAnimation::quantizeRange(float value, float min, float extent) -> ui16
+{
+    if (extent <= 0.0f) {
+        return 0;
+    }
+
+    const float normalized = std::clamp((value - min) / extent, 0.0f, 1.0f);
+    return static_cast<ui16>(std::lround(normalized * kMaxRange));
+}
+
+auto CompressedAnimation::dequantizeRange(ui16 value, float min, float extent) -> float
+{
+    return min + static_cast<float>(value) / kMaxRange * extent;
+}
+
+void CompressedAnimation::quantizeRotation(quat rotation, ui16* out)
+{
+    rotation = glm::normalize(rotation);
+
+    int largest{ 0 };
+    for (int i = 1; i < 4; ++i)
+    {
+        if (std::abs(rotation[i]) > std::abs(rotation[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q describe the same rotation. Make the dropped component
+    // positive so that it can be reconstructed from the other three.
+    if (rotation[largest] < 0.0f) {
+        rotation = -rotation;
+    }
+
+    for (int i = 0, n = 0; i < 4; ++i)
+    {
+        if (i == largest) continue;
+
+        const float normalized = std::clamp(rotation[i] / kMaxSmallComponent, -1.0f, 1.0f);
+        out[n++] = static_cast<ui16>(std::lround((normalized * 0.5f + 0.5f) * kMaxRotationValue));
+    }
+
+    out[0] |= static_cast<ui16>((largest >> 1) << 15);
+    out[1] |= static_cast<ui16>((largest & 1) << 15);
+}
+
+auto CompressedAnimation::dequantizeRotation(const ui16* values) -> quat
+{
+    const int largest = ((values[0] >> 15) << 1) | (values[1] >> 15);
+
+    quat res;
+    float sumSquares{ 0.0f };
+    for (int i = 0, n = 0; i < 4; ++i)
+    {
+        if (i == largest) continue;
+
+        const float normalized = static_cast<float>(values[n++] & kRotationValueMask)
+                               / kMaxRotationValue;
+        res[i] = (normalized * 2.0f - 1.0f) * kMaxSmallComponent;
+        sumSquares += res[i] * res[i];
+    }
+    res[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+
+    return glm::normalize(res);
+}
+
+auto CompressedAnimation::sampleVector(const Track& track, float frame) -> vec3
+{
+    const auto [first, second, t] = findKeys(track, frame);
+    if (first == second) {
+        return dequantizeVector(track, first);
+    }
+
+    return glm::mix(dequantizeVector(track, first), dequantizeVector(track, second), t);
+}
+
+auto CompressedAnimation::sampleRotation(const Track& track, float frame) -> quat
+{
+    const auto [first, second, t] = findKeys(track, frame);
+    const quat a = dequantizeRotation(track.values.data() + first * 3);
+    if (first == second) {
+        return a;
+    }
+
+    // The encoding does not preserve the sign of a quaternion, so
+    // interpolate along the shorter path.
+    quat b = dequantizeRotation(track.values.data() + second * 3);
+    if (glm::dot(a, b) < 0.0f) {
+        b = -b;
+    }
+
+    return glm::normalize(a * (1.0f - t) + b * t);
+}
+
+} // namespace trc
@@ -1,7 +1,12 @@
 #include "trc/assets/GeometryRegistry.h"
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+
 #include "geometry.pb.h"
 #include "trc/assets/AssetManager.h"
+#include "trc/assets/import/BinaryGeometry.h"
 #include "trc/assets/import/InternalFormat.h"
 #include "trc/core/Frame.h"
 #include "trc/ray_tracing/AccelerationStructure.h"
@@ -16,15 +21,57 @@ namespace trc
 
 void AssetData<Geometry>::serialize(std::ostream& os) const
 {
-    serial::Geometry geo = internal::serializeAssetData(*this);
-    geo.SerializeToOstream(&os);
+    internal::writeBinaryGeometry(*this, os);
 }
 
 void AssetData<Geometry>::deserialize(std::istream& is)
 {
+    internal::BinaryGeometryHeader header;
+    is.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const size_t numRead = static_cast<size_t>(is.gcount());
+    const auto headerBytes = std::as_bytes(std::span{ &header, 1 }).first(numRead);
+
+    if (internal::isBinaryGeometry(headerBytes))
+    {
+        if (numRead < sizeof(header)) {
+            throw std::runtime_error("Binary geometry header is truncated");
+        }
+        *this = internal::readBinaryGeometry(is, header);
+        if (!bounds) bounds = getBounds();  // Written before bounds were stored
+        return;
+    }
+
+    // Fall back to the legacy protobuf format. Re-assemble the bytes that
+    // were consumed while testing for the binary header.
+    std::string buf(reinterpret_cast<const char*>(headerBytes.data()), numRead);
+    buf.append(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+
     serial::Geometry geo;
-    geo.ParseFromIstream(&is);
+    geo.ParseFromString(buf);
     *this = internal::deserializeAssetData(geo);
+    bounds = getBounds();
+}
+
+auto AssetData<Geometry>::getVertexFormat() const -> VertexFormat
+{
+    assert(vertices.empty() || packedVertices.empty());
+    return packedVertices.empty() ? VertexFormat::eFull : VertexFormat::ePacked;
+}
+
+auto AssetData<Geometry>::getVertexCount() const -> size_t
+{
+    return std::max(vertices.size(), packedVertices.size());
+}
+
+auto AssetData<Geometry>::getBounds() const -> GeometryBounds
+{
+    if (bounds) {
+        return *bounds;
+    }
+    if (getVertexFormat() == VertexFormat::ePacked) {
+        return GeometryBounds::fromVertices(packedVertices, quantization);
+    }
+    return GeometryBounds::fromVertices(vertices);
 }
 
 void AssetData<Geometry>::resolveReferences(AssetManager& man)
@@ -52,11 +99,13 @@ GeometryRegistry::GeometryRegistry(const GeometryRegistryCreateInfo& info)
     accelerationStructureBuilder(info.instance),
     deviceDataStorage(DeviceDataCache<DeviceData>::makeLoader(
         [this](ui32 id){ return loadDeviceData(LocalID{ id }); },
-        [this](ui32 id, DeviceData data){ freeDeviceData(LocalID{ id }, std::move(data)); }
+        [this](ui32 id, DeviceData data){ freeDeviceData(LocalID{ id }, std::move(data)); },
+        [](ui32, const DeviceData& data){ return getDeviceDataSize(data); }
     )),
     indexDescriptorBinding(info.indexDescriptorBinding),
     vertexDescriptorBinding(info.vertexDescriptorBinding)
 {
+    deviceDataStorage.setRetentionBudget(info.retentionBudget);
 }
 
 void GeometryRegistry::update(vk::CommandBuffer cmdBuf, FrameRenderState& frame)
@@ -77,6 +126,8 @@ auto GeometryRegistry::add(u_ptr<AssetSource<Geometry>> source) -> LocalID
 
 void GeometryRegistry::remove(const LocalID id)
 {
+    // The ID may be reused for a different geometry
+    deviceDataStorage.evict(id);
     dataSources.erase(id);
     idPool.free(id);
 }
@@ -87,16 +138,100 @@ auto GeometryRegistry::getHandle(const LocalID id) -> GeometryHandle
     return GeometryHandle{ deviceDataStorage.get(id) };
 }
 
+auto GeometryRegistry::getCacheStats() const -> DeviceDataCacheStats
+{
+    return deviceDataStorage.getStats();
+}
+
 auto GeometryRegistry::loadDeviceData(const LocalID id) -> DeviceData
 {
     assert(dataSources.contains(id));
     assert(dataSources.at(id) != nullptr);
 
-    auto data = dataSources.at(id)->load();
-    postProcess(id, data);
+    auto& source = dataSources.at(id);
+
+    // Try to read the geometry in-place from the source's serialized data.
+    // Geometries with rigs are excluded because their rig reference must be
+    // resolved by the asset manager, which happens in `AssetSource::load`.
+    if (auto mapped = source->mapData())
+    {
+        if (auto geo = internal::BinaryGeometryView::make(mapped->data);
+            geo && !geo->hasRig())
+        {
+            // Pre-optimized indices can be uploaded directly from the mapping
+            std::vector<VertexIndex> indices;
+            if (!geo->isTriangleOrderOptimized())
+            {
+                indices.assign(geo->getIndices().begin(), geo->getIndices().end());
+                postProcess(id, indices);
+            }
+
+            auto deviceData = makeDeviceData(
+                id,
+                geo->isTriangleOrderOptimized() ? geo->getIndices() : indices,
+                geo->getVertices(), geo->getPackedVertices(),
+                geo->getVertexQuantization(),
+                geo->getSkeletalVertices(), std::nullopt
+            );
+            deviceData.bounds = geo->getBounds();
+            deviceData.animatedBounds = geo->getAnimatedBounds();
+            if (!deviceData.hasSkeleton) {
+                deviceData.animatedBounds = deviceData.bounds;
+            }
+
+            return deviceData;
+        }
+    }
+
+    auto data = source->load();
+    if (!data.triangleOrderOptimized) {
+        postProcess(id, data.indices);
+    }
+
+    std::optional<RigID> rig;
+    if (!data.rig.empty())
+    {
+        assert(!data.skeletalVertices.empty()
+                && "A geometry with a rig must also have a skeleton.");
+        rig = data.rig.getID();
+    }
 
-    const size_t indicesSize = data.indices.size() * sizeof(decltype(data.indices)::value_type);
-    const size_t meshVerticesSize = data.vertices.size() * sizeof(decltype(data.vertices)::value_type);
+    auto deviceData = makeDeviceData(id, data.indices, data.vertices, data.packedVertices,
+                                     data.quantization, data.skeletalVertices, rig);
+    deviceData.bounds = data.getBounds();
+    deviceData.animatedBounds = data.animatedBounds;
+    if (!deviceData.hasSkeleton) {
+        deviceData.animatedBounds = deviceData.bounds;
+    }
+
+    return deviceData;
+}
+
+auto GeometryRegistry::makeDeviceData(
+    const LocalID id,
+    std::span<const VertexIndex> indices,
+    std::span<const MeshVertex> vertices,
+    std::span<const PackedMeshVertex> packedVertices,
+    const VertexQuantization& quantization,
+    std::span<const SkeletalVertex> skeletalVertices,
+    std::optional<RigID> rig)
+    -> DeviceData
+{
+    assert(vertices.empty() || packedVertices.empty());
+
+    std::vector<MeshVertex> unpackedVertices;
+    if (!packedVertices.empty() && config.enableRayTracing)
+    {
+        unpackedVertices = unpackVertices(packedVertices, quantization);
+        vertices = unpackedVertices;
+        packedVertices = {};
+    }
+
+    const bool packed = !packedVertices.empty();
+    const auto vertexData = packed ? std::as_bytes(packedVertices) : std::as_bytes(vertices);
+
+    const size_t indicesSize = indices.size_bytes();
+    const size_t meshVerticesSize = vertexData.size();
 
     const auto alloc = memoryPool.makeAllocator();
     auto deviceData = DeviceData{
@@ -119,20 +254,22 @@ auto GeometryRegistry::loadDeviceData(const LocalID id) -> DeviceData
         },
         .skeletalVertexBuf = {},
 
-        .numIndices = static_cast<ui32>(data.indices.size()),
-        .numVertices = static_cast<ui32>(data.vertices.size()),
+        .numIndices = static_cast<ui32>(indices.size()),
+        .numVertices = static_cast<ui32>(packed ? packedVertices.size() : vertices.size()),
+        .vertexFormat = packed ? VertexFormat::ePacked : VertexFormat::eFull,
+        .quantization = packed ? quantization : VertexQuantization{},
+        .rig = rig,
     };
 
     // Enqueue writes to the device-local vertex buffers
-    dataWriter.write(*deviceData.indexBuf,      0, data.indices.data(),  indicesSize);
-    dataWriter.write(*deviceData.meshVertexBuf, 0, data.vertices.data(), meshVerticesSize);
+    dataWriter.write(*deviceData.indexBuf,      0, indices.data(),    indicesSize);
+    dataWriter.write(*deviceData.meshVertexBuf, 0, vertexData.data(), meshVerticesSize);
 
-    if (!data.skeletalVertices.empty())
+    if (!skeletalVertices.empty())
     {
         deviceData.hasSkeleton = true;
 
-        const size_t skelVerticesSize = data.skeletalVertices.size()
-                                        * sizeof(decltype(data.skeletalVertices)::value_type);
+        const size_t skelVerticesSize = skeletalVertices.size_bytes();
         deviceData.skeletalVertexBuf = {
             instance.getDevice(),
             skelVerticesSize, nullptr,
@@ -141,14 +278,7 @@ auto GeometryRegistry::loadDeviceData(const LocalID id) -> DeviceData
                 | vk::BufferUsageFlagBits::eTransferDst,
             alloc
         };
-        dataWriter.write(*deviceData.skeletalVertexBuf, 0, data.skeletalVertices.data(), skelVerticesSize);
-    }
-
-    if (!data.rig.empty())
-    {
-        assert(!data.skeletalVertices.empty() && deviceData.hasSkeleton
-                && "A geometry with a rig must also have a skeleton.");
-        deviceData.rig = data.rig.getID();
+        dataWriter.write(*deviceData.skeletalVertexBuf, 0, skeletalVertices.data(), skelVerticesSize);
     }
 
     if (config.enableRayTracing)
@@ -226,10 +356,21 @@ void GeometryRegistry::freeDeviceData(LocalID /*id*/, DeviceData data)
     pendingUnloads.emplace_back(std::move(data));
 }
 
-void GeometryRegistry::postProcess(LocalID id, AssetData<Geometry>& data)
+auto GeometryRegistry::getDeviceDataSize(const DeviceData& data) -> size_t
+{
+    size_t vertexSize = data.vertexFormat == VertexFormat::ePacked ? sizeof(PackedMeshVertex)
+                                                                   : sizeof(MeshVertex);
+    if (data.hasSkeleton) {
+        vertexSize += sizeof(SkeletalVertex);
+    }
+
+    return size_t{data.numIndices} * sizeof(VertexIndex) + size_t{data.numVertices} * vertexSize;
+}
+
+void GeometryRegistry::postProcess(LocalID id, std::vector<VertexIndex>& indices)
 {
     try {
-        data.indices = util::optimizeTriangleOrderingForsyth(data.indices);
+        indices = util::optimizeTriangleOrderingForsyth(indices);
     }
     catch (const std::invalid_argument& err) {
         log::warn << log::here() << ": Unable to optimize triangle order for geometry \""
@@ -306,7 +447,8 @@ auto GeometryHandle::getIndexType() const noexcept -> vk::IndexType
 
 auto GeometryHandle::getVertexSize() const noexcept -> size_t
 {
-    return sizeof(MeshVertex);
+    return deviceData->vertexFormat == VertexFormat::ePacked ? sizeof(PackedMeshVertex)
+                                                             : sizeof(MeshVertex);
 }
 
 auto GeometryHandle::getSkeletalVertexSize() const noexcept -> size_t
@@ -314,6 +456,26 @@ auto GeometryHandle::getSkeletalVertexSize() const noexcept -> size_t
     return sizeof(SkeletalVertex);
 }
 
+auto GeometryHandle::getVertexFormat() const noexcept -> VertexFormat
+{
+    return deviceData->vertexFormat;
+}
+
+auto GeometryHandle::getVertexQuantization() const noexcept -> const VertexQuantization&
+{
+    return deviceData->quantization;
+}
+
+auto GeometryHandle::getBounds() const noexcept -> const GeometryBounds&
+{
+    return deviceData->bounds;
+}
+
+auto GeometryHandle::getAnimatedBounds() const noexcept -> const std::optional<GeometryBounds>&
+{
+    return deviceData->animatedBounds;
+}
+
 bool GeometryHandle::hasSkeleton() const
 {
     return deviceData->hasSkeleton;
@@ -13,22 +13,18 @@ trc::AssetData<trc::Material>::AssetData(const MaterialBaseInfo& createInfo)
     shaderProgram(createInfo),
     transparent(createInfo.transparent)
 {
-    for (const auto& [_, program] : shaderProgram.iterSpecializations())
+    // Collect references to textures so we can resolve them at the asset
+    // manager when a material is created from this data. All specializations
+    // share the fragment module's constants, so they are read from it
+    // directly instead of creating every specialization up front.
+    for (const auto& spec : createInfo.fragmentModule.getSpecializationConstants())
     {
-        // Collect references to textures so we can resolve them at the asset
-        // manager when a material is created from this data.
-        for (auto& [stage, specConstants] : program.specConstants)
-        {
-            for (auto& [_, spec] : specConstants)
-            {
-                auto texture = std::dynamic_pointer_cast<RuntimeTextureIndex>(spec);
-                if (!texture) {
-                    throw std::runtime_error("Only texture references are allowed as"
-                                             " specialization constants.");
-                }
-                requiredTextures.emplace_back(texture->getTextureReference());
-            }
+        auto texture = std::dynamic_pointer_cast<RuntimeTextureIndex>(spec.value);
+        if (!texture) {
+            throw std::runtime_error("Only texture references are allowed as"
+                                     " specialization constants.");
         }
+        requiredTextures.emplace_back(texture->getTextureReference());
     }
 }
 
@@ -155,7 +151,8 @@ auto trc::makeMaterialProgram(
     // specialization.
     const DrawablePipelineInfo info{
         .animated=key.flags.has(MaterialKey::Flags::Animated::eTrue),
-        .transparent=data.transparent
+        .transparent=data.transparent,
+        .packedVertices=key.flags.has(MaterialKey::Flags::PackedVertices::eTrue),
     };
     Pipeline::ID basePipeline = pipelines::getDrawableBasePipeline(info.toPipelineFlags());
 
@@ -227,7 +224,8 @@ auto trc::MaterialRegistry::SpecializationStorage::getSpecialization(const Mater
         prog = makeMaterialProgram(
             data,
             MaterialSpecializationInfo{
-                .animated=key.flags.has(MaterialKey::Flags::Animated::eTrue)
+                .animated=key.flags.has(MaterialKey::Flags::Animated::eTrue),
+                .packedVertices=key.flags.has(MaterialKey::Flags::PackedVertices::eTrue),
             }
         );
         runtime = prog->cloneRuntime();
@@ -1,5 +1,11 @@
 #include "trc/assets/TextureRegistry.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
 #include "texture.pb.h"
 #include "trc/assets/import/InternalFormat.h"
 #include "trc/ray_tracing/RayPipelineBuilder.h"
@@ -9,6 +15,79 @@
 namespace trc
 {
 
+namespace
+{
+    auto toVkFormat(TextureFormat format) -> vk::Format
+    {
+        switch (format)
+        {
+        case TextureFormat::eRGBA8: return vk::Format::eR8G8B8A8Unorm;
+        case TextureFormat::eBC1:   return vk::Format::eBc1RgbaUnormBlock;
+        case TextureFormat::eBC3:   return vk::Format::eBc3UnormBlock;
+        case TextureFormat::eBC5:   return vk::Format::eBc5UnormBlock;
+        case TextureFormat::eBC7:   return vk::Format::eBc7UnormBlock;
+        }
+
+        throw std::invalid_argument("[In toVkFormat]: Invalid texture format "
+                                    + std::to_string(static_cast<ui32>(format)));
+    }
+} // anonymous namespace
+
+auto getTextureDataSize(TextureFormat format, uvec2 size) -> size_t
+{
+    if (format == TextureFormat::eRGBA8) {
+        return size_t{size.x} * size_t{size.y} * 4;
+    }
+
+    const size_t blockBytes = format == TextureFormat::eBC1 ? 8 : 16;
+    const uvec2 numBlocks = (size + 3u) / 4u;
+    return size_t{numBlocks.x} * size_t{numBlocks.y} * blockBytes;
+}
+
+auto getMipLevelSize(uvec2 baseSize, ui32 level) -> uvec2
+{
+    auto shift = [level](ui32 x) { return level < 32 ? std::max(1u, x >> level) : 1u; };
+    return { shift(baseSize.x), shift(baseSize.y) };
+}
+
+auto getMaxMipLevelCount(uvec2 size) -> ui32
+{
+    return static_cast<ui32>(std::bit_width(std::max(size.x, size.y)));
+}
+
+void validateMipChain(TextureFormat format, const std::vector<TextureMipLevel>& levels)
+{
+    if (levels.empty()) {
+        return;
+    }
+
+    const uvec2 base = levels.front().size;
+    if (base.x == 0 || base.y == 0) {
+        throw std::runtime_error("Base level of texture mip chain is empty");
+    }
+    if (levels.size() > getMaxMipLevelCount(base))
+    {
+        throw std::runtime_error("Texture mip chain has " + std::to_string(levels.size())
+                                 + " levels, but a " + std::to_string(base.x) + "x"
+                                 + std::to_string(base.y) + " image has at most "
+                                 + std::to_string(getMaxMipLevelCount(base)));
+    }
+
+    for (ui32 i = 0; const auto& level : levels)
+    {
+        if (level.size != getMipLevelSize(base, i++))
+        {
+            throw std::runtime_error("Extent of texture mip level " + std::to_string(i - 1)
+                                     + " does not match the base level's extent");
+        }
+        if (level.data.size() != getTextureDataSize(format, level.size))
+        {
+            throw std::runtime_error("Size of texture mip level data does not match the"
+                                     " level's format and extent");
+        }
+    }
+}
+
 void AssetData<Texture>::serialize(std::ostream& os) const
 {
     serial::Texture tex = internal::serializeAssetData(*this);
@@ -31,10 +110,12 @@ TextureRegistry::TextureRegistry(const TextureRegistryCreateInfo& info)
     dataWriter(info.device),
     deviceDataStorage(DataCache::makeLoader(
         [this](ui32 id){ return loadDeviceData(LocalID{ id }); },
-        [this](ui32 id, DeviceData data){ freeDeviceData(LocalID{ id }, std::move(data)); }
+        [this](ui32 id, DeviceData data){ freeDeviceData(LocalID{ id }, std::move(data)); },
+        [](ui32, const DeviceData& data){ return data.memorySize; }
     )),
     descBinding(info.textureDescBinding)
 {
+    deviceDataStorage.setRetentionBudget(info.retentionBudget);
 }
 
 void TextureRegistry::update(vk::CommandBuffer cmdBuf, FrameRenderState& frameState)
@@ -62,6 +143,9 @@ auto TextureRegistry::add(u_ptr<AssetSource<Texture>> source) -> LocalID
 
 void TextureRegistry::remove(const LocalID id)
 {
+    // The ID may be reused for a different texture
+    deviceDataStorage.evict(id);
+
     std::scoped_lock lock(sourceStorageLock);  // Unique ownership
     dataSources.erase(id);
     idPool.free(id);
@@ -72,6 +156,11 @@ auto TextureRegistry::getHandle(const LocalID id) -> Handle
     return Handle{ deviceDataStorage.get(id) };
 }
 
+auto TextureRegistry::getCacheStats() const -> DeviceDataCacheStats
+{
+    return deviceDataStorage.getStats();
+}
+
 auto TextureRegistry::loadDeviceData(const LocalID id) -> DeviceData
 {
     std::shared_lock lock(sourceStorageLock);  // Shared ownership as we only read here
@@ -80,16 +169,52 @@ auto TextureRegistry::loadDeviceData(const LocalID id) -> DeviceData
     assert(dataSources.get(id) != nullptr);
 
     const ui32 deviceIndex = ui32{id};
-    const auto data = dataSources.get(id)->load();
+    auto data = dataSources.get(id)->load();
+
+    // Textures without pre-encoded data are uploaded as a single RGBA8 level
+    if (data.mipLevels.empty())
+    {
+        auto& level = data.mipLevels.emplace_back(data.size, std::vector<ui8>(data.pixels.size() * 4));
+        memcpy(level.data.data(), data.pixels.data(), level.data.size());
+        data.format = TextureFormat::eRGBA8;
+    }
+
+    // Malformed data would make the copy to the image read or write out of
+    // bounds
+    validateMipChain(data.format, data.mipLevels);
+    if (data.mipLevels.front().size != data.size)
+    {
+        throw std::runtime_error("[In TextureRegistry::loadDeviceData]: Size of the base mip"
+                                 " level does not match the texture's size");
+    }
+    if (data.format != TextureFormat::eRGBA8
+        && !device.getPhysicalDevice().features.textureCompressionBC)
+    {
+        throw std::runtime_error("[In TextureRegistry::loadDeviceData]: Texture uses a"
+                                 " block-compressed format, but the device does not support"
+                                 " the textureCompressionBC feature. Convert the texture"
+                                 " without block compression.");
+    }
+    const auto numLevels = static_cast<ui32>(data.mipLevels.size());
+    const vk::Format format = toVkFormat(data.format);
 
     // Create image resource
     Image image(
-        device, data.size.x, data.size.y,
-        vk::Format::eR8G8B8A8Unorm,
-        vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+        device,
+        vk::ImageCreateInfo(
+            {},
+            vk::ImageType::e2D,
+            format,
+            { data.size.x, data.size.y, 1 },
+            numLevels, 1,
+            vk::SampleCountFlagBits::e1,
+            vk::ImageTiling::eOptimal,
+            vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst
+        ),
         memoryPool.makeAllocator()
     );
-    auto imageView = image.createView(vk::ImageViewType::e2D, vk::Format::eR8G8B8A8Unorm);
+    const vk::ImageSubresourceRange subresRange(vk::ImageAspectFlagBits::eColor, 0, numLevels, 0, 1);
+    auto imageView = image.createView(vk::ImageViewType::e2D, format, {}, subresRange);
 
     // Write data to device-local image memory
     dataWriter.barrierPreWrite(
@@ -101,16 +226,19 @@ auto TextureRegistry::loadDeviceData(const LocalID id) -> DeviceData
             vk::ImageLayout::eUndefined,
             vk::ImageLayout::eTransferDstOptimal,
             VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
-            *image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)
+            *image, subresRange
         )
     );
-    dataWriter.write(
-        *image,
-        vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),
-        { 0, 0, 0 },
-        image.getExtent(),
-        data.pixels.data(), size_t{data.size.x} * size_t{data.size.y} * 4
-    );
+    for (ui32 i = 0; const auto& level : data.mipLevels)
+    {
+        dataWriter.write(
+            *image,
+            vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, i++, 0, 1),
+            { 0, 0, 0 },
+            { level.size.x, level.size.y, 1 },
+            level.data.data(), level.data.size()
+        );
+    }
     dataWriter.barrierPostWrite(
         vk::PipelineStageFlagBits::eTransfer,
         vk::PipelineStageFlagBits::eAllGraphics | vk::PipelineStageFlagBits::eComputeShader,
@@ -120,7 +248,7 @@ auto TextureRegistry::loadDeviceData(const LocalID id) -> DeviceData
             vk::ImageLayout::eTransferDstOptimal,
             vk::ImageLayout::eShaderReadOnlyOptimal,
             VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
-            *image, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1)
+            *image, subresRange
         )
     );
 
@@ -130,11 +258,17 @@ auto TextureRegistry::loadDeviceData(const LocalID id) -> DeviceData
         { image.getDefaultSampler(), *imageView, vk::ImageLayout::eShaderReadOnlyOptimal }
     );
 
+    size_t memorySize{ 0 };
+    for (const auto& level : data.mipLevels) {
+        memorySize += level.data.size();
+    }
+
     // Store resources
     return DeviceData{
         .deviceIndex = deviceIndex,
         .image       = std::move(image),
-        .imageView   = std::move(imageView)
+        .imageView   = std::move(imageView),
+        .memorySize  = memorySize,
     };
 }
 
@@ -0,0 +1,302 @@
+#include "trc/assets/import/AnimationCompression.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+
+namespace trc
+{
+
+namespace
+{
+    using Track = CompressedAnimation::Track;
+
+    constexpr size_t kMaxFrames{ size_t{std::numeric_limits<ui16>::max()} + 1 };
+
+    /**
+     * Limits the number of frames between two keys. Testing a key
+     * interval is quadratic in its length, so this bounds the cost of
+     * compressing long, nearly linear tracks.
+     */
+    constexpr size_t kMaxKeyGap{ 256 };
+
+    struct Transform
+    {
+        vec3 translation;
+        quat rotation;
+        vec3 scale;
+    };
+
+    auto decompose(const mat4& m) -> Transform
+    {
+        vec3 scale{ glm::length(vec3(m[0])), glm::length(vec3(m[1])), glm::length(vec3(m[2])) };
+        if (glm::determinant(mat3(m)) < 0.0f) {
+            scale.x = -scale.x;
+        }
+
+        mat3 rotation(1.0f);
+        for (int i = 0; i < 3; ++i)
+        {
+            if (scale[i] != 0.0f) {
+                rotation[i] = vec3(m[i]) / scale[i];
+            }
+        }
+
+        return { vec3(m[3]), glm::normalize(glm::quat_cast(rotation)), scale };
+    }
+
+    /**
+     * @return float The angle of the rotation from `a` to `b` in radians
+     */
+    auto angleBetween(quat a, quat b) -> float
+    {
+        // More precise than acos(dot(a, b)) for small angles
+        const quat d = glm::conjugate(a) * b;
+        return 2.0f * std::atan2(glm::length(vec3(d.x, d.y, d.z)), std::abs(d.w));
+    }
+
+    /**
+     * @brief Select the keys of a track
+     *
+     * Greedily extends each key interval for as long as all frames in it
+     * can be interpolated from the interval's (decoded) end points within
+     * `tolerance`.
+     *
+     * @return std::vector<ui16> Indices of the selected keys
+     */
+    template<typename T, typename Interpolate, typename Error>
+    auto selectKeys(const std::vector<T>& original,
+                    const std::vector<T>& decoded,
+                    float tolerance,
+                    Interpolate&& interpolate,
+                    Error&& error)
+        -> std::vector<ui16>
+    {
+        assert(!original.empty());
+        assert(original.size() == decoded.size());
+
+        const size_t n = original.size();
+        const bool isConstant = std::ranges::all_of(original, [&](const T& value) {
+            return error(decoded[0], value) <= tolerance;
+        });
+        if (isConstant) {
+            return { 0 };
+        }
+
+        auto fits = [&](size_t first, size_t last) {
+            for (size_t i = first + 1; i < last; ++i)
+            {
+                const float t = static_cast<float>(i - first) / static_cast<float>(last - first);
+                if (error(interpolate(decoded[first], decoded[last], t), original[i]) > tolerance) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        std::vector<ui16> keys{ 0 };
+        for (size_t first = 0; first < n - 1; )
+        {
+            size_t last = first + 1;
+            while (last + 1 < n && last + 1 - first <= kMaxKeyGap && fits(first, last + 1)) {
+                ++last;
+            }
+            keys.push_back(static_cast<ui16>(last));
+            first = last;
+        }
+
+        return keys;
+    }
+
+    auto compressVectorTrack(const std::vector<vec3>& values, float tolerance) -> Track
+    {
+        vec3 min{ values.front() };
+        vec3 max{ values.front() };
+        for (const vec3& v : values)
+        {
+            min = glm::min(min, v);
+            max = glm::max(max, v);
+        }
+
+        Track track{ .frames={}, .values={}, .rangeMin=min, .rangeExtent=max - min };
+
+        std::vector<ui16> quantized;
+        std::vector<vec3> decoded;
+        quantized.reserve(values.size() * 3);
+        decoded.reserve(values.size());
+        for (const vec3& v : values)
+        {
+            vec3& dec = decoded.emplace_back();
+            for (int i = 0; i < 3; ++i)
+            {
+                const ui16 q = CompressedAnimation::quantizeRange(v[i], min[i], track.rangeExtent[i]);
+                quantized.push_back(q);
+                dec[i] = CompressedAnimation::dequantizeRange(q, min[i], track.rangeExtent[i]);
+            }
+        }
+
+        track.frames = selectKeys(values, decoded, tolerance,
+            [](vec3 a, vec3 b, float t) { return glm::mix(a, b, t); },
+            [](vec3 a, vec3 b) {
+                const vec3 diff = glm::abs(a - b);
+                return std::max({ diff.x, diff.y, diff.z });
+            }
+        );
+        for (const ui16 frame : track.frames)
+        {
+            const ui16* q = quantized.data() + size_t{frame} * 3;
+            track.values.insert(track.values.end(), q, q + 3);
+        }
+
+        return track;
+    }
+
+    auto compressRotationTrack(const std::vector<quat>& values, float tolerance) -> Track
+    {
+        Track track;
+
+        std::vector<ui16> quantized(values.size() * 3);
+        std::vector<quat> decoded;
+        decoded.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            CompressedAnimation::quantizeRotation(values[i], quantized.data() + i * 3);
+            decoded.emplace_back(CompressedAnimation::dequantizeRotation(quantized.data() + i * 3));
+        }
+
+        track.frames = selectKeys(values, decoded, tolerance,
+            [](quat a, quat b, float t) {
+                // Same as the decoder
+                if (glm::dot(a, b) < 0.0f) b = -b;
+                return glm::normalize(a * (1.0f - t) + b * t);
+            },
+            [](quat a, quat b) { return angleBetween(a, b); }
+        );
+        for (const ui16 frame : track.frames)
+        {
+            const ui16* q = quantized.data() + size_t{frame} * 3;
+            track.values.insert(track.values.end(), q, q + 3);
+        }
+
+        return track;
+    }
+} // anonymous namespace
+
+
+
+auto AnimationCompressionStats::getRatio() const -> float
+{
+    if (compressedSize == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(originalSize) / static_cast<float>(compressedSize);
+}
+
+auto compressAnimation(
+    const AnimationData& anim,
+    const AnimationCompressionSettings& settings,
+    AnimationCompressionStats* stats)
+    -> CompressedAnimation
+{
+    if (anim.keyframes.empty())
+    {
+        throw std::invalid_argument("[In compressAnimation]: Animation \"" + anim.name + "\""
+                                    " has no keyframes.");
+    }
+    if (anim.keyframes.size() > kMaxFrames)
+    {
+        throw std::invalid_argument("[In compressAnimation]: Animation \"" + anim.name + "\""
+                                    " has " + std::to_string(anim.keyframes.size())
+                                    + " frames. At most " + std::to_string(kMaxFrames)
+                                    + " frames are supported.");
+    }
+    assert(anim.frameCount == anim.keyframes.size());
+
+    const size_t frameCount = anim.keyframes.size();
+    const size_t boneCount = anim.keyframes.front().boneMatrices.size();
+    for (const auto& kf : anim.keyframes)
+    {
+        if (kf.boneMatrices.size() != boneCount)
+        {
+            throw std::invalid_argument("[In compressAnimation]: Keyframes of animation \""
+                                        + anim.name + "\" have different numbers of bones.");
+        }
+    }
+
+    CompressedAnimation res{ .frameCount=static_cast<ui32>(frameCount), .bones={} };
+    res.bones.reserve(boneCount);
+
+    std::vector<vec3> translations(frameCount);
+    std::vector<quat> rotations(frameCount);
+    std::vector<vec3> scales(frameCount);
+    for (size_t bone = 0; bone < boneCount; ++bone)
+    {
+        for (size_t frame = 0; frame < frameCount; ++frame)
+        {
+            const auto [t, r, s] = decompose(anim.keyframes[frame].boneMatrices[bone]);
+            translations[frame] = t;
+            rotations[frame] = r;
+            scales[frame] = s;
+        }
+
+        res.bones.push_back({
+            .translation=compressVectorTrack(translations, settings.translationTolerance),
+            .rotation=compressRotationTrack(rotations, settings.rotationTolerance),
+            .scale=compressVectorTrack(scales, settings.scaleTolerance),
+        });
+    }
+
+    if (stats != nullptr)
+    {
+        *stats = AnimationCompressionStats{
+            .originalSize=frameCount * boneCount * sizeof(mat4),
+            .compressedSize=res.getSize(),
+            .frameCount=static_cast<ui32>(frameCount),
+            .keyCount=0,
+            .maxError=0.0f,
+        };
+        for (const auto& bone : res.bones)
+        {
+            stats->keyCount += bone.translation.frames.size()
+                             + bone.rotation.frames.size()
+                             + bone.scale.frames.size();
+        }
+
+        std::vector<mat4> decoded(boneCount);
+        for (ui32 frame = 0; frame < frameCount; ++frame)
+        {
+            res.sampleFrame(frame, decoded);
+            for (size_t bone = 0; bone < boneCount; ++bone)
+            {
+                const mat4& original = anim.keyframes[frame].boneMatrices[bone];
+                for (int col = 0; col < 4; ++col)
+                {
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        const float err = std::abs(decoded[bone][col][row] - original[col][row]);
+                        stats->maxError = std::max(stats->maxError, err);
+                    }
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+auto compressAnimationInPlace(AnimationData& anim, const AnimationCompressionSettings& settings)
+    -> AnimationCompressionStats
+{
+    AnimationCompressionStats stats;
+    anim.compressed = compressAnimation(anim, settings, &stats);
+    anim.keyframes.clear();
+
+    return stats;
+}
+
+} // namespace trc
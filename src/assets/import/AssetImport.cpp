@@ -3,6 +3,7 @@
 #include <fstream>
 
 #include "trc/base/ImageUtils.h"
+#include "trc/assets/import/GeometryTransformations.h"
 #include "trc/base/Logging.h"
 
 
@@ -52,6 +53,11 @@ auto trc::loadAssets(const fs::path& filePath) -> ThirdPartyFileImportData
     for (auto& mesh : result.meshes)
     {
         linkAssetReferences(mesh);
+
+        computeBounds(mesh.geometry);
+        if (mesh.rig.has_value()) {
+            computeAnimatedBounds(mesh.geometry, mesh.animations);
+        }
     }
 
     return result;
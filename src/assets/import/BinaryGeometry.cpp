@@ -0,0 +1,448 @@
+#include "trc/assets/import/BinaryGeometry.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include <trc_util/Padding.h>
+
+
+
+namespace trc::internal
+{
+
+namespace
+{
+    /**
+     * Saturates instead of overflowing, so that absurd counts in a header
+     * never pass a range check.
+     */
+    template<typename T>
+    auto blobSize(ui64 count) -> ui64
+    {
+        constexpr ui64 kMaxCount = std::numeric_limits<ui64>::max() / sizeof(T);
+        return count > kMaxCount ? std::numeric_limits<ui64>::max() : count * sizeof(T);
+    }
+
+    bool hasPackedVertices(const BinaryGeometryHeader& header)
+    {
+        return header.flags & kBinaryGeometryPackedVertices;
+    }
+
+    bool hasBounds(const BinaryGeometryHeader& header)
+    {
+        return header.flags & kBinaryGeometryBounds;
+    }
+
+    /**
+     * The bounds blob directly follows the header, so the first non-empty
+     * blob after it must not begin earlier than the blob's end.
+     */
+    bool boundsFitBeforeBlobs(const BinaryGeometryHeader& header)
+    {
+        constexpr ui64 boundsEnd = sizeof(BinaryGeometryHeader) + kBinaryGeometryBoundsSize;
+        auto isAfterBounds = [](ui64 offset){ return offset == 0 || offset >= boundsEnd; };
+        return !hasBounds(header)
+            || (isAfterBounds(header.vertexOffset)
+                && isAfterBounds(header.skeletalVertexOffset)
+                && isAfterBounds(header.indexOffset)
+                && isAfterBounds(header.rigPathOffset));
+    }
+
+    /**
+     * @return ui64 Size of the mesh vertex blob, including the quantization
+     *              transform of packed vertices.
+     */
+    auto vertexBlobSize(const BinaryGeometryHeader& header) -> ui64
+    {
+        if (header.numVertices == 0) {
+            return 0;
+        }
+        if (hasPackedVertices(header))
+        {
+            const ui64 size = blobSize<PackedMeshVertex>(header.numVertices);
+            return size > std::numeric_limits<ui64>::max() - kBinaryGeometryQuantizationSize
+                ? std::numeric_limits<ui64>::max()
+                : kBinaryGeometryQuantizationSize + size;
+        }
+        return blobSize<MeshVertex>(header.numVertices);
+    }
+
+    /**
+     * Check that the header describes data that could have been written
+     * by `writeBinaryGeometry` on this host.
+     */
+    bool isValidHeader(const BinaryGeometryHeader& header)
+    {
+        return std::memcmp(header.magic, kBinaryGeometryMagic, sizeof(kBinaryGeometryMagic)) == 0
+            && header.version == kBinaryGeometryVersion
+            && header.vertexSize == (hasPackedVertices(header) ? sizeof(PackedMeshVertex)
+                                                                : sizeof(MeshVertex))
+            && header.skeletalVertexSize == sizeof(SkeletalVertex)
+            && header.indexSize == sizeof(VertexIndex)
+            && header.vertexOffset % kBinaryGeometryAlignment == 0
+            && header.skeletalVertexOffset % kBinaryGeometryAlignment == 0
+            && header.indexOffset % kBinaryGeometryAlignment == 0
+            && (header.numSkeletalVertices == 0
+                || header.numSkeletalVertices == header.numVertices)
+            && boundsFitBeforeBlobs(header);
+    }
+
+    bool blobInRange(ui64 offset, ui64 size, ui64 totalSize)
+    {
+        return offset <= totalSize && size <= totalSize - offset;
+    }
+
+    /**
+     * Check that all blobs described by the header lie within `totalSize`
+     * bytes of data, counted from the beginning of the header.
+     */
+    bool blobsInRange(const BinaryGeometryHeader& header, ui64 totalSize)
+    {
+        return blobInRange(header.vertexOffset, vertexBlobSize(header), totalSize)
+            && blobInRange(header.skeletalVertexOffset,
+                           blobSize<SkeletalVertex>(header.numSkeletalVertices), totalSize)
+            && blobInRange(header.indexOffset, blobSize<VertexIndex>(header.numIndices), totalSize)
+            && blobInRange(header.rigPathOffset, header.rigPathLength, totalSize)
+            && (!hasBounds(header)
+                || blobInRange(sizeof(BinaryGeometryHeader), kBinaryGeometryBoundsSize, totalSize));
+    }
+
+    /**
+     * @return std::optional<ui64> The number of bytes between the stream's
+     *                             read position and its end. Nullopt if
+     *                             the stream is not seekable.
+     */
+    auto remainingSize(std::istream& is) -> std::optional<ui64>
+    {
+        const auto begin = is.tellg();
+        if (begin == std::istream::pos_type(-1)) {
+            return std::nullopt;
+        }
+        is.seekg(0, std::ios::end);
+        const auto end = is.tellg();
+        is.seekg(begin);
+        if (!is || end < begin) {
+            return std::nullopt;
+        }
+        return static_cast<ui64>(end - begin);
+    }
+
+    void writePadding(std::ostream& os, ui64& pos)
+    {
+        static constexpr char zeros[kBinaryGeometryAlignment]{};
+        const ui64 padded = util::pad(pos, kBinaryGeometryAlignment);
+        os.write(zeros, static_cast<std::streamsize>(padded - pos));
+        pos = padded;
+    }
+
+    void skipTo(std::istream& is, ui64& pos, ui64 offset)
+    {
+        if (offset < pos) {
+            throw std::runtime_error("Binary geometry blobs are not ordered sequentially");
+        }
+        is.ignore(static_cast<std::streamsize>(offset - pos));
+        pos = offset;
+    }
+
+    template<typename T>
+    void readBlob(std::istream& is, ui64& pos, ui64 offset, ui64 count, std::vector<T>& out)
+    {
+        if (count == 0) return;
+
+        skipTo(is, pos, offset);
+        out.resize(count);
+        is.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(blobSize<T>(count)));
+        pos += blobSize<T>(count);
+    }
+} // anonymous namespace
+
+void writeBinaryGeometry(const GeometryData& data, std::ostream& os)
+{
+    assert(data.skeletalVertices.empty()
+           || data.skeletalVertices.size() == data.getVertexCount());
+
+    const std::string rigPath = data.rig.hasAssetPath() ? data.rig.getAssetPath().string() : "";
+    const bool packed = data.getVertexFormat() == VertexFormat::ePacked;
+
+    ui32 flags{ 0 };
+    if (data.triangleOrderOptimized) flags |= kBinaryGeometryTriangleOrderOptimized;
+    if (packed) flags |= kBinaryGeometryPackedVertices;
+    flags |= kBinaryGeometryBounds;
+    if (data.animatedBounds) flags |= kBinaryGeometryAnimatedBounds;
+
+    BinaryGeometryHeader header{
+        .magic={},
+        .version=kBinaryGeometryVersion,
+        .flags=flags,
+        .vertexSize=packed ? sizeof(PackedMeshVertex) : sizeof(MeshVertex),
+        .skeletalVertexSize=sizeof(SkeletalVertex),
+        .indexSize=sizeof(VertexIndex),
+        .numVertices=data.getVertexCount(),
+        .numSkeletalVertices=data.skeletalVertices.size(),
+        .numIndices=data.indices.size(),
+        .rigPathLength=rigPath.size(),
+        .vertexOffset=0,
+        .skeletalVertexOffset=0,
+        .indexOffset=0,
+        .rigPathOffset=0,
+    };
+    std::memcpy(header.magic, kBinaryGeometryMagic, sizeof(kBinaryGeometryMagic));
+
+    // Calculate blob offsets. Empty blobs have an offset of zero. The
+    // bounds are always written and directly follow the header.
+    static_assert(sizeof(BinaryGeometryHeader) % kBinaryGeometryAlignment == 0);
+    ui64 offset = sizeof(BinaryGeometryHeader) + kBinaryGeometryBoundsSize;
+    auto nextBlob = [&offset](ui64 size) -> ui64 {
+        if (size == 0) return 0;
+        const ui64 begin = util::pad(offset, kBinaryGeometryAlignment);
+        offset = begin + size;
+        return begin;
+    };
+    header.vertexOffset         = nextBlob(vertexBlobSize(header));
+    header.skeletalVertexOffset = nextBlob(blobSize<SkeletalVertex>(header.numSkeletalVertices));
+    header.indexOffset          = nextBlob(blobSize<VertexIndex>(header.numIndices));
+    header.rigPathOffset        = nextBlob(header.rigPathLength);
+
+    // Write header and blobs
+    ui64 pos = 0;
+    auto writeBlob = [&](const void* src, ui64 size) {
+        if (size == 0) return;
+        writePadding(os, pos);
+        os.write(static_cast<const char*>(src), static_cast<std::streamsize>(size));
+        pos += size;
+    };
+    writeBlob(&header, sizeof(header));
+    const GeometryBounds bounds[2]{
+        data.getBounds(),
+        data.animatedBounds.value_or(GeometryBounds{}),
+    };
+    writeBlob(bounds, kBinaryGeometryBoundsSize);
+    if (packed && header.numVertices > 0)
+    {
+        std::byte quantization[kBinaryGeometryQuantizationSize]{};
+        std::memcpy(quantization, &data.quantization, sizeof(VertexQuantization));
+        writeBlob(quantization, sizeof(quantization));
+        writeBlob(data.packedVertices.data(), blobSize<PackedMeshVertex>(header.numVertices));
+    }
+    else {
+        writeBlob(data.vertices.data(), blobSize<MeshVertex>(header.numVertices));
+    }
+    writeBlob(data.skeletalVertices.data(), blobSize<SkeletalVertex>(header.numSkeletalVertices));
+    writeBlob(data.indices.data(),          blobSize<VertexIndex>(header.numIndices));
+    writeBlob(rigPath.data(),               header.rigPathLength);
+}
+
+bool isBinaryGeometry(std::span<const std::byte> data)
+{
+    return data.size() >= sizeof(kBinaryGeometryMagic)
+        && std::memcmp(data.data(), kBinaryGeometryMagic, sizeof(kBinaryGeometryMagic)) == 0;
+}
+
+auto readBinaryGeometry(std::istream& is, const BinaryGeometryHeader& header) -> GeometryData
+{
+    if (!isValidHeader(header)) {
+        throw std::runtime_error("Invalid or unsupported binary geometry header");
+    }
+
+    // Validate the header's counts before any array is sized from them
+    const auto remaining = remainingSize(is);
+    if (!remaining) {
+        throw std::runtime_error("Binary geometry can only be read from a seekable stream");
+    }
+    if (!blobsInRange(header, sizeof(BinaryGeometryHeader) + *remaining)) {
+        throw std::runtime_error("Binary geometry header describes more data than the stream"
+                                 " contains");
+    }
+
+    GeometryData data;
+    ui64 pos = sizeof(BinaryGeometryHeader);
+    if (hasBounds(header))
+    {
+        GeometryBounds bounds[2];
+        is.read(reinterpret_cast<char*>(bounds), kBinaryGeometryBoundsSize);
+        pos += kBinaryGeometryBoundsSize;
+
+        data.bounds = bounds[0];
+        if (header.flags & kBinaryGeometryAnimatedBounds) {
+            data.animatedBounds = bounds[1];
+        }
+    }
+    if (hasPackedVertices(header) && header.numVertices > 0)
+    {
+        std::vector<std::byte> quantization;
+        readBlob(is, pos, header.vertexOffset, kBinaryGeometryQuantizationSize, quantization);
+        std::memcpy(&data.quantization, quantization.data(), sizeof(VertexQuantization));
+        readBlob(is, pos, header.vertexOffset + kBinaryGeometryQuantizationSize,
+                 header.numVertices, data.packedVertices);
+    }
+    else {
+        readBlob(is, pos, header.vertexOffset, header.numVertices, data.vertices);
+    }
+    readBlob(is, pos, header.skeletalVertexOffset, header.numSkeletalVertices, data.skeletalVertices);
+    readBlob(is, pos, header.indexOffset, header.numIndices, data.indices);
+
+    std::vector<char> rigPath;
+    readBlob(is, pos, header.rigPathOffset, header.rigPathLength, rigPath);
+
+    if (!is) {
+        throw std::runtime_error("Unexpected end of binary geometry data");
+    }
+
+    if (!rigPath.empty()) {
+        data.rig = AssetReference<Rig>(AssetPath(std::string(rigPath.begin(), rigPath.end())));
+    }
+    data.triangleOrderOptimized = header.flags & kBinaryGeometryTriangleOrderOptimized;
+
+    return data;
+}
+
+
+
+auto BinaryGeometryView::make(std::span<const std::byte> data) -> std::optional<BinaryGeometryView>
+{
+    if (data.size() < sizeof(BinaryGeometryHeader)
+        || reinterpret_cast<uintptr_t>(data.data()) % kBinaryGeometryAlignment != 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto& header = *reinterpret_cast<const BinaryGeometryHeader*>(data.data());
+    const ui64 size = data.size();
+    if (!isValidHeader(header) || !blobsInRange(header, size)) {
+        return std::nullopt;
+    }
+
+    return BinaryGeometryView{ data };
+}
+
+BinaryGeometryView::BinaryGeometryView(std::span<const std::byte> data)
+    :
+    data(data)
+{
+}
+
+auto BinaryGeometryView::getHeader() const -> const BinaryGeometryHeader&
+{
+    return *reinterpret_cast<const BinaryGeometryHeader*>(data.data());
+}
+
+auto BinaryGeometryView::getVertexFormat() const -> VertexFormat
+{
+    return hasPackedVertices(getHeader()) ? VertexFormat::ePacked : VertexFormat::eFull;
+}
+
+auto BinaryGeometryView::getVertices() const -> std::span<const MeshVertex>
+{
+    const auto& header = getHeader();
+    if (hasPackedVertices(header)) {
+        return {};
+    }
+    return { reinterpret_cast<const MeshVertex*>(data.data() + header.vertexOffset),
+             header.numVertices };
+}
+
+auto BinaryGeometryView::getPackedVertices() const -> std::span<const PackedMeshVertex>
+{
+    const auto& header = getHeader();
+    if (!hasPackedVertices(header) || header.numVertices == 0) {
+        return {};
+    }
+    const auto begin = data.data() + header.vertexOffset + kBinaryGeometryQuantizationSize;
+    return { reinterpret_cast<const PackedMeshVertex*>(begin), header.numVertices };
+}
+
+auto BinaryGeometryView::getVertexQuantization() const -> VertexQuantization
+{
+    const auto& header = getHeader();
+    VertexQuantization res;
+    if (hasPackedVertices(header) && header.numVertices > 0) {
+        std::memcpy(&res, data.data() + header.vertexOffset, sizeof(VertexQuantization));
+    }
+    return res;
+}
+
+auto BinaryGeometryView::getSkeletalVertices() const -> std::span<const SkeletalVertex>
+{
+    const auto& header = getHeader();
+    return { reinterpret_cast<const SkeletalVertex*>(data.data() + header.skeletalVertexOffset),
+             header.numSkeletalVertices };
+}
+
+auto BinaryGeometryView::getIndices() const -> std::span<const VertexIndex>
+{
+    const auto& header = getHeader();
+    return { reinterpret_cast<const VertexIndex*>(data.data() + header.indexOffset),
+             header.numIndices };
+}
+
+bool BinaryGeometryView::hasRig() const
+{
+    return getHeader().rigPathLength > 0;
+}
+
+bool BinaryGeometryView::isTriangleOrderOptimized() const
+{
+    return getHeader().flags & kBinaryGeometryTriangleOrderOptimized;
+}
+
+auto BinaryGeometryView::getBounds() const -> GeometryBounds
+{
+    if (!hasBounds(getHeader()))
+    {
+        if (getVertexFormat() == VertexFormat::ePacked) {
+            return GeometryBounds::fromVertices(getPackedVertices(), getVertexQuantization());
+        }
+        return GeometryBounds::fromVertices(getVertices());
+    }
+
+    GeometryBounds res;
+    std::memcpy(&res, data.data() + sizeof(BinaryGeometryHeader), sizeof(GeometryBounds));
+    return res;
+}
+
+auto BinaryGeometryView::getAnimatedBounds() const -> std::optional<GeometryBounds>
+{
+    const auto& header = getHeader();
+    if (!hasBounds(header) || !(header.flags & kBinaryGeometryAnimatedBounds)) {
+        return std::nullopt;
+    }
+
+    GeometryBounds res;
+    std::memcpy(&res, data.data() + sizeof(BinaryGeometryHeader) + sizeof(GeometryBounds),
+                sizeof(GeometryBounds));
+    return res;
+}
+
+auto BinaryGeometryView::getRigPath() const -> std::string_view
+{
+    const auto& header = getHeader();
+    return { reinterpret_cast<const char*>(data.data() + header.rigPathOffset),
+             header.rigPathLength };
+}
+
+auto BinaryGeometryView::toGeometryData() const -> GeometryData
+{
+    GeometryData result{
+        .vertices{ getVertices().begin(), getVertices().end() },
+        .skeletalVertices{ getSkeletalVertices().begin(), getSkeletalVertices().end() },
+        .indices{ getIndices().begin(), getIndices().end() },
+        .packedVertices{ getPackedVertices().begin(), getPackedVertices().end() },
+        .quantization=getVertexQuantization(),
+        .triangleOrderOptimized=isTriangleOrderOptimized(),
+        .bounds=getBounds(),
+        .animatedBounds=getAnimatedBounds(),
+    };
+    if (hasRig()) {
+        result.rig = AssetReference<Rig>(AssetPath(std::string(getRigPath())));
+    }
+
+    return result;
+}
+
+} // namespace trc::internal
@@ -1,6 +1,10 @@
 #include "trc/assets/import/GeometryTransformations.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "trc/base/Logging.h"
+#include "trc/util/TriangleCacheOptimizer.h"
 
 
 
@@ -74,4 +78,138 @@ void computeTangents(GeometryData& result)
     log::info << result.indices.size() << " tangents and bitangents computed.";
 }
 
+bool optimizeTriangleOrder(GeometryData& geo)
+{
+    if (geo.triangleOrderOptimized) {
+        return true;
+    }
+    if (geo.indices.size() % 3 != 0)
+    {
+        log::warn << "Unable to optimize triangle order: mesh is not triangulated.";
+        return false;
+    }
+
+    try {
+        geo.indices = util::optimizeTriangleOrderingForsyth(geo.indices);
+        geo.triangleOrderOptimized = true;
+    }
+    catch (const std::invalid_argument& err) {
+        log::warn << "Unable to optimize triangle order: " << err.what();
+    }
+
+    return geo.triangleOrderOptimized;
+}
+
+void packVertexData(GeometryData& geo)
+{
+    if (geo.getVertexFormat() == VertexFormat::ePacked) {
+        return;
+    }
+
+    geo.quantization = VertexQuantization::fromBounds(geo.vertices);
+    geo.packedVertices = packVertices(geo.vertices, geo.quantization);
+    geo.vertices.clear();
+    geo.vertices.shrink_to_fit();
+}
+
+void unpackVertexData(GeometryData& geo)
+{
+    if (geo.getVertexFormat() != VertexFormat::ePacked) {
+        return;
+    }
+
+    geo.vertices = unpackVertices(geo.packedVertices, geo.quantization);
+    geo.packedVertices.clear();
+    geo.packedVertices.shrink_to_fit();
+    geo.quantization = {};
+}
+
+void computeBounds(GeometryData& geo)
+{
+    geo.bounds.reset();
+    geo.bounds = geo.getBounds();
+}
+
+void computeAnimatedBounds(GeometryData& geo, std::span<const AnimationData> animations)
+{
+    const size_t numVerts = geo.getVertexCount();
+    if (geo.skeletalVertices.empty() || geo.skeletalVertices.size() != numVerts) {
+        return;
+    }
+
+    auto getPosition = [&](size_t i) -> vec3 {
+        return geo.getVertexFormat() == VertexFormat::ePacked
+            ? geo.quantization.dequantize(geo.packedVertices[i].position)
+            : geo.vertices[i].position;
+    };
+
+    // Bind-pose box around the vertices that each bone influences
+    struct Box
+    {
+        vec3 min{ std::numeric_limits<float>::max() };
+        vec3 max{ std::numeric_limits<float>::lowest() };
+    };
+    std::vector<Box> boneBoxes;
+    for (size_t i = 0; i < numVerts; ++i)
+    {
+        const vec3 pos = getPosition(i);
+        const auto& skel = geo.skeletalVertices[i];
+        for (int j = 0; j < 4; ++j)
+        {
+            // The vertex shader stops at the first unused weight as well
+            if (skel.boneWeights[j] <= 0.0f) break;
+
+            const ui32 bone = skel.boneIndices[j];
+            if (bone >= boneBoxes.size()) {
+                boneBoxes.resize(bone + 1);
+            }
+            boneBoxes[bone].min = glm::min(boneBoxes[bone].min, pos);
+            boneBoxes[bone].max = glm::max(boneBoxes[bone].max, pos);
+        }
+    }
+
+    const GeometryBounds rest = geo.getBounds();
+    vec3 min = rest.min;
+    vec3 max = rest.max;
+
+    // Transform the bone boxes with every keyframe's bone matrices. The
+    // matrices already contain the inverse bind pose.
+    std::vector<mat4> frameMatrices;
+    for (const auto& anim : animations)
+    {
+        const ui32 numBones = anim.getBoneCount();
+        frameMatrices.resize(numBones);
+        for (ui32 frame = 0; frame < anim.frameCount; ++frame)
+        {
+            std::span<const mat4> bones;
+            if (anim.compressed)
+            {
+                anim.compressed->sampleFrame(frame, frameMatrices);
+                bones = frameMatrices;
+            }
+            else if (frame < anim.keyframes.size()) {
+                bones = anim.keyframes[frame].boneMatrices;
+            }
+
+            const size_t count = std::min(bones.size(), boneBoxes.size());
+            for (size_t bone = 0; bone < count; ++bone)
+            {
+                const Box& box = boneBoxes[bone];
+                if (box.min.x > box.max.x) continue;  // Bone has no vertices
+
+                const mat4& m = bones[bone];
+                const vec3 center = vec3(m * vec4((box.min + box.max) * 0.5f, 1.0f));
+                const vec3 halfExtent = (box.max - box.min) * 0.5f;
+                const vec3 extent = glm::abs(vec3(m[0])) * halfExtent.x
+                                  + glm::abs(vec3(m[1])) * halfExtent.y
+                                  + glm::abs(vec3(m[2])) * halfExtent.z;
+                min = glm::min(min, center - extent);
+                max = glm::max(max, center + extent);
+            }
+        }
+    }
+
+    geo.animatedBounds = GeometryBounds::fromBox(min, max);
+}
+
 } // namespace trc
@@ -1,5 +1,7 @@
 #include "trc/assets/import/InternalFormat.h"
 
+#include <algorithm>
+#include <functional>
 #include <string>
 
 #include "trc/assets/import/PNGConvert.h"
@@ -59,6 +61,58 @@ void writeMatrix(mat4 mat, google::protobuf::RepeatedField<float>* out)
 }
 
 
+void writeU16Array(const std::vector<ui16>& values, std::string* out)
+{
+    out->resize(values.size() * sizeof(ui16));
+    memcpy(out->data(), values.data(), out->size());
+}
+
+auto readU16Array(const std::string& buf) -> std::vector<ui16>
+{
+    std::vector<ui16> values(buf.size() / sizeof(ui16));
+    memcpy(values.data(), buf.data(), values.size() * sizeof(ui16));
+    return values;
+}
+
+void writeTrack(const CompressedAnimation::Track& track, serial::CompressedAnimation::Track* out)
+{
+    writeU16Array(track.frames, out->mutable_frames());
+    writeU16Array(track.values, out->mutable_values());
+    for (int i = 0; i < 3; ++i)
+    {
+        out->add_range_min(track.rangeMin[i]);
+        out->add_range_extent(track.rangeExtent[i]);
+    }
+}
+
+auto readTrack(const serial::CompressedAnimation::Track& track) -> CompressedAnimation::Track
+{
+    CompressedAnimation::Track out{
+        .frames=readU16Array(track.frames()),
+        .values=readU16Array(track.values()),
+    };
+    if (out.frames.empty()) {
+        throw std::runtime_error("Compressed animation track has no keys");
+    }
+    if (out.values.size() != out.frames.size() * 3)
+    {
+        throw std::runtime_error("Number of values in compressed animation track does not"
+                                 " match its number of keys");
+    }
+    if (std::ranges::adjacent_find(out.frames, std::greater_equal{}) != out.frames.end()) {
+        throw std::runtime_error("Keys of compressed animation track are not strictly increasing");
+    }
+    for (int i = 0; i < std::min(3, track.range_min_size()); ++i) {
+        out.rangeMin[i] = track.range_min(i);
+    }
+    for (int i = 0; i < std::min(3, track.range_extent_size()); ++i) {
+        out.rangeExtent[i] = track.range_extent(i);
+    }
+
+    return out;
+}
+
+
 
 template<typename T>
 void assignRef(serial::AssetReference* dst, const AssetReference<T>& src)
@@ -81,14 +135,21 @@ namespace internal
 auto serializeAssetData(const GeometryData& data) -> trc::serial::Geometry
 {
     assert(data.skeletalVertices.empty()
-           || data.skeletalVertices.size() == data.vertices.size());
+           || data.skeletalVertices.size() == data.getVertexCount());
+
+    // The protobuf format has no packed vertex representation
+    const std::vector<trc::MeshVertex> unpackedVertices
+        = trc::unpackVertices(data.packedVertices, data.quantization);
+    const auto& vertices = data.getVertexFormat() == trc::VertexFormat::ePacked
+        ? unpackedVertices
+        : data.vertices;
 
     trc::serial::Geometry geo;
     for (uint32_t idx : data.indices)
     {
         geo.add_indices(idx);
     }
-    for (const trc::MeshVertex& v : data.vertices)
+    for (const trc::MeshVertex& v : vertices)
     {
         trc::serial::Geometry::Vertex* newVert = geo.add_vertices();
         newVert->mutable_position()->set_x(v.position.x);
@@ -119,6 +180,7 @@ auto serializeAssetData(const GeometryData& data) -> trc::serial::Geometry
     if (data.rig.hasAssetPath()) {
         assignRef(geo.mutable_rig(), data.rig);
     }
+    geo.set_triangle_order_optimized(data.triangleOrderOptimized);
 
     return geo;
 }
@@ -157,6 +219,7 @@ auto deserializeAssetData(const trc::serial::Geometry& geo) -> GeometryData
     if (geo.has_rig()) {
         data.rig = toRef<Rig>(geo.rig());
     }
+    data.triangleOrderOptimized = geo.triangle_order_optimized();
 
     assert(data.skeletalVertices.empty()
            || data.skeletalVertices.size() == data.vertices.size());
@@ -168,6 +231,23 @@ auto serializeAssetData(const TextureData& data) -> trc::serial::Texture
 {
     trc::serial::Texture tex;
 
+    // Store pre-encoded data verbatim if available
+    if (!data.mipLevels.empty())
+    {
+        tex.set_format(static_cast<serial::Texture::Format>(data.format));
+        for (const auto& level : data.mipLevels)
+        {
+            assert(level.data.size() == getTextureDataSize(data.format, level.size));
+
+            auto newLevel = tex.add_mip_levels();
+            newLevel->set_width(level.size.x);
+            newLevel->set_height(level.size.y);
+            newLevel->set_data(level.data.data(), level.data.size());
+        }
+
+        return tex;
+    }
+
     auto image = tex.mutable_image();
     image->set_width(data.size.x);
     image->set_height(data.size.y);
@@ -181,6 +261,29 @@ auto deserializeAssetData(const trc::serial::Texture& tex) -> TextureData
 {
     TextureData data;
 
+    if (tex.mip_levels_size() > 0)
+    {
+        if (!serial::Texture::Format_IsValid(tex.format())) {
+            throw std::runtime_error("Unknown texture format " + std::to_string(tex.format()));
+        }
+
+        data.format = static_cast<TextureFormat>(tex.format());
+        data.size = { tex.mip_levels(0).width(), tex.mip_levels(0).height() };
+
+        data.mipLevels.reserve(tex.mip_levels_size());
+        for (const auto& level : tex.mip_levels())
+        {
+            const auto* begin = reinterpret_cast<const ui8*>(level.data().data());
+            data.mipLevels.push_back({
+                { level.width(), level.height() },
+                { begin, begin + level.data().size() }
+            });
+        }
+        validateMipChain(data.format, data.mipLevels);
+
+        return data;
+    }
+
     const std::string& png = tex.image().pixel_data_png();
     data = fromPNG(png.data(), png.size());
     assert(data.size.x == tex.image().width() && data.size.y == tex.image().height());
@@ -286,14 +389,28 @@ auto deserializeAssetData(const serial::Rig& rig) -> RigData
 
 auto serializeAssetData(const AnimationData& anim)  -> serial::Animation
 {
-    assert(anim.frameCount == anim.keyframes.size());
-
     serial::Animation out;
 
     out.set_frame_count(anim.frameCount);
     out.set_duration(anim.durationMs);
     out.set_time_per_frame(anim.frameTimeMs);
 
+    if (anim.compressed)
+    {
+        assert(anim.frameCount == anim.compressed->frameCount);
+        auto dst = out.mutable_compressed();
+        for (const auto& bone : anim.compressed->bones)
+        {
+            auto newBone = dst->add_bones();
+            writeTrack(bone.translation, newBone->mutable_translation());
+            writeTrack(bone.rotation, newBone->mutable_rotation());
+            writeTrack(bone.scale, newBone->mutable_scale());
+        }
+
+        return out;
+    }
+
+    assert(anim.frameCount == anim.keyframes.size());
     for (const auto& kf : anim.keyframes)
     {
         auto dst = out.add_keyframes()->mutable_bone_transform_matrices();
@@ -309,14 +426,30 @@ auto serializeAssetData(const AnimationData& anim)  -> serial::Animation
 
 auto deserializeAssetData(const serial::Animation& tex) -> AnimationData
 {
-    assert(tex.keyframes_size() == static_cast<i32>(tex.frame_count()));
-
     AnimationData out;
 
     out.frameCount = tex.frame_count();
     out.durationMs = tex.duration();
     out.frameTimeMs = tex.time_per_frame();
 
+    if (tex.has_compressed())
+    {
+        auto& compressed = out.compressed.emplace();
+        compressed.frameCount = tex.frame_count();
+        for (const auto& bone : tex.compressed().bones())
+        {
+            compressed.bones.push_back({
+                .translation=readTrack(bone.translation()),
+                .rotation=readTrack(bone.rotation()),
+                .scale=readTrack(bone.scale()),
+            });
+        }
+
+        return out;
+    }
+
+    assert(tex.keyframes_size() == static_cast<i32>(tex.frame_count()));
+
     for (const auto& kf : tex.keyframes())
     {
         assert((kf.bone_transform_matrices_size() % 16) == 0);
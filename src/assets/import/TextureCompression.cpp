@@ -0,0 +1,298 @@
+#include "trc/assets/import/TextureCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+
+namespace trc
+{
+
+namespace
+{
+    using Block = std::array<glm::u8vec4, 16>;
+
+    constexpr ui32 kBlockSize{ 4 };
+
+    auto fetchBlock(uvec2 size, const ui8* rgbaPixels, ui32 blockX, ui32 blockY) -> Block
+    {
+        Block block;
+        for (ui32 y = 0; y < kBlockSize; ++y)
+        {
+            for (ui32 x = 0; x < kBlockSize; ++x)
+            {
+                // Repeat edge pixels for blocks that exceed the image bounds
+                const ui32 px = std::min(blockX * kBlockSize + x, size.x - 1);
+                const ui32 py = std::min(blockY * kBlockSize + y, size.y - 1);
+                std::memcpy(&block[y * kBlockSize + x], rgbaPixels + (size_t{py} * size.x + px) * 4, 4);
+            }
+        }
+
+        return block;
+    }
+
+    auto toRGB565(ivec3 c) -> ui16
+    {
+        return static_cast<ui16>(((c.r * 31 + 127) / 255) << 11
+                               | ((c.g * 63 + 127) / 255) << 5
+                               | ((c.b * 31 + 127) / 255));
+    }
+
+    auto fromRGB565(ui16 c) -> ivec3
+    {
+        const int r = (c >> 11) & 31;
+        const int g = (c >> 5) & 63;
+        const int b = c & 31;
+        return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+    }
+
+    void writeLE16(ui8* dst, ui16 val)
+    {
+        dst[0] = static_cast<ui8>(val);
+        dst[1] = static_cast<ui8>(val >> 8);
+    }
+
+    /**
+     * Encode the color part of a block in the BC1 format. Uses the
+     * bounding box of the block's colors as endpoints.
+     *
+     * @param bool allowAlpha Enables BC1's three-color mode for blocks with
+     *                        transparent pixels. Must be false for the
+     *                        color part of BC3 blocks.
+     */
+    void encodeColorBlock(const Block& block, bool allowAlpha, ui8* dst)
+    {
+        ivec3 minColor{ 255 };
+        ivec3 maxColor{ 0 };
+        bool hasTransparency{ false };
+        for (const auto& px : block)
+        {
+            if (allowAlpha && px.a < 128)
+            {
+                hasTransparency = true;
+                continue;
+            }
+            minColor = glm::min(minColor, ivec3(px));
+            maxColor = glm::max(maxColor, ivec3(px));
+        }
+        if (glm::any(glm::greaterThan(minColor, maxColor))) {  // All pixels are transparent
+            minColor = maxColor = ivec3(0);
+        }
+
+        ui16 c0 = toRGB565(maxColor);
+        ui16 c1 = toRGB565(minColor);
+
+        // Four-color mode requires c0 > c1, three-color mode c0 <= c1
+        if (hasTransparency ? c0 > c1 : c0 < c1) {
+            std::swap(c0, c1);
+        }
+
+        std::array<ivec3, 4> palette{ fromRGB565(c0), fromRGB565(c1) };
+        ui32 numColors = 4;
+        if (hasTransparency)
+        {
+            palette[2] = (palette[0] + palette[1]) / 2;
+            numColors = 3;
+        }
+        else
+        {
+            palette[2] = (2 * palette[0] + palette[1]) / 3;
+            palette[3] = (palette[0] + 2 * palette[1]) / 3;
+        }
+
+        ui32 indices{ 0 };
+        if (c0 != c1 || hasTransparency)
+        {
+            for (ui32 i = 0; i < block.size(); ++i)
+            {
+                ui32 best{ 0 };
+                if (hasTransparency && block[i].a < 128) {
+                    best = 3;
+                }
+                else
+                {
+                    int bestDist = std::numeric_limits<int>::max();
+                    for (ui32 p = 0; p < numColors; ++p)
+                    {
+                        const ivec3 d = ivec3(block[i]) - palette[p];
+                        const int dist = d.x * d.x + d.y * d.y + d.z * d.z;
+                        if (dist < bestDist)
+                        {
+                            bestDist = dist;
+                            best = p;
+                        }
+                    }
+                }
+                indices |= best << (i * 2);
+            }
+        }
+
+        writeLE16(dst, c0);
+        writeLE16(dst + 2, c1);
+        for (ui32 i = 0; i < 4; ++i) {
+            dst[4 + i] = static_cast<ui8>(indices >> (i * 8));
+        }
+    }
+
+    /**
+     * Encode a single channel of a block in the BC4 format (the format of
+     * BC3's alpha block and BC5's channels).
+     */
+    void encodeChannelBlock(const Block& block, ui32 channel, ui8* dst)
+    {
+        int minVal{ 255 };
+        int maxVal{ 0 };
+        for (const auto& px : block)
+        {
+            minVal = std::min(minVal, int{px[channel]});
+            maxVal = std::max(maxVal, int{px[channel]});
+        }
+
+        // Eight-value mode (a0 > a1)
+        std::array<int, 8> palette{ maxVal, minVal };
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * maxVal + i * minVal) / 7;
+        }
+
+        ui64 indices{ 0 };
+        if (maxVal != minVal)
+        {
+            for (ui32 i = 0; i < block.size(); ++i)
+            {
+                ui64 best{ 0 };
+                int bestDist = std::numeric_limits<int>::max();
+                for (ui32 p = 0; p < palette.size(); ++p)
+                {
+                    const int dist = std::abs(int{block[i][channel]} - palette[p]);
+                    if (dist < bestDist)
+                    {
+                        bestDist = dist;
+                        best = p;
+                    }
+                }
+                indices |= best << (i * 3);
+            }
+        }
+
+        dst[0] = static_cast<ui8>(maxVal);
+        dst[1] = static_cast<ui8>(minVal);
+        for (ui32 i = 0; i < 6; ++i) {
+            dst[2 + i] = static_cast<ui8>(indices >> (i * 8));
+        }
+    }
+} // anonymous namespace
+
+auto generateMipChain(uvec2 size, const std::vector<glm::u8vec4>& pixels)
+    -> std::vector<TextureMipLevel>
+{
+    assert(pixels.size() == size_t{size.x} * size.y);
+
+    std::vector<TextureMipLevel> levels;
+    levels.push_back({ size, std::vector<ui8>(pixels.size() * 4) });
+    std::memcpy(levels.back().data.data(), pixels.data(), levels.back().data.size());
+
+    while (levels.back().size.x > 1 || levels.back().size.y > 1)
+    {
+        const auto& src = levels.back();
+        const uvec2 dstSize = glm::max(src.size / 2u, uvec2(1));
+
+        TextureMipLevel dst{ dstSize, std::vector<ui8>(size_t{dstSize.x} * dstSize.y * 4) };
+        for (ui32 y = 0; y < dstSize.y; ++y)
+        {
+            for (ui32 x = 0; x < dstSize.x; ++x)
+            {
+                // 2x2 box filter; clamp at the edges of odd-sized levels
+                const ui32 x0 = std::min(x * 2, src.size.x - 1);
+                const ui32 x1 = std::min(x * 2 + 1, src.size.x - 1);
+                const ui32 y0 = std::min(y * 2, src.size.y - 1);
+                const ui32 y1 = std::min(y * 2 + 1, src.size.y - 1);
+                for (ui32 c = 0; c < 4; ++c)
+                {
+                    auto at = [&](ui32 px, ui32 py) -> ui32 {
+                        return src.data[(size_t{py} * src.size.x + px) * 4 + c];
+                    };
+                    const ui32 sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                    dst.data[(size_t{y} * dstSize.x + x) * 4 + c] = static_cast<ui8>((sum + 2) / 4);
+                }
+            }
+        }
+
+        levels.emplace_back(std::move(dst));
+    }
+
+    return levels;
+}
+
+auto encodeImage(TextureFormat format, uvec2 size, const ui8* rgbaPixels) -> std::vector<ui8>
+{
+    std::vector<ui8> result(getTextureDataSize(format, size));
+    if (format == TextureFormat::eRGBA8)
+    {
+        std::memcpy(result.data(), rgbaPixels, result.size());
+        return result;
+    }
+
+    const uvec2 numBlocks = (size + kBlockSize - 1u) / kBlockSize;
+    const size_t blockBytes = result.size() / (size_t{numBlocks.x} * numBlocks.y);
+
+    for (ui32 by = 0; by < numBlocks.y; ++by)
+    {
+        for (ui32 bx = 0; bx < numBlocks.x; ++bx)
+        {
+            const Block block = fetchBlock(size, rgbaPixels, bx, by);
+            ui8* dst = result.data() + (size_t{by} * numBlocks.x + bx) * blockBytes;
+            switch (format)
+            {
+            case TextureFormat::eBC1:
+                encodeColorBlock(block, true, dst);
+                break;
+            case TextureFormat::eBC3:
+                encodeChannelBlock(block, 3, dst);
+                encodeColorBlock(block, false, dst + 8);
+                break;
+            case TextureFormat::eBC5:
+                encodeChannelBlock(block, 0, dst);
+                encodeChannelBlock(block, 1, dst + 8);
+                break;
+            default:
+                throw std::invalid_argument("[In encodeImage]: No encoder available for texture"
+                                            " format " + std::to_string(static_cast<ui32>(format)));
+            }
+        }
+    }
+
+    return result;
+}
+
+auto encodeTexture(const TextureData& tex, TextureFormat format, bool generateMipmaps)
+    -> TextureData
+{
+    std::vector<TextureMipLevel> levels;
+    if (generateMipmaps) {
+        levels = generateMipChain(tex.size, tex.pixels);
+    }
+    else
+    {
+        auto& base = levels.emplace_back(tex.size, std::vector<ui8>(tex.pixels.size() * 4));
+        std::memcpy(base.data.data(), tex.pixels.data(), base.data.size());
+    }
+
+    for (auto& level : levels) {
+        level.data = encodeImage(format, level.size, level.data.data());
+    }
+
+    return TextureData{
+        .size=tex.size,
+        .pixels={},
+        .format=format,
+        .mipLevels=std::move(levels),
+    };
+}
+
+} // namespace trc
@@ -123,7 +123,7 @@ auto trc::Image::getDefaultSampler() const -> vk::Sampler
                 0.0f,                                             // mip LOD bias
                 true, 8.0f,                                       // anisotropy
                 false, vk::CompareOp::eNever,                     // depth compare
-                0.0f, 0.0f,                                       // min/max LOD
+                0.0f, VK_LOD_CLAMP_NONE,                          // min/max LOD
                 vk::BorderColor::eFloatOpaqueWhite,
                 false                                             // unnormalized coordinates?
             )
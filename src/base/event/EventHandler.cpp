@@ -9,6 +9,17 @@
 namespace trc
 {
 
+void EventQueue<MouseMoveEvent>::push(Type& queue, MouseMoveEvent&& event)
+{
+    if (!queue.try_push(event))
+    {
+        // Never block the producer. If a concurrent producer fills the
+        // freed slot first, drop the new event instead.
+        queue.try_pop();
+        queue.try_push(event);
+    }
+}
+
 void InputEventSpawner::onCharInput(Swapchain& swapchain, uint32_t charcode)
 {
     EventHandler<CharInputEvent>::notify({ &swapchain, charcode });
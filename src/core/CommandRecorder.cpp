@@ -1,6 +1,6 @@
 #include "trc/core/CommandRecorder.h"
 
-#include <future>
+#include <optional>
 
 #include <trc_util/algorithm/VectorTransform.h>
 
@@ -101,52 +101,50 @@ auto CommandRecorder::record(Frame& frame) -> std::vector<vk::CommandBuffer>
     // Each viewport has its own list of command buffer recordings (one command
     // buffer for each render stage) that define resource dependencies among
     // each other.
-    std::vector<std::future<StageRecording>> futures;
-    futures.reserve(numCmdBufs);
+    std::vector<RenderStage::ID> stages;
+    stages.reserve(numCmdBufs);
+    for (const RenderStage::ID stage : frame.getRenderGraph()) {
+        stages.emplace_back(stage);
+    }
+    std::vector<std::optional<StageRecording>> recordings(stages.size());
 
-    // For each render stage, dispatch one thread that executes its tasks.
-    ui32 threadIndex = 0;
-    for (const RenderStage::ID stage : frame.getRenderGraph())
+    // Record each render stage's tasks in parallel. The calling thread
+    // records stages as well instead of idling until the workers are done.
+    threadPool->parallelFor(size_t{0}, stages.size(), size_t{1}, [&](size_t i)
     {
-        vk::CommandBuffer cmdBuf = *cmdBuffers.at(threadIndex);
+        const RenderStage::ID stage = stages[i];
+        vk::CommandBuffer cmdBuf = *cmdBuffers.at(i);
+
+        auto deps = std::make_shared<DependencyRegion>();
+        DeviceExecutionContext ctx = frame.makeTaskExecutionContext(deps);
 
-        // Record all tasks in the stage's task queue
-        futures.emplace_back(threadPool->async(
-            [&frame, stage, cmdBuf]() -> StageRecording
+        cmdBuf.begin({ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+        for (auto& task : frame.iterTasks(stage))
+        {
+            try {
+                task.record(cmdBuf, ctx);
+            }
+            catch (const std::exception& err)
             {
-                auto deps = std::make_shared<DependencyRegion>();
-                DeviceExecutionContext ctx = frame.makeTaskExecutionContext(deps);
-
-                cmdBuf.begin({ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
-                for (auto& task : frame.iterTasks(stage))
-                {
-                    try {
-                        task.record(cmdBuf, ctx);
-                    }
-                    catch (const std::exception& err)
-                    {
-                        log::error << "A render task in stage " << stage
-                                   << " threw an error during recording."
-                                   << " All commands of the task will be discarded."
-                                   << " Error: " << err.what();
-                        continue;
-                    }
-                }
-
-                // We do NOT end the command buffer here! This is done in
-                // `finalizeCmdBuffers` because additional pipeline barriers
-                // need to be recorded at the end of command buffers.
-
-                return { stage, cmdBuf, std::move(*deps) };
+                log::error << "A render task in stage " << stage
+                           << " threw an error during recording."
+                           << " All commands of the task will be discarded."
+                           << " Error: " << err.what();
+                continue;
             }
-        ));
-        ++threadIndex;
-    }
+        }
+
+        // We do NOT end the command buffer here! This is done in
+        // `finalizeCmdBuffers` because additional pipeline barriers
+        // need to be recorded at the end of command buffers.
+
+        recordings[i] = StageRecording{ stage, cmdBuf, std::move(*deps) };
+    });
 
-    // Join threads and finalize the recorded command buffers
+    // Finalize the recorded command buffers
     std::vector<StageRecording> recs;
-    recs.reserve(futures.size());
-    for (auto& f : futures) recs.emplace_back(f.get());
+    recs.reserve(recordings.size());
+    for (auto& rec : recordings) recs.emplace_back(std::move(*rec));
 
     return finalizeCmdBuffers(std::move(recs));
 }
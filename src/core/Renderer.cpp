@@ -220,7 +220,7 @@ void trc::Renderer::submitDraw(
     queue.waitSubmit(submit.get(), signalFence);
 
     // Dispatch asynchronous handler for when the frame has finished rendering
-    threadPool.async(RenderFinishedHandler{
+    threadPool.execute(RenderFinishedHandler{
         device,
         **renderFinishedHostSignalSemaphores,
         *renderFinishedHostSignalValue,
@@ -8,11 +8,30 @@
 namespace trc
 {
 
+namespace
+{
+    /** Matches the layout of `VertexDequantization` in vertex_packing.glsl */
+    struct VertexDequantizationDeviceData
+    {
+        vec4 positionOffset;
+        vec4 positionScale;
+    };
+
+    /** Offset of the dequantization transform in the shadow push constants */
+    constexpr ui32 kShadowDequantizationOffset{ 96 };
+
+    auto toDeviceData(const VertexQuantization& quant) -> VertexDequantizationDeviceData
+    {
+        return { vec4(quant.offset, 0.0f), vec4(quant.scale, 0.0f) };
+    }
+} // anonymous namespace
+
 auto DrawablePipelineInfo::toPipelineFlags() const -> pipelines::DrawableBasePipelineTypeFlags
 {
     pipelines::DrawableBasePipelineTypeFlags flags;
     assert(flags.get<pipelines::AnimationTypeFlagBits>() == pipelines::AnimationTypeFlagBits::none);
     assert(flags.get<pipelines::PipelineShadingTypeFlagBits>() == pipelines::PipelineShadingTypeFlagBits::opaque);
+    assert(flags.get<pipelines::VertexFormatFlagBits>() == pipelines::VertexFormatFlagBits::full);
 
     if (transparent) {
         flags |= pipelines::PipelineShadingTypeFlagBits::transparent;
@@ -20,6 +39,9 @@ auto DrawablePipelineInfo::toPipelineFlags() const -> pipelines::DrawableBasePip
     if (animated) {
         flags |= pipelines::AnimationTypeFlagBits::boneAnim;
     }
+    if (packedVertices) {
+        flags |= pipelines::VertexFormatFlagBits::packed;
+    }
 
     return flags;
 }
@@ -46,6 +68,13 @@ auto makeGBufferDrawFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> Drawable
                 drawInfo->anim.get()
             );
         }
+        if (drawInfo->geo.getVertexFormat() == VertexFormat::ePacked)
+        {
+            material.pushConstants(
+                cmdBuf, layout, DrawablePushConstIndex::eVertexDequantization,
+                toDeviceData(drawInfo->geo.getVertexQuantization())
+            );
+        }
         material.uploadPushConstantDefaultValues(cmdBuf, layout);
 
         drawInfo->geo.bindVertices(cmdBuf, 0);
@@ -71,10 +100,41 @@ auto makeShadowDrawFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> DrawableF
                 drawInfo->anim.get()
             );
         }
+        if (drawInfo->geo.getVertexFormat() == VertexFormat::ePacked)
+        {
+            cmdBuf.pushConstants<VertexDequantizationDeviceData>(
+                layout, vk::ShaderStageFlagBits::eVertex, kShadowDequantizationOffset,
+                toDeviceData(drawInfo->geo.getVertexQuantization())
+            );
+        }
 
         // Draw
         cmdBuf.drawIndexed(drawInfo->geo.getIndexCount(), 1, 0, 0, 0);
     };
 }
 
+auto makeBoundsFunction(s_ptr<DrawableRasterDrawInfo> drawInfo) -> DrawableBoundsFunction
+{
+    // Skinned geometry may be drawn anywhere if its animated bounds are
+    // unknown, so it is never culled
+    if (!drawInfo->geo.getAnimatedBounds()) {
+        return {};
+    }
+
+    return [drawInfo]() -> vec4
+    {
+        // Equal to the rest-pose bounds for geometries without a skeleton
+        const GeometryBounds& bounds = *drawInfo->geo.getAnimatedBounds();
+        const mat4 model = drawInfo->modelMatrixId.get();
+
+        // Scale the radius by the largest axis scaling of the transform
+        const float maxScale2 = glm::max(glm::dot(vec3(model[0]), vec3(model[0])),
+                                glm::max(glm::dot(vec3(model[1]), vec3(model[1])),
+                                         glm::dot(vec3(model[2]), vec3(model[2]))));
+
+        return vec4(vec3(model * vec4(bounds.center, 1.0f)),
+                    bounds.radius * glm::sqrt(maxScale2));
+    };
+}
+
 } // namespace trc
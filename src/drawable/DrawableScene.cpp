@@ -14,15 +14,36 @@ DrawableScene::DrawableScene()
     registerModule(std::make_unique<RasterSceneModule>());
     registerModule(std::make_unique<RaySceneModule>());
     registerModule(std::make_unique<LightSceneModule>());
+
+    // Update transformations in the node tree
+    auto transforms = updateGraph.addJob([this]{ updateTransforms(); });
+    updateGraph.addJob([this]{ updateAnimations(currentTimeDelta); });
+    updateGraph.addContinuation(transforms, [this]{ updateRayInstances(); });
 }
 
 void DrawableScene::update(float timeDeltaMs)
 {
-    // Update transformations in the node tree
-    root.updateAsRoot();
+    currentTimeDelta = timeDeltaMs;
+    currentThreads = nullptr;
+    updateGraph.execute();
+}
+
+void DrawableScene::update(float timeDeltaMs, async::ThreadPool& threads)
+{
+    currentTimeDelta = timeDeltaMs;
+    currentThreads = &threads;
+    updateGraph.execute(threads);
+    currentThreads = nullptr;
+}
 
-    updateAnimations(timeDeltaMs);
-    updateRayInstances();
+void DrawableScene::updateTransforms()
+{
+    if (currentThreads != nullptr) {
+        root.updateAsRoot(*currentThreads);
+    }
+    else {
+        root.updateAsRoot();
+    }
 }
 
 void DrawableScene::updateAnimations(const float timeDelta)
@@ -17,6 +17,7 @@ trc::RasterComponent::RasterComponent(const RasterComponentCreateInfo& createInf
         .mat=matHandle,
         .matRuntime=matHandle.getRuntime({
             .animated=geoHandle.hasRig() && createInfo.anim != AnimationEngine::ID::NONE,
+            .packedVertices=geoHandle.getVertexFormat() == VertexFormat::ePacked,
         }),
         .modelMatrixId=createInfo.modelMatrixId,
         .anim=createInfo.anim,
@@ -36,6 +37,7 @@ void componentlib::ComponentTraits<trc::RasterComponent>::onCreate(
     const DrawablePipelineInfo pipelineInfo{
         .animated=comp.drawInfo->geo.hasRig(),
         .transparent=comp.drawInfo->mat.isTransparent(),
+        .packedVertices=comp.drawInfo->geo.getVertexFormat() == VertexFormat::ePacked,
     };
     RasterSceneBase& base = scene.getRasterModule();
 
@@ -46,7 +48,8 @@ void componentlib::ComponentTraits<trc::RasterComponent>::onCreate(
             stages::gBuffer,
             pipelineInfo.transparent ? SubPasses::transparency : SubPasses::gBuffer,
             comp.drawInfo->matRuntime.getPipeline(),
-            makeGBufferDrawFunction(comp.drawInfo)
+            makeGBufferDrawFunction(comp.drawInfo),
+            makeBoundsFunction(comp.drawInfo)
         )
     );
     comp.drawFuncs.emplace_back(
@@ -54,7 +57,8 @@ void componentlib::ComponentTraits<trc::RasterComponent>::onCreate(
             stages::shadow,
             SubPass::ID(0),
             pipelineInfo.determineShadowPipeline(),
-            makeShadowDrawFunction(comp.drawInfo)
+            makeShadowDrawFunction(comp.drawInfo),
+            makeBoundsFunction(comp.drawInfo)
         )
     );
 }
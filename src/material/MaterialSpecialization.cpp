@@ -1,5 +1,8 @@
 #include "trc/material/MaterialSpecialization.h"
 
+#include <stdexcept>
+#include <string>
+
 #include "trc/material/TorchMaterialSettings.h"
 #include "trc/material/VertexShader.h"
 
@@ -12,7 +15,7 @@ auto makeDeferredMaterialSpecialization(const shader::ShaderModule& fragmentModu
                                         const MaterialSpecializationInfo& info)
     -> shader::ShaderProgramData
 {
-    auto vertexModule = VertexModule{ info.animated }.build(fragmentModule);
+    auto vertexModule = VertexModule{ info.animated, info.packedVertices }.build(fragmentModule);
     return shader::linkShaderProgram(
         {
             { vk::ShaderStageFlagBits::eVertex,   std::move(vertexModule) },
@@ -43,8 +46,15 @@ MaterialSpecializationCache::MaterialSpecializationCache(
     :
     base(std::nullopt)
 {
-    for (const auto& [i, prog] : std::views::enumerate(serial.specializations())) {
-        shaderPrograms.at(i)->deserialize(prog.shader_program(), des);
+    // Materials serialized before a specialization flag existed lack the
+    // specializations that set it, so index by flags instead of position.
+    for (const auto& spec : serial.specializations())
+    {
+        const MaterialKey key{ MaterialSpecializationInfo{
+            .animated=spec.animated(),
+            .packedVertices=spec.packed_vertices(),
+        }};
+        shaderPrograms.at(key.toUniqueIndex()).emplace().deserialize(spec.shader_program(), des);
     }
 }
 
@@ -81,12 +91,16 @@ void MaterialSpecializationCache::serialize(serial::MaterialProgramSpecializatio
     out.clear_specializations();
     for (const auto& [i, prog] : std::views::enumerate(shaderPrograms))
     {
-        assert(prog || base);  // The constructor interface is designed in a way
-                               // that this should always be true.
+        // Specializations missing from a deserialized material cannot be
+        // created, but the available ones are preserved
+        if (!prog && !base) {
+            continue;
+        }
 
         const auto key = MaterialKey::fromUniqueIndex(i);
         auto newSpec = out.add_specializations();
         newSpec->set_animated(key.flags & MaterialKey::Flags::Animated::eTrue);
+        newSpec->set_packed_vertices(key.flags & MaterialKey::Flags::PackedVertices::eTrue);
 
         if (prog) {
             *newSpec->mutable_shader_program() = prog->serialize();
@@ -105,8 +119,17 @@ auto MaterialSpecializationCache::getOrCreateSpecialization(const MaterialKey& k
     auto& program = shaderPrograms[key.toUniqueIndex()];
     if (!program)
     {
-        assert(base);  // The constructor interface is designed in a way that
-                       // this should always be true.
+        if (!base)
+        {
+            const auto info = key.toSpecializationInfo();
+            throw std::out_of_range(
+                "[In MaterialSpecializationCache::getSpecialization]: The material has no"
+                " specialization for animated=" + std::to_string(info.animated)
+                + ", packedVertices=" + std::to_string(info.packedVertices) + ". It was"
+                " probably serialized by an older version. Re-import the material to"
+                " create all specializations."
+            );
+        }
         program = createSpecialization(*base, key);
     }
 
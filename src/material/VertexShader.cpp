@@ -83,7 +83,9 @@ public:
 
 
 
-VertexModule::VertexModule(bool animated)
+VertexModule::VertexModule(bool animated, bool packedVertices)
+    :
+    packedVertices(packedVertices)
 {
     auto tbn = [this, animated]() -> code::Value {
         auto zero = builder.makeConstant(0.0f);
@@ -165,15 +167,15 @@ auto VertexModule::build(const shader::ShaderModule& fragment) && -> shader::Sha
     return ShaderModuleCompiler{}.compile(
         shaderOutput,
         std::move(builder),
-        makeVertexCapabilityConfig()
+        makeVertexCapabilityConfig(packedVertices)
     );
 }
 
-auto VertexModule::makeVertexCapabilityConfig() -> shader::CapabilityConfig
+auto VertexModule::makeVertexCapabilityConfig(bool packedVertices) -> shader::CapabilityConfig
 {
     using shader::CapabilityConfig;
 
-    static auto config = []{
+    auto makeConfig = [](bool packedVertices){
         CapabilityConfig config;
         auto& code = config.getCodeBuilder();
 
@@ -225,17 +227,61 @@ auto VertexModule::makeVertexCapabilityConfig() -> shader::CapabilityConfig
         config.linkCapability(VertexCapability::kAnimMetaBuffer, animMeta);
         config.linkCapability(VertexCapability::kAnimDataBuffer, animBuffer);
 
-        auto vPos     = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 0 });
-        auto vNormal  = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 1 });
-        auto vUV      = config.addResource(CapabilityConfig::ShaderInput{ vec2{}, 2 });
-        auto vTangent = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 3 });
         auto vBoneIndices = config.addResource(CapabilityConfig::ShaderInput{ uvec4{}, 4 });
         auto vBoneWeights = config.addResource(CapabilityConfig::ShaderInput{ vec4{}, 5 });
+        if (!packedVertices)
+        {
+            auto vPos     = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 0 });
+            auto vNormal  = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 1 });
+            auto vUV      = config.addResource(CapabilityConfig::ShaderInput{ vec2{}, 2 });
+            auto vTangent = config.addResource(CapabilityConfig::ShaderInput{ vec3{}, 3 });
+
+            config.linkCapability(VertexCapability::kPosition, vPos);
+            config.linkCapability(VertexCapability::kNormal, vNormal);
+            config.linkCapability(VertexCapability::kTangent, vTangent);
+            config.linkCapability(VertexCapability::kUV, vUV);
+        }
+        else
+        {
+            // See PackedMeshVertex. Attributes are decoded with the
+            // functions in vertex_packing.glsl.
+            const util::Pathlet packingInclude("material_utils/vertex_packing.glsl");
+
+            auto vPos     = config.addResource(CapabilityConfig::ShaderInput{ uvec4{}, 0 });
+            auto vNormal  = config.addResource(CapabilityConfig::ShaderInput{ ivec2{}, 1 });
+            auto vUV      = config.addResource(CapabilityConfig::ShaderInput{ vec2{}, 2 });
+            auto vTangent = config.addResource(CapabilityConfig::ShaderInput{ ivec2{}, 3 });
+            auto dequantPc = config.addResource(CapabilityConfig::PushConstant{
+                code.makeStructType("VertexDequantization", {
+                    { vec4{}, "positionOffset" },
+                    { vec4{}, "positionScale" },
+                }),
+                DrawablePushConstIndex::eVertexDequantization
+            });
+            config.addShaderInclude(dequantPc, packingInclude);
+            config.addShaderInclude(vNormal, packingInclude);
+            config.addShaderInclude(vTangent, packingInclude);
+
+            auto unpack = [&code](const std::string& func, std::vector<code::Value> args) {
+                auto res = code.makeExternalCall(func, std::move(args));
+                code.annotateType(res, vec3{});
+                return res;
+            };
+            config.linkCapability(VertexCapability::kPosition,
+                                  unpack("unpackPosition", {
+                                      config.accessResource(vPos),
+                                      config.accessResource(dequantPc)
+                                  }),
+                                  { vPos, dequantPc });
+            config.linkCapability(VertexCapability::kNormal,
+                                  unpack("unpackOctahedral", { config.accessResource(vNormal) }),
+                                  { vNormal });
+            config.linkCapability(VertexCapability::kTangent,
+                                  unpack("unpackOctahedral", { config.accessResource(vTangent) }),
+                                  { vTangent });
+            config.linkCapability(VertexCapability::kUV, vUV);
+        }
 
-        config.linkCapability(VertexCapability::kPosition, vPos);
-        config.linkCapability(VertexCapability::kNormal, vNormal);
-        config.linkCapability(VertexCapability::kTangent, vTangent);
-        config.linkCapability(VertexCapability::kUV, vUV);
         config.linkCapability(VertexCapability::kBoneIndices, vBoneIndices);
         config.linkCapability(VertexCapability::kBoneWeights, vBoneWeights);
 
@@ -264,9 +310,12 @@ auto VertexModule::makeVertexCapabilityConfig() -> shader::CapabilityConfig
                               { animDataPc });
 
         return config;
-    }();
+    };
+
+    static auto fullConfig = makeConfig(false);
+    static auto packedConfig = makeConfig(true);
 
-    return config;
+    return packedVertices ? packedConfig : fullConfig;
 }
 
 } // namespace trc
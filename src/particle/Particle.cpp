@@ -1,5 +1,7 @@
 #include "trc/particle/Particle.h"
 
+#include <cstddef>
+
 #include "trc/GBufferPass.h"
 #include "trc/ParticlePipelines.h"
 #include "trc/PipelineDefinitions.h" // For the SHADER_DIR constant
@@ -7,11 +9,27 @@
 #include "trc/core/Instance.h"
 #include "trc/core/PipelineBuilder.h"
 #include "trc/core/PipelineLayoutBuilder.h"
+#include "trc_util/math/BatchTransform.h"
 
 
 
 namespace trc
 {
+    static_assert(sizeof(mat4) == sizeof(math::Mat4f));
+    static_assert(sizeof(vec3) == sizeof(math::Vec3f));
+    static_assert(sizeof(quat) == sizeof(math::Quatf));
+    static_assert(offsetof(quat, w) == 3 * sizeof(float), "The kernels expect quaternions as x, y, z, w");
+
+    /**
+     * @brief View an array of GLM objects as an array of the batch
+     *        transform kernels' element type
+     */
+    template<typename Out, typename In>
+    auto asKernelData(std::vector<In>& v) -> std::span<Out>
+    {
+        return { reinterpret_cast<Out*>(v.data()), v.size() };
+    }
+
     struct ParticleVertex
     {
         vec3 position;
@@ -224,16 +242,31 @@ void trc::ParticleCollection::tickParticles(const float timeDelta)
     tmpSizes[Blend::eAlphaBlend].offset       = tmpSizes[Blend::eDiscardZeroAlpha].count;
     blendTypeSizes = tmpSizes;
 
+    // Compute all transforms in one batch
+    tickPositions.clear();
+    tickOrientations.clear();
+    tickScalings.clear();
+    for (const Particle& particle : particles)
+    {
+        tickPositions.push_back(particle.phys.position);
+        tickOrientations.push_back(particle.phys.orientation);
+        tickScalings.push_back(particle.phys.scaling);
+    }
+    tickTransforms.resize(particles.size());
+    math::composeTransforms(
+        asKernelData<const math::Vec3f>(tickPositions),
+        asKernelData<const math::Quatf>(tickOrientations),
+        asKernelData<const math::Vec3f>(tickScalings),
+        asKernelData<math::Mat4f>(tickTransforms)
+    );
+
     ParticleDeviceData* devData = persistentParticleDeviceDataBuf;
     for (size_t i = 0; i < particles.size(); i++)
     {
         const ui32 index = tmpSizes[particles[i].material.blending].offset++;
 
         // Store calculated transform in buffer
-        auto& p = particles[i].phys;
-        devData[index].transform = glm::translate(mat4(1.0f), p.position)
-                                   * mat4(p.orientation)
-                                   * glm::scale(mat4(1.0f), p.scaling);
+        devData[index].transform = tickTransforms[i];
         devData[index].textureIndex = particles[i].material.texture;
     }
 }
@@ -258,7 +291,7 @@ void trc::ParticleSpawn::addParticle(Particle particle)
 
 void trc::ParticleSpawn::spawnParticles()
 {
-    threads.async([this]()
+    threads.execute([this]()
     {
         const mat4& globalTransform = getGlobalTransform();
         std::vector<Particle> newParticles{ particles };
@@ -2,6 +2,8 @@
 
 #include <fstream>
 
+#include <trc_util/MappedFile.h>
+
 
 
 namespace trc
@@ -48,6 +50,32 @@ bool FilesystemDataStorage::remove(const path& path)
     return fs::remove(path.filesystemPath(rootDir));
 }
 
+auto FilesystemDataStorage::map(const path& path) -> std::optional<MappedData>
+{
+    const fs::path fullPath = path.filesystemPath(rootDir);
+    if (!fs::is_regular_file(fullPath)) {
+        return std::nullopt;
+    }
+
+    try {
+        auto file = std::make_shared<util::MappedFile>(fullPath);
+        return MappedData{ .data=file->span(), .owner=file };
+    }
+    catch (const std::runtime_error&) {
+        return std::nullopt;
+    }
+}
+
+auto FilesystemDataStorage::getSize(const path& path) -> std::optional<size_t>
+{
+    std::error_code err;
+    const auto size = fs::file_size(path.filesystemPath(rootDir), err);
+    if (err) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(size);
+}
+
 auto FilesystemDataStorage::begin() -> iterator
 {
     return iterator{ std::make_unique<FileIterator>(rootDir) };
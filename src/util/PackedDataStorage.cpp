@@ -0,0 +1,420 @@
+#include "trc/util/PackedDataStorage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include <trc_util/MappedFile.h>
+#include <trc_util/MemoryStream.h>
+#include <trc_util/Padding.h>
+
+
+
+namespace trc
+{
+
+namespace
+{
+    struct ArchiveHeader
+    {
+        char magic[8];
+        ui32 version;
+        ui32 flags;
+
+        ui64 numEntries;
+        ui64 tocOffset;
+        ui64 stringsOffset;
+        ui64 stringsSize;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 48);
+
+    constexpr char kArchiveMagic[8]{ 'T', 'R', 'C', 'P', 'A', 'C', 'K', '\0' };
+    constexpr ui32 kArchiveVersion{ 1 };
+
+    using Compression = PackedArchiveWriter::Compression;
+
+    bool rangeInBounds(ui64 offset, ui64 size, ui64 totalSize)
+    {
+        return offset <= totalSize && size <= totalSize - offset;
+    }
+
+    /**
+     * Paths are stored in their generic form so that archives are portable
+     * between platforms.
+     */
+    auto toKey(const util::Pathlet& path) -> std::string
+    {
+        return fs::path(path.string()).generic_string();
+    }
+
+    /**
+     * @brief Create an input stream that keeps the viewed memory alive
+     */
+    auto makeStream(s_ptr<const void> owner, std::span<const std::byte> data)
+        -> s_ptr<std::istream>
+    {
+        struct OwningStream
+        {
+            OwningStream(s_ptr<const void> owner, std::span<const std::byte> data)
+                : owner(std::move(owner)),
+                  stream(reinterpret_cast<const char*>(data.data()), data.size())
+            {}
+
+            s_ptr<const void> owner;
+            util::MemoryInputStream stream;
+        };
+
+        auto res = std::make_shared<OwningStream>(std::move(owner), data);
+        return { res, &res->stream };
+    }
+} // anonymous namespace
+
+
+
+PackedDataStorage::PackedDataStorage(const fs::path& archiveFile)
+    :
+    file(std::make_shared<util::MappedFile>(archiveFile))
+{
+    auto invalid = [&](const std::string& reason) {
+        return std::runtime_error("[In PackedDataStorage::PackedDataStorage()]: "
+                                  + archiveFile.string() + " is not a valid archive: " + reason);
+    };
+
+    const auto data = file->span();
+    if (data.size() < sizeof(ArchiveHeader)) {
+        throw invalid("File is too small.");
+    }
+
+    ArchiveHeader header;
+    std::memcpy(&header, data.data(), sizeof(ArchiveHeader));
+    if (std::memcmp(header.magic, kArchiveMagic, sizeof(kArchiveMagic)) != 0) {
+        throw invalid("Wrong magic number.");
+    }
+    if (header.version != kArchiveVersion) {
+        throw invalid("Unsupported version " + std::to_string(header.version) + ".");
+    }
+    if (header.tocOffset % alignof(Entry) != 0
+        || header.numEntries > (data.size() - std::min<ui64>(header.tocOffset, data.size())) / sizeof(Entry)
+        || !rangeInBounds(header.stringsOffset, header.stringsSize, data.size()))
+    {
+        throw invalid("Table of contents is out of bounds.");
+    }
+
+    toc = { reinterpret_cast<const Entry*>(data.data() + header.tocOffset), header.numEntries };
+    strings = { reinterpret_cast<const char*>(data.data() + header.stringsOffset),
+                header.stringsSize };
+
+    // Validate all entries once so that accessors don't have to
+    for (size_t i = 0; i < toc.size(); ++i)
+    {
+        const Entry& entry = toc[i];
+        if (!rangeInBounds(entry.pathOffset, entry.pathLength, strings.size())
+            || !rangeInBounds(entry.dataOffset, entry.storedSize, data.size()))
+        {
+            throw invalid("Entry " + std::to_string(i) + " is out of bounds.");
+        }
+        if (entry.compression > static_cast<ui32>(Compression::eZlib)
+            || (entry.compression == static_cast<ui32>(Compression::eNone)
+                && entry.storedSize != entry.size))
+        {
+            throw invalid("Entry " + std::to_string(i) + " has an invalid compression.");
+        }
+        if (i > 0 && !(getEntryPath(toc[i - 1]) < getEntryPath(entry))) {
+            throw invalid("Table of contents is not sorted.");
+        }
+    }
+}
+
+auto PackedDataStorage::read(const path& path) -> s_ptr<std::istream>
+{
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+
+    if (entry->compression == static_cast<ui32>(Compression::eNone)) {
+        return makeStream(file, getEntryData(*entry));
+    }
+
+    auto buf = decompress(*entry);
+    return makeStream(buf, std::span{ *buf });
+}
+
+auto PackedDataStorage::write(const path& /*path*/) -> s_ptr<std::ostream>
+{
+    return nullptr;
+}
+
+bool PackedDataStorage::remove(const path& /*path*/)
+{
+    return false;
+}
+
+auto PackedDataStorage::map(const path& path) -> std::optional<MappedData>
+{
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr) {
+        return std::nullopt;
+    }
+
+    if (entry->compression == static_cast<ui32>(Compression::eNone)) {
+        return MappedData{ .data=getEntryData(*entry), .owner=file };
+    }
+
+    auto buf = decompress(*entry);
+    return MappedData{ .data=std::span{ *buf }, .owner=buf };
+}
+
+auto PackedDataStorage::getSize(const path& path) -> std::optional<size_t>
+{
+    if (const Entry* entry = findEntry(path)) {
+        return static_cast<size_t>(entry->size);
+    }
+    return std::nullopt;
+}
+
+auto PackedDataStorage::begin() -> iterator
+{
+    return iterator{ std::make_unique<TocIterator>(this, 0) };
+}
+
+auto PackedDataStorage::end() -> iterator
+{
+    return iterator{ std::make_unique<TocIterator>(this, toc.size()) };
+}
+
+auto PackedDataStorage::size() const -> size_t
+{
+    return toc.size();
+}
+
+auto PackedDataStorage::findEntry(const path& path) const -> const Entry*
+{
+    const std::string key = toKey(path);
+    auto it = std::ranges::lower_bound(toc, std::string_view{ key }, {},
+                                       [this](const Entry& e){ return getEntryPath(e); });
+    if (it != toc.end() && getEntryPath(*it) == key) {
+        return &*it;
+    }
+    return nullptr;
+}
+
+auto PackedDataStorage::getEntryPath(const Entry& entry) const -> std::string_view
+{
+    return { strings.data() + entry.pathOffset, entry.pathLength };
+}
+
+auto PackedDataStorage::getEntryData(const Entry& entry) const -> std::span<const std::byte>
+{
+    return file->span().subspan(entry.dataOffset, entry.storedSize);
+}
+
+auto PackedDataStorage::decompress(const Entry& entry) const -> s_ptr<std::vector<std::byte>>
+{
+    assert(entry.compression == static_cast<ui32>(Compression::eZlib));
+
+    const auto src = getEntryData(entry);
+    auto buf = std::make_shared<std::vector<std::byte>>(entry.size);
+    uLongf destSize = buf->size();
+    const int res = uncompress(reinterpret_cast<Bytef*>(buf->data()), &destSize,
+                               reinterpret_cast<const Bytef*>(src.data()), src.size());
+    if (res != Z_OK || destSize != entry.size)
+    {
+        throw std::runtime_error("[In PackedDataStorage::decompress]: Unable to decompress"
+                                 " entry \"" + std::string(getEntryPath(entry)) + "\".");
+    }
+
+    return buf;
+}
+
+
+
+PackedDataStorage::TocIterator::TocIterator(const PackedDataStorage* storage, size_t index)
+    :
+    storage(storage),
+    index(index)
+{
+    updateCurrent();
+}
+
+auto PackedDataStorage::TocIterator::operator*() -> reference
+{
+    return *current;
+}
+
+auto PackedDataStorage::TocIterator::operator*() const -> const_reference
+{
+    return *current;
+}
+
+auto PackedDataStorage::TocIterator::operator->() -> pointer
+{
+    return &*current;
+}
+
+auto PackedDataStorage::TocIterator::operator->() const -> const_pointer
+{
+    return &*current;
+}
+
+auto PackedDataStorage::TocIterator::operator++() -> EntryIterator&
+{
+    ++index;
+    updateCurrent();
+    return *this;
+}
+
+bool PackedDataStorage::TocIterator::operator==(const EntryIterator& _other) const
+{
+    auto other = dynamic_cast<const TocIterator*>(&_other);
+    return other != nullptr
+        && storage == other->storage
+        && index == other->index;
+}
+
+void PackedDataStorage::TocIterator::updateCurrent()
+{
+    if (index < storage->toc.size())
+    {
+        const auto path = storage->getEntryPath(storage->toc[index]);
+        current = util::Pathlet(fs::path(std::string(path)));
+    }
+    else {
+        current.reset();
+    }
+}
+
+
+
+PackedArchiveWriter::PackedArchiveWriter(const fs::path& archiveFile)
+    :
+    file(archiveFile, std::ios::binary)
+{
+    if (!file.is_open())
+    {
+        throw std::runtime_error("[In PackedArchiveWriter::PackedArchiveWriter()]: Unable to open "
+                                 + archiveFile.string() + " for writing.");
+    }
+
+    // Reserve space for the header. It is written in `finish`.
+    const ArchiveHeader header{};
+    writePadded(&header, sizeof(header));
+}
+
+PackedArchiveWriter::~PackedArchiveWriter() noexcept
+{
+    if (!finished)
+    {
+        try {
+            finish();
+        }
+        catch (...) {}
+    }
+}
+
+void PackedArchiveWriter::add(
+    const util::Pathlet& path,
+    std::span<const std::byte> data,
+    Compression compression)
+{
+    if (finished) {
+        throw std::logic_error("[In PackedArchiveWriter::add]: Archive has already been finished.");
+    }
+
+    std::string key = toKey(path);
+    if (!paths.emplace(key).second)
+    {
+        throw std::invalid_argument("[In PackedArchiveWriter::add]: Archive already contains an"
+                                    " entry at " + key + ".");
+    }
+
+    const ui64 size = data.size();
+    std::vector<Bytef> compressed;
+    if (compression == Compression::eZlib)
+    {
+        uLongf compressedSize = compressBound(data.size());
+        compressed.resize(compressedSize);
+        const int res = compress2(compressed.data(), &compressedSize,
+                                  reinterpret_cast<const Bytef*>(data.data()), data.size(),
+                                  Z_BEST_COMPRESSION);
+        if (res == Z_OK && compressedSize < data.size())
+        {
+            compressed.resize(compressedSize);
+            data = std::as_bytes(std::span{ compressed });
+        }
+        else {
+            compression = Compression::eNone;
+        }
+    }
+
+    entries.push_back({
+        .path=std::move(key),
+        .compression=static_cast<ui32>(compression),
+        .offset=util::pad(pos, kEntryAlignment),
+        .storedSize=data.size(),
+        .size=size,
+    });
+    writePadded(data.data(), data.size());
+}
+
+void PackedArchiveWriter::finish()
+{
+    if (finished) return;
+    finished = true;
+
+    std::ranges::sort(entries, {}, &PendingEntry::path);
+
+    // Build table of contents and string table
+    std::vector<PackedDataStorage::Entry> toc;
+    std::string strings;
+    toc.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+        toc.push_back({
+            .pathOffset=strings.size(),
+            .pathLength=entry.path.size(),
+            .dataOffset=entry.offset,
+            .storedSize=entry.storedSize,
+            .size=entry.size,
+            .compression=entry.compression,
+        });
+        strings += entry.path;
+    }
+
+    ArchiveHeader header{
+        .magic={},
+        .version=kArchiveVersion,
+        .flags=0,
+        .numEntries=toc.size(),
+        .tocOffset=util::pad(pos, kEntryAlignment),
+        .stringsOffset=0,
+        .stringsSize=strings.size(),
+    };
+    std::memcpy(header.magic, kArchiveMagic, sizeof(kArchiveMagic));
+
+    writePadded(toc.data(), toc.size() * sizeof(PackedDataStorage::Entry));
+    header.stringsOffset = pos;
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("[In PackedArchiveWriter::finish]: Unable to write archive.");
+    }
+}
+
+void PackedArchiveWriter::writePadded(const void* data, size_t size)
+{
+    static constexpr char zeros[kEntryAlignment]{};
+    const ui64 padded = util::pad(pos, kEntryAlignment);
+    file.write(zeros, static_cast<std::streamsize>(padded - pos));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    pos = padded + size;
+}
+
+} // namespace trc
@@ -0,0 +1,181 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <trc_util/math/BatchTransform.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::math;
+
+static_assert(sizeof(glm::mat4) == sizeof(Mat4f));
+static_assert(sizeof(glm::vec3) == sizeof(Vec3f));
+static_assert(sizeof(glm::quat) == sizeof(Quatf));
+
+/**
+ * @brief Matrix counts for the batch transform benchmarks
+ */
+static void matrixCounts(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(10)->Range(10'000, 1'000'000);
+}
+
+/**
+ * @brief Random transformations in GLM's types
+ */
+struct TransformInputs
+{
+    explicit TransformInputs(size_t count)
+    {
+        std::mt19937 rng{ 42 };
+        std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+        for (size_t i = 0; i < count; ++i)
+        {
+            glm::mat4 m;
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r)
+                    m[c][r] = dist(rng);
+            matrices.push_back(m);
+            translations.emplace_back(dist(rng), dist(rng), dist(rng));
+            rotations.push_back(glm::angleAxis(dist(rng) * 3.14f, glm::vec3(0.0f, 0.0f, 1.0f)));
+            scales.emplace_back(dist(rng) + 2.0f, dist(rng) + 2.0f, dist(rng) + 2.0f);
+        }
+    }
+
+    /** Copy a GLM array into the kernels' element type */
+    template<typename Out, typename In>
+    static auto convert(const std::vector<In>& in) -> std::vector<Out>
+    {
+        std::vector<Out> out(in.size());
+        std::memcpy(out.data(), in.data(), in.size() * sizeof(In));
+        return out;
+    }
+
+    std::vector<glm::mat4> matrices;
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+};
+
+static void BatchTransform_MultiplyGlm(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    std::vector<glm::mat4> out(in.matrices.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = in.matrices[i] * in.matrices[out.size() - 1 - i];
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+static void BatchTransform_Multiply(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    const auto lhs = TransformInputs::convert<Mat4f>(in.matrices);
+    const std::vector<Mat4f> rhs(lhs.rbegin(), lhs.rend());
+    std::vector<Mat4f> out(lhs.size());
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    for (auto _ : state)
+    {
+        multiplyMatrices(lhs, rhs, out, level);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+static void BatchTransform_QuatToMatrixGlm(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    std::vector<glm::mat4> out(in.rotations.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = glm::mat4_cast(in.rotations[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+static void BatchTransform_QuatToMatrix(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    const auto rotations = TransformInputs::convert<Quatf>(in.rotations);
+    std::vector<Mat4f> out(rotations.size());
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    for (auto _ : state)
+    {
+        quatToMatrices(rotations, out, level);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+/**
+ * The particle system's way of building a model matrix
+ */
+static void BatchTransform_ComposeGlm(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    std::vector<glm::mat4> out(in.rotations.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            out[i] = glm::translate(glm::mat4(1.0f), in.translations[i])
+                     * glm::mat4_cast(in.rotations[i])
+                     * glm::scale(glm::mat4(1.0f), in.scales[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+static void BatchTransform_Compose(benchmark::State& state)
+{
+    const TransformInputs in(state.range(0));
+    const auto translations = TransformInputs::convert<Vec3f>(in.translations);
+    const auto rotations = TransformInputs::convert<Quatf>(in.rotations);
+    const auto scales = TransformInputs::convert<Vec3f>(in.scales);
+    std::vector<Mat4f> out(rotations.size());
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    for (auto _ : state)
+    {
+        composeTransforms(translations, rotations, scales, out, level);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+/**
+ * @brief Run a kernel benchmark for each instruction set the CPU supports
+ */
+static void kernelArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({ "count", "simd" });
+    for (int64_t count = 10'000; count <= 1'000'000; count *= 10)
+    {
+        for (int64_t level = 0; level <= int64_t(getSupportedSimdLevel()); ++level) {
+            b->Args({ count, level });
+        }
+    }
+}
+
+BENCHMARK(BatchTransform_MultiplyGlm)->Apply(matrixCounts);
+BENCHMARK(BatchTransform_Multiply)->Apply(kernelArgs);
+BENCHMARK(BatchTransform_QuatToMatrixGlm)->Apply(matrixCounts);
+BENCHMARK(BatchTransform_QuatToMatrix)->Apply(kernelArgs);
+BENCHMARK(BatchTransform_ComposeGlm)->Apply(matrixCounts);
+BENCHMARK(BatchTransform_Compose)->Apply(kernelArgs);
@@ -0,0 +1,127 @@
+#include <trc_util/data/DeferredInsertVector.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::DeferredInsertVector;
+
+static void DeferredInsertVector_Insert(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    for (auto _ : state)
+    {
+        DeferredInsertVector<uint64_t> vec;
+        for (size_t i = 0; i < size; ++i) {
+            vec.emplace_back(i);
+        }
+        vec.update();
+        benchmark::DoNotOptimize(vec.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * Erase from within an iteration, which defers the erasure until
+ * `update` is called.
+ */
+static void DeferredInsertVector_DeferredErase(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    DeferredInsertVector<uint64_t> vec;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (size_t i = 0; i < size; ++i) {
+            vec.emplace_back(i);
+        }
+        vec.update();
+        state.ResumeTiming();
+
+        {
+            auto range = vec.iter();
+            for (auto it = range.begin(); it != range.end(); ++it) {
+                vec.erase(it);
+            }
+        }
+        vec.update();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void DeferredInsertVector_Lookup(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    DeferredInsertVector<uint64_t> vec;
+    for (size_t i = 0; i < size; ++i) {
+        vec.emplace_back(i);
+    }
+    vec.update();
+
+    XorShift rand;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vec.at(rand() % size));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void DeferredInsertVector_Iterate(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    DeferredInsertVector<uint64_t> vec;
+    for (size_t i = 0; i < size; ++i) {
+        vec.emplace_back(i);
+    }
+    vec.update();
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        for (uint64_t value : vec.iter()) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 99 lookups per insertion.
+ */
+static void DeferredInsertVector_ConcurrentLookupAndInsert(benchmark::State& state)
+{
+    constexpr size_t kSize{ 1 << 14 };
+    static DeferredInsertVector<uint64_t>* vec{ nullptr };
+    if (state.thread_index() == 0)
+    {
+        vec = new DeferredInsertVector<uint64_t>;
+        for (size_t i = 0; i < kSize; ++i) {
+            vec->emplace_back(i);
+        }
+        vec->update();
+    }
+
+    XorShift rand{ .state=0x9e3779b97f4a7c15 + state.thread_index() };
+    size_t op{ 0 };
+    for (auto _ : state)
+    {
+        if (++op % 100 == 0) {
+            vec->emplace_back(op);
+        }
+        else {
+            benchmark::DoNotOptimize(vec->at(rand() % kSize));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        delete vec;
+        vec = nullptr;
+    }
+}
+
+BENCHMARK(DeferredInsertVector_Insert)->Apply(containerSizes);
+BENCHMARK(DeferredInsertVector_DeferredErase)->Apply(containerSizes);
+BENCHMARK(DeferredInsertVector_Lookup)->Apply(containerSizes);
+BENCHMARK(DeferredInsertVector_Iterate)->Apply(containerSizes);
+BENCHMARK(DeferredInsertVector_ConcurrentLookupAndInsert)->Apply(threadCounts);
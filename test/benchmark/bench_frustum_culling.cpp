@@ -0,0 +1,81 @@
+#include <random>
+#include <vector>
+
+#include <trc_util/math/FrustumCulling.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::math;
+
+/**
+ * @brief Bounding spheres scattered around a camera at the origin
+ *
+ * About 15% of the spheres intersect the frustum, which is typical for a
+ * large scene viewed from inside.
+ */
+struct CullingInputs
+{
+    explicit CullingInputs(size_t count)
+        : x(count), y(count), z(count), r(count)
+    {
+        std::mt19937 rng{ 42 };
+        std::uniform_real_distribution<float> pos{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> rad{ 0.1f, 2.0f };
+        for (size_t i = 0; i < count; ++i)
+        {
+            x[i] = pos(rng);
+            y[i] = pos(rng);
+            z[i] = pos(rng);
+            r[i] = rad(rng);
+        }
+    }
+
+    /** A 90 degree perspective projection looking down the negative z-axis */
+    static auto makeFrustum() -> Frustum
+    {
+        constexpr float near = 0.1f;
+        constexpr float far = 100.0f;
+        return Frustum::fromViewProjection({
+            1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, far / (near - far), -1,
+            0, 0, -(far * near) / (far - near), 0,
+        });
+    }
+
+    std::vector<float> x, y, z, r;
+};
+
+static void FrustumCulling_CullSpheres(benchmark::State& state)
+{
+    const CullingInputs in(state.range(0));
+    const Frustum frustum = CullingInputs::makeFrustum();
+    std::vector<uint8_t> visible(in.x.size());
+    const auto level = static_cast<SimdLevel>(state.range(1));
+
+    size_t numVisible{ 0 };
+    for (auto _ : state)
+    {
+        numVisible = cullSpheres(frustum, in.x, in.y, in.z, in.r, visible, level);
+        benchmark::DoNotOptimize(visible.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * visible.size());
+    state.counters["visible"] = double(numVisible) / double(visible.size());
+}
+
+/**
+ * @brief Run the benchmark for each instruction set the CPU supports
+ */
+static void cullingArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({ "count", "simd" });
+    for (int64_t count = 1'000; count <= 1'000'000; count *= 10)
+    {
+        for (int64_t level = 0; level <= int64_t(getSupportedSimdLevel()); ++level) {
+            b->Args({ count, level });
+        }
+    }
+}
+
+BENCHMARK(FrustumCulling_CullSpheres)->Apply(cullingArgs);
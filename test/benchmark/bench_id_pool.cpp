@@ -0,0 +1,96 @@
+#include <atomic>
+#include <vector>
+
+#include <trc_util/data/IdPool.h>
+#include <trc_util/data/ThreadsafeQueue.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::IdPool;
+
+/**
+ * The previous ID pool implementation: freed IDs are stored in a
+ * mutex-protected queue. Baseline for `IdPool_Concurrent`.
+ */
+class LockedIdPool
+{
+public:
+    auto generate() -> uint32_t
+    {
+        if (auto id = freeIds.try_pop()) {
+            return *id;
+        }
+        return nextId++;
+    }
+
+    void free(uint32_t id)
+    {
+        freeIds.push(id);
+    }
+
+private:
+    std::atomic<uint32_t> nextId{ 0 };
+    trc::data::ThreadsafeQueue<uint32_t> freeIds;
+};
+
+static void IdPool_Generate(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    for (auto _ : state)
+    {
+        IdPool<uint32_t> pool;
+        for (size_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(pool.generate());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void IdPool_FreeAndReuse(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    IdPool<uint32_t> pool;
+    std::vector<uint32_t> ids(size);
+    for (auto& id : ids) id = pool.generate();
+
+    for (auto _ : state)
+    {
+        for (auto id : ids) pool.free(id);
+        for (auto& id : ids) id = pool.generate();
+    }
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+/**
+ * Each thread repeatedly allocates a batch of IDs, then frees them, as
+ * when objects are spawned and destroyed from worker threads.
+ */
+template<typename Pool>
+static void IdPool_Concurrent(benchmark::State& state)
+{
+    constexpr size_t kBatchSize{ 64 };
+    static Pool* pool{ nullptr };
+    if (state.thread_index() == 0) {
+        pool = new Pool;
+    }
+
+    std::vector<uint32_t> ids(kBatchSize);
+    for (auto _ : state)
+    {
+        for (auto& id : ids) id = pool->generate();
+        for (auto id : ids) pool->free(id);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize * 2);
+
+    if (state.thread_index() == 0)
+    {
+        delete pool;
+        pool = nullptr;
+    }
+}
+
+BENCHMARK(IdPool_Generate)->Apply(containerSizes);
+BENCHMARK(IdPool_FreeAndReuse)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(IdPool_Concurrent, IdPool<uint32_t>)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(IdPool_Concurrent, LockedIdPool)->Apply(threadCounts);
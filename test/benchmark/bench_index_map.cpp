@@ -0,0 +1,76 @@
+#include <trc_util/data/IndexMap.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::IndexMap;
+
+static void IndexMap_Insert(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    for (auto _ : state)
+    {
+        IndexMap<uint32_t, uint64_t> map;
+        for (uint32_t i = 0; i < size; ++i) {
+            map.emplace(i, i);
+        }
+        benchmark::DoNotOptimize(map.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void IndexMap_Remove(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    IndexMap<uint32_t, uint64_t> map;
+    for (uint32_t i = 0; i < size; ++i) {
+        map.emplace(i, i);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(map.remove(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void IndexMap_Lookup(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    IndexMap<uint32_t, uint64_t> map;
+    for (uint32_t i = 0; i < size; ++i) {
+        map.emplace(i, i);
+    }
+
+    XorShift rand;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.at(static_cast<uint32_t>(rand() % size)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void IndexMap_Iterate(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    IndexMap<uint32_t, uint64_t> map;
+    for (uint32_t i = 0; i < size; ++i) {
+        map.emplace(i, i);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        for (uint64_t value : map) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(IndexMap_Insert)->Apply(containerSizes);
+BENCHMARK(IndexMap_Remove)->Apply(containerSizes);
+BENCHMARK(IndexMap_Lookup)->Apply(containerSizes);
+BENCHMARK(IndexMap_Iterate)->Apply(containerSizes);
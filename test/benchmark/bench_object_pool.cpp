@@ -0,0 +1,58 @@
+#include <vector>
+
+#include <trc_util/data/ObjectPool.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::ObjectPool;
+using trc::data::PooledObject;
+
+struct PooledValue : PooledObject<PooledValue>
+{
+    void poolInit(uint64_t v) { value = v; }
+
+    uint64_t value{ 0 };
+};
+
+static void ObjectPool_CreateRelease(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    ObjectPool<PooledValue> pool(size);
+    std::vector<PooledValue*> objects(size);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            objects[i] = &pool.createObject(i);
+        }
+        for (auto obj : objects) {
+            pool.releaseObject(*obj);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+static void ObjectPool_ForeachActive(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    ObjectPool<PooledValue> pool(size);
+    std::vector<PooledValue*> objects(size);
+    for (size_t i = 0; i < size; ++i) {
+        objects[i] = &pool.createObject(i);
+    }
+    // Leave every other object inactive
+    for (size_t i = 0; i < size; i += 2) {
+        pool.releaseObject(*objects[i]);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        pool.foreachActive([&](PooledValue& obj){ sum += obj.value; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(ObjectPool_CreateRelease)->Apply(containerSizes);
+BENCHMARK(ObjectPool_ForeachActive)->Apply(containerSizes);
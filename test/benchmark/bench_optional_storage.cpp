@@ -0,0 +1,92 @@
+#include <memory>
+
+#include <trc_util/data/OptionalStorage.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::OptionalStorage;
+
+// The storage's size is a template parameter, so the sizes are
+// instantiated explicitly instead of using `containerSizes`.
+
+template<size_t N>
+static void OptionalStorage_Emplace(benchmark::State& state)
+{
+    auto storage = std::make_unique<OptionalStorage<uint64_t, N>>();
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i) {
+            storage->emplace(i, i);
+        }
+        benchmark::DoNotOptimize(storage->at(N - 1));
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<size_t N>
+static void OptionalStorage_Erase(benchmark::State& state)
+{
+    auto storage = std::make_unique<OptionalStorage<uint64_t, N>>();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (size_t i = 0; i < N; ++i) {
+            storage->emplace(i, i);
+        }
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < N; ++i) {
+            benchmark::DoNotOptimize(storage->erase(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<size_t N>
+static void OptionalStorage_Lookup(benchmark::State& state)
+{
+    auto storage = std::make_unique<OptionalStorage<uint64_t, N>>();
+    for (size_t i = 0; i < N; ++i) {
+        storage->emplace(i, i);
+    }
+
+    XorShift rand;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage->at(rand() % N));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<size_t N>
+static void OptionalStorage_Iterate(benchmark::State& state)
+{
+    auto storage = std::make_unique<OptionalStorage<uint64_t, N>>();
+    for (size_t i = 0; i < N; i += 2) {
+        storage->emplace(i, i);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (storage->valid(i)) {
+                sum += storage->accessUnchecked(i);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+#define OPTIONAL_STORAGE_BENCHMARK(func)   \
+    BENCHMARK_TEMPLATE(func, 64);          \
+    BENCHMARK_TEMPLATE(func, 512);         \
+    BENCHMARK_TEMPLATE(func, 4096);        \
+    BENCHMARK_TEMPLATE(func, 32768)
+
+OPTIONAL_STORAGE_BENCHMARK(OptionalStorage_Emplace);
+OPTIONAL_STORAGE_BENCHMARK(OptionalStorage_Erase);
+OPTIONAL_STORAGE_BENCHMARK(OptionalStorage_Lookup);
+OPTIONAL_STORAGE_BENCHMARK(OptionalStorage_Iterate);
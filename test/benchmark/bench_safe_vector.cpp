@@ -0,0 +1,140 @@
+#include <trc_util/data/SafeVector.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::util::SafeVector;
+using trc::util::ReadOptimizedSafeVector;
+
+template<typename Vec>
+static void SafeVector_Insert(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    for (auto _ : state)
+    {
+        Vec vec;
+        for (size_t i = 0; i < size; ++i) {
+            vec.emplace(i, i);
+        }
+        benchmark::DoNotOptimize(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Vec>
+static void SafeVector_Erase(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    Vec vec;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (size_t i = 0; i < size; ++i) {
+            vec.emplace(i, i);
+        }
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(vec.erase(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Vec>
+static void SafeVector_Lookup(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    Vec vec;
+    for (size_t i = 0; i < size; ++i) {
+        vec.emplace(i, i);
+    }
+
+    XorShift rand;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vec.at(rand() % size));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Vec>
+static void SafeVector_Iterate(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    Vec vec;
+    for (size_t i = 0; i < size; i += 2) {
+        vec.emplace(i, i);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        for (const uint64_t& value : vec) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (size / 2));
+}
+
+/**
+ * `state.range(0)` lookups per modification. 99:1 is typical for the
+ * asset registries.
+ *
+ * The locked `SafeVector` is the baseline for `ReadOptimizedSafeVector`.
+ */
+template<typename Vec>
+static void SafeVector_ConcurrentReadMostly(benchmark::State& state)
+{
+    constexpr size_t kSize{ 1 << 14 };
+    static Vec* vec{ nullptr };
+    if (state.thread_index() == 0)
+    {
+        vec = new Vec;
+        for (size_t i = 0; i < kSize; ++i) {
+            vec->emplace(i, i);
+        }
+    }
+
+    const size_t readsPerWrite = state.range(0);
+    XorShift rand{ .state=0x9e3779b97f4a7c15 + state.thread_index() };
+    size_t op{ 0 };
+    for (auto _ : state)
+    {
+        const size_t index = rand() % kSize;
+        if (++op % (readsPerWrite + 1) == 0)
+        {
+            if (!vec->erase(index)) {
+                vec->emplace(index, index);
+            }
+        }
+        else if (vec->contains(index))
+        {
+            // The element may have been erased since the check
+            try {
+                benchmark::DoNotOptimize(vec->copyAtomically(index));
+            }
+            catch (const trc::data::InvalidElementAccess&) {}
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        delete vec;
+        vec = nullptr;
+    }
+}
+
+BENCHMARK_TEMPLATE(SafeVector_Insert, SafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Insert, ReadOptimizedSafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Erase, SafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Erase, ReadOptimizedSafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Lookup, SafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Lookup, ReadOptimizedSafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Iterate, SafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_Iterate, ReadOptimizedSafeVector<uint64_t>)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(SafeVector_ConcurrentReadMostly, SafeVector<uint64_t>)
+    ->Arg(99)->Arg(9)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(SafeVector_ConcurrentReadMostly, ReadOptimizedSafeVector<uint64_t>)
+    ->Arg(99)->Arg(9)->Apply(threadCounts);
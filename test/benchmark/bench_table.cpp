@@ -0,0 +1,293 @@
+#include <array>
+
+#include <componentlib/IndirectTableImpl.h>
+#include <componentlib/SoaTableImpl.h>
+#include <componentlib/StableTableImpl.h>
+#include <componentlib/Table.h>
+#include <componentlib/TableUtils.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+
+template<typename T>
+using StableTable = componentlib::Table<T, uint32_t, componentlib::StableTableImpl<T, uint32_t>>;
+template<typename T>
+using IndirectTable = componentlib::Table<T, uint32_t, componentlib::IndirectTableImpl<T, uint32_t>>;
+template<typename T>
+using SoaTable = componentlib::Table<T, uint32_t, componentlib::SoaTableImpl<T, uint32_t>>;
+
+template<template<typename> typename Table>
+static void Table_Emplace(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    for (auto _ : state)
+    {
+        Table<uint64_t> table;
+        for (uint32_t i = 0; i < size; ++i) {
+            table.emplace(i, i);
+        }
+        benchmark::DoNotOptimize(table.contains(0));
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<template<typename> typename Table>
+static void Table_Erase(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> table;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (uint32_t i = 0; i < size; ++i) {
+            table.emplace(i, i);
+        }
+        state.ResumeTiming();
+
+        for (uint32_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(table.erase(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<template<typename> typename Table>
+static void Table_Lookup(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> table;
+    for (uint32_t i = 0; i < size; ++i) {
+        table.emplace(i, i);
+    }
+
+    XorShift rand;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.get(static_cast<uint32_t>(rand() % size)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<template<typename> typename Table>
+static void Table_Iterate(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> table;
+    for (uint32_t i = 0; i < size; ++i) {
+        table.emplace(i, i);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum{ 0 };
+        for (uint64_t value : table) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * Erase all objects in an order unrelated to the insertion order, as
+ * when a scene is unloaded.
+ */
+template<template<typename> typename Table>
+static void Table_MassErase(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> table;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (uint32_t i = 0; i < size; ++i) {
+            table.emplace(i, i);
+        }
+        state.ResumeTiming();
+
+        // Any odd stride is coprime to the power-of-two size
+        for (uint32_t i = 0; i < size; ++i) {
+            table.erase(static_cast<uint32_t>((uint64_t{i} * 7919) % size));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * Join a table with one that contains every other key, once with the
+ * join iterator and once with `componentlib::join`.
+ */
+template<template<typename> typename Table, bool kUseIterator>
+static void Table_Join(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> a;
+    Table<float> b;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        a.emplace(i, i);
+        if (i % 2 == 0) b.emplace(i, static_cast<float>(i));
+    }
+
+    for (auto _ : state)
+    {
+        double sum{ 0.0 };
+        if constexpr (kUseIterator)
+        {
+            for (auto [key, x, y] : a.join(b)) {
+                sum += static_cast<double>(x) * y;
+            }
+        }
+        else {
+            componentlib::join(a, b, [&](uint64_t& x, float& y){ sum += static_cast<double>(x) * y; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * Join a large table with one that contains 1% of its keys. The join
+ * iterator walks both tables; `for_each_joined` drives from the small one.
+ */
+template<template<typename> typename Table, bool kUseIterator>
+static void Table_JoinSmall(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<uint64_t> large;
+    Table<float> small;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        large.emplace(i, i);
+        if (i % 100 == 0) small.emplace(i, static_cast<float>(i));
+    }
+
+    for (auto _ : state)
+    {
+        double sum{ 0.0 };
+        if constexpr (kUseIterator)
+        {
+            for (auto [key, x, y] : large.join(small)) {
+                sum += static_cast<double>(x) * y;
+            }
+        }
+        else
+        {
+            componentlib::for_each_joined(
+                [&](uint64_t& x, float& y){ sum += static_cast<double>(x) * y; },
+                large, small
+            );
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (size / 100));
+}
+
+/**
+ * A transform-like component of which one field is updated per frame
+ */
+struct BenchTransform
+{
+    std::array<float, 3> position{};
+    std::array<float, 4> rotation{};
+    std::array<float, 3> scale{};
+    std::array<float, 3> velocity{};
+    uint32_t flags{ 0 };
+};
+
+template<>
+struct componentlib::SoaLayout<BenchTransform>
+{
+    static constexpr std::tuple fields{
+        &BenchTransform::position, &BenchTransform::rotation, &BenchTransform::scale,
+        &BenchTransform::velocity, &BenchTransform::flags
+    };
+};
+
+/**
+ * Scan a single field of a table with every fourth object erased. The
+ * SoA table reads only that field's array; the other tables load whole
+ * objects.
+ */
+template<template<typename> typename Table>
+static void Table_FieldScan(benchmark::State& state)
+{
+    const uint32_t size = state.range(0);
+    Table<BenchTransform> table;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        BenchTransform t;
+        t.velocity[1] = static_cast<float>(i);
+        table.emplace(i, t);
+    }
+    for (uint32_t i = 0; i < size; i += 4) {
+        table.erase(i);
+    }
+
+    for (auto _ : state)
+    {
+        float sum{ 0.0f };
+        if constexpr (requires { table.template field<&BenchTransform::velocity>(); })
+        {
+            for (const auto& v : table.template field<&BenchTransform::velocity>()) {
+                sum += v[1];
+            }
+        }
+        else
+        {
+            for (const BenchTransform& t : table) {
+                sum += t.velocity[1];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+}
+
+template<template<typename> typename Table>
+static void Table_ParallelJoin(benchmark::State& state)
+{
+    constexpr uint32_t kSize{ 1 << 16 };
+    Table<uint64_t> a;
+    Table<float> b;
+    for (uint32_t i = 0; i < kSize; ++i)
+    {
+        a.emplace(i, i);
+        b.emplace(i, static_cast<float>(i));
+    }
+
+    trc::async::ThreadPool pool(state.range(0));
+    for (auto _ : state)
+    {
+        componentlib::parallel_for_each_joined(
+            pool,
+            [](uint64_t& x, float& y){ y = static_cast<float>(x) * 0.5f + y; },
+            a, b
+        );
+    }
+    state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+BENCHMARK_TEMPLATE(Table_Emplace, StableTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Emplace, IndirectTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Erase, StableTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Erase, IndirectTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_MassErase, StableTable)->RangeMultiplier(4)->Range(1 << 10, 1 << 17);
+BENCHMARK_TEMPLATE(Table_MassErase, IndirectTable)->RangeMultiplier(4)->Range(1 << 10, 1 << 17);
+BENCHMARK_TEMPLATE(Table_Lookup, StableTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Lookup, IndirectTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Iterate, StableTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Iterate, IndirectTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Join, StableTable, true)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Join, StableTable, false)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Join, IndirectTable, true)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_Join, IndirectTable, false)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_JoinSmall, StableTable, true)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_JoinSmall, StableTable, false)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_JoinSmall, IndirectTable, true)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_JoinSmall, IndirectTable, false)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_FieldScan, StableTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_FieldScan, IndirectTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_FieldScan, SoaTable)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Table_ParallelJoin, StableTable)->DenseRange(0, 16, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(Table_ParallelJoin, IndirectTable)->DenseRange(0, 16, 4)->UseRealTime();
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <trc_util/async/ThreadPool.h>
+#include <trc_util/data/ThreadsafeQueue.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::async::ThreadPool;
+
+/**
+ * The previous thread pool implementation: a single locked queue of
+ * std::functions, results delivered through shared promises. Baseline
+ * for the work-stealing `ThreadPool`.
+ *
+ * Implements the parts of `ThreadPool`'s interface that the benchmarks
+ * use the way the old pool's users did.
+ */
+class SingleQueuePool
+{
+public:
+    SingleQueuePool()
+    {
+        const uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t i = 0; i < numThreads; ++i)
+        {
+            workers.emplace_back([this]{
+                while (true)
+                {
+                    auto [work, terminate] = workQueue.wait_pop();
+                    if (terminate) break;
+                    work();
+                }
+            });
+        }
+    }
+
+    ~SingleQueuePool()
+    {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workQueue.push(Work{ .work=[]{}, .terminateThread=true });
+        }
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    template<typename Func>
+    auto async(Func&& func) -> std::future<std::invoke_result_t<Func>>
+    {
+        using ReturnType = std::invoke_result_t<Func>;
+
+        auto promise = std::make_shared<std::promise<ReturnType>>();
+        workQueue.push(Work{
+            .work=[promise, func = std::forward<Func>(func)]() mutable {
+                if constexpr (std::is_same_v<ReturnType, void>)
+                {
+                    func();
+                    promise->set_value();
+                }
+                else {
+                    promise->set_value(func());
+                }
+            },
+            .terminateThread=false
+        });
+
+        return promise->get_future();
+    }
+
+    /** The old pool had no fire-and-forget submission */
+    template<typename Func>
+    void execute(Func&& func)
+    {
+        async(std::forward<Func>(func));
+    }
+
+    template<typename Pred>
+    void waitUntil(Pred&& pred)
+    {
+        while (!pred()) {
+            std::this_thread::yield();
+        }
+    }
+
+    /** One task per chunk, joined through futures */
+    template<typename Func>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, Func&& func)
+    {
+        std::vector<std::future<void>> futures;
+        for (size_t chunk = begin; chunk < end; chunk += grainSize)
+        {
+            futures.emplace_back(async([&func, chunk, end, grainSize]{
+                const size_t chunkEnd = std::min(end, chunk + grainSize);
+                for (size_t i = chunk; i < chunkEnd; ++i) {
+                    func(i);
+                }
+            }));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+    }
+
+private:
+    struct Work
+    {
+        std::function<void()> work;
+        bool terminateThread;
+    };
+
+    std::vector<std::thread> workers;
+    trc::data::ThreadsafeQueue<Work> workQueue;
+};
+
+/**
+ * A small amount of work that the compiler can't optimize away
+ */
+static auto work(size_t i) -> float
+{
+    float x = static_cast<float>(i);
+    for (int j = 0; j < 50; ++j) {
+        x = std::sqrt(x + static_cast<float>(j));
+    }
+    return x;
+}
+
+template<typename Pool>
+static void ThreadPool_Async(benchmark::State& state)
+{
+    const size_t numTasks = state.range(0);
+    Pool pool;
+    std::vector<std::future<float>> futures;
+    futures.reserve(numTasks);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < numTasks; ++i) {
+            futures.emplace_back(pool.async([i]{ return work(i); }));
+        }
+        for (auto& f : futures) {
+            benchmark::DoNotOptimize(f.get());
+        }
+        futures.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+/**
+ * Every benchmark thread submits tasks without futures to a shared pool.
+ */
+template<typename Pool>
+static void ThreadPool_ExecuteConcurrent(benchmark::State& state)
+{
+    constexpr size_t kBatchSize{ 256 };
+    static Pool* pool{ nullptr };
+    if (state.thread_index() == 0) {
+        pool = new Pool;
+    }
+
+    std::atomic<size_t> done{ 0 };
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < kBatchSize; ++i) {
+            pool->execute([&done, i]{ benchmark::DoNotOptimize(work(i)); ++done; });
+        }
+        pool->waitUntil([&]{ return done == kBatchSize; });
+        done = 0;
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+
+    if (state.thread_index() == 0)
+    {
+        delete pool;
+        pool = nullptr;
+    }
+}
+
+template<typename Pool>
+static void ThreadPool_ParallelFor(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    constexpr size_t kGrainSize{ 1000 };
+    Pool pool;
+    std::vector<float> results(size);
+
+    for (auto _ : state)
+    {
+        pool.parallelFor(size_t{ 0 }, size, kGrainSize, [&](size_t i) {
+            results[i] = work(i);
+        });
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(ThreadPool_Async, ThreadPool)->Apply(containerSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(ThreadPool_Async, SingleQueuePool)->Apply(containerSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(ThreadPool_ExecuteConcurrent, ThreadPool)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(ThreadPool_ExecuteConcurrent, SingleQueuePool)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(ThreadPool_ParallelFor, ThreadPool)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->UseRealTime();
+BENCHMARK_TEMPLATE(ThreadPool_ParallelFor, SingleQueuePool)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->UseRealTime();
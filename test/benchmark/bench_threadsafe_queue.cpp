@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <trc_util/data/BoundedQueue.h>
+#include <trc_util/data/ThreadsafeQueue.h>
+
+#include "benchmark_common.h"
+
+using namespace trc::bench;
+using trc::data::BoundedQueue;
+using trc::data::QueueAccess;
+using trc::data::ThreadsafeQueue;
+
+using Clock = std::chrono::steady_clock;
+
+static void ThreadsafeQueue_PushPop(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    ThreadsafeQueue<uint64_t> queue;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            queue.push(i);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(queue.try_pop());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BoundedQueue_PushPop(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    BoundedQueue<uint64_t> queue(size);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            queue.try_push(i);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            benchmark::DoNotOptimize(queue.try_pop());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * Every thread both produces and consumes.
+ */
+template<typename Queue>
+static void Queue_Concurrent(benchmark::State& state)
+{
+    static Queue* queue{ nullptr };
+    if (state.thread_index() == 0) {
+        queue = new Queue(1 << 16);
+    }
+
+    uint64_t value{ 0 };
+    for (auto _ : state)
+    {
+        queue->try_push(++value);
+        benchmark::DoNotOptimize(queue->try_pop());
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        delete queue;
+        queue = nullptr;
+    }
+}
+
+/** Adapts ThreadsafeQueue to the interface of BoundedQueue */
+struct UnboundedQueue : ThreadsafeQueue<uint64_t>
+{
+    explicit UnboundedQueue(size_t) {}
+    bool try_push(uint64_t value) {
+        push(value);
+        return true;
+    }
+};
+
+/**
+ * `state.range(0)` producers push timestamps that as many consumers pop.
+ * Latency is the time between a push and the corresponding pop. Reports
+ * the mean and percentiles over all items of all iterations.
+ */
+template<typename Queue>
+static void Queue_Latency(benchmark::State& state)
+{
+    constexpr size_t kItemsPerIteration{ 1 << 16 };
+    const size_t numThreads = state.range(0);
+    const size_t itemsPerThread = kItemsPerIteration / numThreads;
+
+    Queue queue;
+    std::vector<std::vector<int64_t>> latencies(numThreads);
+    for (auto _ : state)
+    {
+        // Don't measure reallocations of the sample buffers
+        state.PauseTiming();
+        for (auto& samples : latencies) {
+            samples.reserve(samples.size() + itemsPerThread);
+        }
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&]{
+                for (size_t i = 0; i < itemsPerThread; ++i) {
+                    queue.push(Clock::now());
+                }
+            });
+            threads.emplace_back([&, t]{
+                auto& samples = latencies[t];
+                for (size_t i = 0; i < itemsPerThread; ++i)
+                {
+                    const Clock::time_point pushed = queue.wait_pop();
+                    samples.emplace_back((Clock::now() - pushed).count());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * itemsPerThread * numThreads);
+
+    std::vector<int64_t> all;
+    for (const auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    if (all.empty()) {
+        return;
+    }
+    std::ranges::sort(all);
+
+    auto percentile = [&](size_t p) { return static_cast<double>(all[all.size() * p / 1000]); };
+    double sum{ 0.0 };
+    for (const int64_t l : all) {
+        sum += static_cast<double>(l);
+    }
+    state.counters["mean_ns"] = sum / static_cast<double>(all.size());
+    state.counters["p50_ns"] = percentile(500);
+    state.counters["p99_ns"] = percentile(990);
+    state.counters["p999_ns"] = percentile(999);
+}
+
+BENCHMARK(ThreadsafeQueue_PushPop)->Apply(containerSizes);
+BENCHMARK(BoundedQueue_PushPop)->Apply(containerSizes);
+BENCHMARK_TEMPLATE(Queue_Concurrent, UnboundedQueue)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(Queue_Concurrent, BoundedQueue<uint64_t>)->Apply(threadCounts);
+
+BENCHMARK_TEMPLATE(Queue_Latency, ThreadsafeQueue<Clock::time_point>)
+    ->Arg(1)->Arg(4)->Arg(16)->Iterations(20)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_Latency, BoundedQueue<Clock::time_point>)
+    ->Arg(1)->Arg(4)->Arg(16)->Iterations(20)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_Latency,
+                   BoundedQueue<Clock::time_point, QueueAccess::eSingleProducerSingleConsumer>)
+    ->Arg(1)->Iterations(20)->UseRealTime();
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace trc::bench
+{
+    /**
+     * @brief Number of elements for benchmarks of single-threaded operations
+     */
+    inline void containerSizes(benchmark::internal::Benchmark* b)
+    {
+        b->RangeMultiplier(8)->Range(64, 1 << 15);
+    }
+
+    /**
+     * @brief Thread counts for benchmarks of concurrent access
+     */
+    inline void threadCounts(benchmark::internal::Benchmark* b)
+    {
+        b->ThreadRange(1, 16)->UseRealTime();
+    }
+
+    /**
+     * @brief A cheap pseudo-random sequence to scatter accesses
+     */
+    struct XorShift
+    {
+        auto operator()() -> uint64_t
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        uint64_t state{ 0x9e3779b97f4a7c15 };
+    };
+} // namespace trc::bench
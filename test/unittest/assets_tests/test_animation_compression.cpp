@@ -0,0 +1,160 @@
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trc/assets/Animation.h>
+#include <trc/assets/import/AnimationCompression.h>
+
+using namespace trc::basic_types;
+
+auto makeTestAnimation(ui32 frameCount) -> trc::AnimationData
+{
+    trc::AnimationData anim{
+        .name="test",
+        .frameCount=frameCount,
+        .durationMs=frameCount * 10.0f,
+        .frameTimeMs=10.0f,
+        .keyframes={},
+        .compressed=std::nullopt,
+    };
+
+    for (ui32 i = 0; i < frameCount; ++i)
+    {
+        const float f = static_cast<float>(i);
+        auto& kf = anim.keyframes.emplace_back();
+
+        // Constant bone
+        kf.boneMatrices.emplace_back(1.0f);
+
+        // Rotation at constant speed with an offset
+        mat4 rotating = glm::mat4_cast(glm::angleAxis(f * 0.05f, vec3(0, 1, 0)));
+        rotating[3] = vec4(0, 1, 0, 1);
+        kf.boneMatrices.push_back(rotating);
+
+        // Linear translation, non-linear rotation, uniform scale
+        mat4 moving = glm::mat4_cast(glm::angleAxis(std::sin(f * 0.1f), vec3(1, 0, 0)));
+        moving[0] *= 2.0f;
+        moving[1] *= 2.0f;
+        moving[2] *= 2.0f;
+        moving[3] = vec4(f * 0.1f, 0, -1, 1);
+        kf.boneMatrices.push_back(moving);
+    }
+
+    return anim;
+}
+
+TEST(AnimationCompressionTest, QuantizeRotation)
+{
+    const std::vector<quat> rotations{
+        quat(1, 0, 0, 0),
+        glm::angleAxis(0.3f, glm::normalize(vec3(1, 2, 3))),
+        glm::angleAxis(-2.5f, glm::normalize(vec3(-1, 0.5f, 0))),
+        glm::angleAxis(3.1f, vec3(0, 0, 1)),
+    };
+
+    for (const quat& q : rotations)
+    {
+        ui16 values[3];
+        trc::CompressedAnimation::quantizeRotation(q, values);
+        const quat res = trc::CompressedAnimation::dequantizeRotation(values);
+
+        const quat d = glm::conjugate(q) * res;
+        const float angle = 2.0f * std::atan2(glm::length(vec3(d.x, d.y, d.z)), std::abs(d.w));
+        ASSERT_LT(angle, 0.001f);
+    }
+}
+
+TEST(AnimationCompressionTest, ErrorIsBounded)
+{
+    const auto anim = makeTestAnimation(120);
+
+    trc::AnimationCompressionStats stats;
+    const auto compressed = trc::compressAnimation(anim, {}, &stats);
+
+    ASSERT_EQ(compressed.frameCount, 120);
+    ASSERT_EQ(compressed.getBoneCount(), 3);
+    ASSERT_EQ(stats.originalSize, 120 * 3 * sizeof(mat4));
+    ASSERT_EQ(stats.compressedSize, compressed.getSize());
+    ASSERT_GT(stats.getRatio(), 4.0f);
+    ASSERT_LT(stats.maxError, 0.01f);
+
+    // Constant tracks have a single key
+    ASSERT_EQ(compressed.bones[0].translation.frames.size(), 1);
+    ASSERT_EQ(compressed.bones[0].rotation.frames.size(), 1);
+    ASSERT_EQ(compressed.bones[0].scale.frames.size(), 1);
+    ASSERT_EQ(compressed.bones[2].scale.frames.size(), 1);
+
+    // Linear tracks are reduced to their end points
+    ASSERT_LE(compressed.bones[2].translation.frames.size(), 3);
+    ASSERT_EQ(compressed.bones[2].translation.frames.back(), 119);
+
+    std::vector<mat4> decoded(compressed.getBoneCount());
+    for (ui32 frame = 0; frame < anim.frameCount; ++frame)
+    {
+        compressed.sampleFrame(frame, decoded);
+        for (ui32 bone = 0; bone < decoded.size(); ++bone)
+        {
+            const mat4& expected = anim.keyframes[frame].boneMatrices[bone];
+            for (int col = 0; col < 4; ++col)
+            {
+                for (int row = 0; row < 4; ++row) {
+                    ASSERT_NEAR(decoded[bone][col][row], expected[col][row], 0.01f);
+                }
+            }
+        }
+    }
+}
+
+TEST(AnimationCompressionTest, ZeroToleranceKeepsAllKeys)
+{
+    const auto anim = makeTestAnimation(30);
+    const auto compressed = trc::compressAnimation(anim, {
+        .translationTolerance=0.0f,
+        .rotationTolerance=0.0f,
+        .scaleTolerance=0.0f,
+    });
+
+    ASSERT_EQ(compressed.bones[1].rotation.frames.size(), 30);
+    ASSERT_EQ(compressed.bones[1].rotation.values.size(), 30 * 3);
+}
+
+TEST(AnimationCompressionTest, SerializeCompressed)
+{
+    auto anim = makeTestAnimation(60);
+    trc::compressAnimationInPlace(anim);
+    ASSERT_TRUE(anim.keyframes.empty());
+    ASSERT_TRUE(anim.compressed.has_value());
+
+    std::stringstream ss;
+    anim.serialize(ss);
+
+    trc::AnimationData result;
+    result.deserialize(ss);
+
+    ASSERT_EQ(result.frameCount, anim.frameCount);
+    ASSERT_TRUE(result.keyframes.empty());
+    ASSERT_TRUE(result.compressed.has_value());
+    ASSERT_EQ(result.getBoneCount(), 3);
+
+    std::vector<mat4> expected(3);
+    std::vector<mat4> actual(3);
+    for (ui32 frame = 0; frame < anim.frameCount; ++frame)
+    {
+        anim.compressed->sampleFrame(frame, expected);
+        result.compressed->sampleFrame(frame, actual);
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST(AnimationCompressionTest, InvalidInput)
+{
+    trc::AnimationData empty;
+    ASSERT_THROW(trc::compressAnimation(empty), std::invalid_argument);
+
+    auto anim = makeTestAnimation(10);
+    anim.keyframes[5].boneMatrices.pop_back();
+    ASSERT_THROW(trc::compressAnimation(anim), std::invalid_argument);
+}
@@ -1,4 +1,6 @@
+#include <fstream>
 #include <unordered_map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -157,3 +159,106 @@ TEST_F(AssetStorageTest, Iterator)
     }
     ASSERT_TRUE(items.empty());
 }
+
+TEST_F(AssetStorageTest, IndexIsPersisted)
+{
+    const auto newRoot = rootDir / "asset_storage_index_test";
+    fs::create_directories(newRoot);
+    auto dataStorage = std::make_shared<trc::FilesystemDataStorage>(newRoot);
+
+    const trc::AssetPath cube("/cube");
+    const trc::AssetPath rig("/nested/rig");
+    {
+        trc::AssetStorage storage(dataStorage);
+        ASSERT_EQ(storage.getIndex().size(), 0);
+        ASSERT_TRUE(storage.store(cube, trc::makeCubeGeo()));
+        ASSERT_TRUE(storage.store(rig, trc::RigData{}));
+
+        // Modified indices are not persisted until they are flushed
+        ASSERT_FALSE(fs::exists(newRoot / trc::AssetIndex::kIndexPath));
+        storage.flushIndex();
+        ASSERT_TRUE(fs::exists(newRoot / trc::AssetIndex::kIndexPath));
+    }
+
+    // Remove the metadata files to ensure that they are not read anymore
+    fs::remove(newRoot / "cube.meta");
+    fs::remove(newRoot / "nested/rig.meta");
+
+    trc::AssetStorage storage(dataStorage);
+    ASSERT_EQ(storage.getIndex().size(), 2);
+    ASSERT_TRUE(storage.getMetadata(cube)->type.is<trc::Geometry>());
+    ASSERT_TRUE(storage.getMetadata(rig)->type.is<trc::Rig>());
+    ASSERT_EQ(storage.getMetadata(rig)->name, "rig");
+    ASSERT_TRUE(storage.load<trc::Geometry>(cube).has_value());
+
+    std::vector<trc::AssetPath> paths;
+    for (const auto& path : storage) {
+        paths.emplace_back(path);
+    }
+    ASSERT_EQ(paths, (std::vector<trc::AssetPath>{ cube, rig }));
+}
+
+TEST_F(AssetStorageTest, IndexIsRebuiltIfMissing)
+{
+    const auto newRoot = rootDir / "asset_storage_index_rebuild_test";
+    fs::create_directories(newRoot);
+    auto dataStorage = std::make_shared<trc::FilesystemDataStorage>(newRoot);
+
+    const trc::AssetPath path("/geo");
+    const auto geo = trc::makeSphereGeo();
+    {
+        trc::AssetStorage storage(dataStorage);
+        ASSERT_TRUE(storage.store(path, geo));
+    }
+    const auto entry = trc::AssetStorage(dataStorage).getIndex().find(path);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->dataSize, fs::file_size(newRoot / "geo.data"));
+
+    fs::remove(newRoot / trc::AssetIndex::kIndexPath);
+
+    trc::AssetStorage storage(dataStorage);
+    auto rebuilt = storage.getIndex().find(path);
+    ASSERT_TRUE(rebuilt.has_value());
+    ASSERT_TRUE(rebuilt->metadata.type.is<trc::Geometry>());
+    ASSERT_EQ(rebuilt->dataSize, entry->dataSize);
+    ASSERT_EQ(rebuilt->contentHash, entry->contentHash);
+
+    // The content hash reflects the stored data
+    ASSERT_TRUE(storage.store(path, trc::makeCubeGeo()));
+    ASSERT_NE(storage.getIndex().find(path)->contentHash, entry->contentHash);
+
+    ASSERT_TRUE(storage.remove(path));
+    ASSERT_FALSE(storage.getIndex().contains(path));
+    ASSERT_FALSE(storage.getMetadata(path).has_value());
+}
+
+TEST_F(AssetStorageTest, IndexIsValidatedOnLoad)
+{
+    const auto newRoot = rootDir / "asset_storage_index_validate_test";
+    fs::create_directories(newRoot);
+    auto dataStorage = std::make_shared<trc::FilesystemDataStorage>(newRoot);
+
+    const trc::AssetPath cube("/cube");
+    const trc::AssetPath sphere("/sphere");
+    const trc::AssetPath added("/added");
+    {
+        trc::AssetStorage storage(dataStorage);
+        ASSERT_TRUE(storage.store(cube, trc::makeCubeGeo()));
+        ASSERT_TRUE(storage.store(sphere, trc::makeSphereGeo()));
+    }
+    ASSERT_TRUE(fs::exists(newRoot / trc::AssetIndex::kIndexPath));
+
+    // Modify the storage behind the index's back
+    fs::remove(newRoot / "sphere.data");
+    fs::copy_file(newRoot / "cube.meta", newRoot / "added.meta");
+    std::ofstream(newRoot / "added.data") << "new";
+    std::ofstream(newRoot / "cube.data") << "resized";
+
+    trc::AssetStorage storage(dataStorage);
+    ASSERT_EQ(storage.getIndex().size(), 2);
+    ASSERT_FALSE(storage.getIndex().contains(sphere));
+    ASSERT_EQ(storage.getIndex().find(cube)->dataSize, 7);
+    ASSERT_EQ(storage.getIndex().find(cube)->contentHash, trc::AssetIndex::hashContent("resized"));
+    ASSERT_EQ(storage.getIndex().find(added)->dataSize, 3);
+    ASSERT_TRUE(storage.getMetadata(added)->type.is<trc::Geometry>());
+}
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+#include <trc/assets/AssetStorage.h>
+#include <trc/assets/import/BinaryGeometry.h>
+#include <trc/assets/import/GeneratedGeometry.h>
+#include <trc/assets/import/GeometryTransformations.h>
+#include <trc/assets/import/InternalFormat.h>
+#include <trc/util/FilesystemDataStorage.h>
+
+#include "test_utils.h"
+
+using namespace trc::basic_types;
+
+void assertGeometryEqual(const trc::GeometryData& a, const trc::GeometryData& b)
+{
+    ASSERT_EQ(a.indices, b.indices);
+    ASSERT_EQ(a.vertices.size(), b.vertices.size());
+    ASSERT_EQ(a.skeletalVertices.size(), b.skeletalVertices.size());
+    for (size_t i = 0; i < a.vertices.size(); ++i)
+    {
+        ASSERT_EQ(a.vertices[i].position, b.vertices[i].position);
+        ASSERT_EQ(a.vertices[i].normal, b.vertices[i].normal);
+        ASSERT_EQ(a.vertices[i].uv, b.vertices[i].uv);
+        ASSERT_EQ(a.vertices[i].tangent, b.vertices[i].tangent);
+    }
+    for (size_t i = 0; i < a.skeletalVertices.size(); ++i)
+    {
+        ASSERT_EQ(a.skeletalVertices[i].boneIndices, b.skeletalVertices[i].boneIndices);
+        ASSERT_EQ(a.skeletalVertices[i].boneWeights, b.skeletalVertices[i].boneWeights);
+    }
+}
+
+TEST(BinaryGeometryTest, RoundTrip)
+{
+    auto geo = trc::makeSphereGeo();
+    geo.skeletalVertices.resize(geo.vertices.size(), { uvec4(1, 2, 3, 4), vec4(0.25f) });
+    geo.rig = trc::AssetReference<trc::Rig>(trc::AssetPath("/my/rig"));
+
+    std::stringstream ss;
+    geo.serialize(ss);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+
+    assertGeometryEqual(geo, result);
+    ASSERT_TRUE(result.rig.hasAssetPath());
+    ASSERT_EQ(result.rig.getAssetPath(), trc::AssetPath("/my/rig"));
+}
+
+TEST(BinaryGeometryTest, EmptyGeometry)
+{
+    std::stringstream ss;
+    trc::GeometryData{}.serialize(ss);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+
+    ASSERT_TRUE(result.vertices.empty());
+    ASSERT_TRUE(result.skeletalVertices.empty());
+    ASSERT_TRUE(result.indices.empty());
+    ASSERT_TRUE(result.rig.empty());
+}
+
+TEST(BinaryGeometryTest, LegacyFormatIsReadable)
+{
+    const auto geo = trc::makeCubeGeo();
+
+    std::stringstream ss;
+    trc::internal::serializeAssetData(geo).SerializeToOstream(&ss);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+
+    assertGeometryEqual(geo, result);
+}
+
+TEST(BinaryGeometryTest, ViewMappedData)
+{
+    const fs::path rootDir = makeTempDir();
+    auto storage = std::make_shared<trc::FilesystemDataStorage>(rootDir);
+    trc::AssetStorage assets(storage);
+
+    const trc::AssetPath path("/geo");
+    const auto geo = trc::makeSphereGeo();
+    ASSERT_TRUE(assets.store(path, geo));
+
+    auto mapped = assets.mapData(path);
+    ASSERT_TRUE(mapped.has_value());
+    ASSERT_TRUE(trc::internal::isBinaryGeometry(mapped->data));
+
+    auto view = trc::internal::BinaryGeometryView::make(mapped->data);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->getVertices().size(), geo.vertices.size());
+    ASSERT_EQ(view->getIndices().size(), geo.indices.size());
+    ASSERT_TRUE(view->getSkeletalVertices().empty());
+    ASSERT_FALSE(view->hasRig());
+    ASSERT_TRUE(std::ranges::equal(view->getIndices(), geo.indices));
+
+    assertGeometryEqual(geo, view->toGeometryData());
+
+    ASSERT_FALSE(assets.mapData(trc::AssetPath("/does_not_exist")).has_value());
+}
+
+TEST(BinaryGeometryTest, TriangleOrderOptimizedFlag)
+{
+    auto geo = trc::makeSphereGeo();
+    ASSERT_FALSE(geo.triangleOrderOptimized);
+
+    auto sortedIndices = geo.indices;
+    std::ranges::sort(sortedIndices);
+
+    ASSERT_TRUE(trc::optimizeTriangleOrder(geo));
+    ASSERT_TRUE(geo.triangleOrderOptimized);
+    auto optimizedIndices = geo.indices;
+    std::ranges::sort(optimizedIndices);
+    ASSERT_EQ(sortedIndices, optimizedIndices);
+
+    // Binary format
+    std::stringstream ss;
+    geo.serialize(ss);
+    const std::string buf = ss.str();
+    ASSERT_TRUE(reinterpret_cast<const trc::internal::BinaryGeometryHeader*>(buf.data())->flags
+                & trc::internal::kBinaryGeometryTriangleOrderOptimized);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+    ASSERT_TRUE(result.triangleOrderOptimized);
+    assertGeometryEqual(geo, result);
+
+    // Legacy format
+    std::stringstream legacy;
+    trc::internal::serializeAssetData(geo).SerializeToOstream(&legacy);
+    trc::GeometryData legacyResult;
+    legacyResult.deserialize(legacy);
+    ASSERT_TRUE(legacyResult.triangleOrderOptimized);
+
+    // Unoptimized geometries don't have the flag
+    std::stringstream unoptimized;
+    trc::makeCubeGeo().serialize(unoptimized);
+    result.deserialize(unoptimized);
+    ASSERT_FALSE(result.triangleOrderOptimized);
+}
+
+TEST(BinaryGeometryTest, InvalidData)
+{
+    std::stringstream ss;
+    trc::makeCubeGeo().serialize(ss);
+    const std::string buf = ss.str();
+
+    // Use an aligned buffer so that we only test the validation logic
+    struct alignas(trc::internal::kBinaryGeometryAlignment) Block {
+        std::byte data[trc::internal::kBinaryGeometryAlignment];
+    };
+    std::vector<Block> mem(buf.size() / sizeof(Block) + 1);
+    memcpy(mem.data(), buf.data(), buf.size());
+    const auto bytes = std::as_bytes(std::span{ mem }).first(buf.size());
+
+    ASSERT_TRUE(trc::internal::BinaryGeometryView::make(bytes).has_value());
+    ASSERT_FALSE(trc::internal::BinaryGeometryView::make(bytes.first(bytes.size() - 1)));
+    ASSERT_FALSE(trc::internal::BinaryGeometryView::make(bytes.first(10)));
+    ASSERT_FALSE(trc::internal::BinaryGeometryView::make(bytes.subspan(4)));
+
+    // Truncated stream
+    std::stringstream truncated(buf.substr(0, buf.size() / 2));
+    trc::GeometryData result;
+    ASSERT_THROW(result.deserialize(truncated), std::runtime_error);
+
+    // Counts that exceed the stream are rejected before anything is
+    // allocated
+    for (const ui64 numIndices : { ui64{ 1 } << 40, std::numeric_limits<ui64>::max() })
+    {
+        trc::internal::BinaryGeometryHeader header;
+        memcpy(&header, buf.data(), sizeof(header));
+        header.numIndices = numIndices;
+        std::string corrupt = buf;
+        memcpy(corrupt.data(), &header, sizeof(header));
+
+        std::stringstream is(corrupt);
+        ASSERT_THROW(result.deserialize(is), std::runtime_error);
+    }
+}
+
+TEST(BinaryGeometryTest, OctahedralEncoding)
+{
+    const std::vector<vec3> dirs{
+        vec3(1, 0, 0), vec3(0, -1, 0), vec3(0, 0, 1), vec3(0, 0, -1),
+        glm::normalize(vec3(1, 2, 3)),
+        glm::normalize(vec3(-0.3f, 0.1f, -0.9f)),
+        glm::normalize(vec3(-1, -1, -1)),
+    };
+
+    for (const vec3& dir : dirs)
+    {
+        const vec3 res = trc::unpackOctahedral(trc::packOctahedral(dir));
+        ASSERT_NEAR(glm::length(res), 1.0f, 1e-5f);
+        ASSERT_GT(glm::dot(res, dir), 0.99999f);
+    }
+}
+
+TEST(BinaryGeometryTest, PackedVertices)
+{
+    const auto geo = trc::makeSphereGeo();
+    auto packed = geo;
+    trc::packVertexData(packed);
+
+    ASSERT_EQ(packed.getVertexFormat(), trc::VertexFormat::ePacked);
+    ASSERT_EQ(packed.getVertexCount(), geo.vertices.size());
+    ASSERT_TRUE(packed.vertices.empty());
+
+    // Binary format stores packed vertices as-is
+    std::stringstream ss;
+    packed.serialize(ss);
+    const std::string buf = ss.str();
+    const auto& header = *reinterpret_cast<const trc::internal::BinaryGeometryHeader*>(buf.data());
+    ASSERT_TRUE(header.flags & trc::internal::kBinaryGeometryPackedVertices);
+    ASSERT_EQ(header.vertexSize, sizeof(trc::PackedMeshVertex));
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+    ASSERT_EQ(result.getVertexFormat(), trc::VertexFormat::ePacked);
+    ASSERT_EQ(result.quantization.offset, packed.quantization.offset);
+    ASSERT_EQ(result.quantization.scale, packed.quantization.scale);
+    ASSERT_EQ(result.indices, packed.indices);
+    ASSERT_EQ(result.packedVertices.size(), packed.packedVertices.size());
+    ASSERT_EQ(0, memcmp(result.packedVertices.data(), packed.packedVertices.data(),
+                        packed.packedVertices.size() * sizeof(trc::PackedMeshVertex)));
+
+    // Unpacked vertices are close to the originals
+    trc::unpackVertexData(result);
+    ASSERT_EQ(result.getVertexFormat(), trc::VertexFormat::eFull);
+    ASSERT_EQ(result.vertices.size(), geo.vertices.size());
+    const float posTolerance = glm::length(packed.quantization.scale) / 65535.0f;
+    for (size_t i = 0; i < geo.vertices.size(); ++i)
+    {
+        const auto& a = geo.vertices[i];
+        const auto& b = result.vertices[i];
+        ASSERT_LE(glm::distance(a.position, b.position), posTolerance);
+        ASSERT_NEAR(glm::distance(a.normal, b.normal), 0.0f, 1e-3f);
+        ASSERT_NEAR(glm::distance(a.uv, b.uv), 0.0f, 1e-3f);
+    }
+
+    // The legacy format does not support packed vertices
+    std::stringstream legacy;
+    trc::internal::serializeAssetData(packed).SerializeToOstream(&legacy);
+    trc::GeometryData legacyResult;
+    legacyResult.deserialize(legacy);
+    ASSERT_EQ(legacyResult.getVertexFormat(), trc::VertexFormat::eFull);
+    assertGeometryEqual(result, legacyResult);
+}
+
+TEST(BinaryGeometryTest, Bounds)
+{
+    auto geo = trc::makeSphereGeo();
+    ASSERT_FALSE(geo.bounds.has_value());
+
+    trc::computeBounds(geo);
+    ASSERT_TRUE(geo.bounds.has_value());
+    const auto bounds = *geo.bounds;
+    for (const auto& v : geo.vertices)
+    {
+        ASSERT_TRUE(glm::all(glm::lessThanEqual(bounds.min, v.position)));
+        ASSERT_TRUE(glm::all(glm::greaterThanEqual(bounds.max, v.position)));
+        ASSERT_LE(glm::distance(bounds.center, v.position), bounds.radius + 1e-5f);
+    }
+
+    // Bounds of packed vertices contain the dequantized positions
+    auto packed = geo;
+    trc::packVertexData(packed);
+    const auto packedBounds = trc::GeometryBounds::fromVertices(packed.packedVertices,
+                                                                packed.quantization);
+    for (const auto& v : packed.packedVertices)
+    {
+        const vec3 pos = packed.quantization.dequantize(v.position);
+        ASSERT_TRUE(glm::all(glm::lessThanEqual(packedBounds.min, pos)));
+        ASSERT_TRUE(glm::all(glm::greaterThanEqual(packedBounds.max, pos)));
+    }
+
+    // Binary format stores the bounds
+    geo.bounds = trc::GeometryBounds::fromBox(vec3(-2.0f), vec3(3.0f));
+    std::stringstream ss;
+    geo.serialize(ss);
+    const std::string buf = ss.str();
+    const auto& header = *reinterpret_cast<const trc::internal::BinaryGeometryHeader*>(buf.data());
+    ASSERT_TRUE(header.flags & trc::internal::kBinaryGeometryBounds);
+    ASSERT_FALSE(header.flags & trc::internal::kBinaryGeometryAnimatedBounds);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+    ASSERT_TRUE(result.bounds.has_value());
+    ASSERT_EQ(result.bounds->min, vec3(-2.0f));
+    ASSERT_EQ(result.bounds->max, vec3(3.0f));
+    ASSERT_FALSE(result.animatedBounds.has_value());
+
+    // The legacy format computes bounds on load
+    std::stringstream legacy;
+    trc::internal::serializeAssetData(trc::makeCubeGeo()).SerializeToOstream(&legacy);
+    trc::GeometryData legacyResult;
+    legacyResult.deserialize(legacy);
+    ASSERT_TRUE(legacyResult.bounds.has_value());
+    ASSERT_EQ(legacyResult.bounds->min, trc::makeCubeGeo().getBounds().min);
+    ASSERT_EQ(legacyResult.bounds->max, trc::makeCubeGeo().getBounds().max);
+}
+
+TEST(BinaryGeometryTest, AnimatedBounds)
+{
+    auto geo = trc::makeCubeGeo();
+    trc::computeAnimatedBounds(geo, {});
+    ASSERT_FALSE(geo.animatedBounds.has_value());
+
+    // All vertices are attached to bone 1
+    geo.skeletalVertices.resize(geo.vertices.size(), { uvec4(1, 0, 0, 0), vec4(1, 0, 0, 0) });
+    trc::computeBounds(geo);
+
+    trc::AnimationData anim;
+    anim.frameCount = 2;
+    anim.keyframes = {
+        { .boneMatrices={ mat4(1.0f), mat4(1.0f) } },
+        { .boneMatrices={ mat4(1.0f), glm::translate(mat4(1.0f), vec3(5, 0, 0)) } },
+    };
+    trc::computeAnimatedBounds(geo, std::span{ &anim, 1 });
+    ASSERT_TRUE(geo.animatedBounds.has_value());
+    ASSERT_EQ(geo.animatedBounds->min, geo.bounds->min);
+    ASSERT_FLOAT_EQ(geo.animatedBounds->max.x, geo.bounds->max.x + 5.0f);
+    ASSERT_FLOAT_EQ(geo.animatedBounds->max.y, geo.bounds->max.y);
+    ASSERT_GE(geo.animatedBounds->radius, geo.bounds->radius);
+
+    // Round trip through the binary format and a mapped view
+    std::stringstream ss;
+    geo.serialize(ss);
+    const std::string buf = ss.str();
+    ASSERT_TRUE(reinterpret_cast<const trc::internal::BinaryGeometryHeader*>(buf.data())->flags
+                & trc::internal::kBinaryGeometryAnimatedBounds);
+
+    trc::GeometryData result;
+    result.deserialize(ss);
+    ASSERT_TRUE(result.animatedBounds.has_value());
+    ASSERT_EQ(result.animatedBounds->min, geo.animatedBounds->min);
+    ASSERT_EQ(result.animatedBounds->max, geo.animatedBounds->max);
+
+    const fs::path rootDir = makeTempDir();
+    trc::AssetStorage assets(std::make_shared<trc::FilesystemDataStorage>(rootDir));
+    ASSERT_TRUE(assets.store(trc::AssetPath("/anim_geo"), geo));
+    auto mapped = assets.mapData(trc::AssetPath("/anim_geo"));
+    ASSERT_TRUE(mapped.has_value());
+    auto view = trc::internal::BinaryGeometryView::make(mapped->data);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->getBounds().max, geo.bounds->max);
+    ASSERT_TRUE(view->getAnimatedBounds().has_value());
+    ASSERT_EQ(view->getAnimatedBounds()->max, geo.animatedBounds->max);
+}
@@ -1,3 +1,8 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -186,3 +191,332 @@ TEST(DeviceDataCacheTest, MultipleHandlesToSameObject)
     ASSERT_EQ(numCreates, 1);
     ASSERT_EQ(numFrees, 1);
 }
+
+auto makeAsyncCache(auto load, auto free, s_ptr<trc::async::ThreadPool> threads)
+    -> trc::DeviceDataCache<MyData>
+{
+    return trc::DeviceDataCache<MyData>{
+        trc::DeviceDataCache<MyData>::makeLoader(std::move(load), std::move(free)),
+        std::move(threads)
+    };
+}
+
+/**
+ * A loader that blocks until it is released by the test
+ */
+struct BlockingLoader
+{
+    void release()
+    {
+        std::scoped_lock lock(mutex);
+        released = true;
+        cvar.notify_all();
+    }
+
+    auto load(ui32 id) -> MyData
+    {
+        std::unique_lock lock(mutex);
+        cvar.wait(lock, [this]{ return released; });
+        ++numLoads;
+        if (id == kFailingId) {
+            throw std::runtime_error("Load failed");
+        }
+        return MyData{ "loaded", i64{ id } };
+    }
+
+    static constexpr ui32 kFailingId{ 666 };
+
+    std::mutex mutex;
+    std::condition_variable cvar;
+    bool released{ false };
+    std::atomic<ui32> numLoads{ 0 };
+    std::atomic<ui32> numFrees{ 0 };
+};
+
+TEST(DeviceDataCacheTest, AsyncLoadWithFallback)
+{
+    BlockingLoader loader;
+    loader.released = true;  // Don't block for the fallback
+
+    auto cache = makeAsyncCache(
+        [&](ui32 id){ return loader.load(id); },
+        [&](ui32, MyData){ ++loader.numFrees; },
+        std::make_shared<trc::async::ThreadPool>(2)
+    );
+
+    auto fallback = cache.get(0);
+    ASSERT_TRUE(fallback.isLoaded());
+    ASSERT_EQ(fallback->num, 0);
+
+    loader.released = false;
+    std::atomic<bool> callbackCalled{ false };
+    auto handle = cache.getAsync(7, fallback, [&](ui32 id, bool success) {
+        ASSERT_EQ(id, 7);
+        ASSERT_TRUE(success);
+        callbackCalled = true;
+    });
+
+    // Handle refers to the fallback while loading
+    ASSERT_FALSE(handle.isLoaded());
+    ASSERT_EQ(handle->num, 0);
+    ASSERT_FALSE(callbackCalled);
+
+    loader.release();
+    handle.wait();
+    ASSERT_TRUE(handle.isLoaded());
+    ASSERT_EQ(handle->num, 7);
+    ASSERT_EQ(handle->string, "loaded");
+
+    cache.waitIdle();
+    ASSERT_TRUE(callbackCalled);
+    ASSERT_EQ(loader.numLoads, 2);
+
+    // Already loaded entries invoke the callback immediately
+    bool immediateCallback{ false };
+    auto handle2 = cache.getAsync(7, std::nullopt, [&](ui32, bool){ immediateCallback = true; });
+    ASSERT_TRUE(immediateCallback);
+    ASSERT_TRUE(handle2.isLoaded());
+    ASSERT_EQ(loader.numLoads, 2);
+}
+
+TEST(DeviceDataCacheTest, AsyncLoadWithoutFallback)
+{
+    BlockingLoader loader;
+    auto cache = makeAsyncCache(
+        [&](ui32 id){ return loader.load(id); },
+        [&](ui32, MyData){ ++loader.numFrees; },
+        std::make_shared<trc::async::ThreadPool>(2)
+    );
+
+    auto handle = cache.getAsync(3);
+    ASSERT_FALSE(handle.isLoaded());
+    ASSERT_EQ(handle.operator->(), nullptr);
+
+    auto future = handle.getFuture();
+    ASSERT_EQ(future.wait_for(std::chrono::milliseconds(1)), std::future_status::timeout);
+
+    loader.release();
+    future.wait();
+    ASSERT_TRUE(handle.isLoaded());
+    ASSERT_EQ(handle->num, 3);
+
+    // Blocking `get` returns the same entry
+    auto handle2 = cache.get(3);
+    ASSERT_EQ(&*handle2, &*handle);
+    ASSERT_EQ(loader.numLoads, 1);
+}
+
+TEST(DeviceDataCacheTest, AsyncHandleDroppedWhileLoading)
+{
+    BlockingLoader loader;
+    auto cache = makeAsyncCache(
+        [&](ui32 id){ return loader.load(id); },
+        [&](ui32, MyData){ ++loader.numFrees; },
+        std::make_shared<trc::async::ThreadPool>(2)
+    );
+
+    cache.getAsync(1);
+    cache.getAsync(2);
+    auto revived = cache.getAsync(2);
+    {
+        auto dropped = cache.getAsync(5);
+    }
+
+    loader.release();
+    cache.waitIdle();
+
+    // Entries without handles are freed once loaded
+    ASSERT_EQ(loader.numLoads, 3);
+    ASSERT_EQ(loader.numFrees, 2);
+    ASSERT_TRUE(revived.isLoaded());
+    ASSERT_EQ(revived->num, 2);
+
+    // A dropped entry is loaded again on the next access
+    auto handle = cache.get(5);
+    ASSERT_EQ(handle->num, 5);
+    ASSERT_EQ(loader.numLoads, 4);
+}
+
+TEST(DeviceDataCacheTest, AsyncLoadFailure)
+{
+    BlockingLoader loader;
+    loader.released = true;
+
+    auto cache = makeAsyncCache(
+        [&](ui32 id){ return loader.load(id); },
+        [&](ui32, MyData){ ++loader.numFrees; },
+        std::make_shared<trc::async::ThreadPool>(2)
+    );
+
+    std::atomic<bool> success{ true };
+    auto handle = cache.getAsync(BlockingLoader::kFailingId, std::nullopt,
+                                 [&](ui32, bool s){ success = s; });
+    ASSERT_THROW(handle.wait(), std::runtime_error);
+    cache.waitIdle();
+    ASSERT_FALSE(success);
+    ASSERT_FALSE(handle.isLoaded());
+
+    // Failed loads are retried
+    ASSERT_THROW(cache.get(BlockingLoader::kFailingId), std::runtime_error);
+    ASSERT_EQ(loader.numLoads, 2);
+    ASSERT_EQ(loader.numFrees, 0);
+}
+
+auto makeSizedCache(auto load, auto free, auto size) -> trc::DeviceDataCache<MyData>
+{
+    return trc::DeviceDataCache<MyData>{
+        trc::DeviceDataCache<MyData>::makeLoader(std::move(load), std::move(free), std::move(size))
+    };
+}
+
+TEST(DeviceDataCacheTest, RetainedEntriesAreReused)
+{
+    int numLoads{ 0 };
+    std::unordered_set<ui32> loaded;
+    auto cache = makeSizedCache(
+        [&](ui32 id){ ++numLoads; loaded.emplace(id); return MyData{ "", i64{ id } }; },
+        [&](ui32 id, MyData){ loaded.erase(id); },
+        [](ui32, const MyData&){ return size_t{ 10 }; }
+    );
+    cache.setRetentionBudget(100);
+
+    cache.get(1);
+    ASSERT_TRUE(loaded.contains(1));
+    ASSERT_EQ(cache.getStats().retainedEntries, 1);
+    ASSERT_EQ(cache.getStats().retainedBytes, 10);
+
+    auto handle = cache.get(1);
+    ASSERT_EQ(handle->num, 1);
+    ASSERT_EQ(numLoads, 1);
+    ASSERT_EQ(cache.getStats().retainedEntries, 0);
+    ASSERT_EQ(cache.getStats().retainedBytes, 0);
+
+    const auto stats = cache.getStats();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 1);
+    ASSERT_EQ(stats.evictions, 0);
+}
+
+TEST(DeviceDataCacheTest, LeastRecentlyUsedEntryIsEvicted)
+{
+    std::unordered_set<ui32> loaded;
+    auto cache = makeSizedCache(
+        [&](ui32 id){ loaded.emplace(id); return MyData{ "", i64{ id } }; },
+        [&](ui32 id, MyData){ loaded.erase(id); },
+        [](ui32 id, const MyData&){ return size_t{ id == 10 ? 100u : 10u }; }
+    );
+    cache.setRetentionBudget(30);
+
+    cache.get(1);
+    cache.get(2);
+    cache.get(3);
+    cache.get(1);  // Move 1 to the back of the LRU list
+    ASSERT_EQ(loaded, (std::unordered_set<ui32>{ 1, 2, 3 }));
+
+    cache.get(4);
+    ASSERT_EQ(loaded, (std::unordered_set<ui32>{ 1, 3, 4 }));
+    ASSERT_EQ(cache.getStats().evictions, 1);
+    ASSERT_EQ(cache.getStats().retainedBytes, 30);
+
+    // Entries larger than the budget are never retained
+    cache.get(10);
+    ASSERT_FALSE(loaded.contains(10));
+    ASSERT_EQ(loaded, (std::unordered_set<ui32>{ 1, 3, 4 }));
+
+    // Shrinking the budget evicts entries
+    cache.setRetentionBudget(10);
+    ASSERT_EQ(loaded, (std::unordered_set<ui32>{ 4 }));
+    ASSERT_EQ(cache.getStats().evictions, 3);
+
+    cache.setRetentionBudget(0);
+    ASSERT_TRUE(loaded.empty());
+    ASSERT_EQ(cache.getStats().retainedEntries, 0);
+}
+
+TEST(DeviceDataCacheTest, EvictRetainedEntry)
+{
+    std::unordered_set<ui32> loaded;
+    {
+        auto cache = makeSizedCache(
+            [&](ui32 id){ loaded.emplace(id); return MyData{ "", i64{ id } }; },
+            [&](ui32 id, MyData){ loaded.erase(id); },
+            [](ui32, const MyData&){ return size_t{ 1 }; }
+        );
+        cache.setRetentionBudget(10);
+
+        auto handle = cache.get(1);
+        cache.get(2);
+        cache.get(3);
+        ASSERT_FALSE(cache.evict(1));  // Still referenced
+        ASSERT_FALSE(cache.evict(4));  // Not in the cache
+        ASSERT_TRUE(cache.evict(2));
+        ASSERT_EQ(loaded, (std::unordered_set<ui32>{ 1, 3 }));
+        ASSERT_EQ(cache.getStats().retainedEntries, 1);
+    }
+
+    // Retained entries are freed when the cache is destroyed
+    ASSERT_TRUE(loaded.empty());
+}
+
+TEST(DeviceDataCacheTest, AsyncLoadIsRetainedWhenOrphaned)
+{
+    BlockingLoader loader;
+    auto cache = makeAsyncCache(
+        [&](ui32 id){ return loader.load(id); },
+        [&](ui32, MyData){ ++loader.numFrees; },
+        std::make_shared<trc::async::ThreadPool>(2)
+    );
+    cache.setRetentionBudget(sizeof(MyData));
+
+    cache.getAsync(7);
+    loader.release();
+    cache.waitIdle();
+    ASSERT_EQ(loader.numFrees, 0);
+    ASSERT_EQ(cache.getStats().retainedEntries, 1);
+
+    auto handle = cache.getAsync(7);
+    ASSERT_TRUE(handle.isLoaded());
+    ASSERT_EQ(handle->num, 7);
+    ASSERT_EQ(loader.numLoads, 1);
+}
+
+TEST(DeviceDataCacheTest, ConcurrentHandlesToSameEntry)
+{
+    constexpr ui32 kNumIds{ 3 };
+    constexpr int kNumThreads{ 4 };
+    constexpr int kNumIterations{ 2000 };
+
+    std::atomic<int> live[kNumIds]{};
+    std::atomic<int> numLoads{ 0 };
+    std::atomic<int> numFrees{ 0 };
+    std::atomic<bool> doubleLoad{ false };
+    auto cache = makeCache(
+        [&](ui32 id){
+            doubleLoad = doubleLoad || live[id].fetch_add(1) != 0;
+            ++numLoads;
+            return MyData{ "", i64{ id } };
+        },
+        [&](ui32 id, MyData){ --live[id]; ++numFrees; }
+    );
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            for (int i = 0; i < kNumIterations; ++i)
+            {
+                const ui32 id = (t + i) % kNumIds;
+                auto handle = cache.get(id);
+                auto copy = handle;
+                ASSERT_EQ(copy->num, id);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    ASSERT_FALSE(doubleLoad);
+    ASSERT_EQ(numLoads, numFrees);
+    for (auto& n : live) {
+        ASSERT_EQ(n, 0);
+    }
+}
@@ -0,0 +1,169 @@
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trc/assets/Texture.h>
+#include <trc/assets/import/TextureCompression.h>
+
+using namespace trc::basic_types;
+
+auto makeTestTexture(uvec2 size) -> trc::TextureData
+{
+    trc::TextureData tex{ .size=size, .pixels{} };
+    for (ui32 y = 0; y < size.y; ++y)
+    {
+        for (ui32 x = 0; x < size.x; ++x) {
+            tex.pixels.emplace_back(x * 16, y * 16, (x + y) * 8, 255);
+        }
+    }
+
+    return tex;
+}
+
+TEST(TextureFormatTest, DataSize)
+{
+    using trc::TextureFormat;
+
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eRGBA8, { 5, 3 }), 60);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC1, { 4, 4 }), 8);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC1, { 5, 3 }), 16);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC1, { 1, 1 }), 8);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC3, { 8, 8 }), 64);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC5, { 9, 4 }), 48);
+    ASSERT_EQ(trc::getTextureDataSize(TextureFormat::eBC7, { 4, 8 }), 32);
+}
+
+TEST(TextureFormatTest, MipChain)
+{
+    const auto tex = makeTestTexture({ 12, 5 });
+    const auto levels = trc::generateMipChain(tex.size, tex.pixels);
+
+    const std::vector<uvec2> expectedSizes{ { 12, 5 }, { 6, 2 }, { 3, 1 }, { 1, 1 } };
+    ASSERT_EQ(levels.size(), expectedSizes.size());
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        ASSERT_EQ(levels[i].size, expectedSizes[i]);
+        ASSERT_EQ(levels[i].data.size(), size_t{levels[i].size.x} * levels[i].size.y * 4);
+    }
+
+    // Box filter of a uniform image is the same color
+    const trc::TextureData uniform{ .size{ 4, 4 }, .pixels=std::vector(16, glm::u8vec4(10, 20, 30, 40)) };
+    for (const auto& level : trc::generateMipChain(uniform.size, uniform.pixels))
+    {
+        for (size_t i = 0; i < level.data.size(); i += 4)
+        {
+            ASSERT_EQ(level.data[i + 0], 10);
+            ASSERT_EQ(level.data[i + 1], 20);
+            ASSERT_EQ(level.data[i + 2], 30);
+            ASSERT_EQ(level.data[i + 3], 40);
+        }
+    }
+}
+
+TEST(TextureFormatTest, EncodeBC1SolidColor)
+{
+    // Pure red (0xf800 in RGB565) encodes exactly
+    const std::vector<glm::u8vec4> pixels(16, glm::u8vec4(255, 0, 0, 255));
+    const auto block = trc::encodeImage(trc::TextureFormat::eBC1, { 4, 4 },
+                                        reinterpret_cast<const ui8*>(pixels.data()));
+
+    const std::vector<ui8> expected{ 0x00, 0xf8, 0x00, 0xf8, 0, 0, 0, 0 };
+    ASSERT_EQ(block, expected);
+}
+
+TEST(TextureFormatTest, EncodeSizes)
+{
+    const auto tex = makeTestTexture({ 7, 9 });
+    for (auto format : { trc::TextureFormat::eRGBA8, trc::TextureFormat::eBC1,
+                         trc::TextureFormat::eBC3, trc::TextureFormat::eBC5 })
+    {
+        const auto encoded = trc::encodeTexture(tex, format, true);
+        ASSERT_EQ(encoded.format, format);
+        ASSERT_EQ(encoded.size, tex.size);
+        ASSERT_EQ(encoded.mipLevels.size(), 4);
+        for (const auto& level : encoded.mipLevels) {
+            ASSERT_EQ(level.data.size(), trc::getTextureDataSize(format, level.size));
+        }
+
+        const auto single = trc::encodeTexture(tex, format, false);
+        ASSERT_EQ(single.mipLevels.size(), 1);
+        ASSERT_EQ(single.mipLevels[0].size, tex.size);
+    }
+
+    ASSERT_THROW(trc::encodeTexture(tex, trc::TextureFormat::eBC7, true), std::invalid_argument);
+}
+
+TEST(TextureFormatTest, SerializeMipLevels)
+{
+    const auto encoded = trc::encodeTexture(makeTestTexture({ 16, 16 }), trc::TextureFormat::eBC3, true);
+
+    std::stringstream ss;
+    encoded.serialize(ss);
+
+    trc::TextureData result;
+    result.deserialize(ss);
+
+    ASSERT_EQ(result.size, encoded.size);
+    ASSERT_EQ(result.format, encoded.format);
+    ASSERT_TRUE(result.pixels.empty());
+    ASSERT_EQ(result.mipLevels.size(), encoded.mipLevels.size());
+    for (size_t i = 0; i < result.mipLevels.size(); ++i)
+    {
+        ASSERT_EQ(result.mipLevels[i].size, encoded.mipLevels[i].size);
+        ASSERT_EQ(result.mipLevels[i].data, encoded.mipLevels[i].data);
+    }
+}
+
+TEST(TextureFormatTest, MalformedMipChainIsRejected)
+{
+    using trc::TextureFormat;
+
+    ASSERT_EQ(trc::getMaxMipLevelCount({ 12, 5 }), 4);
+    ASSERT_EQ(trc::getMaxMipLevelCount({ 1, 1 }), 1);
+    ASSERT_EQ(trc::getMaxMipLevelCount({ 0, 0 }), 0);
+    ASSERT_EQ(trc::getMipLevelSize({ 12, 5 }, 2), uvec2(3, 1));
+    ASSERT_EQ(trc::getMipLevelSize({ 12, 5 }, 40), uvec2(1, 1));
+
+    const auto encoded = trc::encodeTexture(makeTestTexture({ 16, 8 }), TextureFormat::eBC1, true);
+    ASSERT_NO_THROW(trc::validateMipChain(encoded.format, encoded.mipLevels));
+
+    auto roundTrip = [](const trc::TextureData& tex) {
+        std::stringstream ss;
+        tex.serialize(ss);
+        trc::TextureData result;
+        result.deserialize(ss);
+    };
+
+    // Wrong extent, with data of the matching size
+    auto wrongExtent = encoded;
+    wrongExtent.mipLevels[2].size = { 8, 4 };
+    wrongExtent.mipLevels[2].data.resize(trc::getTextureDataSize(TextureFormat::eBC1, { 8, 4 }));
+    ASSERT_THROW(roundTrip(wrongExtent), std::runtime_error);
+
+    // More levels than the extent allows
+    auto tooManyLevels = encoded;
+    tooManyLevels.mipLevels.push_back(tooManyLevels.mipLevels.back());
+    ASSERT_THROW(roundTrip(tooManyLevels), std::runtime_error);
+
+    // Empty base level
+    trc::TextureData empty{ .size{ 0, 0 }, .pixels{} };
+    empty.format = TextureFormat::eRGBA8;
+    empty.mipLevels.push_back({ { 0, 0 }, {} });
+    ASSERT_THROW(roundTrip(empty), std::runtime_error);
+}
+
+TEST(TextureFormatTest, LegacyFormatIsReadable)
+{
+    const auto tex = makeTestTexture({ 8, 4 });
+
+    std::stringstream ss;
+    tex.serialize(ss);
+
+    trc::TextureData result;
+    result.deserialize(ss);
+
+    ASSERT_EQ(result.size, tex.size);
+    ASSERT_EQ(result.pixels, tex.pixels);
+    ASSERT_TRUE(result.mipLevels.empty());
+}
@@ -7,6 +7,7 @@
 
 #include <trc/base/Logging.h>
 #include <trc/base/event/EventHandler.h>
+#include <trc/base/event/InputEvents.h>
 #include <trc_util/async/ThreadPool.h>
 
 using namespace trc;
@@ -124,3 +125,26 @@ TEST_F(EventHandlerTest, EventsFromMultipleThreads)
     ASSERT_EQ(sum, iVal * (kNumThreads / 2) * kNumIterations);
     ASSERT_FLOAT_EQ(fSum, fVal * static_cast<float>(kNumThreads / 2) * kNumIterations);
 }
+
+TEST_F(EventHandlerTest, MouseMoveNeverBlocks)
+{
+    std::atomic<bool> signal{ false };
+    std::atomic<int> count{ 0 };
+    std::atomic<float> lastX{ -1.0f };
+    addListener<MouseMoveEvent>([&](const MouseMoveEvent& e){
+        while (!signal);  // Stall the event thread
+        lastX = e.x;
+        ++count;
+    });
+
+    // Many more events than the queue can hold
+    constexpr int kNumEvents{ 5000 };
+    for (int i = 0; i < kNumEvents; ++i) {
+        EventHandler<MouseMoveEvent>::notify({ nullptr, float(i), 0.0f });
+    }
+
+    // Old movements are dropped in favour of the most recent ones
+    signal = true;
+    while (lastX != float(kNumEvents - 1));
+    ASSERT_LT(count, kNumEvents);
+}
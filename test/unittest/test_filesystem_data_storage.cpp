@@ -57,6 +57,9 @@ TEST_F(FilesystemDataStorageTest, ReadWrite)
         ASSERT_FALSE(is2->fail());
         ASSERT_EQ(str, "Hello, World!");
     }
+
+    ASSERT_EQ(storage.getSize(path), 13);
+    ASSERT_FALSE(storage.getSize(trc::util::Pathlet("/bar")).has_value());
 }
 
 TEST_F(FilesystemDataStorageTest, Erase)
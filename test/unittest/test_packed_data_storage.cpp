@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trc/util/PackedDataStorage.h>
+
+#include "test_utils.h"
+
+class PackedDataStorageTest : public testing::Test
+{
+protected:
+    using Compression = trc::PackedArchiveWriter::Compression;
+
+    static auto bytes(const std::string& str) -> std::span<const std::byte> {
+        return std::as_bytes(std::span{ str });
+    }
+
+    static auto readAll(std::istream& is) -> std::string {
+        return { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    }
+
+    static inline fs::path rootDir{ makeTempDir() };
+};
+
+TEST_F(PackedDataStorageTest, InvalidArchiveThrows)
+{
+    ASSERT_THROW(trc::PackedDataStorage(rootDir / "does_not_exist"), std::runtime_error);
+
+    std::ofstream(rootDir / "invalid") << "This is not an archive; it's just some text.";
+    ASSERT_THROW(trc::PackedDataStorage(rootDir / "invalid"), std::runtime_error);
+
+    // Truncated archive
+    {
+        trc::PackedArchiveWriter writer(rootDir / "truncated");
+        writer.add(trc::util::Pathlet("foo"), bytes("Hello, World!"));
+    }
+    fs::resize_file(rootDir / "truncated", fs::file_size(rootDir / "truncated") - 4);
+    ASSERT_THROW(trc::PackedDataStorage(rootDir / "truncated"), std::runtime_error);
+}
+
+TEST_F(PackedDataStorageTest, EmptyArchive)
+{
+    trc::PackedArchiveWriter(rootDir / "empty").finish();
+
+    trc::PackedDataStorage storage(rootDir / "empty");
+    ASSERT_EQ(storage.size(), 0);
+    ASSERT_EQ(storage.begin(), storage.end());
+    ASSERT_EQ(storage.read(trc::util::Pathlet("foo")), nullptr);
+}
+
+TEST_F(PackedDataStorageTest, ReadEntries)
+{
+    const std::string compressible(10000, 'a');
+    {
+        trc::PackedArchiveWriter writer(rootDir / "archive");
+        writer.add(trc::util::Pathlet("/foo/bar.txt"), bytes("Hello, World!"));
+        writer.add(trc::util::Pathlet("a/b/c"), bytes(compressible), Compression::eZlib);
+        writer.add(trc::util::Pathlet("/empty"), {});
+        writer.add(trc::util::Pathlet("/tiny"), bytes("x"), Compression::eZlib);
+        ASSERT_THROW(writer.add(trc::util::Pathlet("foo/bar.txt"), bytes("")),
+                     std::invalid_argument);
+        writer.finish();
+        ASSERT_THROW(writer.add(trc::util::Pathlet("other"), bytes("")), std::logic_error);
+    }
+
+    // Compression reduces the archive's size
+    ASSERT_LT(fs::file_size(rootDir / "archive"), compressible.size());
+
+    trc::PackedDataStorage storage(rootDir / "archive");
+    ASSERT_EQ(storage.size(), 4);
+
+    auto is = storage.read(trc::util::Pathlet("foo/bar.txt"));
+    ASSERT_NE(is, nullptr);
+    ASSERT_EQ(readAll(*is), "Hello, World!");
+
+    is = storage.read(trc::util::Pathlet("/a/b/c"));
+    ASSERT_NE(is, nullptr);
+    ASSERT_EQ(readAll(*is), compressible);
+
+    is = storage.read(trc::util::Pathlet("empty"));
+    ASSERT_NE(is, nullptr);
+    ASSERT_EQ(readAll(*is), "");
+
+    is = storage.read(trc::util::Pathlet("tiny"));
+    ASSERT_NE(is, nullptr);
+    ASSERT_EQ(readAll(*is), "x");
+
+    ASSERT_EQ(storage.read(trc::util::Pathlet("foo")), nullptr);
+    ASSERT_EQ(storage.read(trc::util::Pathlet("foo/bar.txt/baz")), nullptr);
+    ASSERT_EQ(storage.read(trc::util::Pathlet("zzz")), nullptr);
+}
+
+TEST_F(PackedDataStorageTest, MapEntries)
+{
+    const std::string compressible(1000, 'b');
+    {
+        trc::PackedArchiveWriter writer(rootDir / "map_archive");
+        writer.add(trc::util::Pathlet("first"), bytes("abc"));
+        writer.add(trc::util::Pathlet("second"), bytes("defgh"));
+        writer.add(trc::util::Pathlet("compressed"), bytes(compressible), Compression::eZlib);
+    }
+
+    std::optional<trc::DataStorage::MappedData> mapped;
+    {
+        trc::PackedDataStorage storage(rootDir / "map_archive");
+        ASSERT_FALSE(storage.map(trc::util::Pathlet("third")));
+
+        auto first = storage.map(trc::util::Pathlet("first"));
+        ASSERT_TRUE(first.has_value());
+        ASSERT_EQ(first->data.size(), 3);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(first->data.data())
+                  % trc::PackedArchiveWriter::kEntryAlignment, 0);
+
+        mapped = storage.map(trc::util::Pathlet("second"));
+        ASSERT_TRUE(mapped.has_value());
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(mapped->data.data())
+                  % trc::PackedArchiveWriter::kEntryAlignment, 0);
+
+        auto compressed = storage.map(trc::util::Pathlet("compressed"));
+        ASSERT_TRUE(compressed.has_value());
+        ASSERT_EQ(std::string(reinterpret_cast<const char*>(compressed->data.data()),
+                              compressed->data.size()),
+                  compressible);
+
+        // Sizes are uncompressed sizes
+        ASSERT_EQ(storage.getSize(trc::util::Pathlet("first")), 3);
+        ASSERT_EQ(storage.getSize(trc::util::Pathlet("compressed")), compressible.size());
+        ASSERT_FALSE(storage.getSize(trc::util::Pathlet("third")).has_value());
+    }
+
+    // Mapped data outlives the storage
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapped->data.data()), mapped->data.size()),
+              "defgh");
+}
+
+TEST_F(PackedDataStorageTest, IsReadOnly)
+{
+    trc::PackedArchiveWriter(rootDir / "readonly").add(trc::util::Pathlet("foo"), bytes("foo"));
+
+    trc::PackedDataStorage storage(rootDir / "readonly");
+    ASSERT_EQ(storage.write(trc::util::Pathlet("foo")), nullptr);
+    ASSERT_EQ(storage.write(trc::util::Pathlet("bar")), nullptr);
+    ASSERT_FALSE(storage.remove(trc::util::Pathlet("foo")));
+    ASSERT_NE(storage.read(trc::util::Pathlet("foo")), nullptr);
+}
+
+TEST_F(PackedDataStorageTest, Iteration)
+{
+    const std::vector<std::string> paths{ "z", "a/b", "a/a", "m/n/o", "b" };
+    {
+        trc::PackedArchiveWriter writer(rootDir / "iter_archive");
+        for (const auto& path : paths) {
+            writer.add(trc::util::Pathlet(path), bytes(path));
+        }
+    }
+
+    trc::PackedDataStorage storage(rootDir / "iter_archive");
+    std::vector<std::string> found;
+    for (const auto& path : storage)
+    {
+        found.emplace_back(path.string());
+        auto is = storage.read(path);
+        ASSERT_NE(is, nullptr);
+        ASSERT_EQ(readAll(*is), path.string());
+    }
+
+    auto expected = paths;
+    std::ranges::sort(expected);
+    ASSERT_EQ(found, expected);
+}
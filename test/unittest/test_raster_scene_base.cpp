@@ -3,6 +3,7 @@
 
 #include <gtest/gtest.h>
 
+#include <trc/Camera.h>
 #include <trc/RasterSceneBase.h>
 using namespace trc;
 
@@ -143,3 +144,53 @@ TEST(RasterSceneBaseTest, ThreadSafeRegistration)
     invokeDrawFunctions(scene, s[0], u[0], p[0]);
     ASSERT_EQ(numInvocations, 100);
 }
+
+TEST(RasterSceneBaseTest, FrustumCulling)
+{
+    RasterSceneBase scene;
+
+    const RenderStage::ID stage(0);
+    const SubPass::ID subpass(0);
+    const Pipeline::ID pipeline(0);
+
+    size_t numExecuted{ 0 };
+    auto func = [&](auto&&, auto&&){ ++numExecuted; };
+
+    // Every fifth draw call is in front of the camera, the others are behind it
+    std::vector<RasterSceneBase::UniqueRegistrationID> regs;
+    for (int i = 0; i < 100; ++i)
+    {
+        const vec4 sphere(0.0f, 0.0f, i % 5 == 0 ? -10.0f : 10.0f, 1.0f);
+        regs.emplace_back(scene.registerDrawFunction(stage, subpass, pipeline, func,
+                                                     [sphere]{ return sphere; }));
+    }
+
+    // Draw calls without bounds are never culled
+    regs.emplace_back(scene.registerDrawFunction(stage, subpass, pipeline, func));
+
+    // Looks down the negative z-axis from the origin
+    const Camera camera(1.0f, 90.0f, 1.0f, 100.0f);
+    const auto frustum = makeViewFrustum(camera);
+
+    DrawCullingStats stats;
+    const DrawEnvironment env{ .currentPipeline=nullptr };
+    for (auto& f : scene.iterVisibleDrawFunctions(stage, subpass, pipeline, frustum, stats)) {
+        f(env, vk::CommandBuffer{});
+    }
+    ASSERT_EQ(numExecuted, 21);
+    ASSERT_EQ(stats.numVisible, 21);
+    ASSERT_EQ(stats.numCulled, 80);
+
+    ASSERT_FALSE(scene.getCullingStats(camera).has_value());
+    scene.setCullingStats(camera, stats);
+    ASSERT_TRUE(scene.getCullingStats(camera).has_value());
+    ASSERT_EQ(scene.getCullingStats(camera)->numVisible, 21);
+    ASSERT_EQ(scene.getCullingStats(camera)->numCulled, 80);
+    scene.clearCullingStats();
+    ASSERT_FALSE(scene.getCullingStats(camera).has_value());
+
+    // Draw functions are not culled without a frustum
+    numExecuted = 0;
+    invokeDrawFunctions(scene, stage, subpass, pipeline);
+    ASSERT_EQ(numExecuted, 101);
+}
@@ -0,0 +1,145 @@
+#include <deque>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trc/Node.h>
+#include <trc/TransformHierarchy.h>
+#include <trc_util/async/ThreadPool.h>
+using namespace trc;
+
+auto globalTranslation(const Node& node) -> vec3
+{
+    return vec3(node.getGlobalTransform()[3]);
+}
+
+TEST(TransformHierarchyTest, BuildLevels)
+{
+    Node root;
+    std::deque<Node> nodes(6);
+    root.attach(nodes[0]);
+    root.attach(nodes[1]);
+    nodes[0].attach(nodes[2]);
+    nodes[1].attach(nodes[3]);
+    nodes[3].attach(nodes[4]);
+    nodes[4].attach(nodes[5]);
+
+    TransformHierarchy hierarchy;
+    hierarchy.build(root);
+    ASSERT_EQ(hierarchy.size(), 6);
+    ASSERT_EQ(hierarchy.getNumLevels(), 4);
+
+    hierarchy.build(nodes[5]);
+    ASSERT_EQ(hierarchy.size(), 0);
+    ASSERT_EQ(hierarchy.getNumLevels(), 0);
+}
+
+TEST(TransformHierarchyTest, NodeUpdatePropagatesTransforms)
+{
+    Node root;
+    std::deque<Node> nodes(5);
+    root.attach(nodes[0]);
+    nodes[0].attach(nodes[1]);
+    nodes[1].attach(nodes[2]);
+    root.attach(nodes[3]);
+    nodes[3].attach(nodes[4]);
+    for (auto& node : nodes) {
+        node.translateX(1.0f);
+    }
+    root.translateX(100.0f);
+
+    root.updateAsRoot();
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 3.0f);
+    ASSERT_EQ(globalTranslation(nodes[4]).x, 2.0f);
+
+    root.update();
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 103.0f);
+    ASSERT_EQ(globalTranslation(nodes[4]).x, 102.0f);
+
+    // Structural changes are picked up by the next update
+    nodes[1].detachFromParent();
+    root.update();
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 2.0f);
+
+    nodes[4].attach(nodes[1]);
+    root.updateAsRoot();
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 4.0f);
+
+    Node moved(std::move(nodes[3]));
+    moved.translateX(10.0f);
+    root.updateAsRoot();
+    ASSERT_EQ(globalTranslation(moved).x, 11.0f);
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 14.0f);
+}
+
+TEST(TransformHierarchyTest, ParallelUpdate)
+{
+    Node root;
+    std::vector<Node> parents(16);
+    std::vector<Node> children(20000);
+    for (auto& node : parents)
+    {
+        root.attach(node);
+        node.translateY(1.0f);
+    }
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        parents[i % parents.size()].attach(children[i]);
+        children[i].translateX(static_cast<float>(i));
+    }
+
+    async::ThreadPool threads(4);
+    root.updateAsRoot(threads);
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        ASSERT_EQ(globalTranslation(children[i]).x, static_cast<float>(i));
+        ASSERT_EQ(globalTranslation(children[i]).y, 1.0f);
+    }
+}
+
+TEST(TransformHierarchyTest, IncrementalUpdate)
+{
+    Node root;
+    std::deque<Node> nodes(5);
+    root.attach(nodes[0]);
+    nodes[0].attach(nodes[1]);
+    nodes[1].attach(nodes[2]);
+    root.attach(nodes[3]);
+    nodes[3].attach(nodes[4]);
+    for (auto& node : nodes) {
+        node.translateX(1.0f);
+    }
+
+    root.update();
+    ASSERT_EQ(root.getLastUpdateStats().numUpdated, 5);
+    ASSERT_EQ(root.getLastUpdateStats().numSkipped, 0);
+
+    // Nothing has changed
+    root.update();
+    ASSERT_EQ(root.getLastUpdateStats().numUpdated, 0);
+    ASSERT_EQ(root.getLastUpdateStats().numSkipped, 5);
+
+    // Only the changed node and its descendants are recomputed
+    nodes[1].translateX(1.0f);
+    root.update();
+    ASSERT_EQ(root.getLastUpdateStats().numUpdated, 2);
+    ASSERT_EQ(root.getLastUpdateStats().numSkipped, 3);
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 4.0f);
+    ASSERT_EQ(globalTranslation(nodes[4]).x, 2.0f);
+
+    // A changed root transform affects all nodes
+    root.translateX(10.0f);
+    root.update();
+    ASSERT_EQ(root.getLastUpdateStats().numUpdated, 5);
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 14.0f);
+    ASSERT_EQ(globalTranslation(nodes[4]).x, 12.0f);
+
+    // Subtrees that were updated on their own are handled correctly
+    nodes[0].update(root.getGlobalTransform());
+    nodes[1].translateX(1.0f);
+    root.update();
+    nodes[2].translateX(1.0f);
+    nodes[0].update(root.getGlobalTransform());
+    ASSERT_EQ(nodes[0].getLastUpdateStats().numUpdated, 1);
+    ASSERT_EQ(globalTranslation(nodes[2]).x, 16.0f);
+}
@@ -0,0 +1,177 @@
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trc_util/math/BatchTransform.h>
+
+using namespace trc::math;
+
+/** Not a multiple of the SIMD widths, so the remainder loops are tested */
+constexpr size_t kCount{ 37 };
+
+class BatchTransformTest : public testing::TestWithParam<SimdLevel>
+{
+protected:
+    static auto mul(const Mat4f& a, const Mat4f& b) -> Mat4f
+    {
+        Mat4f res{};
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                for (int k = 0; k < 4; ++k)
+                    res[c * 4 + r] += a[k * 4 + r] * b[c * 4 + k];
+        return res;
+    }
+
+    static auto translation(const Vec3f& t) -> Mat4f {
+        return { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  t[0], t[1], t[2], 1 };
+    }
+
+    static auto scaling(const Vec3f& s) -> Mat4f {
+        return { s[0], 0, 0, 0,  0, s[1], 0, 0,  0, 0, s[2], 0,  0, 0, 0, 1 };
+    }
+
+    /** Rotation about the normalized axis `a` by angle `angle` */
+    static auto axisAngle(const Vec3f& a, float angle) -> Quatf
+    {
+        const float s = std::sin(angle / 2.0f);
+        return { a[0] * s, a[1] * s, a[2] * s, std::cos(angle / 2.0f) };
+    }
+
+    auto randomMatrices() -> std::vector<Mat4f>
+    {
+        std::vector<Mat4f> res(kCount);
+        for (auto& m : res) {
+            for (float& f : m) f = dist(rng);
+        }
+        return res;
+    }
+
+    auto randomRotations() -> std::vector<Quatf>
+    {
+        std::vector<Quatf> res;
+        for (size_t i = 0; i < kCount; ++i)
+        {
+            Vec3f axis{ dist(rng), dist(rng), dist(rng) + 3.0f };
+            const float len = std::hypot(axis[0], axis[1], axis[2]);
+            for (float& f : axis) f /= len;
+            res.push_back(axisAngle(axis, dist(rng) * std::numbers::pi_v<float>));
+        }
+        return res;
+    }
+
+    static void expectNear(const Mat4f& expected, const Mat4f& actual)
+    {
+        for (int i = 0; i < 16; ++i) {
+            ASSERT_NEAR(expected[i], actual[i], 1e-5f) << "at element " << i;
+        }
+    }
+
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+};
+
+TEST_P(BatchTransformTest, MultiplyMatrices)
+{
+    const auto lhs = randomMatrices();
+    const auto rhs = randomMatrices();
+    std::vector<Mat4f> out(kCount);
+    multiplyMatrices(lhs, rhs, out, GetParam());
+    for (size_t i = 0; i < kCount; ++i) {
+        expectNear(mul(lhs[i], rhs[i]), out[i]);
+    }
+
+    // In place
+    auto inPlace = lhs;
+    multiplyMatrices(inPlace, rhs, inPlace, GetParam());
+    ASSERT_EQ(inPlace, out);
+
+    ASSERT_THROW(multiplyMatrices(lhs, std::span{ rhs }.first(3), out, GetParam()),
+                 std::invalid_argument);
+}
+
+TEST_P(BatchTransformTest, MultiplyWithCommonParent)
+{
+    const auto parent = randomMatrices()[0];
+    auto children = randomMatrices();
+    std::vector<Mat4f> out(kCount);
+    multiplyMatrices(parent, children, out, GetParam());
+    for (size_t i = 0; i < kCount; ++i) {
+        expectNear(mul(parent, children[i]), out[i]);
+    }
+
+    multiplyMatrices(parent, children, children, GetParam());
+    ASSERT_EQ(children, out);
+}
+
+TEST_P(BatchTransformTest, QuatToMatrices)
+{
+    // A quarter turn about z maps x to y and y to -x
+    std::vector<Quatf> quats(kCount, axisAngle({ 0, 0, 1 }, std::numbers::pi_v<float> / 2.0f));
+    std::vector<Mat4f> out(kCount);
+    quatToMatrices(quats, out, GetParam());
+    for (const auto& m : out) {
+        expectNear({ 0, 1, 0, 0,  -1, 0, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 }, m);
+    }
+
+    // The composition of two rotations equals the product of the matrices
+    const auto a = randomRotations();
+    const auto b = randomRotations();
+    std::vector<Quatf> ab;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const auto& [x1, y1, z1, w1] = a[i];
+        const auto& [x2, y2, z2, w2] = b[i];
+        ab.push_back({
+            w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2,
+            w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2,
+            w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2,
+            w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2,
+        });
+    }
+    std::vector<Mat4f> ma(kCount), mb(kCount), mab(kCount);
+    quatToMatrices(a, ma, GetParam());
+    quatToMatrices(b, mb, GetParam());
+    quatToMatrices(ab, mab, GetParam());
+    for (size_t i = 0; i < kCount; ++i) {
+        expectNear(mul(ma[i], mb[i]), mab[i]);
+    }
+}
+
+TEST_P(BatchTransformTest, ComposeTransforms)
+{
+    const auto rotations = randomRotations();
+    std::vector<Vec3f> translations, scales;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        translations.push_back({ dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f });
+        scales.push_back({ dist(rng) + 2.0f, dist(rng) + 2.0f, dist(rng) + 2.0f });
+    }
+
+    std::vector<Mat4f> rotMats(kCount), out(kCount);
+    quatToMatrices(rotations, rotMats, GetParam());
+    composeTransforms(translations, rotations, scales, out, GetParam());
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const Mat4f expected = mul(mul(translation(translations[i]), rotMats[i]), scaling(scales[i]));
+        expectNear(expected, out[i]);
+    }
+
+    ASSERT_THROW(composeTransforms(translations, rotations, std::span{ scales }.first(5), out),
+                 std::invalid_argument);
+}
+
+TEST_P(BatchTransformTest, EmptyInput)
+{
+    std::vector<Mat4f> none;
+    ASSERT_NO_THROW(multiplyMatrices(none, none, none, GetParam()));
+    ASSERT_NO_THROW(quatToMatrices({}, {}, GetParam()));
+    ASSERT_NO_THROW(composeTransforms({}, {}, {}, {}, GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllLevels,
+    BatchTransformTest,
+    testing::Values(SimdLevel::eScalar, SimdLevel::eSse2, SimdLevel::eAvx2)
+);
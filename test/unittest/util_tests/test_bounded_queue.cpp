@@ -0,0 +1,118 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trc_util/data/BoundedQueue.h>
+
+using namespace trc::data;
+
+using SpscQueue = BoundedQueue<int, QueueAccess::eSingleProducerSingleConsumer>;
+
+TEST(BoundedQueueTest, Capacity)
+{
+    ASSERT_THROW(BoundedQueue<int>(0), std::invalid_argument);
+    ASSERT_THROW(SpscQueue(0), std::invalid_argument);
+
+    BoundedQueue<int> queue(5);
+    ASSERT_EQ(queue.capacity(), 8);
+    ASSERT_TRUE(queue.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+    ASSERT_FALSE(queue.try_push(8));
+    ASSERT_EQ(queue.size(), 8);
+
+    SpscQueue spsc(2);
+    ASSERT_TRUE(spsc.try_push(0));
+    ASSERT_TRUE(spsc.try_push(1));
+    ASSERT_FALSE(spsc.try_push(2));
+    ASSERT_EQ(spsc.size(), 2);
+}
+
+TEST(BoundedQueueTest, FifoOrder)
+{
+    BoundedQueue<std::string> queue(4);
+    SpscQueue spsc(4);
+
+    // Wrap around the ring a few times
+    for (int i = 0; i < 20; ++i)
+    {
+        queue.push(std::to_string(i));
+        spsc.emplace(i);
+        if (i % 2 == 1)
+        {
+            ASSERT_EQ(queue.try_pop(), std::to_string(i - 1));
+            ASSERT_EQ(queue.wait_pop(), std::to_string(i));
+            ASSERT_EQ(spsc.try_pop(), i - 1);
+            ASSERT_EQ(spsc.wait_pop(), i);
+        }
+    }
+    ASSERT_FALSE(queue.try_pop().has_value());
+    ASSERT_FALSE(spsc.try_pop().has_value());
+}
+
+TEST(BoundedQueueTest, DestroysRemainingElements)
+{
+    auto value = std::make_shared<int>(0);
+    {
+        BoundedQueue<std::shared_ptr<int>> queue(4);
+        queue.push(value);
+        queue.push(value);
+        queue.try_pop();
+        ASSERT_EQ(value.use_count(), 2);
+    }
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(BoundedQueueTest, MultithreadedPushPop)
+{
+    constexpr int kNumThreads{ 4 };
+    constexpr int kItemsPerThread{ 10000 };
+
+    // Small capacity so that producers block on a full queue
+    BoundedQueue<int> queue(16);
+    std::vector<std::atomic<int>> counts(kNumThreads * kItemsPerThread);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            for (int i = 0; i < kItemsPerThread; ++i) {
+                queue.push(t * kItemsPerThread + i);
+            }
+        });
+        threads.emplace_back([&]{
+            for (int i = 0; i < kItemsPerThread; ++i) {
+                ++counts[queue.wait_pop()];
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    ASSERT_TRUE(queue.empty());
+    for (auto& c : counts) {
+        ASSERT_EQ(c, 1);
+    }
+}
+
+TEST(BoundedQueueTest, SingleProducerSingleConsumer)
+{
+    constexpr int kNumItems{ 100000 };
+
+    SpscQueue queue(16);
+    std::thread producer([&]{
+        for (int i = 0; i < kNumItems; ++i) {
+            queue.push(i);
+        }
+    });
+
+    for (int i = 0; i < kNumItems; ++i) {
+        ASSERT_EQ(queue.wait_pop(), i);
+    }
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -89,3 +95,112 @@ TEST(ExternalStorageTest, CopyAndMoveOperations)
     data0 = std::move(data1);
     ASSERT_NE(data2.get(), data0.get());
 }
+
+struct DirtyData
+{
+    auto operator<=>(const DirtyData&) const = default;
+
+    int value{ 0 };
+};
+
+TEST(ExternalStorageTest, DirtyRanges)
+{
+    std::vector<ExternalStorage<DirtyData>> data(600);
+    ASSERT_GE(ExternalStorage<DirtyData>::getCapacity(), 600u);
+
+    // Newly created values are dirty
+    std::vector<uint32_t> ranges;
+    size_t numDirty{ 0 };
+    ExternalStorage<DirtyData>::consumeDirtyRanges(
+        [&](uint32_t first, std::span<const DirtyData> values) {
+            ranges.push_back(first);
+            numDirty += values.size();
+        }
+    );
+    ASSERT_GE(numDirty, 600u);
+    ASSERT_FALSE(ranges.empty());
+
+    // Nothing has changed since the last call
+    numDirty = 0;
+    ExternalStorage<DirtyData>::consumeDirtyRanges(
+        [&](uint32_t, std::span<const DirtyData> values) { numDirty += values.size(); }
+    );
+    ASSERT_EQ(numDirty, 0u);
+
+    // Modify a few values, including consecutive ones
+    const std::vector<size_t> modified{ 3, 63, 64, 65, 255, 256, 599 };
+    for (size_t i : modified) {
+        data[i].set({ static_cast<int>(i) });
+    }
+
+    std::vector<std::pair<uint32_t, DirtyData>> visited;
+    ExternalStorage<DirtyData>::consumeDirtyRanges(
+        [&](uint32_t first, std::span<const DirtyData> values) {
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                visited.emplace_back(first + i, values[i]);
+            }
+        }
+    );
+    ASSERT_EQ(visited.size(), modified.size());
+    for (size_t i : modified)
+    {
+        const uint32_t id = data[i].getDataId();
+        auto it = std::ranges::find(visited, id, [](auto& p){ return p.first; });
+        ASSERT_NE(it, visited.end());
+        ASSERT_EQ(it->second.value, static_cast<int>(i));
+    }
+}
+
+TEST(ExternalStorageTest, TaggedStoragesAreIndependent)
+{
+    struct OtherTag {};
+    using Other = ExternalStorage<DirtyData, OtherTag>;
+
+    auto countDirty = [](auto consume) {
+        size_t n{ 0 };
+        consume([&](uint32_t, std::span<const DirtyData> values) { n += values.size(); });
+        return n;
+    };
+    auto consumeDefault = [](auto&& f) { ExternalStorage<DirtyData>::consumeDirtyRanges(f); };
+    auto consumeOther = [](auto&& f) { Other::consumeDirtyRanges(f); };
+
+    ExternalStorage<DirtyData> a;
+    Other b;
+    countDirty(consumeDefault);
+    countDirty(consumeOther);
+
+    b.set({ 42 });
+    ASSERT_EQ(countDirty(consumeDefault), 0u);
+    ASSERT_EQ(countDirty(consumeOther), 1u);
+
+    a.set({ 7 });
+    ASSERT_EQ(countDirty(consumeOther), 0u);
+    ASSERT_EQ(countDirty(consumeDefault), 1u);
+
+    const Other::ID id = b;
+    ASSERT_EQ(id.get().value, 42);
+}
+
+TEST(ExternalStorageTest, ConcurrentCreateAndRead)
+{
+    ExternalStorage<DirtyData> first;
+    first.set({ 42 });
+    const auto id = first.getDataId();
+
+    std::atomic<bool> stop{ false };
+    std::thread reader([&]{
+        while (!stop) {
+            ASSERT_EQ(id.get().value, 42);
+        }
+    });
+
+    // Growing the storage must not invalidate existing values
+    std::vector<std::unique_ptr<ExternalStorage<DirtyData>>> data;
+    for (int i = 0; i < 5000; ++i) {
+        data.emplace_back(std::make_unique<ExternalStorage<DirtyData>>());
+    }
+
+    stop = true;
+    reader.join();
+    ASSERT_EQ(first.get().value, 42);
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trc_util/math/FrustumCulling.h>
+
+using namespace trc::math;
+
+/**
+ * A Vulkan-style perspective projection with a 90 degree field of view,
+ * looking down the negative z-axis from the origin
+ */
+auto makeProjection(float near, float far) -> Mat4f
+{
+    return { 1, 0, 0, 0,
+             0, 1, 0, 0,
+             0, 0, far / (near - far), -1,
+             0, 0, -(far * near) / (far - near), 0 };
+}
+
+class FrustumCullingTest : public testing::TestWithParam<SimdLevel>
+{
+protected:
+    struct Spheres
+    {
+        void add(float x_, float y_, float z_, float r_)
+        {
+            x.push_back(x_);
+            y.push_back(y_);
+            z.push_back(z_);
+            r.push_back(r_);
+        }
+
+        auto cull(const Frustum& frustum, SimdLevel level) const -> std::vector<uint8_t>
+        {
+            std::vector<uint8_t> visible(x.size());
+            const size_t numVisible = cullSpheres(frustum, x, y, z, r, visible, level);
+            EXPECT_EQ(numVisible, std::ranges::count(visible, 1));
+            return visible;
+        }
+
+        std::vector<float> x, y, z, r;
+    };
+};
+
+TEST_P(FrustumCullingTest, CullSpheres)
+{
+    const auto frustum = Frustum::fromViewProjection(makeProjection(1.0f, 100.0f));
+
+    Spheres s;
+    s.add(0, 0, -10, 1);      // In front of the camera
+    s.add(0, 0, 10, 1);       // Behind the camera
+    s.add(0, 0, -0.5f, 0.1f); // Before the near plane
+    s.add(0, 0, -200, 1);     // Beyond the far plane
+    s.add(0, 0, -100.5f, 1);  // Intersects the far plane
+    s.add(20, 0, -10, 1);     // Right of the frustum
+    s.add(10.5f, 0, -10, 1);  // Intersects the right plane
+    s.add(0, -20, -10, 1);    // Below the frustum
+    s.add(0, 0, 0, 50);       // Contains the camera
+
+    // Repeat the spheres so that all kernel widths are used
+    Spheres many;
+    for (int i = 0; i < 5; ++i)
+    {
+        for (size_t j = 0; j < s.x.size(); ++j) {
+            many.add(s.x[j], s.y[j], s.z[j], s.r[j]);
+        }
+    }
+
+    const std::vector<uint8_t> expected{ 1, 0, 0, 0, 1, 0, 1, 0, 1 };
+    const auto visible = many.cull(frustum, GetParam());
+    for (size_t i = 0; i < visible.size(); ++i) {
+        ASSERT_EQ(visible[i], expected[i % expected.size()]) << "at sphere " << i;
+    }
+}
+
+TEST_P(FrustumCullingTest, MatchesScalarResults)
+{
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<float> pos{ -60.0f, 60.0f };
+    std::uniform_real_distribution<float> rad{ 0.0f, 5.0f };
+
+    Spheres s;
+    for (int i = 0; i < 1003; ++i) {
+        s.add(pos(rng), pos(rng), pos(rng), rad(rng));
+    }
+
+    const auto frustum = Frustum::fromViewProjection(makeProjection(0.1f, 50.0f));
+    const auto expected = s.cull(frustum, SimdLevel::eScalar);
+    ASSERT_GT(std::ranges::count(expected, 1), 0);
+    ASSERT_GT(std::ranges::count(expected, 0), 0);
+    ASSERT_EQ(expected, s.cull(frustum, GetParam()));
+}
+
+TEST_P(FrustumCullingTest, InfiniteFarPlane)
+{
+    Mat4f proj = makeProjection(1.0f, 100.0f);
+    proj[10] = -1.0f;
+    proj[14] = -1.0f;
+    const auto frustum = Frustum::fromViewProjection(proj);
+
+    Spheres s;
+    s.add(0, 0, -1e6f, 1);
+    s.add(0, 0, 10, 1);
+    ASSERT_EQ(s.cull(frustum, GetParam()), (std::vector<uint8_t>{ 1, 0 }));
+}
+
+TEST_P(FrustumCullingTest, InvalidArguments)
+{
+    const auto frustum = Frustum::fromViewProjection(makeProjection(1.0f, 100.0f));
+    std::vector<float> a(5), b(4);
+    std::vector<uint8_t> visible(5);
+    ASSERT_THROW(cullSpheres(frustum, a, a, b, a, visible, GetParam()), std::invalid_argument);
+    ASSERT_EQ(cullSpheres(frustum, {}, {}, {}, {}, {}, GetParam()), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllLevels,
+    FrustumCullingTest,
+    testing::Values(SimdLevel::eScalar, SimdLevel::eSse2, SimdLevel::eAvx2)
+);
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <future>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trc_util/data/IdPool.h>
+
+using namespace trc::data;
+
+TEST(IdPoolTest, GeneratesSequentialIds)
+{
+    IdPool<uint32_t> pool;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        ASSERT_EQ(pool.generate(), i);
+    }
+}
+
+TEST(IdPoolTest, ReusesFreedIds)
+{
+    IdPool<uint64_t> pool;
+    for (int i = 0; i < 2000; ++i) pool.generate();
+
+    pool.free(5);
+    pool.free(1500);
+    ASSERT_EQ(pool.generate(), 1500);
+    ASSERT_EQ(pool.generate(), 5);
+    ASSERT_EQ(pool.generate(), 2000);
+}
+
+TEST(IdPoolTest, Reset)
+{
+    IdPool<uint32_t> pool;
+    pool.generate();
+    pool.free(pool.generate());
+
+    pool.reset();
+    ASSERT_EQ(pool.generate(), 0);
+    ASSERT_EQ(pool.generate(), 1);
+}
+
+TEST(IdPoolTest, Move)
+{
+    IdPool<uint32_t> pool;
+    pool.generate();
+    pool.generate();
+    pool.free(0);
+
+    IdPool<uint32_t> other(std::move(pool));
+    ASSERT_EQ(other.generate(), 0);
+    ASSERT_EQ(other.generate(), 2);
+    ASSERT_EQ(pool.generate(), 0);
+
+    pool = std::move(other);
+    ASSERT_EQ(pool.generate(), 3);
+}
+
+TEST(IdPoolTest, ConcurrentGenerateAndFree)
+{
+    constexpr size_t kNumThreads{ 4 };
+    constexpr size_t kIdsPerThread{ 5000 };
+
+    IdPool<uint32_t> pool;
+    std::vector<std::future<std::vector<uint32_t>>> results;
+    for (size_t t = 0; t < kNumThreads; ++t)
+    {
+        results.emplace_back(std::async(std::launch::async, [&pool]{
+            std::vector<uint32_t> ids;
+            for (size_t i = 0; i < kIdsPerThread; ++i)
+            {
+                ids.push_back(pool.generate());
+                if (i % 3 == 0)
+                {
+                    pool.free(ids.back());
+                    ids.pop_back();
+                }
+            }
+            return ids;
+        }));
+    }
+
+    // IDs held at the same time are unique
+    std::set<uint32_t> all;
+    size_t count{ 0 };
+    for (auto& f : results)
+    {
+        for (uint32_t id : f.get())
+        {
+            all.emplace(id);
+            ++count;
+        }
+    }
+    ASSERT_EQ(all.size(), count);
+
+    // Freed IDs are reused, so the IDs stay dense
+    ASSERT_LT(*all.rbegin(), count + kNumThreads);
+}
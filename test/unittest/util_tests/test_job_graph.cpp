@@ -0,0 +1,197 @@
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trc_util/async/JobGraph.h>
+
+using namespace trc::async;
+
+TEST(JobGraphTest, EmptyGraph)
+{
+    ThreadPool pool(2);
+    JobGraph graph;
+    ASSERT_EQ(graph.size(), 0);
+    ASSERT_NO_THROW(graph.execute());
+    ASSERT_NO_THROW(graph.execute(pool));
+}
+
+TEST(JobGraphTest, InvalidDependency)
+{
+    JobGraph graph;
+    auto a = graph.addJob([]{});
+    ASSERT_THROW(graph.addDependency(a, 1), std::out_of_range);
+    ASSERT_THROW(graph.addJob([]{}, { 3 }), std::out_of_range);
+    ASSERT_THROW(graph.addContinuation(2, []{}), std::out_of_range);
+    ASSERT_EQ(graph.size(), 1);
+}
+
+TEST(JobGraphTest, DependencyOrder)
+{
+    ThreadPool pool(4);
+    JobGraph graph;
+
+    std::mutex lock;
+    std::vector<int> executed;
+    auto record = [&](int i) {
+        return [&, i]{ std::scoped_lock _(lock); executed.push_back(i); };
+    };
+
+    // 0 -> 2 -> 3, 1 -> 2, 1 -> 4
+    auto a = graph.addJob(record(0));
+    auto b = graph.addJob(record(1));
+    auto c = graph.addJob(record(2), { a, b });
+    graph.addContinuation(c, record(3));
+    graph.addContinuation(b, record(4));
+
+    auto indexOf = [&](int i) {
+        return std::ranges::find(executed, i) - executed.begin();
+    };
+    for (int run = 0; run < 100; ++run)
+    {
+        executed.clear();
+        if (run % 2 == 0) graph.execute(pool);
+        else              graph.execute();
+
+        ASSERT_EQ(executed.size(), 5);
+        ASSERT_LT(indexOf(0), indexOf(2));
+        ASSERT_LT(indexOf(1), indexOf(2));
+        ASSERT_LT(indexOf(2), indexOf(3));
+        ASSERT_LT(indexOf(1), indexOf(4));
+    }
+}
+
+TEST(JobGraphTest, ReExecuteAfterModification)
+{
+    ThreadPool pool(2);
+    JobGraph graph;
+
+    std::atomic<int> count{ 0 };
+    auto a = graph.addJob([&]{ ++count; });
+    graph.execute(pool);
+    ASSERT_EQ(count, 1);
+
+    graph.addContinuation(a, [&]{ count += 10; });
+    graph.execute(pool);
+    ASSERT_EQ(count, 12);
+
+    graph.clear();
+    graph.execute(pool);
+    ASSERT_EQ(count, 12);
+}
+
+TEST(JobGraphTest, WideGraph)
+{
+    ThreadPool pool(4);
+    JobGraph graph;
+
+    constexpr int kNumJobs{ 200 };
+    std::atomic<int> sum{ 0 };
+    std::atomic<int> final{ 0 };
+    auto first = graph.addJob([]{});
+    auto last = graph.addJob([&]{ final = sum.load(); });
+    for (int i = 0; i < kNumJobs; ++i)
+    {
+        auto job = graph.addContinuation(first, [&, i]{ sum += i; });
+        graph.addDependency(last, job);
+    }
+
+    for (int run = 1; run <= 20; ++run)
+    {
+        graph.execute(pool);
+        ASSERT_EQ(final, run * kNumJobs * (kNumJobs - 1) / 2);
+    }
+}
+
+TEST(JobGraphTest, DetectsCycles)
+{
+    ThreadPool pool(2);
+    JobGraph graph;
+
+    auto a = graph.addJob([]{});
+    auto b = graph.addContinuation(a, []{});
+    auto c = graph.addContinuation(b, []{});
+    graph.addDependency(a, c);
+    ASSERT_THROW(graph.execute(), std::logic_error);
+    ASSERT_THROW(graph.execute(pool), std::logic_error);
+}
+
+TEST(JobGraphTest, RethrowsExceptions)
+{
+    ThreadPool pool(2);
+    JobGraph graph;
+
+    bool continuationRan{ false };
+    auto a = graph.addJob([]{ throw std::runtime_error("error"); });
+    graph.addContinuation(a, [&]{ continuationRan = true; });
+
+    ASSERT_THROW(graph.execute(pool), std::runtime_error);
+    ASSERT_FALSE(continuationRan);
+    ASSERT_THROW(graph.execute(), std::runtime_error);
+    ASSERT_FALSE(continuationRan);
+}
+
+TEST(JobGraphTest, NestedParallelWork)
+{
+    ThreadPool pool(2);
+    JobGraph graph;
+
+    std::vector<int> values(1000, 0);
+    auto fill = graph.addJob([&]{
+        pool.parallelFor(size_t{0}, values.size(), size_t{10}, [&](size_t i){ values[i] = 1; });
+    });
+    std::atomic<int> sum{ 0 };
+    graph.addContinuation(fill, [&]{
+        sum = pool.parallelReduce(size_t{0}, values.size(), size_t{10}, 0,
+                                  [&](size_t i){ return values[i]; }, std::plus<int>{});
+    });
+
+    graph.execute(pool);
+    ASSERT_EQ(sum, 1000);
+}
+
+TEST(JobGraphTest, OnlyRunsOwnJobs)
+{
+    ThreadPool pool(1);
+
+    // Occupy the only worker with a blocking task
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    pool.execute([&]{
+        started = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!started) std::this_thread::yield();
+
+    // An unrelated task must not be picked up by the executing thread
+    std::atomic<bool> unrelatedDone{ false };
+    std::thread::id unrelatedThread;
+    pool.execute([&]{
+        unrelatedThread = std::this_thread::get_id();
+        unrelatedDone = true;
+    });
+
+    // Several roots and a fan-out, so that jobs are made ready for the pool
+    JobGraph graph;
+    std::atomic<int> count{ 0 };
+    auto a = graph.addJob([&]{ ++count; });
+    auto b = graph.addJob([&]{ ++count; });
+    for (int i = 0; i < 8; ++i) {
+        graph.addJob([&]{ ++count; }, { a, b });
+    }
+
+    graph.execute(pool);
+    ASSERT_EQ(count, 10);
+    ASSERT_FALSE(unrelatedDone);
+
+    // Executing again reuses the state while stale helpers are pending
+    graph.execute(pool);
+    ASSERT_EQ(count, 20);
+
+    release = true;
+    while (!unrelatedDone) std::this_thread::yield();
+    ASSERT_NE(unrelatedThread, std::this_thread::get_id());
+}
@@ -0,0 +1,52 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <trc_util/MappedFile.h>
+
+namespace fs = std::filesystem;
+
+TEST(MappedFileTest, MapFileContents)
+{
+    const fs::path path = fs::temp_directory_path() / "torch_unittest_mapped_file";
+    const std::string content = "Hello, mapped World!";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    trc::util::MappedFile file(path);
+    ASSERT_EQ(file.size(), content.size());
+    ASSERT_NE(file.data(), nullptr);
+    ASSERT_EQ(std::memcmp(file.data(), content.data(), content.size()), 0);
+    ASSERT_EQ(file.span().size(), content.size());
+
+    // Mapping stays valid after move
+    trc::util::MappedFile moved(std::move(file));
+    ASSERT_EQ(file.data(), nullptr);
+    ASSERT_EQ(file.size(), 0);
+    ASSERT_EQ(std::memcmp(moved.data(), content.data(), content.size()), 0);
+
+    fs::remove(path);
+}
+
+TEST(MappedFileTest, EmptyFile)
+{
+    const fs::path path = fs::temp_directory_path() / "torch_unittest_mapped_file_empty";
+    std::ofstream{ path };
+
+    trc::util::MappedFile file(path);
+    ASSERT_EQ(file.size(), 0);
+    ASSERT_EQ(file.data(), nullptr);
+    ASSERT_TRUE(file.span().empty());
+
+    fs::remove(path);
+}
+
+TEST(MappedFileTest, NonexistentFileThrows)
+{
+    ASSERT_THROW(trc::util::MappedFile("/does/not/exist/at/all"), std::runtime_error);
+}
@@ -86,3 +86,53 @@ TEST(MemoryStreamTest, SeekPosition)
     std::getline(stream, line);
     ASSERT_TRUE(line.empty());
 }
+
+TEST(MemoryStreamTest, InputStream)
+{
+    const std::string str = R"({"hello":"world"})";
+    trc::util::MemoryInputStream jsonStream(str.data(), str.size());
+
+    json j1;
+    ASSERT_NO_THROW(j1 = parse(jsonStream));
+    ASSERT_EQ(j1, json({ { "hello", "world" } }));
+
+    const std::string words = "some words";
+    trc::util::MemoryInputStream istream(words.data(), words.size());
+
+    std::string word;
+    istream >> word;
+    ASSERT_EQ(word, "some");
+    istream >> word;
+    ASSERT_EQ(word, "words");
+    ASSERT_EQ(istream.get(), std::char_traits<char>::eof());
+    ASSERT_TRUE(istream.eof());
+}
+
+TEST(MemoryStreamTest, InputStreamSeek)
+{
+    const std::string str = "0123456789";
+    trc::util::MemoryInputStream istream(str.data(), str.size());
+
+    istream.seekg(4);
+    ASSERT_EQ(istream.tellg(), 4);
+    ASSERT_EQ(istream.get(), '4');
+
+    istream.seekg(2, std::ios::cur);
+    ASSERT_EQ(istream.get(), '7');
+
+    istream.seekg(-1, std::ios::end);
+    ASSERT_EQ(istream.get(), '9');
+
+    istream.seekg(0, std::ios::end);
+    ASSERT_EQ(istream.tellg(), 10);
+
+    // Out of bounds
+    istream.seekg(11);
+    ASSERT_TRUE(istream.fail());
+    istream.clear();
+
+    istream.seekg(0);
+    char buf[10];
+    istream.read(buf, sizeof(buf));
+    ASSERT_EQ(std::string(buf, sizeof(buf)), str);
+}
@@ -13,6 +13,7 @@
 #include <trc_util/data/SafeVector.h>
 
 using trc::util::SafeVector;
+using trc::util::ReadOptimizedSafeVector;
 
 TEST(SafeVectorTest, BasicValidityTests)
 {
@@ -241,7 +242,7 @@ TEST(SafeVectorTest, ConcurrentEmplaceErase)
         std::uniform_int_distribution<size_t> dist(0, kNumElems);
 
         std::this_thread::sleep_for(std::chrono::nanoseconds(1));
-        for (int i = 0; i < kNumElems; ++i) {
+        for (size_t i = 0; i < kNumElems; ++i) {
             vec.erase(dist(rgen));
         }
     };
@@ -302,8 +303,8 @@ TEST(SafeVectorTest, IteratorDeadlock)
     constexpr size_t kNumElems{ 10000 };
 
     SafeVector<int> vec;
-    for (int i = 1; i <= kNumElems; ++i) {
-        vec.emplace(i, i);
+    for (size_t i = 1; i <= kNumElems; ++i) {
+        vec.emplace(i, static_cast<int>(i));
     }
 
     // No deadlock occurs when accessing the vector while iterating over it
@@ -410,3 +411,110 @@ TEST(SafeVectorTest, AtomicAccess)
     terminate = true;
     for (auto& f : futures) f.wait();
 }
+
+TEST(SafeVectorTest, ReadOptimizedBasicOperations)
+{
+    ReadOptimizedSafeVector<std::string, 8> vec;
+
+    ASSERT_FALSE(vec.contains(0));
+    ASSERT_FALSE(vec.contains(1234));
+    ASSERT_THROW(vec.at(3), std::out_of_range);
+    ASSERT_THROW(vec.copyAtomically(3), std::out_of_range);
+
+    vec.emplace(2, "foo");
+    vec.emplace(20, "bar");
+    ASSERT_TRUE(vec.contains(2));
+    ASSERT_FALSE(vec.contains(3));
+    ASSERT_TRUE(vec.contains(20));
+    ASSERT_EQ(vec.at(2), "foo");
+    ASSERT_EQ(std::as_const(vec).at(20), "bar");
+    ASSERT_THROW(vec.at(3), trc::data::InvalidElementAccess);
+
+    ASSERT_FALSE(vec.try_emplace(2, "baz").second);
+    ASSERT_EQ(vec.try_emplace(3, "baz").first.get(), "baz");
+    ASSERT_EQ(vec.copyAtomically(3), "baz");
+    ASSERT_EQ(vec.applyAtomically(3, [](std::string& s) { s += "!"; return s.size(); }), 4);
+    ASSERT_EQ(std::as_const(vec).applyAtomically(3, [](const std::string& s) { return s; }), "baz!");
+
+    int count{ 0 };
+    for (const auto& str : vec) count += !str.empty();
+    ASSERT_EQ(count, 3);
+
+    ASSERT_TRUE(vec.erase(2));
+    ASSERT_FALSE(vec.erase(2));
+    ASSERT_FALSE(vec.contains(2));
+
+    vec.clear();
+    ASSERT_FALSE(vec.contains(3));
+    ASSERT_FALSE(vec.contains(20));
+    ASSERT_EQ(vec.cbegin(), vec.cend());
+}
+
+TEST(SafeVectorTest, ReadOptimizedConcurrentReads)
+{
+    constexpr size_t kNumElems{ 10000 };
+    constexpr size_t kNumReaders{ 4 };
+
+    using T = std::array<uint64_t, 16>;
+    ReadOptimizedSafeVector<T> vec;
+    for (size_t i = 0; i < kNumElems; i += 2) {
+        vec.emplace(i, T{});
+    }
+
+    std::atomic<bool> terminate{ false };
+    std::random_device dev;
+
+    // Writers modify, erase, and re-create elements while readers copy them
+    auto writer = [&](uint64_t val) {
+        std::mt19937 rgen(dev());
+        std::uniform_int_distribution<size_t> dist(0, kNumElems - 1);
+        while (!terminate)
+        {
+            const size_t index = dist(rgen);
+            if (index % 2 == 0)
+            {
+                vec.applyAtomically(index, [val](T& arr) {
+                    for (uint64_t& i : arr) i = val;
+                });
+            }
+            else if (!vec.erase(index)) {
+                T arr;
+                arr.fill(val);
+                vec.emplace(index, arr);
+            }
+        }
+    };
+
+    auto reader = [&] {
+        std::mt19937 rgen(dev());
+        std::uniform_int_distribution<size_t> dist(0, kNumElems - 1);
+        for (int i = 0; i < 100000; ++i)
+        {
+            const size_t index = dist(rgen);
+            if (index % 2 == 0) {
+                ASSERT_TRUE(vec.contains(index));
+            }
+
+            try {
+                const T copy = vec.copyAtomically(index);
+                for (uint64_t val : copy) ASSERT_EQ(val, copy[0]);
+            }
+            catch (const trc::data::InvalidElementAccess&) {
+                ASSERT_EQ(index % 2, 1);
+            }
+        }
+    };
+
+    std::vector<std::future<void>> writers;
+    writers.emplace_back(std::async(std::launch::async, writer, 1));
+    writers.emplace_back(std::async(std::launch::async, writer, 2));
+
+    std::vector<std::future<void>> readers;
+    for (size_t i = 0; i < kNumReaders; ++i) {
+        readers.emplace_back(std::async(std::launch::async, reader));
+    }
+    for (auto& f : readers) f.get();
+
+    terminate = true;
+    for (auto& f : writers) f.get();
+}
@@ -1,3 +1,10 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <trc_util/async/ThreadPool.h>
@@ -8,6 +15,12 @@ TEST(ThreadPoolTest, EmptyPool)
 {
     ThreadPool pool(0);
     ASSERT_THROW(pool.async([]{}), std::invalid_argument);
+    ASSERT_THROW(pool.execute([]{}), std::invalid_argument);
+
+    // Parallel algorithms run on the calling thread
+    int sum{ 0 };
+    pool.parallelFor(0, 10, 1, [&](int i){ sum += i; });
+    ASSERT_EQ(sum, 45);
 }
 
 TEST(ThreadPoolTest, ExecuteFunction)
@@ -16,3 +29,142 @@ TEST(ThreadPoolTest, ExecuteFunction)
     auto fut = pool.async([]{ return 42; });
     ASSERT_EQ(fut.get(), 42);
 }
+
+TEST(ThreadPoolTest, AsyncPropagatesExceptions)
+{
+    ThreadPool pool(2);
+    auto fut = pool.async([]{ throw std::runtime_error("error"); });
+    ASSERT_THROW(fut.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ExecuteWithoutFuture)
+{
+    std::atomic<int> count{ 0 };
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            pool.execute([&]{ ++count; });
+        }
+    }  // The destructor waits for all work to complete
+
+    ASSERT_EQ(count, 1000);
+}
+
+TEST(ThreadPoolTest, ParallelFor)
+{
+    ThreadPool pool(4);
+
+    std::vector<int> values(10007, 0);
+    pool.parallelFor(size_t{0}, values.size(), size_t{64}, [&](size_t i){ values[i] = i; });
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+
+    std::atomic<int> sum{ 0 };
+    pool.parallelFor(-50, 51, [&](int i){ sum += i; });
+    ASSERT_EQ(sum, 0);
+
+    // Empty ranges
+    pool.parallelFor(5, 5, 1, [](int){ FAIL(); });
+    pool.parallelFor(5, 2, 1, [](int){ FAIL(); });
+
+    ASSERT_THROW(pool.parallelFor(0, 10, 0, [](int){}), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsExceptions)
+{
+    ThreadPool pool(4);
+    ASSERT_THROW(
+        pool.parallelFor(0, 1000, 1, [](int i){
+            if (i == 500) throw std::logic_error("error");
+        }),
+        std::logic_error
+    );
+}
+
+TEST(ThreadPoolTest, ParallelForOnlyRunsOwnChunks)
+{
+    ThreadPool pool(1);
+
+    // Occupy the only worker with a blocking task
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    pool.execute([&]{
+        started = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!started) std::this_thread::yield();
+
+    // An unrelated task must not be picked up by the waiting thread
+    std::atomic<bool> unrelatedDone{ false };
+    std::thread::id unrelatedThread;
+    pool.execute([&]{
+        unrelatedThread = std::this_thread::get_id();
+        unrelatedDone = true;
+    });
+
+    std::atomic<int> sum{ 0 };
+    pool.parallelFor(0, 100, 1, [&](int i){ sum += i; });
+    ASSERT_EQ(sum, 4950);
+    ASSERT_FALSE(unrelatedDone);
+
+    release = true;
+    while (!unrelatedDone) std::this_thread::yield();
+    ASSERT_NE(unrelatedThread, std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, ParallelReduce)
+{
+    ThreadPool pool(4);
+
+    const uint64_t n = 100000;
+    const uint64_t sum = pool.parallelReduce(uint64_t{1}, n + 1, uint64_t{100}, uint64_t{0},
+                                         [](uint64_t i){ return i; },
+                                         [](uint64_t a, uint64_t b){ return a + b; });
+    ASSERT_EQ(sum, n * (n + 1) / 2);
+
+    // Non-commutative reductions are applied in order
+    const std::string str = pool.parallelReduce(0, 26, 3, std::string{},
+                                                [](int i){ return std::string(1, 'a' + i); },
+                                                [](std::string a, std::string b){ return a + b; });
+    ASSERT_EQ(str, "abcdefghijklmnopqrstuvwxyz");
+
+    ASSERT_EQ(pool.parallelReduce(0, 0, 1, 7, [](int){ return 1; }, std::plus<int>{}), 7);
+
+    // The initial value is folded once, not once per chunk
+    ASSERT_EQ(pool.parallelReduce(0, 100, 7, 1000, [](int){ return 1; }, std::plus<int>{}), 1100);
+}
+
+TEST(ThreadPoolTest, NestedSubmission)
+{
+    // More nested waits than workers would deadlock a pool that blocks
+    // while waiting
+    ThreadPool pool(2);
+
+    std::atomic<int> count{ 0 };
+    pool.parallelFor(0, 8, 1, [&](int) {
+        pool.parallelFor(0, 8, 1, [&](int) {
+            auto fut = pool.async([&]{ ++count; });
+            pool.wait(fut);
+            fut.get();
+        });
+    });
+    ASSERT_EQ(count, 64);
+
+    auto outer = pool.async([&]{
+        std::vector<std::future<int>> inner;
+        for (int i = 0; i < 16; ++i) {
+            inner.emplace_back(pool.async([i]{ return i; }));
+        }
+
+        int sum{ 0 };
+        for (auto& f : inner)
+        {
+            pool.wait(f);
+            sum += f.get();
+        }
+        return sum;
+    });
+    pool.wait(outer);
+    ASSERT_EQ(outer.get(), 120);
+}
@@ -1,15 +1,28 @@
+#include <chrono>
 #include <iostream>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <argparse/argparse.hpp>
+#include <trc/assets/import/AnimationCompression.h>
 #include <trc/assets/import/AssetImport.h>
+#include <trc/assets/import/GeometryTransformations.h>
 #include <trc/assets/import/InternalFormat.h>
+#include <trc/assets/import/TextureCompression.h>
 #include <trc/text/Font.h>
 #include <trc/util/TorchDirectories.h>
+#include <trc_util/async/ThreadPool.h>
 
 namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
 
 enum class FileType
 {
@@ -29,18 +42,133 @@ constexpr auto kDefaultFontSize{ 18 };
 
 constexpr auto kInvalidUsageExitcode{ 64 };
 
-auto parseFileTypeString(const std::string& typeStr, const fs::path& inputFile) -> FileType;
+/**
+ * Increase this whenever a change to the converter changes its output.
+ * Invalidates all conversion caches.
+ */
+constexpr auto kConverterVersion{ 4 };
+constexpr auto kCacheFileName{ ".convert_cache" };
+
+struct ConvertOptions
+{
+    std::string type;
+    bool dryRun;
+
+    bool exportRigs;
+    bool exportAnimations;
+    bool compressAnimations;
+    bool exportMaterials;
+    bool optimize;
+    bool packVertices;
+
+    uint fontSize;
+    trc::TextureFormat textureFormat;
+    bool mipmaps;
+
+    /**
+     * @return std::string A string that identifies all options that
+     *         influence the converter's output.
+     */
+    auto makeCacheKey(FileType type) const -> std::string;
+};
+
+/**
+ * @brief A single input file and the location to which it is converted
+ */
+struct ConvertJob
+{
+    fs::path input;
+    fs::path output;
+    FileType type;
+};
+
+/**
+ * @brief Remembers which inputs have been converted with which options
+ *
+ * Stored as a plain text file in the output directory. Each line has the
+ * tab-separated fields `<content hash> <cache key> <input> <output>`.
+ */
+class ConvertCache
+{
+public:
+    struct Entry
+    {
+        uint64_t contentHash;
+        std::string cacheKey;
+        fs::path output;
+    };
+
+    static auto load(const fs::path& file) -> ConvertCache;
+    void save(const fs::path& file) const;
+
+    auto find(const fs::path& input) const -> const Entry*;
+    void set(const fs::path& input, Entry entry);
+    void erase(const fs::path& input);
+
+private:
+    std::unordered_map<std::string, Entry> entries;
+};
+
+/**
+ * @brief The result of a part of a file that is converted in parallel
+ */
+struct PartResult
+{
+    std::string log;
+    Clock::time_point end;
+
+    /** False if any of the part's outputs could not be written */
+    bool complete{ true };
+};
+
+/**
+ * @brief The result of an asynchronous conversion of a single file
+ */
+struct JobResult
+{
+    bool skipped{ false };
+    uint64_t contentHash{ 0 };
+    Clock::time_point start;
+    Clock::time_point end;
+
+    std::string log;
+
+    /** Individual parts of a file that are converted in parallel */
+    std::vector<std::future<PartResult>> parts;
+};
 
-void convertGeometry(const fs::path& input, const fs::path& outPath, argparse::ArgumentParser&);
-void convertTexture(const fs::path& input, const fs::path& outPath, argparse::ArgumentParser&);
-void convertFont(const fs::path& input, const fs::path& outPath, argparse::ArgumentParser&);
+auto detectFileType(const fs::path& inputFile) -> std::optional<FileType>;
+auto parseFileTypeString(const std::string& typeStr, const fs::path& inputFile) -> FileType;
+auto parseTextureFormatString(const std::string& formatStr) -> trc::TextureFormat;
+auto hashFile(const fs::path& file) -> uint64_t;
+
+auto makeDefaultOutputPath(const fs::path& input, FileType type) -> fs::path;
+auto collectJobs(const std::vector<std::string>& inputs,
+                 const fs::path& outDir,
+                 const ConvertOptions& opts)
+    -> std::vector<ConvertJob>;
+
+auto runJob(const ConvertJob& job,
+            const ConvertOptions& opts,
+            const ConvertCache& cache,
+            trc::async::ThreadPool& threads)
+    -> JobResult;
+
+void convertGeometry(const ConvertJob& job, const ConvertOptions& opts,
+                     trc::async::ThreadPool& threads, JobResult& result);
+void convertTexture(const ConvertJob& job, const ConvertOptions& opts, std::ostream& log);
+void convertFont(const ConvertJob& job, const ConvertOptions& opts, std::ostream& log);
 
 int main(const int argc, const char** argv)
 {
     argparse::ArgumentParser program;
     program.add_description("Convert common asset formats into Torch's asset format.");
 
-    program.add_argument("file");
+    program.add_argument("files")
+        .nargs(argparse::nargs_pattern::at_least_one)
+        .help("Files or directories to convert. Directories are searched recursively for"
+              " files of known formats. If more than one input or a directory is specified,"
+              " all inputs are converted in parallel and '-o' names the output directory.");
 
     program.add_argument("--type")
         .default_value("auto")
@@ -58,7 +186,19 @@ int main(const int argc, const char** argv)
     program.add_argument("-o")
         .help("Name of the output file. Used as a name for the output directory if"
               " multiple assets are exported from a single file; this is the case with"
-              " geometry file formats.");
+              " geometry file formats. Names the output directory when converting multiple"
+              " inputs.");
+
+    program.add_argument("-j", "--jobs")
+        .default_value(std::thread::hardware_concurrency())
+        .scan<'u', uint>()
+        .help("Number of files and meshes that are converted in parallel. Defaults to the"
+              " number of hardware threads.");
+
+    program.add_argument("--force", "-f")
+        .default_value(false)
+        .implicit_value(true)
+        .help("Convert all inputs, even if they have not changed since their last conversion.");
 
     program.add_argument("--rigs")
         .help("Also export skeletal rigs from geometry file types.")
@@ -68,16 +208,41 @@ int main(const int argc, const char** argv)
         .help("Also export animations from geometry file types.")
         .default_value(false)
         .implicit_value(true);
+    program.add_argument("--no-compress-animations")
+        .help("Store exported animations as uncompressed bone matrices.")
+        .default_value(false)
+        .implicit_value(true);
     program.add_argument("--materials")
         .help("Also export materials from geometry file types.")
         .default_value(false)
         .implicit_value(true);
 
+    program.add_argument("--no-optimize")
+        .help("Don't optimize the triangle order of exported geometries. The engine will then"
+              " optimize them every time they are loaded.")
+        .default_value(false)
+        .implicit_value(true);
+    program.add_argument("--packed-vertices")
+        .help("Store exported geometries in the compact vertex format. Reduces vertex memory"
+              " by more than half at the cost of a small loss of precision.")
+        .default_value(false)
+        .implicit_value(true);
+
     program.add_argument("--font-size")
         .default_value(uint{kDefaultFontSize})
         .scan<'i', uint>()
         .help("If importing fonts (--type font), specify which font size to import.");
 
+    program.add_argument("--texture-format")
+        .default_value(std::string{"rgba8"})
+        .help("If importing textures, specify the format in which image data is stored."
+              " Allowed values are 'rgba8' (default), 'bc1', 'bc3', 'bc5'. Block-compressed"
+              " formats require the textureCompressionBC device feature.");
+    program.add_argument("--no-mipmaps")
+        .help("If importing textures, don't generate mip levels.")
+        .default_value(false)
+        .implicit_value(true);
+
     // Parse command-line args
     try {
         program.parse_args(argc, argv);
@@ -89,43 +254,147 @@ int main(const int argc, const char** argv)
 
     // Run
     try {
-        const fs::path input = program.get("file");
-        if (!fs::is_regular_file(input))
+        const ConvertOptions opts{
+            .type             = program.get("type"),
+            .dryRun           = program.get<bool>("dry-run"),
+            .exportRigs       = program.get<bool>("rigs"),
+            .exportAnimations = program.get<bool>("animations"),
+            .compressAnimations = !program.get<bool>("no-compress-animations"),
+            .exportMaterials  = program.get<bool>("materials"),
+            .optimize         = !program.get<bool>("no-optimize"),
+            .packVertices     = program.get<bool>("packed-vertices"),
+            .fontSize         = program.get<uint>("font-size"),
+            .textureFormat    = parseTextureFormatString(program.get("texture-format")),
+            .mipmaps          = !program.get<bool>("no-mipmaps"),
+        };
+        const bool force = program.get<bool>("force");
+        const uint numThreads = std::max(program.get<uint>("jobs"), 1u);
+
+        const auto inputs = program.get<std::vector<std::string>>("files");
+        const fs::path output = program.present<std::string>("o").value_or("");
+
+        std::vector<ConvertJob> jobs;
+        fs::path outDir;
+        if (inputs.size() == 1 && !fs::is_directory(inputs.front()))
         {
-            std::cout << "Error: " << input << " is not a file\n";
-            exit(1);
+            // Single-file mode: `-o` names the output file
+            const fs::path input = inputs.front();
+            if (!fs::is_regular_file(input))
+            {
+                std::cout << "Error: " << input << " is not a file\n";
+                exit(1);
+            }
+
+            const auto type = parseFileTypeString(opts.type, input);
+            jobs.push_back({
+                input,
+                output.empty() ? makeDefaultOutputPath(input.filename(), type) : output,
+                type
+            });
+            outDir = jobs.front().output.parent_path();
+        }
+        else
+        {
+            outDir = output;
+            jobs = collectJobs(inputs, outDir, opts);
         }
 
-        const auto type = parseFileTypeString(program.get("type"), input);
+        const fs::path cacheFile = (outDir.empty() ? fs::path(".") : outDir) / kCacheFileName;
+        const auto cache = force ? ConvertCache{} : ConvertCache::load(cacheFile);
+        auto updatedCache = ConvertCache::load(cacheFile);
 
-        fs::path output = program.present<std::string>("o").value_or("");
-        if (output.empty())
+        // Convert all files in parallel. Geometry files schedule their
+        // meshes as separate tasks.
+        const auto startTime = Clock::now();
+        size_t numConverted{ 0 };
+        size_t numSkipped{ 0 };
+        size_t numFailed{ 0 };
         {
-            // Geometry files don't get a custom extension because the file name
-            // is interpreted as a directory instead.
-            output = input.filename().replace_extension(
-                  type == FileType::eTexture ? kTexFileExt
-                : type == FileType::eFont ? kFontFileExt
-                : ""
-                );
-        }
+            trc::async::ThreadPool threads(numThreads);
+            std::vector<std::future<JobResult>> results;
+            for (const auto& job : jobs)
+            {
+                results.emplace_back(threads.async([&, &job=job]{
+                    return runJob(job, opts, cache, threads);
+                }));
+            }
 
-        if (output.has_parent_path()) {
-            fs::create_directories(output.parent_path());
-        }
+            // Collect results in order
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                const auto& job = jobs[i];
+                const auto progress = std::format("[{}/{}]", i + 1, jobs.size());
+                try {
+                    auto res = results[i].get();
+                    if (res.skipped)
+                    {
+                        ++numSkipped;
+                        std::cout << progress << " Skipped " << job.input << " (unchanged)\n";
+                        continue;
+                    }
+
+                    // Parts finish independently of each other, so the file's
+                    // conversion time is determined by the last one.
+                    bool complete{ true };
+                    for (auto& part : res.parts)
+                    {
+                        auto [log, partEnd, partComplete] = part.get();
+                        res.log += log;
+                        res.end = std::max(res.end, partEnd);
+                        complete = complete && partComplete;
+                    }
+
+                    // Convert the file again on the next run
+                    if (!complete)
+                    {
+                        ++numFailed;
+                        updatedCache.erase(job.input);
+                        std::cout << res.log << progress << " Error: Unable to write all"
+                                  << " outputs of " << job.input << "\n";
+                        continue;
+                    }
+
+                    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        res.end - res.start
+                    );
+                    std::cout << res.log << progress << " Converted " << job.input
+                              << " in " << ms.count() << " ms\n";
+                    ++numConverted;
+
+                    if (!opts.dryRun)
+                    {
+                        updatedCache.set(job.input, {
+                            .contentHash = res.contentHash,
+                            .cacheKey    = opts.makeCacheKey(job.type),
+                            .output      = job.output,
+                        });
+                    }
+                }
+                catch (const std::exception& err)
+                {
+                    ++numFailed;
+                    updatedCache.erase(job.input);
+                    std::cout << progress << " Error: Unable to convert " << job.input << ": "
+                              << err.what() << "\n";
+                }
+            }
+        }  // Wait for parts of failed files to finish
 
-        // Import the appropriate file type
-        switch (type)
+        if (jobs.size() != 1)
         {
-        case FileType::eGeometry:
-            convertGeometry(input, output, program);
-            break;
-        case FileType::eTexture:
-            convertTexture(input, output, program);
-            break;
-        case FileType::eFont:
-            convertFont(input, output, program);
-            break;
+            const auto totalMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                Clock::now() - startTime
+            );
+            std::cout << std::format("Converted {} files, skipped {} unchanged files, {} failed"
+                                     " ({} ms).\n",
+                                     numConverted, numSkipped, numFailed, totalMs.count());
+        }
+
+        if (!opts.dryRun && (numConverted > 0 || numFailed > 0)) {
+            updatedCache.save(cacheFile);
+        }
+        if (numFailed > 0) {
+            exit(1);
         }
     }
     catch (const std::exception& err)
@@ -137,6 +406,92 @@ int main(const int argc, const char** argv)
     return 0;
 }
 
+auto ConvertOptions::makeCacheKey(FileType fileType) const -> std::string
+{
+    switch (fileType)
+    {
+    case FileType::eGeometry:
+        return std::format("v{}:geometry:rigs={}:anims={}:compress={}:mats={}:optimize={}:packed={}",
+                           kConverterVersion, exportRigs, exportAnimations, compressAnimations,
+                           exportMaterials, optimize, packVertices);
+    case FileType::eTexture:
+        return std::format("v{}:texture:format={}:mipmaps={}",
+                           kConverterVersion, static_cast<int>(textureFormat), mipmaps);
+    case FileType::eFont:
+        return std::format("v{}:font:size={}", kConverterVersion, fontSize);
+    }
+
+    throw std::logic_error("Unknown file type");
+}
+
+auto ConvertCache::load(const fs::path& file) -> ConvertCache
+{
+    ConvertCache cache;
+    std::ifstream is(file);
+    std::string line;
+    while (std::getline(is, line))
+    {
+        std::stringstream ss(line);
+        std::string hash, key, input, output;
+        if (std::getline(ss, hash, '\t')
+            && std::getline(ss, key, '\t')
+            && std::getline(ss, input, '\t')
+            && std::getline(ss, output))
+        {
+            try {
+                cache.entries.try_emplace(input, std::stoull(hash, nullptr, 16), key, output);
+            }
+            catch (const std::logic_error&) {}  // Ignore malformed lines
+        }
+    }
+
+    return cache;
+}
+
+void ConvertCache::save(const fs::path& file) const
+{
+    std::ofstream os(file);
+    for (const auto& [input, entry] : entries)
+    {
+        os << std::format("{:016x}\t{}\t{}\t{}\n",
+                          entry.contentHash, entry.cacheKey, input, entry.output.string());
+    }
+}
+
+auto ConvertCache::find(const fs::path& input) const -> const Entry*
+{
+    auto it = entries.find(fs::absolute(input).lexically_normal().string());
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+void ConvertCache::set(const fs::path& input, Entry entry)
+{
+    entries.insert_or_assign(fs::absolute(input).lexically_normal().string(), std::move(entry));
+}
+
+void ConvertCache::erase(const fs::path& input)
+{
+    entries.erase(fs::absolute(input).lexically_normal().string());
+}
+
+auto detectFileType(const fs::path& inputFile) -> std::optional<FileType>
+{
+    using Set = std::unordered_set<std::string>;
+
+    const auto ext = inputFile.extension().string();
+    if (Set{ ".fbx", ".obj", ".dae" }.contains(ext)) {
+        return FileType::eGeometry;
+    }
+    if (Set{ ".png", ".jpg", ".jpeg", ".tif", ".bmp" }.contains(ext)) {
+        return FileType::eTexture;
+    }
+    if (Set{ ".ttf", ".otf" }.contains(ext)) {
+        return FileType::eFont;
+    }
+
+    return std::nullopt;
+}
+
 auto parseFileTypeString(const std::string& typeStr, const fs::path& inputFile) -> FileType
 {
     using Set = std::unordered_set<std::string>;
@@ -152,51 +507,195 @@ auto parseFileTypeString(const std::string& typeStr, const fs::path& inputFile)
     }
     if (Set{ "auto", "default" }.contains(typeStr))
     {
-        const auto ext = fs::path{inputFile}.extension().string();
-        if (Set{ ".fbx", ".obj", ".dae" }.contains(ext)) {
-            return FileType::eGeometry;
+        if (auto type = detectFileType(inputFile)) {
+            return *type;
+        }
+        throw std::invalid_argument(std::format("Unable to detect file type of {}.",
+                                                inputFile.string()));
+    }
+
+    throw std::runtime_error(std::format("Value not allowed for '--type' argument: {}.", typeStr));
+}
+
+auto parseTextureFormatString(const std::string& formatStr) -> trc::TextureFormat
+{
+    if (formatStr == "rgba8") return trc::TextureFormat::eRGBA8;
+    if (formatStr == "bc1")   return trc::TextureFormat::eBC1;
+    if (formatStr == "bc3")   return trc::TextureFormat::eBC3;
+    if (formatStr == "bc5")   return trc::TextureFormat::eBC5;
+
+    throw std::runtime_error(std::format("Value not allowed for '--texture-format' argument: {}.",
+                                         formatStr));
+}
+
+auto hashFile(const fs::path& file) -> uint64_t
+{
+    std::ifstream is(file, std::ios::binary);
+    if (!is.is_open()) {
+        throw std::runtime_error(std::format("Unable to read file {}", file.string()));
+    }
+
+    // 64-bit FNV-1a
+    uint64_t hash{ 0xcbf29ce484222325 };
+    char buf[1 << 16];
+    while (is.read(buf, sizeof(buf)) || is.gcount() > 0)
+    {
+        for (std::streamsize i = 0; i < is.gcount(); ++i)
+        {
+            hash ^= static_cast<uint8_t>(buf[i]);
+            hash *= 0x100000001b3;
+        }
+    }
+
+    return hash;
+}
+
+auto makeDefaultOutputPath(const fs::path& input, FileType type) -> fs::path
+{
+    // Geometry files don't get a custom extension because the file name
+    // is interpreted as a directory instead.
+    return fs::path{ input }.replace_extension(
+          type == FileType::eTexture ? kTexFileExt
+        : type == FileType::eFont ? kFontFileExt
+        : ""
+    );
+}
+
+auto collectJobs(
+    const std::vector<std::string>& inputs,
+    const fs::path& outDir,
+    const ConvertOptions& opts)
+    -> std::vector<ConvertJob>
+{
+    std::vector<ConvertJob> jobs;
+    for (const fs::path input : inputs)
+    {
+        if (fs::is_regular_file(input))
+        {
+            const auto type = parseFileTypeString(opts.type, input);
+            jobs.push_back({ input, outDir / makeDefaultOutputPath(input.filename(), type), type });
+            continue;
         }
-        if (Set{ ".png", ".jpg", ".jpeg", ".tif", ".bmp" }.contains(ext)) {
-            return FileType::eTexture;
+        if (!fs::is_directory(input)) {
+            throw std::invalid_argument(std::format("{} is not a file or directory", input.string()));
         }
-        if (Set{ ".ttf", ".otf" }.contains(ext)) {
-            return FileType::eFont;
+
+        // Directories are mirrored in the output directory. Only files of
+        // known formats are converted.
+        for (const auto& entry : fs::recursive_directory_iterator(input))
+        {
+            const auto detected = detectFileType(entry.path());
+            if (!entry.is_regular_file() || !detected) {
+                continue;
+            }
+
+            const auto type = parseFileTypeString(opts.type, entry.path());
+            if (type != *detected) {
+                continue;
+            }
+
+            const auto relPath = entry.path().lexically_relative(input);
+            jobs.push_back({ entry.path(), outDir / makeDefaultOutputPath(relPath, type), type });
         }
-        throw std::invalid_argument(std::format("Unable to detect file type of {}.", typeStr));
     }
 
-    throw std::runtime_error(std::format("Value not allowed for '--type' argument: {}.", typeStr));
+    // Inputs with the same name from different directories, or an input
+    // that is specified more than once, would be converted to the same
+    // output concurrently.
+    std::unordered_map<std::string, const ConvertJob*> jobsByOutput;
+    for (const auto& job : jobs)
+    {
+        const auto key = fs::absolute(job.output).lexically_normal().string();
+        const auto [it, inserted] = jobsByOutput.try_emplace(key, &job);
+        if (!inserted)
+        {
+            throw std::invalid_argument(std::format(
+                "{} and {} would both be converted to {}. Convert them to different"
+                " output directories.",
+                it->second->input.string(), job.input.string(), job.output.string()
+            ));
+        }
+    }
+
+    return jobs;
 }
 
-void convertGeometry(
-    const fs::path& input,
-    const fs::path& outPath,
-    argparse::ArgumentParser& args)
+auto runJob(
+    const ConvertJob& job,
+    const ConvertOptions& opts,
+    const ConvertCache& cache,
+    trc::async::ThreadPool& threads)
+    -> JobResult
 {
-    const bool dryRun = args.get<bool>("dry-run");
+    JobResult result{ .start=Clock::now() };
+
+    // Skip inputs that have not changed since their last conversion
+    if (!opts.dryRun)
+    {
+        result.contentHash = hashFile(job.input);
+        const auto entry = cache.find(job.input);
+        if (entry != nullptr
+            && entry->contentHash == result.contentHash
+            && entry->cacheKey == opts.makeCacheKey(job.type)
+            && entry->output == job.output
+            && fs::exists(job.output))
+        {
+            result.skipped = true;
+            return result;
+        }
+    }
+
+    if (job.output.has_parent_path()) {
+        fs::create_directories(job.output.parent_path());
+    }
+
+    // Import the appropriate file type
+    std::stringstream log;
+    switch (job.type)
+    {
+    case FileType::eGeometry:
+        convertGeometry(job, opts, threads, result);
+        break;
+    case FileType::eTexture:
+        convertTexture(job, opts, log);
+        break;
+    case FileType::eFont:
+        convertFont(job, opts, log);
+        break;
+    }
+    result.log += log.str();
+    result.end = Clock::now();
 
-    const bool exportRigs = args.get<bool>("rigs");
-    const bool exportAnimations = args.get<bool>("animations");
-    const bool exportMaterials = args.get<bool>("materials");
+    return result;
+}
 
-    trc::ThirdPartyFileImportData data = trc::loadAssets(input);
-    if (data.meshes.empty())
+void convertGeometry(
+    const ConvertJob& job,
+    const ConvertOptions& opts,
+    trc::async::ThreadPool& threads,
+    JobResult& result)
+{
+    const auto& outPath = job.output;
+    auto data = std::make_shared<trc::ThirdPartyFileImportData>(trc::loadAssets(job.input));
+    if (data->meshes.empty())
     {
-        std::cout << "Nothing to import. Exiting.";
+        result.log += std::format("{} contains nothing to import.\n", job.input.string());
         return;
     }
 
-    if (dryRun)
+    if (opts.dryRun)
     {
-        std::cout << input << " contains " << data.meshes.size() << " meshes:\n";
-        for (const auto& mesh : data.meshes)
+        std::stringstream log;
+        log << job.input << " contains " << data->meshes.size() << " meshes:\n";
+        for (const auto& mesh : data->meshes)
         {
-            std::cout << " - " << mesh.name << " ("
-                      << mesh.materials.size() << " materials, "
-                      << mesh.animations.size() << " animations, "
-                      << (mesh.rig.has_value() ? "1 rig" : "no rig")
-                      << ")\n";
+            log << " - " << mesh.name << " ("
+                << mesh.materials.size() << " materials, "
+                << mesh.animations.size() << " animations, "
+                << (mesh.rig.has_value() ? "1 rig" : "no rig")
+                << ")\n";
         }
+        result.log += log.str();
         return;
     }
 
@@ -210,81 +709,170 @@ void convertGeometry(
                                              outPath.string(), err.what()));
     }
 
-    for (const auto& mesh : data.meshes)
-    {
-        auto tryWrite = [&]<typename T>(const trc::AssetData<T>& data, const fs::path& fileName) {
-            const auto filePath = outPath / fileName;
-            std::ofstream file(filePath);
-            if (!file.is_open())
-            {
-                std::cout << "[Warning] Unable to write to file " << filePath << ". Skipping.\n";
-                return false;
+    // Meshes may share materials, rigs, and animations, and mesh names
+    // need not be unique. Each output file is assigned to the first mesh
+    // that produces it, so that no file is written by two tasks at once.
+    std::unordered_set<std::string> claimedFiles;
+    auto claimOutputs = [&](const trc::ThirdPartyMeshImport& mesh) {
+        std::unordered_set<std::string> owned;
+        auto claim = [&](const std::string& fileName) {
+            if (claimedFiles.insert(fileName).second) {
+                owned.insert(fileName);
             }
-
-            trc::AssetSerializerTraits<T>::serialize(data, file);
-            return true;
         };
 
-        // Always export the geometry
-        tryWrite(mesh.geometry, mesh.name + kGeoFileExt);
-
-        // Export additional data if enabled
-        if (exportRigs && mesh.rig)
-        {
-            auto rig = mesh.rig.value();
-            rig.animations.clear();
-            tryWrite(rig, mesh.rig->name + kRigFileExt);
+        claim(mesh.name + kGeoFileExt);
+        if (opts.exportRigs && mesh.rig) {
+            claim(mesh.rig->name + kRigFileExt);
         }
-        if (exportAnimations)
+        if (opts.exportAnimations)
         {
             for (const auto& anim : mesh.animations) {
-                tryWrite(anim, anim.name + kAnimFileExt);
+                claim(anim.name + kAnimFileExt);
             }
         }
-        if (exportMaterials)
+        if (opts.exportMaterials)
         {
             for (const auto& mat : mesh.materials) {
-                tryWrite(trc::makeMaterial(mat.data), mat.name + kMatFileExt);
+                claim(mat.name + kMatFileExt);
             }
         }
+
+        return owned;
+    };
+
+    // Convert meshes in parallel. `data` is kept alive by the tasks.
+    for (auto& mesh : data->meshes)
+    {
+        auto ownedFiles = claimOutputs(mesh);
+        if (!ownedFiles.contains(mesh.name + kGeoFileExt))
+        {
+            result.log += std::format("[Warning] {} contains more than one mesh named {}."
+                                      " Only the first one is exported.\n",
+                                      job.input.string(), mesh.name);
+        }
+
+        result.parts.emplace_back(threads.async([&opts, &outPath, data, &mesh,
+                                                 owned=std::move(ownedFiles)] {
+            std::stringstream log;
+            bool complete{ true };
+            auto owns = [&](const std::string& fileName) { return owned.contains(fileName); };
+            auto tryWrite = [&]<typename T>(const trc::AssetData<T>& data, const std::string& fileName) {
+                if (!owns(fileName)) {
+                    return;  // Written by another mesh
+                }
+
+                const auto filePath = outPath / fileName;
+                std::ofstream file(filePath, std::ios::binary);
+                if (file.is_open()) {
+                    trc::AssetSerializerTraits<T>::serialize(data, file);
+                }
+                if (!file)
+                {
+                    log << "[Warning] Unable to write to file " << filePath << ". Skipping.\n";
+                    complete = false;
+                }
+            };
+
+            // Always export the geometry
+            if (owns(mesh.name + kGeoFileExt))
+            {
+                if (opts.optimize && !trc::optimizeTriangleOrder(mesh.geometry)) {
+                    log << "[Warning] Unable to optimize triangle order of " << mesh.name << ".\n";
+                }
+                if (opts.packVertices) {
+                    trc::packVertexData(mesh.geometry);
+                }
+                tryWrite(mesh.geometry, mesh.name + kGeoFileExt);
+            }
+
+            // Export additional data if enabled
+            if (opts.exportRigs && mesh.rig && owns(mesh.rig->name + kRigFileExt))
+            {
+                auto rig = mesh.rig.value();
+                rig.animations.clear();
+                tryWrite(rig, mesh.rig->name + kRigFileExt);
+            }
+            if (opts.exportAnimations)
+            {
+                for (const auto& anim : mesh.animations)
+                {
+                    if (!owns(anim.name + kAnimFileExt)) {
+                        continue;
+                    }
+                    if (!opts.compressAnimations || anim.keyframes.empty())
+                    {
+                        tryWrite(anim, anim.name + kAnimFileExt);
+                        continue;
+                    }
+
+                    auto compressed = anim;
+                    const auto stats = trc::compressAnimationInPlace(compressed);
+                    log << std::format("Compressed animation {}: {} KiB -> {} KiB ({:.1f}x),"
+                                       " {} of {} keys, max. error {:.6f}\n",
+                                       anim.name,
+                                       stats.originalSize / 1024, stats.compressedSize / 1024,
+                                       stats.getRatio(), stats.keyCount,
+                                       size_t{stats.frameCount} * anim.getBoneCount() * 3,
+                                       stats.maxError);
+                    tryWrite(compressed, anim.name + kAnimFileExt);
+                }
+            }
+            if (opts.exportMaterials)
+            {
+                for (const auto& mat : mesh.materials) {
+                    tryWrite(trc::makeMaterial(mat.data), mat.name + kMatFileExt);
+                }
+            }
+
+            return PartResult{ log.str(), Clock::now(), complete };
+        }));
     }
 
-    std::cout << "Exported data from " << input << " to " << outPath << ".\n";
+    result.log += std::format("Exported {} meshes from {} to {}.\n",
+                              data->meshes.size(), job.input.string(), outPath.string());
 }
 
-void convertTexture(
-    const fs::path& input,
-    const fs::path& outPath,
-    argparse::ArgumentParser& args)
+void convertTexture(const ConvertJob& job, const ConvertOptions& opts, std::ostream& log)
 {
-    const bool dryRun = args.get<bool>("dry-run");
-
-    const auto tex = trc::loadTexture(input);
-    if (dryRun)
+    const auto tex = trc::loadTexture(job.input);
+    if (opts.dryRun)
     {
-        std::cout << input << " contains an image of size "
-                  << tex.size.x << "x" << tex.size.y << ".\n";
+        log << job.input << " contains an image of size "
+            << tex.size.x << "x" << tex.size.y << ".\n";
         return;
     }
 
-    std::ofstream file(outPath);
-    tex.serialize(file);
-    std::cout << "Exported texture " << input << " to " << outPath << ".\n";
+    const auto encoded = trc::encodeTexture(tex, opts.textureFormat, opts.mipmaps);
+
+    std::ofstream file(job.output, std::ios::binary);
+    encoded.serialize(file);
+    if (!file) {
+        throw std::runtime_error(std::format("Unable to write to file {}", job.output.string()));
+    }
+    log << "Exported texture " << job.input << " (" << encoded.mipLevels.size()
+        << " mip levels) to " << job.output << ".\n";
 }
 
-void convertFont(const fs::path& input, const fs::path& outPath, argparse::ArgumentParser& args)
+void convertFont(const ConvertJob& job, const ConvertOptions& opts, std::ostream& log)
 {
-    const bool dryRun = args.get<bool>("dry-run");
-    const uint size = args.get<uint>("font-size");
+    // The FreeType library instance is shared and not thread-safe
+    static std::mutex freetypeLock;
+    std::unique_lock lock(freetypeLock);
+    const auto font = trc::loadFont(job.input, opts.fontSize);
+    lock.unlock();
 
-    const auto font = trc::loadFont(input, size);
-    if (dryRun)
+    if (opts.dryRun)
     {
-        std::cout << input << " contains a font.\n";
+        log << job.input << " contains a font.\n";
         return;
     }
 
-    std::ofstream file(outPath);
+    std::ofstream file(job.output);
     font.serialize(file);
-    std::cout << "Exported font " << input << " (size " << size << ") to " << outPath << ".\n";
+    if (!file) {
+        throw std::runtime_error(std::format("Unable to write to file {}", job.output.string()));
+    }
+    log << "Exported font " << job.input << " (size " << opts.fontSize << ") to "
+        << job.output << ".\n";
 }
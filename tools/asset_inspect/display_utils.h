@@ -14,6 +14,11 @@ inline auto calcExtent(const trc::GeometryData& geo) -> vec3
     for (const auto& v : geo.vertices) {
         r = glm::max(r, glm::abs(v.position));
     }
+    if (geo.getVertexFormat() == trc::VertexFormat::ePacked)
+    {
+        const auto& q = geo.quantization;
+        r = glm::max(glm::abs(q.offset), glm::abs(q.offset + q.scale));
+    }
 
     return r;
 }
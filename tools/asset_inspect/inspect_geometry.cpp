@@ -60,7 +60,7 @@ int main(int argc, const char* argv[])
         std::cout << "Error: " << geo.error() << ". Exiting.\n";
         exit(1);
     }
-    if (geo->vertices.empty() || geo->indices.empty())
+    if (geo->getVertexCount() == 0 || geo->indices.empty())
     {
         std::cout << "Error: Geometry has no vertices. The file may not be a Torch asset file.\n";
         exit(1);
@@ -84,6 +84,8 @@ int main(int argc, const char* argv[])
 void printInfo(const trc::GeometryData& geo)
 {
     std::cout << "Vertices: " << geo.indices.size() << "\n";
+    std::cout << "Packed vertices: " << std::boolalpha
+              << (geo.getVertexFormat() == trc::VertexFormat::ePacked) << "\n";
     std::cout << "Bone information: " << std::boolalpha << !geo.skeletalVertices.empty() << "\n";
     std::cout << "Rig: " << !geo.rig.empty() << "\n";
 }
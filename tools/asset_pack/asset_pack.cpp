@@ -0,0 +1,102 @@
+#include <iostream>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <trc/assets/AssetStorage.h>
+#include <trc/util/FilesystemDataStorage.h>
+#include <trc/util/PackedDataStorage.h>
+
+namespace fs = std::filesystem;
+
+constexpr auto kInvalidUsageExitcode{ 64 };
+
+auto readFile(const fs::path& file) -> std::vector<std::byte>;
+
+int main(const int argc, const char** argv)
+{
+    argparse::ArgumentParser program;
+    program.add_description("Pack an asset directory into a single archive that can be read"
+                            " with trc::PackedDataStorage.");
+
+    program.add_argument("directory");
+
+    program.add_argument("-o")
+        .required()
+        .help("Name of the output archive.");
+
+    program.add_argument("--compress")
+        .default_value(false)
+        .implicit_value(true)
+        .help("Compress entries with zlib. Compressed entries cannot be mapped into memory"
+              " in-place, so loading them is slower. Entries that do not become smaller are"
+              " stored uncompressed.");
+
+    // Parse command-line args
+    try {
+        program.parse_args(argc, argv);
+    }
+    catch (const std::runtime_error& err) {
+        std::cout << program;
+        exit(kInvalidUsageExitcode);
+    }
+
+    // Run
+    try {
+        const fs::path inputDir = program.get("directory");
+        const fs::path output = program.get("-o");
+        const auto compression = program.get<bool>("compress")
+            ? trc::PackedArchiveWriter::Compression::eZlib
+            : trc::PackedArchiveWriter::Compression::eNone;
+
+        if (!fs::is_directory(inputDir))
+        {
+            std::cout << "Error: " << inputDir << " is not a directory\n";
+            exit(1);
+        }
+
+        // Ship an up-to-date asset index with the archive. Archives are
+        // read-only, so an index could not be persisted after loading.
+        auto input = std::make_shared<trc::FilesystemDataStorage>(inputDir);
+        trc::AssetStorage(input).flushIndex();
+
+        trc::PackedArchiveWriter writer(output);
+
+        size_t numEntries{ 0 };
+        size_t totalSize{ 0 };
+        for (const auto& path : *input)
+        {
+            const auto data = readFile(path.filesystemPath(inputDir));
+            writer.add(path, data, compression);
+
+            ++numEntries;
+            totalSize += data.size();
+        }
+        writer.finish();
+
+        std::cout << std::format("Packed {} files ({} bytes) into {} ({} bytes).\n",
+                                 numEntries, totalSize, output.string(), fs::file_size(output));
+    }
+    catch (const std::exception& err)
+    {
+        std::cout << "Error: " << err.what() << "\n";
+        exit(1);
+    }
+
+    return 0;
+}
+
+auto readFile(const fs::path& file) -> std::vector<std::byte>
+{
+    std::ifstream is(file, std::ios::binary);
+    if (!is.is_open()) {
+        throw std::runtime_error(std::format("Unable to read file {}.", file.string()));
+    }
+
+    std::vector<std::byte> data(fs::file_size(file));
+    is.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    return data;
+}
@@ -3,6 +3,7 @@
 #include <concepts>
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 #include <trc_util/data/IdPool.h>
@@ -29,6 +30,9 @@ namespace componentlib
  * Both of them take the owning storage, the object ID, and the created/deleted
  * object.
  *
+ * `onCreate` receives the table's reference type, which is `C&` unless the
+ * table implementation uses proxy references (see `SoaTableImpl`).
+ *
  * Note that `onDelete`, if it is defined, takes the *already deleted*
  * component as an *l-value*. At the time `onDelete` is called, the
  * component does not exist in the table anymore.
@@ -139,9 +143,14 @@ private:
     };
 
     // Table implementation type for component traits that define a TableImpl
-    // template.
+    // template. The type_identity_t wrapper works around GCC rejecting type
+    // requirements that name an alias template specialization directly.
     template<ComponentType C>
-        requires requires { typename ComponentTraits<C>::template TableImpl<TableKeyType>; }
+        requires requires {
+            typename std::type_identity_t<
+                typename ComponentTraits<C>::template TableImpl<TableKeyType>
+            >;
+        }
     struct TableImpl<C> {
         using Type = typename ComponentTraits<C>::template TableImpl<TableKeyType>;
     };
@@ -150,10 +159,17 @@ private:
     template<ComponentType C>
     using TableType = Table<C, TableKeyType, typename TableImpl<C>::Type>;
 
+    // Reference and pointer types to components. These are `C&` and `C*`
+    // unless the table implementation defines proxy types.
+    template<ComponentType C> using Reference = typename TableType<C>::reference;
+    template<ComponentType C> using ConstReference = typename TableType<C>::const_reference;
+    template<ComponentType C> using Pointer = typename TableType<C>::pointer;
+    template<ComponentType C> using ConstPointer = typename TableType<C>::const_pointer;
+
     template<ComponentType C>
     static constexpr bool hasComponentConstructor =
         HasValidComponentTraits<C>
-        && requires (Derived& d, Key obj, C& c) { ComponentTraits<C>{}.onCreate(d, obj, c); };
+        && requires (Derived& d, Key obj, Reference<C> c) { ComponentTraits<C>{}.onCreate(d, obj, c); };
 
     template<ComponentType C>
     static constexpr bool hasComponentDestructor =
@@ -196,7 +212,7 @@ public:
      */
     template<ComponentType C, typename ...Args>
         requires std::constructible_from<C, Args...>
-    inline auto add(Key key, Args&&... args) -> C&
+    inline auto add(Key key, Args&&... args) -> Reference<C>
     {
         return createComponent<C>(key, std::forward<Args>(args)...);
     }
@@ -218,7 +234,7 @@ public:
      * @return C&
      */
     template<ComponentType C>
-    inline auto get(Key key) -> C&
+    inline auto get(Key key) -> Reference<C>
     {
         return getTable<C>().get(key);
     }
@@ -229,7 +245,7 @@ public:
      * @return C&
      */
     template<ComponentType C>
-    inline auto get(Key key) const -> const C&
+    inline auto get(Key key) const -> ConstReference<C>
     {
         return getTable<C>().get(key);
     }
@@ -240,7 +256,7 @@ public:
      * @return trc::Maybe<C&>
      */
     template<ComponentType C>
-    inline auto tryGet(Key key) -> C*
+    inline auto tryGet(Key key) -> Pointer<C>
     {
         return getTable<C>().try_get(key);
     }
@@ -251,7 +267,7 @@ public:
      * @return trc::Maybe<C&>
      */
     template<ComponentType C>
-    inline auto tryGet(Key key) const -> const C*
+    inline auto tryGet(Key key) const -> ConstPointer<C>
     {
         return getTable<C>().try_get(key);
     }
@@ -262,7 +278,7 @@ public:
      * @return trc::Maybe<C&>
      */
     template<ComponentType C>
-    inline auto getM(Key key) -> trc::Maybe<C&>
+    inline auto getM(Key key) -> trc::Maybe<Reference<C>>
     {
         return getTable<C>().get_m(key);
     }
@@ -273,7 +289,7 @@ public:
      * @return trc::Maybe<C&>
      */
     template<ComponentType C>
-    inline auto getM(Key key) const -> trc::Maybe<const C&>
+    inline auto getM(Key key) const -> trc::Maybe<ConstReference<C>>
     {
         return getTable<C>().get_m(key);
     }
@@ -370,7 +386,7 @@ private:
      */
     template<ComponentType C, typename ...Args>
         requires std::constructible_from<C, Args...>
-    inline auto createComponent(Key obj, Args&&... args) -> C&;
+    inline auto createComponent(Key obj, Args&&... args) -> Reference<C>;
 
     template<ComponentType C>
     inline void createDestructor(Key obj);
@@ -534,7 +550,8 @@ inline auto ComponentStorage<Derived, Key>::createComponent(Key obj, T&& createI
 template<typename Derived, TableKey Key>
 template<ComponentType C, typename ...Args>
     requires std::constructible_from<C, Args...>
-inline auto ComponentStorage<Derived, Key>::createComponent(Key obj, Args&&... args) -> C&
+inline auto ComponentStorage<Derived, Key>::createComponent(Key obj, Args&&... args)
+    -> Reference<C>
 {
     // Construct the component
     auto [component, success] = getTable<C>().try_emplace(obj, std::forward<Args>(args)...);
@@ -5,6 +5,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -29,9 +30,24 @@ namespace componentlib
         void reserve(size_type minElems)
         {
             objects.reserve(minElems);
+            keys.reserve(minElems);
             indices.reserve(minElems);
         }
 
+        auto size() const -> size_type {
+            return objects.size();
+        }
+        auto keyBound() const -> size_type {
+            return indices.size();
+        }
+
+        /**
+         * @brief The keys of all objects in the order of value iteration
+         */
+        auto denseKeys() const -> std::span<const key_type> {
+            return keys;
+        }
+
         bool contains(key_type key) const {
             return indices.size() > static_cast<size_t>(key)
                 && indices.at(static_cast<size_t>(key)) != NONE;
@@ -72,6 +88,7 @@ namespace componentlib
 
             auto [newIndex, obj] = _do_emplace_back(std::forward<Args>(args)...);
             indices.at(static_cast<size_type>(key)) = newIndex;
+            keys.emplace_back(key);
             return obj;
         }
 
@@ -80,8 +97,10 @@ namespace componentlib
          */
         bool erase(key_type key)
         {
-            if (contains(key)) {
+            if (contains(key))
+            {
                 _do_erase_unsafe(key);
+                return true;
             }
             return false;
         }
@@ -89,6 +108,7 @@ namespace componentlib
         void clear()
         {
             objects.clear();
+            keys.clear();
             indices.clear();
         }
 
@@ -128,7 +148,11 @@ namespace componentlib
         auto _do_emplace_back(Args&&... args) -> std::pair<size_type, reference>;
         auto _do_erase_unsafe(key_type key) -> value_type;
 
+        /** Densely packed objects */
         std::vector<value_type> objects;
+        /** The key of each object in `objects` */
+        std::vector<key_type> keys;
+        /** Maps keys to indices in `objects` */
         std::vector<size_type> indices;
     };
 
@@ -156,10 +180,8 @@ namespace componentlib
     template<typename ...Args>
     inline auto IndirectTableImpl<T, Key>::_do_emplace(size_type index, Args&&... args) -> reference
     {
-        return *objects.emplace(
-            objects.begin() + index,
-            std::forward<Args>(args)...
-        );
+        objects.at(index) = value_type(std::forward<Args>(args)...);
+        return objects.at(index);
     }
 
     template<typename T, TableKey Key>
@@ -177,17 +199,19 @@ namespace componentlib
     inline auto IndirectTableImpl<T, Key>::_do_erase_unsafe(key_type key) -> value_type
     {
         size_type& index = indices.at(static_cast<size_type>(key));
+        value_type result = std::move(objects.at(index));
 
-        // Unstably remove object
-        std::swap(objects.at(index), objects.back());
-        value_type result = std::move(objects.back());
-        objects.pop_back();
-
-        // Flag object as not existing and modify index that pointed at the moved object
-        auto swappedObjectIndexIt = std::find(indices.begin(), indices.end(), objects.size());
-        if (swappedObjectIndexIt != indices.end()) {
-            *swappedObjectIndexIt = index;
+        // Unstably remove object: move the last object into the gap and
+        // redirect the index of its key
+        const size_type last = objects.size() - 1;
+        if (index != last)
+        {
+            objects[index] = std::move(objects[last]);
+            keys[index] = keys[last];
+            indices[static_cast<size_type>(keys[index])] = index;
         }
+        objects.pop_back();
+        keys.pop_back();
         index = NONE;
 
         return result;
@@ -0,0 +1,584 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TableBase.h"
+
+namespace componentlib
+{
+    /**
+     * @brief Declares the fields of a type that is stored in a
+     *        `SoaTableImpl`
+     *
+     * Specialize this template for a component type and list pointers to
+     * its data members in a static tuple `fields`. Members that are not
+     * listed are not stored; they are default-initialized when an object
+     * is read from the table. Field types must be movable, so C arrays are
+     * not allowed. `bool` fields are not allowed either, because
+     * `std::vector<bool>` cannot hand out pointers to its elements; store
+     * a `uint8_t` or an enum instead.
+     *
+     * # Example
+     * ```cpp
+     *
+     * struct Particle { vec3 position; vec3 velocity; float age; };
+     *
+     * template<>
+     * struct SoaLayout<Particle>
+     * {
+     *     static constexpr std::tuple fields{
+     *         &Particle::position, &Particle::velocity, &Particle::age
+     *     };
+     * };
+     * ```
+     */
+    template<typename T>
+    struct SoaLayout;
+
+    namespace internal
+    {
+        template<typename MemberPtr>
+        struct MemberTraits;
+
+        template<typename C, typename M>
+        struct MemberTraits<M C::*>
+        {
+            using Class = C;
+            using Type = M;
+        };
+
+        template<typename T>
+        using SoaFields = std::remove_cvref_t<decltype(SoaLayout<T>::fields)>;
+
+        template<typename Fields>
+        struct SoaFieldTypes;
+
+        template<typename ...Ptrs>
+        struct SoaFieldTypes<std::tuple<Ptrs...>>
+        {
+            using Pointers = std::tuple<typename MemberTraits<Ptrs>::Type*...>;
+            using ConstPointers = std::tuple<const typename MemberTraits<Ptrs>::Type*...>;
+            using Arrays = std::tuple<std::vector<typename MemberTraits<Ptrs>::Type>...>;
+
+            template<typename T>
+            static constexpr bool kMembersOf = (... && std::same_as<typename MemberTraits<Ptrs>::Class, T>);
+            static constexpr bool kMovable = (... && std::movable<typename MemberTraits<Ptrs>::Type>);
+            static constexpr bool kNoBool = (... && !std::same_as<std::remove_cv_t<typename MemberTraits<Ptrs>::Type>, bool>);
+        };
+
+        template<typename T>
+        constexpr size_t kNumSoaFields = std::tuple_size_v<SoaFields<T>>;
+
+        /**
+         * @return size_t The index of `Member` in `SoaLayout<T>::fields`,
+         *                or the number of fields if it is not listed.
+         */
+        template<typename T, auto Member>
+        consteval auto soaFieldIndex() -> size_t
+        {
+            using Fields = SoaFields<T>;
+
+            size_t index = kNumSoaFields<T>;
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ([&] {
+                    if constexpr (std::same_as<std::tuple_element_t<I, Fields>, decltype(Member)>)
+                    {
+                        if (std::get<I>(SoaLayout<T>::fields) == Member) {
+                            index = I;
+                        }
+                    }
+                }(), ...);
+            }(std::make_index_sequence<kNumSoaFields<T>>{});
+
+            return index;
+        }
+    } // namespace internal
+
+    template<typename T>
+    concept SoaType = std::is_default_constructible_v<T>
+                   && requires { SoaLayout<T>::fields; }
+                   && internal::SoaFieldTypes<internal::SoaFields<T>>::template kMembersOf<T>
+                   && internal::SoaFieldTypes<internal::SoaFields<T>>::kMovable
+                   && internal::SoaFieldTypes<internal::SoaFields<T>>::kNoBool;
+
+    /**
+     * @brief The type of a field in a `SoaLayout<>`
+     */
+    template<auto Member>
+    using SoaFieldType = typename internal::MemberTraits<decltype(Member)>::Type;
+
+    /**
+     * @brief Reference to an object in a `SoaTableImpl`
+     *
+     * The object's fields are not adjacent in memory, so a reference
+     * consists of a pointer to each field. Access fields with `get`;
+     * convert to `T` to copy the whole object and assign a `T` to
+     * overwrite it.
+     */
+    template<SoaType T, bool kConst>
+    class SoaRef
+    {
+        using Types = internal::SoaFieldTypes<internal::SoaFields<T>>;
+        using Pointers = std::conditional_t<kConst, typename Types::ConstPointers,
+                                                    typename Types::Pointers>;
+        static constexpr auto kIndices = std::make_index_sequence<internal::kNumSoaFields<T>>{};
+
+    public:
+        explicit SoaRef(Pointers fields) : fields(fields) {}
+
+        /** Convert a mutable reference to a const reference */
+        template<bool kOtherConst> requires (kConst && !kOtherConst)
+        SoaRef(const SoaRef<T, kOtherConst>& other)
+            : fields(other.fields)
+        {}
+
+        /**
+         * @brief Access a field of the referenced object
+         */
+        template<auto Member>
+        auto get() const -> auto&
+        {
+            constexpr size_t index = internal::soaFieldIndex<T, Member>();
+            static_assert(index < internal::kNumSoaFields<T>,
+                          "Member is not listed in SoaLayout<T>::fields.");
+            return *std::get<index>(fields);
+        }
+
+        /**
+         * @brief Copy the referenced object
+         */
+        operator T() const
+        {
+            T result{};
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ((result.*std::get<I>(SoaLayout<T>::fields) = *std::get<I>(fields)), ...);
+            }(kIndices);
+            return result;
+        }
+
+        /**
+         * @brief Overwrite the referenced object's fields
+         */
+        auto operator=(const T& value) const -> const SoaRef& requires (!kConst)
+        {
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ((*std::get<I>(fields) = value.*std::get<I>(SoaLayout<T>::fields)), ...);
+            }(kIndices);
+            return *this;
+        }
+
+        /**
+         * @brief Overwrite the referenced object's fields
+         */
+        auto operator=(T&& value) const -> const SoaRef& requires (!kConst)
+        {
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ((*std::get<I>(fields) = std::move(value.*std::get<I>(SoaLayout<T>::fields))), ...);
+            }(kIndices);
+            return *this;
+        }
+
+    private:
+        friend class SoaRef<T, true>;
+
+        Pointers fields;
+    };
+
+    /**
+     * @brief Nullable pointer-like handle to an object in a `SoaTableImpl`
+     */
+    template<SoaType T, bool kConst>
+    class SoaPtr
+    {
+    public:
+        SoaPtr() = default;
+        SoaPtr(std::nullptr_t) {}
+        explicit SoaPtr(SoaRef<T, kConst> ref) : ref(ref) {}
+
+        explicit operator bool() const {
+            return ref.has_value();
+        }
+
+        bool operator==(std::nullptr_t) const {
+            return !ref.has_value();
+        }
+
+        auto operator*() const -> SoaRef<T, kConst>
+        {
+            assert(ref.has_value());
+            return *ref;
+        }
+
+        auto operator->() const -> const SoaRef<T, kConst>*
+        {
+            assert(ref.has_value());
+            return &*ref;
+        }
+
+    private:
+        std::optional<SoaRef<T, kConst>> ref;
+    };
+
+    template<typename TableType>
+    struct SoaTableValueIterator;
+    template<typename TableType>
+    struct SoaTableKeyIterator;
+
+    /**
+     * @brief Table that stores each field of its objects in a separate
+     *        array (structure of arrays)
+     *
+     * The fields are declared by a specialization of `SoaLayout<T>`. All
+     * arrays are densely packed: the object at dense index `i` has the key
+     * `denseKeys()[i]` and its fields at index `i` of each array. Erasing
+     * an object moves the last object into its place, so iterating over
+     * `field<&T::member>()` touches only live objects and only the bytes
+     * of that one field, without any validity checks.
+     *
+     * Objects are accessed through the proxy types `SoaRef` and `SoaPtr`
+     * instead of `T&` and `T*`. References are invalidated when objects
+     * are added or removed.
+     */
+    template<SoaType T, TableKey Key>
+    class SoaTableImpl
+    {
+    public:
+        using value_type = T;
+        using reference = SoaRef<T, false>;
+        using const_reference = SoaRef<T, true>;
+        using pointer = SoaPtr<T, false>;
+        using const_pointer = SoaPtr<T, true>;
+        using key_type = Key;
+
+        using size_type = std::size_t;
+
+        void reserve(size_type minElems);
+
+        auto size() const -> size_type {
+            return keys.size();
+        }
+        auto keyBound() const -> size_type {
+            return indices.size();
+        }
+
+        bool contains(key_type key) const {
+            return indices.size() > static_cast<size_type>(key)
+                && indices[static_cast<size_type>(key)] != NONE;
+        }
+
+        auto at(key_type key) -> pointer;
+        auto at(key_type key) const -> const_pointer;
+
+        /**
+         * Construct and overwrite. Expand space if key is new.
+         */
+        template<typename ...Args>
+        auto emplace(key_type key, Args&&... args) -> reference;
+
+        /**
+         * Try to erase.
+         */
+        bool erase(key_type key);
+
+        void clear();
+
+        /**
+         * @brief All values of one field, densely packed
+         *
+         * The value at index `i` belongs to the object with key
+         * `denseKeys()[i]`.
+         */
+        template<auto Member>
+        auto field() -> std::span<SoaFieldType<Member>>
+        {
+            return std::get<fieldIndex<Member>()>(arrays);
+        }
+
+        /**
+         * @brief All values of one field, densely packed
+         */
+        template<auto Member>
+        auto field() const -> std::span<const SoaFieldType<Member>>
+        {
+            return std::get<fieldIndex<Member>()>(arrays);
+        }
+
+        /**
+         * @brief The keys of all objects in dense order
+         */
+        auto denseKeys() const -> std::span<const key_type> {
+            return keys;
+        }
+
+        // iterator types
+        using ValueIterator = SoaTableValueIterator<SoaTableImpl<T, Key>>;
+        using KeyIterator = SoaTableKeyIterator<SoaTableImpl<T, Key>>;
+
+        // const-iterator types
+        using ConstValueIterator = SoaTableValueIterator<const SoaTableImpl<T, Key>>;
+        using ConstKeyIterator = SoaTableKeyIterator<const SoaTableImpl<T, Key>>;
+
+        friend ValueIterator;
+        friend ConstValueIterator;
+        friend KeyIterator;
+        friend ConstKeyIterator;
+
+        auto valueBegin()       -> ValueIterator      { return ValueIterator(*this, 0); }
+        auto valueBegin() const -> ConstValueIterator { return ConstValueIterator(*this, 0); }
+        auto valueEnd()         -> ValueIterator      { return ValueIterator(*this, size()); }
+        auto valueEnd()   const -> ConstValueIterator { return ConstValueIterator(*this, size()); }
+
+        auto keyBegin()       -> KeyIterator      { return KeyIterator(*this, 0); }
+        auto keyBegin() const -> ConstKeyIterator { return ConstKeyIterator(*this, 0); }
+        auto keyEnd()         -> KeyIterator      { return KeyIterator(*this, keyBound()); }
+        auto keyEnd()   const -> ConstKeyIterator { return ConstKeyIterator(*this, keyBound()); }
+
+    private:
+        /** Indirection index that indicates that a key does not exist */
+        static constexpr size_type NONE = std::numeric_limits<size_type>::max();
+
+        static constexpr auto kIndices = std::make_index_sequence<internal::kNumSoaFields<T>>{};
+
+        template<auto Member>
+        static consteval auto fieldIndex() -> size_t
+        {
+            constexpr size_t index = internal::soaFieldIndex<T, Member>();
+            static_assert(index < internal::kNumSoaFields<T>,
+                          "Member is not listed in SoaLayout<T>::fields.");
+            return index;
+        }
+
+        auto refAt(size_type index) -> reference;
+        auto refAt(size_type index) const -> const_reference;
+
+        typename internal::SoaFieldTypes<internal::SoaFields<T>>::Arrays arrays;
+        /** The key of each object, in dense order */
+        std::vector<key_type> keys;
+        /** Maps keys to dense indices */
+        std::vector<size_type> indices;
+    };
+
+    /**
+     * @brief Iterator over the values in a `SoaTableImpl` in dense order
+     */
+    template<typename TableType>
+    struct SoaTableValueIterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = typename TableType::value_type;
+        using reference = std::conditional_t<std::is_const_v<TableType>,
+                                             typename TableType::const_reference,
+                                             typename TableType::reference>;
+        using difference_type = std::ptrdiff_t;
+
+        SoaTableValueIterator() = default;
+        SoaTableValueIterator(TableType& table, size_t index) : table(&table), index(index) {}
+
+        auto operator++() -> SoaTableValueIterator& { ++index; return *this; }
+        auto operator--() -> SoaTableValueIterator& { --index; return *this; }
+        auto operator++(int) -> SoaTableValueIterator { auto r = *this; ++index; return r; }
+        auto operator--(int) -> SoaTableValueIterator { auto r = *this; --index; return r; }
+
+        auto operator*() const -> reference {
+            return table->refAt(index);
+        }
+
+        bool operator==(const SoaTableValueIterator& other) const {
+            return index == other.index;
+        }
+
+    private:
+        TableType* table{ nullptr };
+        size_t index{ 0 };
+    };
+
+    /**
+     * @brief Iterator over the keys in a `SoaTableImpl` in ascending order
+     */
+    template<typename TableType>
+    struct SoaTableKeyIterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = typename TableType::key_type;
+        using key_type = typename TableType::key_type;
+        using reference = const key_type&;
+        using pointer = const key_type*;
+        using difference_type = std::ptrdiff_t;
+
+        using ref_to_table_value_type = std::conditional_t<std::is_const_v<TableType>,
+                                                           typename TableType::const_reference,
+                                                           typename TableType::reference>;
+
+        SoaTableKeyIterator() = default;
+        SoaTableKeyIterator(TableType& table, size_t key)
+            : table(&table), currentKey(key_type(key))
+        {
+            skipForward(key);
+        }
+
+        auto operator++() -> SoaTableKeyIterator&
+        {
+            skipForward(static_cast<size_t>(currentKey) + 1);
+            return *this;
+        }
+
+        auto operator--() -> SoaTableKeyIterator&
+        {
+            size_t key = static_cast<size_t>(currentKey);
+            do {
+                --key;
+            } while (key > 0 && table->indices[key] == TableType::NONE);
+            currentKey = key_type(key);
+            return *this;
+        }
+
+        auto operator++(int) -> SoaTableKeyIterator { auto r = *this; ++*this; return r; }
+        auto operator--(int) -> SoaTableKeyIterator { auto r = *this; --*this; return r; }
+
+        auto operator*() const -> reference { return currentKey; }
+        auto operator->() const -> pointer { return &currentKey; }
+
+        bool operator==(const SoaTableKeyIterator& other) const {
+            return currentKey == other.currentKey;
+        }
+
+        /**
+         * @brief Query the value at the iterator's current key
+         */
+        auto queryValue() const -> ref_to_table_value_type
+        {
+            return table->refAt(table->indices[static_cast<size_t>(currentKey)]);
+        }
+
+    private:
+        void skipForward(size_t key)
+        {
+            const size_t end = table->indices.size();
+            while (key < end && table->indices[key] == TableType::NONE) ++key;
+            currentKey = key_type(std::min(key, end));
+        }
+
+        TableType* table{ nullptr };
+        key_type currentKey{};
+    };
+
+
+
+    template<SoaType T, TableKey Key>
+    void SoaTableImpl<T, Key>::reserve(size_type minElems)
+    {
+        std::apply([&](auto&... array) { (array.reserve(minElems), ...); }, arrays);
+        keys.reserve(minElems);
+        indices.reserve(minElems);
+    }
+
+    template<SoaType T, TableKey Key>
+    auto SoaTableImpl<T, Key>::at(key_type key) -> pointer
+    {
+        if (!contains(key)) {
+            return nullptr;
+        }
+        return pointer(refAt(indices[static_cast<size_type>(key)]));
+    }
+
+    template<SoaType T, TableKey Key>
+    auto SoaTableImpl<T, Key>::at(key_type key) const -> const_pointer
+    {
+        if (!contains(key)) {
+            return nullptr;
+        }
+        return const_pointer(refAt(indices[static_cast<size_type>(key)]));
+    }
+
+    template<SoaType T, TableKey Key>
+    template<typename ...Args>
+    auto SoaTableImpl<T, Key>::emplace(key_type key, Args&&... args) -> reference
+    {
+        if (static_cast<size_type>(key) >= indices.size()) {
+            indices.resize(static_cast<size_type>(key) + 1, NONE);
+        }
+
+        T value(std::forward<Args>(args)...);
+
+        size_type& index = indices[static_cast<size_type>(key)];
+        if (index != NONE)
+        {
+            refAt(index) = std::move(value);
+            return refAt(index);
+        }
+
+        [&]<size_t ...I>(std::index_sequence<I...>) {
+            (std::get<I>(arrays).emplace_back(
+                std::move(value.*std::get<I>(SoaLayout<T>::fields))
+            ), ...);
+        }(kIndices);
+        keys.emplace_back(key);
+        index = keys.size() - 1;
+
+        return refAt(index);
+    }
+
+    template<SoaType T, TableKey Key>
+    bool SoaTableImpl<T, Key>::erase(key_type key)
+    {
+        if (!contains(key)) {
+            return false;
+        }
+
+        // Move the last object into the gap and redirect its key's index
+        size_type& index = indices[static_cast<size_type>(key)];
+        const size_type last = keys.size() - 1;
+        std::apply([&](auto&... array) {
+            ((index != last ? void(array[index] = std::move(array[last])) : void()), ...);
+            (array.pop_back(), ...);
+        }, arrays);
+        if (index != last)
+        {
+            keys[index] = keys[last];
+            indices[static_cast<size_type>(keys[index])] = index;
+        }
+        keys.pop_back();
+        index = NONE;
+
+        return true;
+    }
+
+    template<SoaType T, TableKey Key>
+    void SoaTableImpl<T, Key>::clear()
+    {
+        std::apply([](auto&... array) { (array.clear(), ...); }, arrays);
+        keys.clear();
+        indices.clear();
+    }
+
+    template<SoaType T, TableKey Key>
+    auto SoaTableImpl<T, Key>::refAt(size_type index) -> reference
+    {
+        assert(index < size());
+        return std::apply([&](auto&... array) {
+            return reference({ &array[index]... });
+        }, arrays);
+    }
+
+    template<SoaType T, TableKey Key>
+    auto SoaTableImpl<T, Key>::refAt(size_type index) const -> const_reference
+    {
+        assert(index < size());
+        return std::apply([&](const auto&... array) {
+            return const_reference({ &array[index]... });
+        }, arrays);
+    }
+} // namespace componentlib
@@ -37,6 +37,13 @@ namespace componentlib
 
         void reserve(size_type minElems);
 
+        auto size() const -> size_type {
+            return numObjects;
+        }
+        auto keyBound() const -> size_type {
+            return chunks.size() * kChunkSize;
+        }
+
         bool contains(key_type key) const;
 
         auto at(key_type key) -> pointer;
@@ -119,6 +126,7 @@ namespace componentlib
         using Chunk = trc::data::OptionalStorage<value_type, kChunkSize>;
 
         trc::data::IndexMap<size_type, std::unique_ptr<Chunk>> chunks;
+        size_type numObjects{ 0 };
     };
 
 
@@ -166,7 +174,13 @@ namespace componentlib
 
         const size_type chunk = chunkIndex(key);
         const size_type elem = elemIndex(key);
-        return chunks.at(chunk)->emplace(elem, std::forward<Args>(args)...);
+        const bool isNew = !chunks.at(chunk)->valid(elem);
+
+        reference obj = chunks.at(chunk)->emplace(elem, std::forward<Args>(args)...);
+        if (isNew) {
+            ++numObjects;
+        }
+        return obj;
     }
 
     template<typename T, TableKey Key, size_t ChunkSize>
@@ -176,7 +190,11 @@ namespace componentlib
         {
             const size_type chunk = chunkIndex(key);
             const size_type elem = elemIndex(key);
-            return chunks.at(chunk)->erase(elem);
+            if (chunks.at(chunk)->erase(elem))
+            {
+                --numObjects;
+                return true;
+            }
         }
 
         return false;
@@ -186,5 +204,6 @@ namespace componentlib
     void StableTableImpl<T, Key, ChunkSize>::clear()
     {
         chunks = {};
+        numObjects = 0;
     }
 } // namespace componentlib
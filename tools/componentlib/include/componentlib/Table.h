@@ -14,6 +14,7 @@ namespace trc {
 }
 
 #include "IndirectTableImpl.h"
+#include "SoaTableImpl.h"
 #include "StableTableImpl.h"
 #include "TableIterators.h"
 #include "TableJoinIterator.h"
@@ -34,10 +35,10 @@ public:
     using value_type = T;
     using key_type = Key;
 
-    using reference = T&;
-    using const_reference = const T&;
-    using pointer = T*;
-    using const_pointer = const T*;
+    using reference = typename Impl::reference;
+    using const_reference = typename Impl::const_reference;
+    using pointer = typename Impl::pointer;
+    using const_pointer = typename Impl::const_pointer;
 
     using size_type = size_t;
 
@@ -177,6 +178,55 @@ public:
      */
     inline void reserve(size_type minSize);
 
+    /**
+     * @return size_type The number of objects in the table
+     */
+    inline auto size() const -> size_type;
+
+    /**
+     * @return size_type An upper bound for the table's keys. All keys in
+     *                   the table are less than this number.
+     */
+    inline auto key_bound() const -> size_type;
+
+public:
+    // ---------------------- //
+    //      Field access      //
+    // ---------------------- //
+
+    /**
+     * @brief Access one field of all objects as a contiguous array
+     *
+     * Only available if the implementation stores fields separately, e.g.
+     * `SoaTableImpl`. The value at index `i` belongs to the object with
+     * key `dense_keys()[i]`.
+     *
+     * @tparam Member A pointer to a data member of `T`
+     */
+    template<auto Member>
+        requires requires (Impl& impl) { impl.template field<Member>(); }
+    inline auto field() {
+        return impl.template field<Member>();
+    }
+
+    template<auto Member>
+        requires requires (const Impl& impl) { impl.template field<Member>(); }
+    inline auto field() const {
+        return impl.template field<Member>();
+    }
+
+    /**
+     * @brief The keys of all objects in the implementation's storage order
+     *
+     * Is the order of `field()`'s arrays for `SoaTableImpl` and the order
+     * of value iteration for `IndirectTableImpl`.
+     */
+    inline auto dense_keys() const
+        requires requires (const Impl& impl) { impl.denseKeys(); }
+    {
+        return impl.denseKeys();
+    }
+
 public:
     // -------------------------- //
     //      Iterator classes      //
@@ -361,6 +411,18 @@ inline void Table<T, Key, Impl>::reserve(size_t minSize)
     impl.reserve(minSize);
 }
 
+template<typename T, typename Key, typename Impl>
+inline auto Table<T, Key, Impl>::size() const -> size_type
+{
+    return impl.size();
+}
+
+template<typename T, typename Key, typename Impl>
+inline auto Table<T, Key, Impl>::key_bound() const -> size_type
+{
+    return impl.keyBound();
+}
+
 template<typename T, typename Key, typename Impl>
 inline auto Table<T, Key, Impl>::begin() -> ValueIterator
 {
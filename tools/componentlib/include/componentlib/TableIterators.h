@@ -31,10 +31,10 @@ public:
 
     using difference_type = size_t;
 
-    using conditionally_const_value_type = std::conditional_t<
+    using conditionally_const_reference = std::conditional_t<
         std::is_const_v<TableType>,
-        const value_type,
-        value_type
+        typename TableType::const_reference,
+        typename TableType::reference
     >;
 
     // Bidirectional for now. LegacyRandomAccessIterator is much more complex
@@ -43,7 +43,7 @@ public:
     struct KeyValuePair
     {
         key_type key;
-        conditionally_const_value_type& value;
+        conditionally_const_reference value;
     };
 
     TablePairIterator() = default;
@@ -27,14 +27,21 @@ struct TableJoinIterator
     using KeyIteratorT = typename TableT::KeyIterator;
     using KeyIteratorU = typename TableU::KeyIterator;
 
+    using RefT = std::conditional_t<std::is_const_v<TableT>,
+                                    typename TableT::const_reference,
+                                    typename TableT::reference>;
+    using RefU = std::conditional_t<std::is_const_v<TableU>,
+                                    typename TableU::const_reference,
+                                    typename TableU::reference>;
+
     /**
      * A structure representing a single row in a join of two tables
      */
     struct RowJoin
     {
         KeyT key;
-        T& t;
-        U& u;
+        RefT t;
+        RefU u;
     };
 
     using difference_type = size_t;
@@ -1,10 +1,155 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <trc_util/async/ThreadPool.h>
+
 #include "Table.h"
 
 namespace componentlib
 {
 
+namespace internal
+{
+    template<typename TableT>
+    using RowPointer = decltype(std::declval<TableT&>().try_get(
+        std::declval<typename TableT::key_type>()
+    ));
+
+    template<typename TableT>
+    using RowReference = decltype(*std::declval<RowPointer<TableT>>());
+
+    template<typename TableT>
+    inline auto makeKey(size_t key) -> typename TableT::key_type
+    {
+        return typename TableT::key_type(key);
+    }
+
+    /**
+     * @brief Call `func` with the objects at `key` in all tables
+     *
+     * Does nothing if any of the tables has no object at `key`. Passes the
+     * key as the first table's key type if `func` accepts it.
+     */
+    template<typename F, typename ...Tables, size_t ...I>
+    inline void joinRow(F& func, size_t key, std::tuple<Tables&...> tables, std::index_sequence<I...>)
+    {
+        using Key = typename std::tuple_element_t<0, std::tuple<Tables...>>::key_type;
+
+        std::tuple<RowPointer<Tables>...> rows;
+        const bool found = (... && (
+            (std::get<I>(rows) = std::get<I>(tables).try_get(makeKey<Tables>(key))) != nullptr
+        ));
+        if (!found) {
+            return;
+        }
+
+        if constexpr (std::invocable<F&, Key, RowReference<Tables>...>) {
+            func(makeKey<std::tuple_element_t<0, std::tuple<Tables...>>>(key), *std::get<I>(rows)...);
+        }
+        else {
+            func(*std::get<I>(rows)...);
+        }
+    }
+
+    template<typename F, typename ...Tables>
+    concept JoinCallback = std::invocable<F&, typename std::tuple_element_t<0, std::tuple<Tables...>>::key_type,
+                                          RowReference<Tables>...>
+                        || std::invocable<F&, RowReference<Tables>...>;
+} // namespace internal
+
+/**
+ * @brief Join any number of tables on their keys
+ *
+ * Calls `func` for each key that exists in all of the tables, with the
+ * objects at that key as arguments, in ascending order of keys. `func`
+ * may additionally take the key (of the first table's key type) as its
+ * first parameter.
+ *
+ * Iterates over the keys of the table with the fewest objects and looks
+ * the others up. Key iteration is linear in a table's key range
+ * (`key_bound()`). If the smallest table is sparse and stores its keys
+ * densely (see `Table::dense_keys`), its keys are sorted instead, so the
+ * cost is O(n log n) in its size.
+ *
+ * `func` must not add objects to or remove objects from the tables.
+ *
+ * # Example
+ * ```cpp
+ *
+ * for_each_joined([](Transform& t, const Velocity& v){ t.position += v.value; },
+ *                 transforms, velocities);
+ * ```
+ */
+template<typename F, typename ...Tables>
+    requires (sizeof...(Tables) > 0) && internal::JoinCallback<F, Tables...>
+inline void for_each_joined(F&& func, Tables&... tables)
+{
+    const std::array<size_t, sizeof...(Tables)> sizes{ tables.size()... };
+    const size_t driver = std::ranges::min_element(sizes) - sizes.begin();
+
+    const std::tuple<Tables&...> tuple{ tables... };
+    constexpr auto indices = std::index_sequence_for<Tables...>{};
+    auto drive = [&](auto& table) {
+        if constexpr (requires { table.dense_keys(); })
+        {
+            // Sorting is cheaper than scanning a mostly empty key range
+            constexpr size_t kMaxSparseFraction{ 8 };
+            if (table.size() * kMaxSparseFraction < table.key_bound())
+            {
+                std::vector<size_t> keys;
+                keys.reserve(table.size());
+                for (const auto& key : table.dense_keys()) {
+                    keys.emplace_back(static_cast<size_t>(key));
+                }
+                std::ranges::sort(keys);
+                for (const size_t key : keys) {
+                    internal::joinRow(func, key, tuple, indices);
+                }
+                return;
+            }
+        }
+        for (const auto& key : table.keys()) {
+            internal::joinRow(func, static_cast<size_t>(key), tuple, indices);
+        }
+    };
+
+    [&]<size_t ...I>(std::index_sequence<I...>) {
+        (void)(... || (I == driver && (drive(std::get<I>(tuple)), true)));
+    }(indices);
+}
+
+/**
+ * @brief Join any number of tables on their keys in parallel
+ *
+ * Calls `func` for each key that exists in all of the tables, like
+ * `for_each_joined`. The range of possible keys is split into chunks
+ * that are processed on the calling thread and the pool's workers, so
+ * `func` is called concurrently for different rows and must be
+ * thread-safe. Calls are not ordered.
+ *
+ * Returns when all rows have been processed. If `func` throws, the
+ * first exception is rethrown on the calling thread.
+ *
+ * `func` must not add objects to or remove objects from the tables.
+ */
+template<typename F, typename ...Tables>
+    requires (sizeof...(Tables) > 0) && internal::JoinCallback<F, Tables...>
+inline void parallel_for_each_joined(trc::async::ThreadPool& pool, F&& func, Tables&... tables)
+{
+    const size_t keyBound = std::min({ tables.key_bound()... });
+    const std::tuple<Tables&...> tuple{ tables... };
+    pool.parallelFor(size_t{ 0 }, keyBound, [&](size_t key) {
+        internal::joinRow(func, key, tuple, std::index_sequence_for<Tables...>{});
+    });
+}
+
 /**
  * @brief Join two tables
  *
@@ -20,14 +165,16 @@ template<
     typename T, typename U,          // Table object types
     typename TKey, typename UKey,    // Table key types
     typename TImpl, typename UImpl,
-    std::invocable<TKey, T&, U&> F   // Callback type
+    std::invocable<TKey, typename TImpl::reference, typename UImpl::reference> F
 >
 inline void join(Table<T, TKey, TImpl>& t, Table<U, UKey, UImpl>& u, F&& func)
 {
-    for (auto [key, t_v, u_v] : t.join(u))
-    {
-        func(key, t_v, u_v);
-    }
+    for_each_joined(
+        [&func](TKey key, typename TImpl::reference t_v, typename UImpl::reference u_v) {
+            func(key, t_v, u_v);
+        },
+        t, u
+    );
 }
 
 /**
@@ -44,11 +191,13 @@ template<
     typename T, typename U,          // Table object types
     typename TKey, typename UKey,    // Table key types
     typename TImpl, typename UImpl,
-    std::invocable<T&, U&> F         // Callback type
+    std::invocable<typename TImpl::reference, typename UImpl::reference> F
 >
 inline void join(Table<T, TKey, TImpl>& t, Table<U, UKey, UImpl>& u, F&& func)
 {
-    join(t, u, [&func](auto, T& t, U& u) { func(t, u); });
+    join(t, u, [&func](auto, typename TImpl::reference t, typename UImpl::reference u) {
+        func(t, u);
+    });
 }
 
 } // namespace componentlib
@@ -95,6 +95,49 @@ TEST(TABLE_TEST_NAME, KeyIterator)
     ASSERT_THAT(keys, testing::ElementsAre(1, 3, 7, 8));
 }
 
+TEST(TABLE_TEST_NAME, EraseAndOverwrite)
+{
+    constexpr int kNumElems = 1000;
+
+    Table<int> table;
+    for (int i = 0; i < kNumElems; ++i) {
+        table.emplace(i, i);
+    }
+
+    // Erase in an order unrelated to the insertion order
+    std::unordered_set<int> erased;
+    for (int i = 0; i < kNumElems / 2; ++i)
+    {
+        const int key = (i * 7919) % kNumElems;
+        ASSERT_EQ(table.erase(key), key);
+        erased.emplace(key);
+    }
+
+    // Overwriting an existing object doesn't add an object
+    int overwritten = 0;
+    while (erased.contains(overwritten)) ++overwritten;
+    table.emplace(overwritten, -1);
+
+    int numObjects = 0;
+    for (int i = 0; i < kNumElems; ++i)
+    {
+        if (erased.contains(i))
+        {
+            ASSERT_FALSE(table.contains(i));
+            continue;
+        }
+
+        ASSERT_TRUE(table.contains(i));
+        ASSERT_EQ(table.get(i), i == overwritten ? -1 : i);
+        ++numObjects;
+    }
+    ASSERT_EQ(numObjects, kNumElems - static_cast<int>(erased.size()));
+
+    int numIterated = 0;
+    for ([[maybe_unused]] int value : table) ++numIterated;
+    ASSERT_EQ(numIterated, numObjects);
+}
+
 TEST(TABLE_TEST_NAME, PairIterator)
 {
     constexpr int kNumElems = 2000;
@@ -220,6 +263,94 @@ TEST(TABLE_TEST_NAME, JoinOneEmpty)
     ASSERT_TRUE(createJoinIt(t2, t1).empty());
 }
 
+TEST(TABLE_TEST_NAME, Size)
+{
+    Table<int> table;
+    ASSERT_EQ(table.size(), 0);
+
+    table.emplace(3, 1);
+    table.emplace(70, 2);
+    table.emplace(3, 4);
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_GT(table.key_bound(), 70);
+
+    table.erase(3);
+    ASSERT_EQ(table.size(), 1);
+    table.clear();
+    ASSERT_EQ(table.size(), 0);
+}
+
+TEST(TABLE_TEST_NAME, MultiTableJoin)
+{
+    Table<int> t1;
+    Table<std::string> t2;
+    Table<float> t3;
+    for (int i = 0; i < 1000; ++i) t1.emplace(i, i);
+    for (int i = 0; i < 1000; i += 3) t2.emplace(i, std::to_string(i));
+    for (int i = 0; i < 1000; i += 5) t3.emplace(i, static_cast<float>(i));
+
+    // The smallest table is neither the first nor the last
+    std::vector<uint32_t> keys;
+    componentlib::for_each_joined(
+        [&](uint32_t key, int& a, float& b, std::string& c) {
+            ASSERT_EQ(a, static_cast<int>(key));
+            ASSERT_FLOAT_EQ(b, static_cast<float>(key));
+            ASSERT_EQ(c, std::to_string(key));
+            keys.push_back(key);
+        },
+        t1, t3, t2
+    );
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < 1000; i += 15) expected.push_back(i);
+    ASSERT_EQ(keys, expected);
+
+    // Without a key parameter and with const tables
+    const auto& ct1 = t1;
+    int count = 0;
+    componentlib::for_each_joined([&](const int&, float&) { ++count; }, ct1, t3);
+    ASSERT_EQ(count, 200);
+}
+
+TEST(TABLE_TEST_NAME, SparseTableJoin)
+{
+    Table<int> t1;
+    Table<int> t2;
+    for (int i = 0; i < 100000; ++i) t1.emplace(i, i);
+    t2.emplace(99999, 2);
+    t2.emplace(5, 1);
+    t2.emplace(70000, 3);
+
+    // Keys are visited in ascending order even if the sparse table stores
+    // them in insertion order
+    std::vector<uint32_t> keys;
+    componentlib::for_each_joined(
+        [&](uint32_t key, int& a, int&) { ASSERT_EQ(a, static_cast<int>(key)); keys.push_back(key); },
+        t1, t2
+    );
+    ASSERT_EQ(keys, (std::vector<uint32_t>{ 5, 70000, 99999 }));
+}
+
+TEST(TABLE_TEST_NAME, ParallelJoin)
+{
+    constexpr int kNumElems = 10000;
+
+    Table<int> t1;
+    Table<int> t2;
+    for (int i = 0; i < kNumElems; ++i) t1.emplace(i, i);
+    for (int i = 0; i < kNumElems; i += 2) t2.emplace(i, 0);
+
+    for (uint32_t numThreads : { 0u, 1u, 4u })
+    {
+        trc::async::ThreadPool pool(numThreads);
+        componentlib::parallel_for_each_joined(pool, [](int& a, int& b) { b += a; }, t1, t2);
+    }
+
+    for (int i = 0; i < kNumElems; i += 2) {
+        ASSERT_EQ(t2.get(i), i * 3);
+    }
+}
+
 TEST(TABLE_TEST_NAME, ConstIteratorsCompileTime)
 {
     const Table<int> t;
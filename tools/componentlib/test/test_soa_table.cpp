@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+namespace t = testing;
+
+#include <componentlib/ComponentID.h>
+#include <componentlib/ComponentStorage.h>
+#include <componentlib/Table.h>
+#include <componentlib/TableUtils.h>
+using namespace componentlib;
+
+struct Particle
+{
+    float x{ 0.0f };
+    float y{ 0.0f };
+    int age{ 0 };
+    std::string name;
+
+    // Not stored in the table
+    int scratch{ 0 };
+};
+
+template<>
+struct componentlib::SoaLayout<Particle>
+{
+    static constexpr std::tuple fields{ &Particle::x, &Particle::y, &Particle::age, &Particle::name };
+};
+
+using SoaTable = Table<Particle, uint32_t, SoaTableImpl<Particle, uint32_t>>;
+
+struct Flagged
+{
+    bool flag{ false };
+};
+
+template<>
+struct componentlib::SoaLayout<Flagged>
+{
+    static constexpr std::tuple fields{ &Flagged::flag };
+};
+
+static_assert(SoaType<Particle>);
+static_assert(!SoaType<Flagged>, "std::vector<bool> cannot store bool fields by reference");
+
+auto makeParticle(int age, float x = 0.0f) -> Particle
+{
+    Particle p;
+    p.age = age;
+    p.x = x;
+    return p;
+}
+
+TEST(SoaTableTest, EmplaceAndGet)
+{
+    SoaTable table;
+    auto ref = table.emplace(3, Particle{ 1.0f, 2.0f, 7, "foo", 42 });
+
+    ASSERT_TRUE(table.contains(3));
+    ASSERT_FALSE(table.contains(0));
+    ASSERT_EQ(table.size(), 1);
+    ASSERT_EQ(table.key_bound(), 4);
+    ASSERT_EQ(ref.get<&Particle::age>(), 7);
+
+    Particle p = table.get(3);
+    ASSERT_EQ(p.x, 1.0f);
+    ASSERT_EQ(p.y, 2.0f);
+    ASSERT_EQ(p.age, 7);
+    ASSERT_EQ(p.name, "foo");
+    ASSERT_EQ(p.scratch, 0);
+
+    table.get(3).get<&Particle::name>() = "bar";
+    ASSERT_EQ(table.get(3).get<&Particle::name>(), "bar");
+
+    ASSERT_TRUE(table.try_get(3));
+    ASSERT_FALSE(table.try_get(0));
+    ASSERT_TRUE(table.try_get(4) == nullptr);
+    ASSERT_EQ(table.try_get(3)->get<&Particle::x>(), 1.0f);
+    ASSERT_THROW(table.get(1), std::out_of_range);
+
+    const SoaTable& constTable = table;
+    ASSERT_EQ(constTable.get(3).get<&Particle::y>(), 2.0f);
+    ASSERT_EQ(constTable.get_m(3).get().get<&Particle::age>(), 7);
+    ASSERT_THROW(constTable.get_m(2).get(), trc::functional::MaybeEmptyError);
+}
+
+TEST(SoaTableTest, OverwriteAndTryEmplace)
+{
+    SoaTable table;
+    table.emplace(0, makeParticle(1));
+    table.emplace(0, makeParticle(2));
+    ASSERT_EQ(table.size(), 1);
+    ASSERT_EQ(table.get(0).get<&Particle::age>(), 2);
+
+    auto [ref, success] = table.try_emplace(0, makeParticle(3));
+    ASSERT_FALSE(success);
+    ASSERT_EQ(ref.get<&Particle::age>(), 2);
+
+    table.get(0) = makeParticle(4, 5.0f);
+    ASSERT_EQ(table.get(0).get<&Particle::age>(), 4);
+    ASSERT_EQ(table.get(0).get<&Particle::x>(), 5.0f);
+}
+
+TEST(SoaTableTest, FieldsStayDenseAfterErase)
+{
+    SoaTable table;
+    for (uint32_t i = 0; i < 100; ++i) {
+        table.emplace(i, Particle{ .x=float(i), .age=int(i), .name=std::to_string(i) });
+    }
+    for (uint32_t i = 1; i < 100; i += 2)
+    {
+        Particle p = table.erase(i);
+        ASSERT_EQ(p.age, i);
+        ASSERT_EQ(p.name, std::to_string(i));
+    }
+    ASSERT_FALSE(table.try_erase(1).has_value());
+
+    ASSERT_EQ(table.size(), 50);
+    auto keys = table.dense_keys();
+    auto xs = table.field<&Particle::x>();
+    auto ages = table.field<&Particle::age>();
+    auto names = table.field<&Particle::name>();
+    ASSERT_EQ(keys.size(), 50);
+    ASSERT_EQ(xs.size(), 50);
+    ASSERT_EQ(names.size(), 50);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        ASSERT_EQ(keys[i] % 2, 0);
+        ASSERT_EQ(xs[i], float(keys[i]));
+        ASSERT_EQ(ages[i], int(keys[i]));
+        ASSERT_EQ(names[i], std::to_string(keys[i]));
+        ASSERT_EQ(table.get(keys[i]).get<&Particle::age>(), int(keys[i]));
+    }
+
+    // Writes through the field array are visible through the table
+    for (float& x : table.field<&Particle::x>()) x *= 2.0f;
+    ASSERT_EQ(table.get(42).get<&Particle::x>(), 84.0f);
+
+    table.clear();
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_TRUE(table.field<&Particle::age>().empty());
+}
+
+TEST(SoaTableTest, Iteration)
+{
+    SoaTable table;
+    for (uint32_t key : { 9, 2, 5, 0 }) {
+        table.emplace(key, makeParticle(int(key) * 10));
+    }
+    table.erase(5);
+
+    std::vector<uint32_t> keys;
+    for (uint32_t key : table.keys()) keys.push_back(key);
+    ASSERT_THAT(keys, t::ElementsAre(0, 2, 9));
+
+    std::vector<int> ages;
+    for (Particle p : table) ages.push_back(p.age);
+    std::ranges::sort(ages);
+    ASSERT_THAT(ages, t::ElementsAre(0, 20, 90));
+
+    for (auto [key, value] : table.items()) {
+        ASSERT_EQ(value.get<&Particle::age>(), int(key) * 10);
+    }
+}
+
+TEST(SoaTableTest, JoinWithOtherTables)
+{
+    SoaTable particles;
+    Table<int> weights;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        particles.emplace(i, makeParticle(int(i)));
+        if (i % 3 == 0) weights.emplace(i, int(i) * 2);
+    }
+
+    std::vector<uint32_t> keys;
+    for_each_joined([&](uint32_t key, SoaTable::reference p, int& w) {
+        ASSERT_EQ(w, p.get<&Particle::age>() * 2);
+        keys.push_back(key);
+    }, particles, weights);
+    ASSERT_THAT(keys, t::ElementsAre(0, 3, 6, 9, 12, 15, 18));
+
+    keys.clear();
+    for (auto [key, p, w] : particles.join(weights))
+    {
+        ASSERT_EQ(w, p.get<&Particle::age>() * 2);
+        keys.push_back(key);
+    }
+    ASSERT_THAT(keys, t::ElementsAre(0, 3, 6, 9, 12, 15, 18));
+}
+
+
+
+struct _SoaObjectTag {};
+using SoaObject = ComponentID<_SoaObjectTag>;
+
+struct SoaScene : ComponentStorage<SoaScene, SoaObject> {};
+
+struct Velocity
+{
+    float dx{ 0.0f };
+    float dy{ 0.0f };
+};
+
+template<>
+struct componentlib::SoaLayout<Velocity>
+{
+    static constexpr std::tuple fields{ &Velocity::dx, &Velocity::dy };
+};
+
+template<>
+struct componentlib::ComponentTraits<Velocity>
+{
+    template<typename KeyT>
+    using TableImpl = SoaTableImpl<Velocity, KeyT>;
+
+    static void onCreate(SoaScene&, SoaObject, SoaRef<Velocity, false> v) {
+        v.get<&Velocity::dy>() = -1.0f;
+    }
+};
+
+TEST(SoaTableTest, ComponentStorage)
+{
+    SoaScene scene;
+    SoaObject a = scene.createObject(Velocity{ 1.0f, 0.0f });
+    SoaObject b = scene.createObject();
+    scene.add<Velocity>(b, 2.0f, 0.0f);
+
+    ASSERT_TRUE(scene.has<Velocity>(a));
+    ASSERT_EQ(scene.get<Velocity>(a).get<&Velocity::dx>(), 1.0f);
+    ASSERT_EQ(scene.get<Velocity>(a).get<&Velocity::dy>(), -1.0f);
+    ASSERT_TRUE(scene.tryGet<Velocity>(b));
+    ASSERT_EQ(scene.getM<Velocity>(b).get().get<&Velocity::dx>(), 2.0f);
+
+    float sum{ 0.0f };
+    for (float dx : scene.get<Velocity>().field<&Velocity::dx>()) sum += dx;
+    ASSERT_EQ(sum, 3.0f);
+
+    scene.deleteObject(a);
+    ASSERT_FALSE(scene.has<Velocity>(a));
+    ASSERT_FALSE(scene.tryGet<Velocity>(a));
+    ASSERT_EQ(scene.get<Velocity>().size(), 1);
+    ASSERT_EQ(scene.get<Velocity>(b).get<&Velocity::dx>(), 2.0f);
+}
@@ -1,5 +1,7 @@
 #include "Scene.h"
 
+#include <componentlib/TableUtils.h>
+
 #include "App.h"
 #include "gui/ContextMenu.h"
 #include "object/Context.h"
@@ -184,19 +186,22 @@ void Scene::calcObjectHover()
 
     float closestDist{ std::numeric_limits<float>::max() };
     SceneObject closestObject{ SceneObject::NONE };
-    for (const auto& [key, hitbox, node] : get<Hitbox>().join(get<ObjectBaseNode>()))
-    {
-        const vec3 objectSpace = glm::inverse(node.getGlobalTransform()) * mousePos;
-        if (hitbox.isInside(objectSpace))
+    componentlib::for_each_joined(
+        [&](SceneObject key, Hitbox& hitbox, ObjectBaseNode& node)
         {
-            const float dist = distance(objectSpace, hitbox.getSphere().position);
-            if (dist <= closestDist)
+            const vec3 objectSpace = glm::inverse(node.getGlobalTransform()) * mousePos;
+            if (hitbox.isInside(objectSpace))
             {
-                closestDist = dist;
-                closestObject = key;
+                const float dist = distance(objectSpace, hitbox.getSphere().position);
+                if (dist <= closestDist)
+                {
+                    closestDist = dist;
+                    closestObject = key;
+                }
             }
-        }
-    }
+        },
+        get<Hitbox>(), get<ObjectBaseNode>()
+    );
 
     objectSelection.hoverObject(closestObject);
 }
@@ -14,7 +14,10 @@ auto makeHitbox(const trc::GeometryData& geo) -> Hitbox
     vec3 maxCoords{ std::numeric_limits<float>::min() };
     vec3 minCoords{ std::numeric_limits<float>::max() };
 
-    for (const trc::MeshVertex& vert : geo.vertices)
+    const auto vertices = geo.getVertexFormat() == trc::VertexFormat::ePacked
+        ? trc::unpackVertices(geo.packedVertices, geo.quantization)
+        : geo.vertices;
+    for (const trc::MeshVertex& vert : vertices)
     {
         maxCoords = max(vert.position, maxCoords);
         minCoords = min(vert.position, minCoords);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace trc::util
+{
+    namespace fs = std::filesystem;
+
+    /**
+     * @brief A read-only memory mapping of a file
+     *
+     * The mapped memory is valid for the lifetime of the object. Modifying
+     * the file while it is mapped results in undefined contents of the
+     * mapped region.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @throw std::runtime_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const fs::path& path);
+        ~MappedFile() noexcept;
+
+        /**
+         * @return const std::byte* Pointer to the first byte of the file.
+         *         The pointer is aligned to at least the system's page size.
+         *         Is nullptr if the file is empty.
+         */
+        auto data() const noexcept -> const std::byte*;
+        auto size() const noexcept -> size_t;
+
+        auto span() const noexcept -> std::span<const std::byte>;
+
+    private:
+        void unmap() noexcept;
+
+        const std::byte* mapping{ nullptr };
+        size_t mappingSize{ 0 };
+#if defined(_WIN32)
+        void* fileHandle{ nullptr };
+        void* mappingHandle{ nullptr };
+#endif
+    };
+} // namespace trc::util
@@ -27,6 +27,30 @@ namespace trc::util
             memory_stream_base(char* data, size_t size) : sbuf(data, size) {}
             memory_streambuf sbuf;
         };
+
+        class memory_istreambuf : public std::streambuf
+        {
+        public:
+            memory_istreambuf(const char* data, size_t size);
+
+            auto underflow() -> int_type override;
+            auto showmanyc() -> std::streamsize override;
+
+            auto seekoff(off_type off,
+                         std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) -> pos_type override;
+            auto seekpos(pos_type pos, std::ios_base::openmode which) -> pos_type override;
+
+        private:
+            char* begin;
+            char* end;
+        };
+
+        struct memory_istream_base
+        {
+            memory_istream_base(const char* data, size_t size) : sbuf(data, size) {}
+            memory_istreambuf sbuf;
+        };
     } // namespace internal
 
     /**
@@ -48,4 +72,23 @@ namespace trc::util
         {
         }
     };
+
+    /**
+     * @brief A read-only std::istream interface to a chunk of memory
+     *
+     * Does not copy the data; the memory must outlive the stream. Supports
+     * absolute and relative positioning via `seekg` and `tellg`.
+     */
+    class MemoryInputStream : private virtual internal::memory_istream_base
+                            , public std::istream
+    {
+    public:
+        MemoryInputStream(const char* data, size_t size)
+            :
+            memory_istream_base(data, size),
+            std::ios(&this->sbuf),
+            std::istream(&this->sbuf)
+        {
+        }
+    };
 } // namespace trc::util
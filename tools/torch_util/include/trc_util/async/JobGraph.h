@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace trc::async
+{
+    /**
+     * @brief A reusable graph of jobs with dependencies
+     *
+     * Jobs are added once and the graph is executed any number of times,
+     * e.g. once per frame. A job starts as soon as all of its
+     * dependencies have finished, so independent jobs run in parallel on
+     * a thread pool.
+     *
+     * The graph is validated and its execution state is allocated when it
+     * is executed for the first time after a modification. Subsequent
+     * executions of an unmodified graph do not allocate memory.
+     *
+     * # Example
+     * ```cpp
+     *
+     * JobGraph graph;
+     * auto transforms = graph.addJob([&]{ updateTransforms(); });
+     * auto animations = graph.addJob([&]{ updateAnimations(); });
+     * graph.addJob([&]{ writeInstances(); }, { transforms, animations });
+     *
+     * while (running) graph.execute(threadPool);
+     * ```
+     */
+    class JobGraph
+    {
+    public:
+        using JobID = uint32_t;
+        using Job = std::function<void()>;
+
+        JobGraph() = default;
+        JobGraph(const JobGraph&) = delete;
+        JobGraph(JobGraph&&) noexcept = default;
+        auto operator=(const JobGraph&) -> JobGraph& = delete;
+        auto operator=(JobGraph&&) noexcept -> JobGraph& = default;
+        ~JobGraph() noexcept = default;
+
+        /**
+         * @brief Add a job without dependencies
+         */
+        auto addJob(Job job) -> JobID;
+
+        /**
+         * @brief Add a job that runs after a set of other jobs
+         *
+         * @throw std::out_of_range if a dependency is not a job in this
+         *                          graph.
+         */
+        auto addJob(Job job, std::initializer_list<JobID> dependencies) -> JobID;
+
+        /**
+         * @brief Add a job that runs after another job has finished
+         *
+         * Equivalent to `addJob(continuation, { job })`.
+         *
+         * @throw std::out_of_range if `job` is not a job in this graph.
+         */
+        auto addContinuation(JobID job, Job continuation) -> JobID;
+
+        /**
+         * @brief Declare that a job must not start before another has
+         *        finished
+         *
+         * @throw std::out_of_range if either ID is not a job in this graph.
+         */
+        void addDependency(JobID job, JobID dependency);
+
+        /**
+         * @return size_t The number of jobs in the graph
+         */
+        auto size() const -> size_t;
+
+        /**
+         * @brief Remove all jobs from the graph
+         */
+        void clear();
+
+        /**
+         * @brief Execute all jobs on the calling thread
+         *
+         * Runs jobs in an order that satisfies all dependencies. If a job
+         * throws, no further jobs are run and the exception is rethrown.
+         *
+         * @throw std::logic_error if the graph contains a dependency
+         *                         cycle.
+         */
+        void execute();
+
+        /**
+         * @brief Execute all jobs on a thread pool
+         *
+         * The calling thread participates in the execution and returns
+         * when all jobs have finished. It only executes jobs of this
+         * graph, never other tasks of the pool, and blocks while the
+         * remaining jobs run on other threads. Jobs may submit nested work
+         * to `pool` and wait for it.
+         *
+         * If a job throws, jobs that have not yet been started are
+         * skipped and the first exception is rethrown on the calling
+         * thread.
+         *
+         * A graph must not be executed concurrently from multiple
+         * threads.
+         *
+         * @throw std::logic_error if the graph contains a dependency
+         *                         cycle.
+         */
+        void execute(ThreadPool& pool);
+
+    private:
+        static constexpr JobID kNoJob{ UINT32_MAX };
+
+        struct Node
+        {
+            Job job;
+            std::vector<JobID> successors;
+            uint32_t numDependencies{ 0 };
+        };
+
+        /**
+         * State of a running execution. Allocated when the graph's
+         * structure changes, reset for every execution.
+         *
+         * Shared with the helper tasks in the pool because a helper may
+         * start only after the execution has finished, or after the graph
+         * has been destroyed. Such a helper finds no ready jobs and never
+         * touches the graph.
+         */
+        struct ExecutionState
+        {
+            explicit ExecutionState(size_t numJobs);
+
+            std::unique_ptr<std::atomic<uint32_t>[]> remainingDependencies;
+            std::atomic<size_t> remainingJobs{ 0 };
+            std::atomic<bool> failed{ false };
+            std::mutex errorLock;
+            std::exception_ptr error;
+            ThreadPool* pool{ nullptr };
+
+            /**
+             * Jobs whose dependencies have finished, but that no thread has
+             * started yet. Its capacity is the number of jobs, so pushing
+             * never allocates.
+             */
+            std::vector<JobID> readyJobs;
+            std::mutex readyJobsLock;
+        };
+
+        void checkID(JobID id, const char* method) const;
+
+        /**
+         * @brief Validate the graph and compute its execution order if it
+         *        has been modified since the last execution
+         */
+        void prepare();
+
+        /**
+         * @brief Run a job and all successors it unblocks
+         *
+         * Runs one unblocked successor on the calling thread and makes
+         * the others ready.
+         */
+        void runJob(ExecutionState& s, JobID id);
+
+        /**
+         * @brief Make a job available to the calling thread of `execute`
+         *        and submit a helper task that runs it to the pool
+         */
+        void pushReadyJob(ExecutionState& s, JobID id);
+
+        /**
+         * @return JobID A ready job, or `kNoJob` if there is none
+         */
+        static auto popReadyJob(ExecutionState& s) -> JobID;
+
+        std::vector<Node> nodes;
+        bool modified{ true };
+
+        /** Jobs in dependency order */
+        std::vector<JobID> order;
+        /** Jobs without dependencies */
+        std::vector<JobID> roots;
+        std::shared_ptr<ExecutionState> state;
+    };
+} // namespace trc::async
@@ -1,16 +1,50 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <exception>
 #include <functional>
-#include <thread>
 #include <future>
-
-#include <trc_util/data/ThreadsafeQueue.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace trc::async
 {
+    /**
+     * @brief A work-stealing thread pool
+     *
+     * Each worker thread owns a task deque. Workers take tasks from the
+     * back of their own deque and steal tasks from the front of other
+     * workers' deques when they run out of work. Tasks submitted from
+     * within a task are pushed to the executing worker's deque; tasks
+     * submitted from other threads are distributed among all workers in
+     * a round-robin fashion. Submissions thus don't contend on a single
+     * lock.
+     *
+     * Threads that call `parallelFor` or `parallelReduce` process chunks
+     * of their own range and then block until the remaining chunks, which
+     * are already being processed by other threads, have finished. They
+     * never execute unrelated tasks, so a parallel loop is not delayed by
+     * long-running or blocking tasks in the pool. Threads that wait with
+     * `wait` or `waitUntil` execute arbitrary pending tasks while they
+     * wait. Tasks can therefore submit nested work and wait for it without
+     * deadlocking the pool.
+     *
+     * Task queues grow as needed but never shrink, so submitting tasks
+     * whose captures fit into `Task`'s small-object storage does not
+     * allocate once the queues have reached their working size.
+     */
     class ThreadPool
     {
     public:
+        using Task = std::move_only_function<void()>;
+
         ThreadPool(const ThreadPool&) = delete;
         ThreadPool(ThreadPool&&) noexcept = delete;
         auto operator=(const ThreadPool&) -> ThreadPool& = delete;
@@ -37,15 +71,31 @@ namespace trc::async
          */
         ~ThreadPool();
 
+        auto getThreadCount() const -> uint32_t;
+
+        /**
+         * @brief Execute a function asynchronously without a result
+         *
+         * Cheaper than `async` because no shared state is allocated. The
+         * function must not throw; an exception that escapes it
+         * terminates the program, as it would for `std::thread`.
+         *
+         * @throw std::invalid_argument if the pool has been created with
+         *                              a thread count of zero.
+         */
+        template<typename Func>
+            requires std::is_invocable_v<Func>
+        void execute(Func&& func);
+
         /**
-         * @brief Execute a function asynchronously with low overhead
+         * @brief Execute a function asynchronously
          *
-         * This function can run into a deadlock if the maximum worker
-         * count has been reached **and** no workers are idle **and** if
-         * no existing worker can finish its task before the task supplied
-         * to this function is completed. In this case, this function
-         * would block indefinitely waiting for a worker to become
-         * available and the work would never be executed.
+         * Exceptions thrown by the function are stored in the returned
+         * future.
+         *
+         * Blocking on the returned future from within a task of the same
+         * pool can deadlock if all workers do so. Use `wait` to wait for
+         * the future instead.
          *
          * @return std::future Future with the result value of the executed
          *                     function.
@@ -56,27 +106,141 @@ namespace trc::async
             requires std::is_invocable_v<Func, Args...>
         auto async(Func&& func, Args&&... args) -> std::future<std::invoke_result_t<Func, Args...>>;
 
-    private:
         /**
-         * Execute a function asynchronously.
+         * @brief Wait for a future to become ready
+         *
+         * Executes pending tasks of the pool until the future is ready.
+         * Does not retrieve the future's value.
+         */
+        template<typename T>
+        void wait(const std::future<T>& future);
+
+        /**
+         * @brief Execute pending tasks until a condition is met
+         *
+         * The executed tasks may be any tasks in the pool. Don't wait on a
+         * thread that must not block if the pool also runs blocking tasks.
+         *
+         * @param Pred&& pred Is called repeatedly, possibly while tasks
+         *                    are executed on other threads. Must be
+         *                    thread-safe.
+         */
+        template<typename Pred>
+            requires std::is_invocable_r_v<bool, Pred&>
+        void waitUntil(Pred&& pred);
+
+        /**
+         * @brief Call a function for each index in a range in parallel
+         *
+         * Splits the range [begin, end) into chunks of `grainSize` indices
+         * and distributes them among the calling thread and the pool's
+         * workers. Returns when all indices have been processed.
+         *
+         * The calling thread only executes chunks of this loop, never other
+         * tasks of the pool.
+         *
+         * If `func` throws, no further indices are processed and the first
+         * exception is rethrown on the calling thread.
+         *
+         * @throw std::invalid_argument if `grainSize` is less than one.
+         */
+        template<std::integral I, typename Func>
+            requires std::is_invocable_v<Func&, I>
+        void parallelFor(I begin, I end, I grainSize, Func&& func);
+
+        /**
+         * @brief Call a function for each index in a range in parallel
          *
-         * Tries to find an idle thread to execute the function with. If
-         * no such thread is available, it creates a new thread.
+         * Chooses a grain size that creates a few chunks per worker.
          */
-        void execute(std::function<void()> func);
+        template<std::integral I, typename Func>
+            requires std::is_invocable_v<Func&, I>
+        void parallelFor(I begin, I end, Func&& func);
 
-        struct Work
+        /**
+         * @brief Map and reduce a range of indices in parallel
+         *
+         * Computes `reduce(... reduce(reduce(identity, func(begin)),
+         * func(begin + 1)) ..., func(end - 1))`. Chunks of `grainSize`
+         * indices are reduced in parallel, then the chunks' results are
+         * reduced in order. The result is thus deterministic if `reduce`
+         * is associative. `identity` is folded exactly once, so it need not
+         * be a neutral element of `reduce`.
+         *
+         * @throw std::invalid_argument if `grainSize` is less than one.
+         */
+        template<std::integral I, typename T, typename Func, typename Reduce>
+            requires std::is_invocable_r_v<T, Func&, I>
+                  && std::is_invocable_r_v<T, Reduce&, T, T>
+        auto parallelReduce(I begin, I end, I grainSize, T identity, Func&& func, Reduce&& reduce)
+            -> T;
+
+    private:
+        /**
+         * @brief A task deque implemented as a growable ring buffer
+         *
+         * Not synchronized; access must be guarded by `mutex`.
+         */
+        struct WorkQueue
         {
-            std::function<void()> work;
-            bool terminateThread;
+            bool empty() const;
+            void pushBack(Task task);
+            auto popBack() -> Task;
+            auto popFront() -> Task;
+
+            std::mutex mutex;
+
+        private:
+            void grow();
+
+            std::vector<Task> ring;
+            size_t head{ 0 };
+            size_t size{ 0 };
         };
 
+        /**
+         * @throw std::invalid_argument if the pool has no workers.
+         */
+        void push(Task task);
+
+        /**
+         * @brief Execute one pending task on the calling thread
+         *
+         * Takes a task from the calling worker's own queue, or steals one
+         * from another queue.
+         *
+         * @return bool False if no task was available.
+         */
+        bool runPendingTask();
+
+        void workerLoop(uint32_t index);
+
+        /** One queue per worker */
+        std::vector<std::unique_ptr<WorkQueue>> queues;
         std::vector<std::thread> workers;
-        data::ThreadsafeQueue<Work> workQueue;
+
+        /**
+         * Number of tasks in all queues. Incremented before a task is
+         * pushed, so it may briefly be larger than the real count.
+         */
+        std::atomic<size_t> numPending{ 0 };
+        std::atomic<uint32_t> nextQueue{ 0 };
+
+        std::mutex sleepMutex;
+        std::condition_variable sleepCvar;
+        std::atomic<uint32_t> numSleeping{ 0 };
+        std::atomic<bool> stopRequested{ false };
     };
 
 
 
+    template<typename Func>
+        requires std::is_invocable_v<Func>
+    inline void ThreadPool::execute(Func&& func)
+    {
+        push(Task{ std::forward<Func>(func) });
+    }
+
     template<typename Func, typename ...Args>
         requires std::is_invocable_v<Func, Args...>
     inline auto ThreadPool::async(Func&& func, Args&&... args)
@@ -84,21 +248,177 @@ namespace trc::async
     {
         using ReturnType = std::invoke_result_t<Func, Args...>;
 
-        // Use a shared ptr because std::functions must be copyable, which
-        // isn't the case for std::promise
-        auto promise = std::make_shared<std::promise<ReturnType>>();
-        execute([promise, func = std::forward<Func>(func), ...args = std::forward<Args>(args)]() mutable
+        std::promise<ReturnType> promise;
+        auto future = promise.get_future();
+        push([promise = std::move(promise),
+              func = std::forward<Func>(func),
+              ...args = std::forward<Args>(args)]() mutable
+        {
+            try {
+                if constexpr (std::is_same_v<ReturnType, void>)
+                {
+                    std::invoke(func, std::forward<Args>(args)...);
+                    promise.set_value();
+                }
+                else {
+                    promise.set_value(std::invoke(func, std::forward<Args>(args)...));
+                }
+            }
+            catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+
+        return future;
+    }
+
+    template<typename T>
+    inline void ThreadPool::wait(const std::future<T>& future)
+    {
+        waitUntil([&future]{
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+    }
+
+    template<std::integral I, typename Func>
+        requires std::is_invocable_v<Func&, I>
+    inline void ThreadPool::parallelFor(I begin, I end, I grainSize, Func&& func)
+    {
+        using Size = std::make_unsigned_t<I>;
+
+        if (grainSize < 1) {
+            throw std::invalid_argument("[In ThreadPool::parallelFor]: Grain size must be at least 1.");
+        }
+        if (begin >= end) {
+            return;
+        }
+
+        const Size count = static_cast<Size>(end - begin);
+        const Size grain = static_cast<Size>(grainSize);
+        const size_t numChunks = count / grain + (count % grain != 0);
+
+        // Shared with the helper tasks because a helper may start only
+        // after this function has returned. Such a helper finds no chunks
+        // left and never touches `func`.
+        struct State
         {
-            if constexpr (std::is_same_v<ReturnType, void>)
+            std::atomic<size_t> nextChunk{ 0 };
+            std::atomic<size_t> doneChunks{ 0 };
+            std::atomic<bool> failed{ false };
+            std::mutex errorLock;
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<State>();
+
+        auto runChunks = [state, numChunks, count, grain, begin, f = &func] {
+            for (size_t chunk; (chunk = state->nextChunk.fetch_add(1)) < numChunks;)
             {
-                func(std::forward<Args>(args)...);
-                promise->set_value();
+                const Size first = static_cast<Size>(chunk) * grain;
+                const Size last = std::min(count, first + grain);
+                try {
+                    for (Size i = first; i < last && !state->failed.load(std::memory_order_relaxed); ++i) {
+                        (*f)(static_cast<I>(begin + static_cast<I>(i)));
+                    }
+                }
+                catch (...)
+                {
+                    std::scoped_lock lock(state->errorLock);
+                    if (!state->error) state->error = std::current_exception();
+                    state->failed = true;
+                }
+
+                if (state->doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == numChunks) {
+                    state->doneChunks.notify_all();
+                }
             }
-            else {
-                promise->set_value(func(std::forward<Args>(args)...));
+        };
+
+        // The calling thread processes chunks as well, so one task fewer
+        // than the number of chunks suffices.
+        const size_t numTasks = std::min(numChunks - 1, workers.size());
+        for (size_t i = 0; i < numTasks; ++i) {
+            push(runChunks);
+        }
+
+        // Only help with our own chunks. Running other pending tasks here
+        // could block the caller on unrelated work.
+        runChunks();
+        for (size_t done; (done = state->doneChunks.load(std::memory_order_acquire)) < numChunks;) {
+            state->doneChunks.wait(done, std::memory_order_acquire);
+        }
+
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    template<std::integral I, typename Func>
+        requires std::is_invocable_v<Func&, I>
+    inline void ThreadPool::parallelFor(I begin, I end, Func&& func)
+    {
+        constexpr size_t kChunksPerThread{ 4 };
+
+        const size_t count = begin < end ? static_cast<size_t>(end - begin) : 0;
+        const size_t numChunks = std::max<size_t>(1, workers.size() * kChunksPerThread);
+        const I grainSize = static_cast<I>(std::max<size_t>(1, count / numChunks));
+        parallelFor(begin, end, grainSize, std::forward<Func>(func));
+    }
+
+    template<std::integral I, typename T, typename Func, typename Reduce>
+        requires std::is_invocable_r_v<T, Func&, I>
+              && std::is_invocable_r_v<T, Reduce&, T, T>
+    inline auto ThreadPool::parallelReduce(
+        I begin,
+        I end,
+        I grainSize,
+        T identity,
+        Func&& func,
+        Reduce&& reduce)
+        -> T
+    {
+        if (grainSize < 1) {
+            throw std::invalid_argument("[In ThreadPool::parallelReduce]: Grain size must be at least 1.");
+        }
+        if (begin >= end) {
+            return identity;
+        }
+
+        using Size = std::make_unsigned_t<I>;
+        const Size count = static_cast<Size>(end - begin);
+        const Size grain = static_cast<Size>(grainSize);
+        const size_t numChunks = count / grain + (count % grain != 0);
+
+        std::vector<T> partials(numChunks, identity);  // Overwritten by every chunk
+        parallelFor(size_t{0}, numChunks, size_t{1}, [&](size_t chunk) {
+            const Size first = static_cast<Size>(chunk) * grain;
+            const Size last = std::min(count, first + grain);
+
+            // Start with the first element so that `identity` is folded
+            // only once, into the final result
+            T acc = func(static_cast<I>(begin + static_cast<I>(first)));
+            for (Size i = first + 1; i < last; ++i) {
+                acc = reduce(std::move(acc), func(static_cast<I>(begin + static_cast<I>(i))));
             }
+            partials[chunk] = std::move(acc);
         });
 
-        return promise->get_future();
+        T result = std::move(identity);
+        for (T& partial : partials) {
+            result = reduce(std::move(result), std::move(partial));
+        }
+
+        return result;
+    }
+
+    template<typename Pred>
+        requires std::is_invocable_r_v<bool, Pred&>
+    inline void ThreadPool::waitUntil(Pred&& pred)
+    {
+        while (!pred())
+        {
+            if (!runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
     }
 } // namespace trc::async
@@ -0,0 +1,516 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace trc::data
+{
+    /** Size used to separate data accessed by different threads */
+    constexpr size_t kCacheLineSize{ 64 };
+
+    /**
+     * @brief The threads that may access a `BoundedQueue` concurrently
+     */
+    enum class QueueAccess
+    {
+        /** Any number of producer and consumer threads */
+        eMultiProducerMultiConsumer,
+
+        /** At most one producer and one consumer thread at a time */
+        eSingleProducerSingleConsumer,
+    };
+
+    namespace internal
+    {
+        /**
+         * @brief Blocks threads until the state of a lock-free queue
+         *        changes
+         *
+         * Costs a memory fence and a load if no thread is waiting.
+         */
+        class QueueWaiter
+        {
+        public:
+            /**
+             * @brief Retry an operation until it succeeds, sleeping
+             *        between attempts
+             *
+             * @param Func&& tryOp Returns a value that converts to `true`
+             *                     on success.
+             */
+            template<typename Func>
+            auto waitFor(Func&& tryOp) -> decltype(tryOp());
+
+            /**
+             * @brief Wake threads blocked in `waitFor`
+             *
+             * Must be called after every change that could make a
+             * waiting thread's operation succeed.
+             */
+            void notify();
+
+        private:
+            /** Number of times a waiting thread retries before it sleeps */
+            static constexpr uint32_t kSpinCount{ 64 };
+
+            std::atomic<uint32_t> numWaiting{ 0 };
+            std::atomic<uint32_t> epoch{ 0 };
+        };
+    } // namespace internal
+
+    /**
+     * @brief A bounded, lock-free, multi-producer multi-consumer queue
+     *
+     * A ring buffer of sequenced cells after Dmitry Vyukov's design. A
+     * push or pop claims a cell with a single compare-and-swap on the
+     * queue's enqueue or dequeue position and publishes it with a release
+     * store to the cell's sequence number. Positions are kept on separate
+     * cache lines so that producers and consumers don't invalidate each
+     * other's caches.
+     *
+     * Implements the `push`, `emplace`, `try_pop`, and `wait_pop` interface
+     * of `ThreadsafeQueue`. Because the queue is bounded, `push` and
+     * `emplace` block while the queue is full; `try_push` fails instead.
+     */
+    template<typename T, QueueAccess Access = QueueAccess::eMultiProducerMultiConsumer>
+    class BoundedQueue
+    {
+    public:
+        using value_type = T;
+        using size_type  = size_t;
+
+        static constexpr size_t kDefaultCapacity{ 1024 };
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue(BoundedQueue&&) noexcept = delete;
+        auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+        auto operator=(BoundedQueue&&) noexcept -> BoundedQueue& = delete;
+
+        /**
+         * @param size_t capacity Rounded up to the next power of two.
+         *
+         * @throw std::invalid_argument if `capacity` is zero.
+         */
+        explicit BoundedQueue(size_t capacity = kDefaultCapacity);
+        ~BoundedQueue() noexcept;
+
+        auto capacity() const -> size_type;
+
+        /**
+         * @return size_t The number of elements in the queue. Only a
+         *                snapshot if other threads access the queue.
+         */
+        auto size() const -> size_type;
+        bool empty() const;
+
+        /**
+         * @brief Push an item into the queue if it is not full
+         *
+         * @return bool False if the queue is full.
+         */
+        template<typename... Args>
+        bool try_emplace(Args&&... args);
+        bool try_push(const T& item) { return try_emplace(item); }
+        bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+        /**
+         * @brief Push an item into the queue
+         *
+         * Waits until the queue has space for the item.
+         */
+        template<typename... Args>
+        void emplace(Args&&... args);
+        void push(const T& item) { emplace(item); }
+        void push(T&& item) { emplace(std::move(item)); }
+
+        /**
+         * @brief Try to erase and retrieve the first element in the queue
+         *
+         * @return std::optional<T> None if the queue is empty. Otherwise
+         *                          the front element.
+         */
+        auto try_pop() -> std::optional<T>;
+
+        /**
+         * @brief Erase and retrieve the first element in the queue
+         *
+         * Waits until an element is available.
+         */
+        auto wait_pop() -> T;
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            alignas(T) std::byte storage[sizeof(T)];
+
+            auto get() -> T* { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        const size_t mask;
+        const std::unique_ptr<Cell[]> cells;
+
+        alignas(kCacheLineSize) std::atomic<size_t> enqueuePos{ 0 };
+        alignas(kCacheLineSize) std::atomic<size_t> dequeuePos{ 0 };
+
+        alignas(kCacheLineSize) internal::QueueWaiter notFull;
+        internal::QueueWaiter notEmpty;
+    };
+
+    /**
+     * @brief A bounded, lock-free, single-producer single-consumer queue
+     *
+     * Cheaper than the multi-producer variant because positions are
+     * advanced with plain stores instead of compare-and-swap. Each side
+     * caches the other side's last known position to avoid touching its
+     * cache line on every operation.
+     */
+    template<typename T>
+    class BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>
+    {
+    public:
+        using value_type = T;
+        using size_type  = size_t;
+
+        static constexpr size_t kDefaultCapacity{ 1024 };
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue(BoundedQueue&&) noexcept = delete;
+        auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+        auto operator=(BoundedQueue&&) noexcept -> BoundedQueue& = delete;
+
+        /**
+         * @param size_t capacity Rounded up to the next power of two.
+         *
+         * @throw std::invalid_argument if `capacity` is zero.
+         */
+        explicit BoundedQueue(size_t capacity = kDefaultCapacity);
+        ~BoundedQueue() noexcept;
+
+        auto capacity() const -> size_type;
+        auto size() const -> size_type;
+        bool empty() const;
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args);
+        bool try_push(const T& item) { return try_emplace(item); }
+        bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+        template<typename... Args>
+        void emplace(Args&&... args);
+        void push(const T& item) { emplace(item); }
+        void push(T&& item) { emplace(std::move(item)); }
+
+        auto try_pop() -> std::optional<T>;
+        auto wait_pop() -> T;
+
+    private:
+        struct Slot
+        {
+            alignas(T) std::byte storage[sizeof(T)];
+
+            auto get() -> T* { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        const size_t mask;
+        const std::unique_ptr<Slot[]> slots;
+
+        /** Written by the producer */
+        alignas(kCacheLineSize) std::atomic<size_t> tail{ 0 };
+        size_t cachedHead{ 0 };
+
+        /** Written by the consumer */
+        alignas(kCacheLineSize) std::atomic<size_t> head{ 0 };
+        size_t cachedTail{ 0 };
+
+        alignas(kCacheLineSize) internal::QueueWaiter notFull;
+        internal::QueueWaiter notEmpty;
+    };
+
+
+
+    namespace internal
+    {
+        inline auto roundCapacity(size_t capacity) -> size_t
+        {
+            if (capacity == 0) {
+                throw std::invalid_argument("[In BoundedQueue::BoundedQueue]: Capacity must not be zero.");
+            }
+            return std::bit_ceil(capacity);
+        }
+
+        template<typename Func>
+        inline auto QueueWaiter::waitFor(Func&& tryOp) -> decltype(tryOp())
+        {
+            for (uint32_t i = 0; i < kSpinCount; ++i)
+            {
+                if (auto res = tryOp()) {
+                    return res;
+                }
+                std::this_thread::yield();
+            }
+
+            numWaiting.fetch_add(1);
+            while (true)
+            {
+                // Register as a waiter before the state is checked, so that
+                // `notify` can't miss the change that makes `tryOp` succeed.
+                const uint32_t current = epoch.load();
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (auto res = tryOp())
+                {
+                    numWaiting.fetch_sub(1);
+                    return res;
+                }
+                epoch.wait(current);
+            }
+        }
+
+        inline void QueueWaiter::notify()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (numWaiting.load(std::memory_order_relaxed) > 0)
+            {
+                epoch.fetch_add(1);
+                epoch.notify_all();
+            }
+        }
+    } // namespace internal
+
+
+
+    template<typename T, QueueAccess Access>
+    inline BoundedQueue<T, Access>::BoundedQueue(size_t capacity)
+        :
+        mask(internal::roundCapacity(capacity) - 1),
+        cells(std::make_unique<Cell[]>(mask + 1))
+    {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T, QueueAccess Access>
+    inline BoundedQueue<T, Access>::~BoundedQueue() noexcept
+    {
+        while (try_pop());
+    }
+
+    template<typename T, QueueAccess Access>
+    inline auto BoundedQueue<T, Access>::capacity() const -> size_type
+    {
+        return mask + 1;
+    }
+
+    template<typename T, QueueAccess Access>
+    inline auto BoundedQueue<T, Access>::size() const -> size_type
+    {
+        const size_t dequeue = dequeuePos.load(std::memory_order_relaxed);
+        const size_t enqueue = enqueuePos.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? std::min(enqueue - dequeue, capacity()) : 0;
+    }
+
+    template<typename T, QueueAccess Access>
+    inline bool BoundedQueue<T, Access>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template<typename T, QueueAccess Access>
+    template<typename... Args>
+    inline bool BoundedQueue<T, Access>::try_emplace(Args&&... args)
+    {
+        Cell* cell;
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // The cell is free; claim it
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;  // The queue is full
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        notEmpty.notify();
+
+        return true;
+    }
+
+    template<typename T, QueueAccess Access>
+    template<typename... Args>
+    inline void BoundedQueue<T, Access>::emplace(Args&&... args)
+    {
+        if (try_emplace(std::forward<Args>(args)...)) {
+            return;
+        }
+
+        // Arguments are forwarded only on success, so they are intact on
+        // every retry.
+        notFull.waitFor([&]{ return try_emplace(std::forward<Args>(args)...); });
+    }
+
+    template<typename T, QueueAccess Access>
+    inline auto BoundedQueue<T, Access>::try_pop() -> std::optional<T>
+    {
+        Cell* cell;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                // The cell contains an element; claim it
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return std::nullopt;  // The queue is empty
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> result(std::move(*cell->get()));
+        cell->get()->~T();
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        notFull.notify();
+
+        return result;
+    }
+
+    template<typename T, QueueAccess Access>
+    inline auto BoundedQueue<T, Access>::wait_pop() -> T
+    {
+        if (auto item = try_pop()) {
+            return std::move(*item);
+        }
+        return std::move(*notEmpty.waitFor([this]{ return try_pop(); }));
+    }
+
+
+
+    template<typename T>
+    inline BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::BoundedQueue(size_t capacity)
+        :
+        mask(internal::roundCapacity(capacity) - 1),
+        slots(std::make_unique<Slot[]>(mask + 1))
+    {
+    }
+
+    template<typename T>
+    inline BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::~BoundedQueue() noexcept
+    {
+        while (try_pop());
+    }
+
+    template<typename T>
+    inline auto BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::capacity() const
+        -> size_type
+    {
+        return mask + 1;
+    }
+
+    template<typename T>
+    inline auto BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::size() const
+        -> size_type
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_relaxed);
+        return t > h ? t - h : 0;
+    }
+
+    template<typename T>
+    inline bool BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template<typename T>
+    template<typename... Args>
+    inline bool BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::try_emplace(
+        Args&&... args)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead > mask)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) {
+                return false;  // The queue is full
+            }
+        }
+
+        new (slots[t & mask].storage) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        notEmpty.notify();
+
+        return true;
+    }
+
+    template<typename T>
+    template<typename... Args>
+    inline void BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::emplace(
+        Args&&... args)
+    {
+        if (try_emplace(std::forward<Args>(args)...)) {
+            return;
+        }
+        notFull.waitFor([&]{ return try_emplace(std::forward<Args>(args)...); });
+    }
+
+    template<typename T>
+    inline auto BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::try_pop()
+        -> std::optional<T>
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) {
+                return std::nullopt;  // The queue is empty
+            }
+        }
+
+        T* item = slots[h & mask].get();
+        std::optional<T> result(std::move(*item));
+        item->~T();
+        head.store(h + 1, std::memory_order_release);
+        notFull.notify();
+
+        return result;
+    }
+
+    template<typename T>
+    inline auto BoundedQueue<T, QueueAccess::eSingleProducerSingleConsumer>::wait_pop() -> T
+    {
+        if (auto item = try_pop()) {
+            return std::move(*item);
+        }
+        return std::move(*notEmpty.waitFor([this]{ return try_pop(); }));
+    }
+} // namespace trc::data
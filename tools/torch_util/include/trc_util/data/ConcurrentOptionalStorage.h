@@ -0,0 +1,483 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "OptionalStorage.h"
+
+namespace trc::data
+{
+    /**
+     * @brief A fixed-size, thread-safe container of nullable objects with
+     *        wait-free reads
+     *
+     * Provides the same element interface as `OptionalStorage`, but
+     * validity checks and element lookups don't take a lock. Each element
+     * has an atomic state word that holds its validity and a sequence
+     * number. Writers (`emplace`, `erase`, and mutable `apply`) are
+     * serialized by a lock, mark the element as being written while they
+     * modify it, and publish the new state with a release store.
+     *
+     * `copy` reads trivially copyable elements optimistically and retries
+     * if the element's sequence number changed during the read (a
+     * seqlock), so it never blocks writers. Other element types are
+     * copied under a shared lock.
+     */
+    template<typename T, size_t N>
+    class ConcurrentOptionalStorage
+    {
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = size_t;
+
+        static constexpr size_type kSize = N;
+
+        ConcurrentOptionalStorage(const ConcurrentOptionalStorage&) = delete;
+        ConcurrentOptionalStorage(ConcurrentOptionalStorage&&) noexcept = delete;
+        auto operator=(const ConcurrentOptionalStorage&) -> ConcurrentOptionalStorage& = delete;
+        auto operator=(ConcurrentOptionalStorage&&) noexcept -> ConcurrentOptionalStorage& = delete;
+
+        ConcurrentOptionalStorage() = default;
+        ~ConcurrentOptionalStorage() noexcept;
+
+        inline auto size() const noexcept -> size_type {
+            return kSize;
+        }
+
+        /**
+         * @brief Check whether an element is valid. Wait-free.
+         *
+         * @throw std::out_of_range if `index` is out of bounds.
+         */
+        bool valid(size_type index) const;
+
+        /**
+         * @brief Access an element with validity check. Wait-free.
+         *
+         * @throw InvalidElementAccess if element at `index` is not valid.
+         * @throw std::out_of_range if `index` is out of bounds.
+         */
+        auto at(size_type index) -> reference;
+        auto at(size_type index) const -> const_reference;
+
+        /**
+         * @brief Construct an element in-place, overwriting existing elements
+         */
+        template<typename ...Args>
+        auto emplace(size_type index, Args&&... args) -> reference;
+
+        /**
+         * @brief Construct an element in-place if no element is at index
+         */
+        template<typename ...Args>
+        auto try_emplace(size_type index, Args&&... args)
+            -> std::pair<std::reference_wrapper<value_type>, bool>;
+
+        /**
+         * @return bool True if an element was erased, false otherwise.
+         */
+        bool erase(size_type index);
+
+        void clear();
+
+        /**
+         * @brief Create a copy of an element that is consistent with
+         *        respect to concurrent writes
+         *
+         * @throw InvalidElementAccess if element at `index` is not valid.
+         */
+        auto copy(size_type index) const -> value_type
+            requires std::copy_constructible<value_type>;
+
+        /**
+         * @brief Modify an element exclusively
+         */
+        template<std::invocable<reference> F>
+        auto apply(size_type index, F&& func) -> std::invoke_result_t<F, reference>;
+
+        /**
+         * @brief Read an element while no writer modifies it
+         */
+        template<std::invocable<const_reference> F>
+        auto apply(size_type index, F&& func) const -> std::invoke_result_t<F, const_reference>;
+
+    private:
+        /** Layout of the state word: [sequence number | valid | writing] */
+        static constexpr uint32_t kWriting{ 1 << 0 };
+        static constexpr uint32_t kValid{ 1 << 1 };
+        static constexpr uint32_t kSequenceIncrement{ 1 << 2 };
+
+        static void checkBounds(size_type index);
+
+        auto ptr(size_type index) const -> T* {
+            return std::launder(reinterpret_cast<T*>(const_cast<std::byte*>(data.data()))) + index;
+        }
+
+        /**
+         * Writer lock must be held.
+         *
+         * @param bool validDuringWrite If false, the element is invalid to
+         *                              readers from now on.
+         */
+        void beginWrite(size_type index, bool validDuringWrite);
+        /** Writer lock must be held */
+        void endWrite(size_type index, bool valid);
+
+        mutable std::shared_mutex writeLock;
+        std::array<std::atomic<uint32_t>, N> states{};
+        alignas(T) std::array<std::byte, N * sizeof(T)> data;
+    };
+
+    /**
+     * @brief An append-only sequence of default-constructed objects with
+     *        wait-free lookup
+     *
+     * Objects are allocated individually and are never moved or destroyed
+     * before the container is destroyed. Lookups read the published size
+     * and a pointer from a segmented table without taking a lock; growing
+     * the container is serialized by a mutex.
+     */
+    template<typename T>
+        requires std::is_default_constructible_v<T>
+    class ChunkDirectory
+    {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+
+        ChunkDirectory(const ChunkDirectory&) = delete;
+        ChunkDirectory(ChunkDirectory&&) noexcept = delete;
+        auto operator=(const ChunkDirectory&) -> ChunkDirectory& = delete;
+        auto operator=(ChunkDirectory&&) noexcept -> ChunkDirectory& = delete;
+
+        ChunkDirectory() = default;
+        ~ChunkDirectory() noexcept;
+
+        auto size() const -> size_type;
+
+        /**
+         * @brief Access an object. Wait-free.
+         *
+         * @throw std::out_of_range if `index >= size()`.
+         */
+        auto get(size_type index) const -> T*;
+
+        /**
+         * @brief Grow the container to at least `newSize` objects
+         */
+        void resize_to_fit(size_type newSize);
+
+    private:
+        /** Segment k holds 2^k pointers */
+        static constexpr size_t kNumSegments{ 48 };
+
+        static auto locate(size_type index) -> std::pair<size_t, size_t>
+        {
+            const size_t segment = std::bit_width(index + 1) - 1;
+            return { segment, index + 1 - (size_t{1} << segment) };
+        }
+
+        std::atomic<size_type> publishedSize{ 0 };
+        std::mutex growLock;
+        std::array<std::unique_ptr<T*[]>, kNumSegments> segments;
+    };
+
+
+
+    template<typename T, size_t N>
+    ConcurrentOptionalStorage<T, N>::~ConcurrentOptionalStorage() noexcept
+    {
+        for (size_type i = 0; i < kSize; ++i)
+        {
+            if (states[i].load(std::memory_order_relaxed) & kValid) {
+                ptr(i)->~T();
+            }
+        }
+    }
+
+    template<typename T, size_t N>
+    void ConcurrentOptionalStorage<T, N>::checkBounds(size_type index)
+    {
+        if (index >= kSize)
+        {
+            throw std::out_of_range("[ConcurrentOptionalStorage::checkBounds]: Tried to access element "
+                                    + std::to_string(index) + " in container of size "
+                                    + std::to_string(kSize) + ".");
+        }
+    }
+
+    template<typename T, size_t N>
+    bool ConcurrentOptionalStorage<T, N>::valid(size_type index) const
+    {
+        checkBounds(index);
+        return states[index].load(std::memory_order_acquire) & kValid;
+    }
+
+    template<typename T, size_t N>
+    auto ConcurrentOptionalStorage<T, N>::at(size_type index) -> reference
+    {
+        if (!valid(index)) {
+            throw InvalidElementAccess("[ConcurrentOptionalStorage::at]: Access to invalid element.");
+        }
+        return *ptr(index);
+    }
+
+    template<typename T, size_t N>
+    auto ConcurrentOptionalStorage<T, N>::at(size_type index) const -> const_reference
+    {
+        if (!valid(index)) {
+            throw InvalidElementAccess("[ConcurrentOptionalStorage::at]: Access to invalid element.");
+        }
+        return *ptr(index);
+    }
+
+    template<typename T, size_t N>
+    template<typename ...Args>
+    auto ConcurrentOptionalStorage<T, N>::emplace(size_type index, Args&&... args) -> reference
+    {
+        checkBounds(index);
+        std::scoped_lock lock(writeLock);
+
+        const bool wasValid = states[index].load(std::memory_order_relaxed) & kValid;
+        beginWrite(index, false);
+        if (wasValid) {
+            ptr(index)->~T();
+        }
+        try {
+            new (ptr(index)) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            endWrite(index, false);
+            throw;
+        }
+        endWrite(index, true);
+
+        return *ptr(index);
+    }
+
+    template<typename T, size_t N>
+    template<typename ...Args>
+    auto ConcurrentOptionalStorage<T, N>::try_emplace(size_type index, Args&&... args)
+        -> std::pair<std::reference_wrapper<value_type>, bool>
+    {
+        checkBounds(index);
+        std::scoped_lock lock(writeLock);
+
+        if (states[index].load(std::memory_order_relaxed) & kValid) {
+            return { *ptr(index), false };
+        }
+
+        beginWrite(index, false);
+        try {
+            new (ptr(index)) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            endWrite(index, false);
+            throw;
+        }
+        endWrite(index, true);
+
+        return { *ptr(index), true };
+    }
+
+    template<typename T, size_t N>
+    bool ConcurrentOptionalStorage<T, N>::erase(size_type index)
+    {
+        checkBounds(index);
+        std::scoped_lock lock(writeLock);
+
+        if (!(states[index].load(std::memory_order_relaxed) & kValid)) {
+            return false;
+        }
+
+        beginWrite(index, false);
+        ptr(index)->~T();
+        endWrite(index, false);
+
+        return true;
+    }
+
+    template<typename T, size_t N>
+    void ConcurrentOptionalStorage<T, N>::clear()
+    {
+        for (size_type i = 0; i < kSize; ++i) {
+            erase(i);
+        }
+    }
+
+    template<typename T, size_t N>
+    auto ConcurrentOptionalStorage<T, N>::copy(size_type index) const -> value_type
+        requires std::copy_constructible<value_type>
+    {
+        checkBounds(index);
+
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+        {
+            const auto& state = states[index];
+            while (true)
+            {
+                const uint32_t before = state.load(std::memory_order_acquire);
+                if (before & kWriting)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (!(before & kValid)) {
+                    throw InvalidElementAccess("[ConcurrentOptionalStorage::copy]: Access to invalid element.");
+                }
+
+                // The copy may observe a partial write; it is discarded in
+                // that case.
+                T result;
+                std::memcpy(static_cast<void*>(&result), ptr(index), sizeof(T));
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (state.load(std::memory_order_relaxed) == before) {
+                    return result;
+                }
+            }
+        }
+        else {
+            return apply(index, [](const T& val){ return T{ val }; });
+        }
+    }
+
+    template<typename T, size_t N>
+    template<std::invocable<typename ConcurrentOptionalStorage<T, N>::reference> F>
+    auto ConcurrentOptionalStorage<T, N>::apply(size_type index, F&& func)
+        -> std::invoke_result_t<F, reference>
+    {
+        checkBounds(index);
+        std::scoped_lock lock(writeLock);
+        if (!(states[index].load(std::memory_order_relaxed) & kValid)) {
+            throw InvalidElementAccess("[ConcurrentOptionalStorage::apply]: Access to invalid element.");
+        }
+
+        // Invalidate optimistic readers while the element is modified
+        struct WriteScope
+        {
+            ConcurrentOptionalStorage& self;
+            size_type index;
+            ~WriteScope() { self.endWrite(index, true); }
+        };
+        beginWrite(index, true);
+        WriteScope scope{ *this, index };
+
+        return std::invoke(std::forward<F>(func), *ptr(index));
+    }
+
+    template<typename T, size_t N>
+    template<std::invocable<typename ConcurrentOptionalStorage<T, N>::const_reference> F>
+    auto ConcurrentOptionalStorage<T, N>::apply(size_type index, F&& func) const
+        -> std::invoke_result_t<F, const_reference>
+    {
+        checkBounds(index);
+        std::shared_lock lock(writeLock);
+        if (!(states[index].load(std::memory_order_relaxed) & kValid)) {
+            throw InvalidElementAccess("[ConcurrentOptionalStorage::apply]: Access to invalid element.");
+        }
+
+        return std::invoke(std::forward<F>(func), std::as_const(*ptr(index)));
+    }
+
+    template<typename T, size_t N>
+    void ConcurrentOptionalStorage<T, N>::beginWrite(size_type index, bool validDuringWrite)
+    {
+        auto& state = states[index];
+        uint32_t newState = state.load(std::memory_order_relaxed) | kWriting;
+        if (!validDuringWrite) newState &= ~kValid;
+        state.store(newState, std::memory_order_relaxed);
+
+        // Order the flag before the element's modification, so that
+        // optimistic readers that see the modification also see the flag.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    template<typename T, size_t N>
+    void ConcurrentOptionalStorage<T, N>::endWrite(size_type index, bool valid)
+    {
+        auto& state = states[index];
+        const uint32_t sequence = (state.load(std::memory_order_relaxed) & ~(kWriting | kValid))
+                                + kSequenceIncrement;
+        state.store(sequence | (valid ? kValid : 0), std::memory_order_release);
+    }
+
+
+
+    template<typename T>
+        requires std::is_default_constructible_v<T>
+    ChunkDirectory<T>::~ChunkDirectory() noexcept
+    {
+        const size_type size = publishedSize.load();
+        for (size_type i = 0; i < size; ++i)
+        {
+            const auto [segment, offset] = locate(i);
+            delete segments[segment][offset];
+        }
+    }
+
+    template<typename T>
+        requires std::is_default_constructible_v<T>
+    auto ChunkDirectory<T>::size() const -> size_type
+    {
+        return publishedSize.load(std::memory_order_acquire);
+    }
+
+    template<typename T>
+        requires std::is_default_constructible_v<T>
+    auto ChunkDirectory<T>::get(size_type index) const -> T*
+    {
+        if (index >= size()) {
+            throw std::out_of_range("[In ChunkDirectory::get]: Index out of range.");
+        }
+
+        // Entries below the published size are never modified, so the
+        // acquire load of the size orders these reads.
+        const auto [segment, offset] = locate(index);
+        return segments[segment][offset];
+    }
+
+    template<typename T>
+        requires std::is_default_constructible_v<T>
+    void ChunkDirectory<T>::resize_to_fit(size_type newSize)
+    {
+        if (newSize <= size()) {
+            return;
+        }
+
+        std::scoped_lock lock(growLock);
+        size_type size = publishedSize.load(std::memory_order_relaxed);
+        for (; size < newSize; ++size)
+        {
+            const auto [segment, offset] = locate(size);
+            if (segments[segment] == nullptr) {
+                segments[segment] = std::make_unique<T*[]>(size_t{1} << segment);
+            }
+            segments[segment][offset] = new T;
+
+            // Publish each object immediately so that readers don't wait
+            // for the entire resize
+            publishedSize.store(size + 1, std::memory_order_release);
+        }
+    }
+} // namespace trc::data
@@ -2,13 +2,17 @@
 
 #include <cassert>
 
+#include <array>
+#include <atomic>
+#include <bit>
 #include <concepts>
-#include <mutex>
+#include <functional>
 #include <source_location>
+#include <span>
 #include <stdexcept>
 #include <string>
-#include <vector>
 
+#include "ConcurrentOptionalStorage.h"
 #include "IdPool.h"
 #include "TypesafeId.h"
 
@@ -25,6 +29,17 @@ namespace trc::data
      * objects to provide read-only access. Only the data's owner (i.e.
      * the original `ExternalStorage<>` object) has write access.
      *
+     * All values of a type `T` are stored in chunks of contiguous memory
+     * that never move, so storage can grow while other threads read
+     * values. Each chunk tracks which of its values have been modified;
+     * `consumeDirtyRanges` enumerates these, e.g. to upload only the
+     * changed values to a device buffer.
+     *
+     * All objects of the same `ExternalStorage<T, Tag>` type share one
+     * storage and thus one set of modification flags. Use distinct `Tag`
+     * types to keep values of the same type that are consumed separately
+     * in independent storages.
+     *
      * # Example
      *
      * ```cpp
@@ -40,7 +55,7 @@ namespace trc::data
      * assert(ref.get().b == data.get().b);
      * ```
      */
-    template<std::semiregular T>
+    template<std::semiregular T, typename Tag = T>
     class ExternalStorage
     {
     public:
@@ -67,7 +82,7 @@ namespace trc::data
              * @throw std::invalid_argument if `*this == ID::NONE`.
              */
             inline auto get() const -> T {
-                return ExternalStorage<T>::getData(*this);
+                return ExternalStorage<T, Tag>::getData(*this);
             }
         };
 
@@ -90,7 +105,7 @@ namespace trc::data
         /**
          * @brief Retrieve the value referenced by an ID
          *
-         * `ExternalStorage<T>::getData(id)` is equivalent to
+         * `ExternalStorage<T, Tag>::getData(id)` is equivalent to
          * `id.get()`.
          *
          * @throw std::invalid_argument if `id == ID::NONE`.
@@ -132,10 +147,40 @@ namespace trc::data
          */
         inline void set(T&& value);
 
+        /**
+         * @brief Number of values that fit into the currently allocated
+         *        storage
+         *
+         * All IDs are less than this number. Useful to size a device
+         * buffer that mirrors the stored values.
+         */
+        static auto getCapacity() -> uint32_t;
+
+        /**
+         * @brief Visit all values that were modified since the last call
+         *
+         * Calls `visitor(firstId, values)` for every range of consecutive
+         * IDs whose values have been set or (re)initialized, where
+         * `values[i]` is the value of ID `firstId + i`. Ranges never span
+         * multiple chunks. The modification flags are cleared in the
+         * process.
+         *
+         * May be called concurrently with `set`. A value that is modified
+         * while it is being visited is reported again on the next call.
+         *
+         * Consuming clears the flags for all callers, so each storage
+         * should have a single consumer.
+         */
+        template<std::invocable<uint32_t, std::span<const T>> F>
+        static void consumeDirtyRanges(F&& visitor);
+
     private:
         class RegularDataStorage
         {
         public:
+            /** Number of values per chunk. Must be a multiple of 64. */
+            static constexpr uint32_t kChunkSize{ 256 };
+
             auto create() -> ID;
             void free(ID id);
 
@@ -143,10 +188,27 @@ namespace trc::data
             void set(ID id, const T& value);
             void set(ID id, T&& value);
 
+            auto capacity() const -> uint32_t;
+
+            template<typename F>
+            void consumeDirtyRanges(F&& visitor);
+
         private:
+            static constexpr uint32_t kBitsPerWord{ 64 };
+            static constexpr uint32_t kDirtyWords{ kChunkSize / kBitsPerWord };
+            static_assert(kChunkSize % kBitsPerWord == 0);
+
+            struct Chunk
+            {
+                std::array<T, kChunkSize> objects{};
+                std::array<std::atomic<uint64_t>, kDirtyWords> dirty{};
+            };
+
+            auto at(ID id) -> T&;
+            void markDirty(ID id);
+
             IdPool<uint32_t> idGenerator;
-            std::mutex lock;
-            std::vector<T> objects;
+            ChunkDirectory<Chunk> chunks;
         };
 
         static inline RegularDataStorage staticDataStorage;
@@ -154,30 +216,30 @@ namespace trc::data
         ID dataId{ staticDataStorage.create() };
     };
 
-    template<std::semiregular T>
-    ExternalStorage<T>::ExternalStorage(
+    template<std::semiregular T, typename Tag>
+    ExternalStorage<T, Tag>::ExternalStorage(
         const ExternalStorage& other)
     {
         set(other.get());
     }
 
-    template<std::semiregular T>
-    ExternalStorage<T>::ExternalStorage(ExternalStorage&& other) noexcept
+    template<std::semiregular T, typename Tag>
+    ExternalStorage<T, Tag>::ExternalStorage(ExternalStorage&& other) noexcept
     {
         // Move semantics don't make sense here; just copy the value
         set(other.get());
     }
 
-    template<std::semiregular T>
-    auto ExternalStorage<T>::operator=(const ExternalStorage& rhs)
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::operator=(const ExternalStorage& rhs)
         -> ExternalStorage&
     {
         set(rhs.get());
         return *this;
     }
 
-    template<std::semiregular T>
-    auto ExternalStorage<T>::operator=(ExternalStorage&& rhs) noexcept
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::operator=(ExternalStorage&& rhs) noexcept
         -> ExternalStorage&
     {
         // Move semantics don't make sense here; just copy the value
@@ -186,8 +248,8 @@ namespace trc::data
         return *this;
     }
 
-    template<std::semiregular T>
-    auto ExternalStorage<T>::getData(ID id) -> T
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::getData(ID id) -> T
     {
         if (id == ID::NONE)
         {
@@ -200,79 +262,161 @@ namespace trc::data
         return staticDataStorage.get(id);
     }
 
-    template<std::semiregular T>
-    inline auto ExternalStorage<T>::getDataId() const -> ID
+    template<std::semiregular T, typename Tag>
+    inline auto ExternalStorage<T, Tag>::getDataId() const -> ID
     {
         assert(dataId != ID::NONE);
         return dataId;
     }
 
-    template<std::semiregular T>
-    inline auto ExternalStorage<T>::get() const -> T
+    template<std::semiregular T, typename Tag>
+    inline auto ExternalStorage<T, Tag>::get() const -> T
     {
         assert(dataId != ID::NONE);
         return getData(dataId);
     }
 
-    template<std::semiregular T>
-    inline void ExternalStorage<T>::set(const T& value)
+    template<std::semiregular T, typename Tag>
+    inline void ExternalStorage<T, Tag>::set(const T& value)
     {
         assert(dataId != ID::NONE);
         staticDataStorage.set(dataId, value);
     }
 
-    template<std::semiregular T>
-    inline void ExternalStorage<T>::set(T&& value)
+    template<std::semiregular T, typename Tag>
+    inline void ExternalStorage<T, Tag>::set(T&& value)
     {
         assert(dataId != ID::NONE);
         staticDataStorage.set(dataId, std::move(value));
     }
 
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::getCapacity() -> uint32_t
+    {
+        return staticDataStorage.capacity();
+    }
+
+    template<std::semiregular T, typename Tag>
+    template<std::invocable<uint32_t, std::span<const T>> F>
+    void ExternalStorage<T, Tag>::consumeDirtyRanges(F&& visitor)
+    {
+        staticDataStorage.consumeDirtyRanges(std::forward<F>(visitor));
+    }
+
 
 
-    template<std::semiregular T>
-    auto ExternalStorage<T>::RegularDataStorage::create() -> ID
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::RegularDataStorage::create() -> ID
     {
         const uint32_t id = idGenerator.generate();
-        if (objects.size() <= id)
-        {
-            std::scoped_lock lk(lock);
-            objects.resize(id + 1);
-        }
+        chunks.resize_to_fit(id / kChunkSize + 1);
 
-        objects[id] = {};
+        at(ID(id)) = {};
+        markDirty(ID(id));
 
         return ID(id);
     }
 
-    template<std::semiregular T>
-    void ExternalStorage<T>::RegularDataStorage::free(ID id)
+    template<std::semiregular T, typename Tag>
+    void ExternalStorage<T, Tag>::RegularDataStorage::free(ID id)
     {
         assert(id != ID::NONE);
         idGenerator.free(id);
     }
 
-    template<std::semiregular T>
-    auto ExternalStorage<T>::RegularDataStorage::get(ID id) -> T
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::RegularDataStorage::get(ID id) -> T
     {
         assert(id != ID::NONE);
-        assert(objects.size() > id);
-        return objects[id];
+        return at(id);
     }
 
-    template<std::semiregular T>
-    void ExternalStorage<T>::RegularDataStorage::set(ID id, const T& value)
+    template<std::semiregular T, typename Tag>
+    void ExternalStorage<T, Tag>::RegularDataStorage::set(ID id, const T& value)
     {
         assert(id != ID::NONE);
-        assert(objects.size() > id);
-        objects[id] = value;
+        at(id) = value;
+        markDirty(id);
     }
 
-    template<std::semiregular T>
-    void ExternalStorage<T>::RegularDataStorage::set(ID id, T&& value)
+    template<std::semiregular T, typename Tag>
+    void ExternalStorage<T, Tag>::RegularDataStorage::set(ID id, T&& value)
     {
         assert(id != ID::NONE);
-        assert(objects.size() > id);
-        objects[id] = std::move(value);
+        at(id) = std::move(value);
+        markDirty(id);
+    }
+
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::RegularDataStorage::capacity() const -> uint32_t
+    {
+        return static_cast<uint32_t>(chunks.size()) * kChunkSize;
+    }
+
+    template<std::semiregular T, typename Tag>
+    template<typename F>
+    void ExternalStorage<T, Tag>::RegularDataStorage::consumeDirtyRanges(F&& visitor)
+    {
+        constexpr uint32_t kNoRange{ UINT32_MAX };
+
+        const size_t numChunks = chunks.size();
+        for (size_t c = 0; c < numChunks; ++c)
+        {
+            Chunk& chunk = *chunks.get(c);
+            const uint32_t chunkBegin = static_cast<uint32_t>(c) * kChunkSize;
+            auto emit = [&](uint32_t begin, uint32_t end) {
+                std::invoke(visitor,
+                            chunkBegin + begin,
+                            std::span<const T>(chunk.objects.data() + begin, end - begin));
+            };
+
+            // Find runs of set bits. Runs may continue across word
+            // boundaries, but not across chunks.
+            uint32_t rangeBegin{ kNoRange };
+            for (uint32_t w = 0; w < kDirtyWords; ++w)
+            {
+                const uint64_t bits = chunk.dirty[w].exchange(0, std::memory_order_acquire);
+                const uint32_t wordBegin = w * kBitsPerWord;
+
+                uint32_t bit = 0;
+                while (bit < kBitsPerWord)
+                {
+                    if (rangeBegin == kNoRange)
+                    {
+                        if ((bits >> bit) == 0) break;
+                        bit += std::countr_zero(bits >> bit);
+                        rangeBegin = wordBegin + bit;
+                    }
+
+                    bit += std::countr_one(bits >> bit);
+                    if (bit < kBitsPerWord)
+                    {
+                        emit(rangeBegin, wordBegin + bit);
+                        rangeBegin = kNoRange;
+                    }
+                }
+            }
+
+            if (rangeBegin != kNoRange) {
+                emit(rangeBegin, kChunkSize);
+            }
+        }
+    }
+
+    template<std::semiregular T, typename Tag>
+    auto ExternalStorage<T, Tag>::RegularDataStorage::at(ID id) -> T&
+    {
+        const uint32_t index = id;
+        assert(index < capacity());
+        return chunks.get(index / kChunkSize)->objects[index % kChunkSize];
+    }
+
+    template<std::semiregular T, typename Tag>
+    void ExternalStorage<T, Tag>::RegularDataStorage::markDirty(ID id)
+    {
+        const uint32_t index = static_cast<uint32_t>(id) % kChunkSize;
+        chunks.get(static_cast<uint32_t>(id) / kChunkSize)
+            ->dirty[index / kBitsPerWord]
+            .fetch_or(uint64_t{1} << (index % kBitsPerWord), std::memory_order_release);
     }
 } // namespace trc::data
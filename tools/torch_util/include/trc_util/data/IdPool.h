@@ -1,64 +1,237 @@
 #pragma once
 
+#include <array>
 #include <atomic>
-
-#include "ThreadsafeQueue.h"
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 
 namespace trc::data
 {
 
 /**
  * @brief Thread-safe generator for reusable IDs
+ *
+ * Freed IDs are reused before new IDs are generated, so the set of IDs in
+ * use stays densely packed around zero. This makes the IDs suitable as
+ * indices into arrays such as `SafeVector`.
+ *
+ * `generate` and `free` are lock-free. Freed IDs are kept in an
+ * intrusive stack (a Treiber stack): each ID has a link slot that holds
+ * the next free ID, and the stack's head is a single atomic word that
+ * contains the top ID and a version counter to prevent ABA problems. The
+ * most recently freed ID is reused first. Link slots are allocated in
+ * segments of geometrically growing size and are never released before
+ * the pool is destroyed.
+ *
+ * At most `kMaxIds` distinct IDs can be generated.
  */
-template<typename T = uint64_t>
+template<std::unsigned_integral T = uint64_t>
 class IdPool
 {
 public:
+    /** Number of distinct IDs a pool can generate */
+    static constexpr uint64_t kMaxIds{ UINT32_MAX };
+
     IdPool(const IdPool&) = delete;
     IdPool& operator=(const IdPool&) = delete;
 
     IdPool() = default;
-    ~IdPool() noexcept = default;
+    ~IdPool() noexcept;
 
-    IdPool(IdPool&& other) noexcept
-        : nextId(T{other.nextId}), freeIds(std::move(other.freeIds))
-    {
-        other.nextId = T{0};
+    /**
+     * Moving a pool is not thread-safe.
+     */
+    IdPool(IdPool&& other) noexcept;
+
+    /**
+     * Moving a pool is not thread-safe.
+     */
+    IdPool& operator=(IdPool&& rhs) noexcept;
+
+    /**
+     * @brief Get an unused ID
+     *
+     * Reuses the most recently freed ID if one exists.
+     *
+     * @throw std::out_of_range if the pool has run out of IDs.
+     */
+    auto generate() -> T;
+
+    /**
+     * @brief Make an ID available for reuse
+     *
+     * The ID must have been returned by `generate` and not have been
+     * freed since.
+     */
+    void free(T id);
+
+    /**
+     * @brief Forget all generated and freed IDs
+     *
+     * Not thread-safe.
+     */
+    void reset();
+
+private:
+    using Link = std::atomic<uint32_t>;
+
+    /** Marks the end of the free list */
+    static constexpr uint32_t kEndOfList{ UINT32_MAX };
+
+    /** Segment 0 holds this many links; segment k > 0 holds kFirstSegmentSize * 2^(k-1) */
+    static constexpr uint32_t kFirstSegmentSize{ 1024 };
+    static constexpr size_t kNumSegments{
+        std::bit_width(UINT32_MAX / kFirstSegmentSize) + 1
+    };
+
+    static constexpr auto makeHead(uint32_t top, uint32_t version) -> uint64_t {
+        return (static_cast<uint64_t>(version) << 32) | top;
     }
+    static constexpr auto getTop(uint64_t head) -> uint32_t {
+        return static_cast<uint32_t>(head);
+    }
+    static constexpr auto getVersion(uint64_t head) -> uint32_t {
+        return static_cast<uint32_t>(head >> 32);
+    }
+
+    /**
+     * @brief Get an ID's link slot, allocating its segment if necessary
+     */
+    auto getLink(uint32_t id) -> Link&;
+
+    void releaseSegments() noexcept;
+
+    std::atomic<uint64_t> nextId{ 0 };
+    std::atomic<uint64_t> freeHead{ makeHead(kEndOfList, 0) };
+    std::array<std::atomic<Link*>, kNumSegments> segments{};
+};
 
-    IdPool& operator=(IdPool&& rhs) noexcept
+
+
+template<std::unsigned_integral T>
+IdPool<T>::~IdPool() noexcept
+{
+    releaseSegments();
+}
+
+template<std::unsigned_integral T>
+IdPool<T>::IdPool(IdPool&& other) noexcept
+    :
+    nextId(other.nextId.load()),
+    freeHead(other.freeHead.load())
+{
+    for (size_t i = 0; i < kNumSegments; ++i) {
+        segments[i] = other.segments[i].exchange(nullptr);
+    }
+    other.nextId = 0;
+    other.freeHead = makeHead(kEndOfList, 0);
+}
+
+template<std::unsigned_integral T>
+auto IdPool<T>::operator=(IdPool&& rhs) noexcept -> IdPool&
+{
+    if (this != &rhs)
     {
-        if (this != &rhs)
-        {
-            nextId = T{rhs.nextId};
-            rhs.nextId = 0;
-            freeIds = std::move(rhs.freeIds);
+        releaseSegments();
+        nextId = rhs.nextId.load();
+        freeHead = rhs.freeHead.load();
+        for (size_t i = 0; i < kNumSegments; ++i) {
+            segments[i] = rhs.segments[i].exchange(nullptr);
         }
-        return *this;
+        rhs.nextId = 0;
+        rhs.freeHead = makeHead(kEndOfList, 0);
     }
+    return *this;
+}
 
-    auto generate() -> T
+template<std::unsigned_integral T>
+auto IdPool<T>::generate() -> T
+{
+    uint64_t head = freeHead.load(std::memory_order_acquire);
+    while (getTop(head) != kEndOfList)
     {
-        if (auto id = freeIds.try_pop()) {
-            return *id;
+        // The link may be overwritten concurrently if another thread pops
+        // and re-pushes the top ID. The version check in the CAS rejects
+        // the stale value in that case.
+        const uint32_t top = getTop(head);
+        const uint32_t next = getLink(top).load(std::memory_order_relaxed);
+        if (freeHead.compare_exchange_weak(head, makeHead(next, getVersion(head) + 1),
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire))
+        {
+            return static_cast<T>(top);
         }
-        return nextId++;
     }
 
-    void free(T id)
+    const uint64_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    if (id >= kMaxIds || id > std::numeric_limits<T>::max())
     {
-        freeIds.push(id);
+        nextId.fetch_sub(1, std::memory_order_relaxed);
+        throw std::out_of_range("[In IdPool::generate]: The pool has run out of IDs.");
     }
 
-    void reset()
+    return static_cast<T>(id);
+}
+
+template<std::unsigned_integral T>
+void IdPool<T>::free(T id)
+{
+    assert(static_cast<uint64_t>(id) < nextId.load());
+
+    const uint32_t index = static_cast<uint32_t>(id);
+    Link& link = getLink(index);
+
+    uint64_t head = freeHead.load(std::memory_order_relaxed);
+    do {
+        link.store(getTop(head), std::memory_order_relaxed);
+    } while (!freeHead.compare_exchange_weak(head, makeHead(index, getVersion(head) + 1),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+}
+
+template<std::unsigned_integral T>
+void IdPool<T>::reset()
+{
+    freeHead = makeHead(kEndOfList, 0);
+    nextId = 0;
+}
+
+template<std::unsigned_integral T>
+auto IdPool<T>::getLink(const uint32_t id) -> Link&
+{
+    const size_t segment = id < kFirstSegmentSize
+        ? 0
+        : std::bit_width(id / kFirstSegmentSize);
+    const uint32_t segmentBegin = segment == 0 ? 0 : kFirstSegmentSize << (segment - 1);
+    const uint32_t segmentSize = segment == 0 ? kFirstSegmentSize : segmentBegin;
+
+    Link* links = segments[segment].load(std::memory_order_acquire);
+    if (links == nullptr)
     {
-        freeIds = {};
-        nextId = 0;
+        // Multiple threads may race to allocate the segment; only one wins.
+        auto newLinks = std::make_unique<Link[]>(segmentSize);
+        if (segments[segment].compare_exchange_strong(links, newLinks.get(),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+        {
+            links = newLinks.release();
+        }
     }
 
-private:
-    std::atomic<T> nextId{ T(0) };
-    ThreadsafeQueue<T> freeIds;
-};
+    return links[id - segmentBegin];
+}
+
+template<std::unsigned_integral T>
+void IdPool<T>::releaseSegments() noexcept
+{
+    for (auto& segment : segments) {
+        delete[] segment.exchange(nullptr);
+    }
+}
 
 } // namespace trc::data
@@ -8,8 +8,9 @@
 #include <stdexcept>
 #include <utility>
 
-#include "OptionalStorage.h"
+#include "ConcurrentOptionalStorage.h"
 #include "ElementLockableVector.h"
+#include "OptionalStorage.h"
 
 namespace trc::util
 {
@@ -18,6 +19,31 @@ namespace trc::util
      */
     constexpr size_t kSafeVectorDefaultChunkSize{ 40 };
 
+    /**
+     * @brief Synchronization strategy of a `SafeVector<>`
+     */
+    enum class SafeVectorMode
+    {
+        /**
+         * Every access, including lookups, locks the chunk that contains
+         * the accessed element.
+         */
+        eLocked,
+
+        /**
+         * `contains` and `at` are wait-free. Chunks are published in an
+         * append-only table, and elements' validity is read from atomic
+         * state words. Writers lock only the modified chunk.
+         * `copyAtomically` reads trivially copyable elements optimistically
+         * and validates the copy with the element's sequence number.
+         *
+         * `clear` destroys all elements, but retains the chunks' memory
+         * until the vector is destroyed, because concurrent readers may
+         * still access them.
+         */
+        eReadOptimized,
+    };
+
     /**
      * @brief A memory- and thread-safe container
      *
@@ -47,10 +73,15 @@ namespace trc::util
      *  - Iterating over the vector becomes less cache-efficient.
      *  - Higher ratio of memory overhead from management structures to actual
      *    data. For example, we need one mutex per chunk.
+     *
+     * Use `SafeVectorMode::eReadOptimized` for vectors that are read much
+     * more often than they are modified, such as lookup tables on hot
+     * paths.
      */
     template<
         typename T,
-        size_t ChunkSize = kSafeVectorDefaultChunkSize
+        size_t ChunkSize = kSafeVectorDefaultChunkSize,
+        SafeVectorMode Mode = SafeVectorMode::eLocked
         >
     class SafeVector
     {
@@ -91,7 +122,7 @@ namespace trc::util
         {
             const size_type chunk = _chunk_index(index);
             return chunks.size() > chunk
-                && chunks.read(chunk)->valid(_elem_index(index));
+                && readChunk(chunk)->valid(_elem_index(index));
         }
 
         /**
@@ -108,7 +139,7 @@ namespace trc::util
          */
         auto at(size_type index) -> reference
         {
-            auto chunk = chunks.write(_chunk_index(index));
+            auto chunk = writeChunk(_chunk_index(index));
             return chunk->at(_elem_index(index));
         }
 
@@ -126,7 +157,7 @@ namespace trc::util
          */
         auto at(size_type index) const -> const_reference
         {
-            auto chunk = chunks.read(_chunk_index(index));
+            auto chunk = readChunk(_chunk_index(index));
             return chunk->at(_elem_index(index));
         }
 
@@ -152,7 +183,7 @@ namespace trc::util
             const size_type chunk = _chunk_index(index);
             chunks.resize_to_fit(chunk + 1);
 
-            return chunks.write(chunk)->emplace(_elem_index(index), std::forward<Args>(args)...);
+            return writeChunk(chunk)->emplace(_elem_index(index), std::forward<Args>(args)...);
         }
 
         /**
@@ -177,14 +208,10 @@ namespace trc::util
             -> std::pair<std::reference_wrapper<value_type>, bool>
         {
             const size_type chunkIndex = _chunk_index(index);
-            const size_type elem = _elem_index(index);
             chunks.resize_to_fit(chunkIndex + 1);
 
-            auto chunk = chunks.write(chunkIndex);
-            if (chunk->valid(elem)) {
-                return { chunk->at(elem), false };
-            }
-            return { chunk->emplace(elem, std::forward<Args>(args)...), true };
+            return writeChunk(chunkIndex)->try_emplace(_elem_index(index),
+                                                       std::forward<Args>(args)...);
         }
 
         /**
@@ -194,7 +221,7 @@ namespace trc::util
          */
         bool erase(size_type index)
         {
-            return chunks.write(_chunk_index(index))->erase(_elem_index(index));
+            return writeChunk(_chunk_index(index))->erase(_elem_index(index));
         }
 
         /**
@@ -216,7 +243,15 @@ namespace trc::util
          */
         void clear()
         {
-            chunks.clear();
+            if constexpr (kReadOptimized)
+            {
+                for (size_type i = 0; i < chunks.size(); ++i) {
+                    chunks.get(i)->clear();
+                }
+            }
+            else {
+                chunks.clear();
+            }
         }
 
         /**
@@ -232,8 +267,13 @@ namespace trc::util
         auto copyAtomically(size_type index) const -> value_type
             requires std::copy_constructible<value_type>
         {
-            auto chunk = chunks.read(_chunk_index(index));
-            return value_type{ chunk->at(_elem_index(index)) };
+            auto chunk = readChunk(_chunk_index(index));
+            if constexpr (kReadOptimized) {
+                return chunk->copy(_elem_index(index));
+            }
+            else {
+                return value_type{ chunk->at(_elem_index(index)) };
+            }
         }
 
         /**
@@ -254,8 +294,11 @@ namespace trc::util
         auto applyAtomically(size_type index, F&& func)
             -> std::invoke_result_t<F, reference>
         {
-            auto chunk = chunks.write(_chunk_index(index));
-            if constexpr (std::same_as<void, std::invoke_result_t<F, reference>>) {
+            auto chunk = writeChunk(_chunk_index(index));
+            if constexpr (kReadOptimized) {
+                return chunk->apply(_elem_index(index), std::forward<F>(func));
+            }
+            else if constexpr (std::same_as<void, std::invoke_result_t<F, reference>>) {
                 func(chunk->at(_elem_index(index)));
             }
             else {
@@ -281,8 +324,11 @@ namespace trc::util
         auto applyAtomically(size_type index, F&& func) const
             -> std::invoke_result_t<F, const_reference>
         {
-            auto chunk = chunks.read(_chunk_index(index));
-            if constexpr (std::same_as<void, std::invoke_result_t<F, reference>>) {
+            auto chunk = readChunk(_chunk_index(index));
+            if constexpr (kReadOptimized) {
+                return chunk->apply(_elem_index(index), std::forward<F>(func));
+            }
+            else if constexpr (std::same_as<void, std::invoke_result_t<F, const_reference>>) {
                 func(chunk->at(_elem_index(index)));
             }
             else {
@@ -299,13 +345,53 @@ namespace trc::util
         auto cend()   const -> const_iterator;
 
     private:
-        using Chunk = data::OptionalStorage<value_type, ChunkSize>;
+        static constexpr bool kReadOptimized{ Mode == SafeVectorMode::eReadOptimized };
+
+        /**
+         * In locked mode, we need to be able to lock single chunks to
+         * ensure atomicity of operations like `emplace` or `erase`. In
+         * read-optimized mode, chunks synchronize their writers internally.
+         */
+        using Chunk = std::conditional_t<
+            kReadOptimized,
+            data::ConcurrentOptionalStorage<value_type, ChunkSize>,
+            data::OptionalStorage<value_type, ChunkSize>
+        >;
+        using ChunkStorage = std::conditional_t<
+            kReadOptimized,
+            data::ChunkDirectory<Chunk>,
+            data::ElementLockableVector<Chunk>
+        >;
 
         /**
-         * We need to be able to lock single chunks to ensure atomicity of
-         * operations like `emplace` or `erase`.
+         * @return A pointer-like object to a chunk that holds a lock on the
+         *         chunk in locked mode.
          */
-        data::ElementLockableVector<Chunk> chunks;
+        auto readChunk(size_type chunk) const
+        {
+            if constexpr (kReadOptimized) {
+                return static_cast<const Chunk*>(chunks.get(chunk));
+            }
+            else {
+                return chunks.read(chunk);
+            }
+        }
+
+        /**
+         * @return A pointer-like object to a chunk that holds a lock on the
+         *         chunk in locked mode.
+         */
+        auto writeChunk(size_type chunk)
+        {
+            if constexpr (kReadOptimized) {
+                return chunks.get(chunk);
+            }
+            else {
+                return chunks.write(chunk);
+            }
+        }
+
+        ChunkStorage chunks;
 
     public:
         template<bool Constant>
@@ -443,11 +529,11 @@ namespace trc::util
             auto getChunk(size_type chunkIndex) -> ChunkPtr
             {
                 if constexpr (Constant) {
-                    auto chunk = self->chunks.read(chunkIndex);
+                    auto chunk = self->readChunk(chunkIndex);
                     return &*chunk;
                 }
                 else {
-                    auto chunk = self->chunks.write(chunkIndex);
+                    auto chunk = self->writeChunk(chunkIndex);
                     return &*chunk;
                 }
             }
@@ -456,47 +542,47 @@ namespace trc::util
 
 
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::begin() -> iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::begin() -> iterator
     {
         return iterator{ *this, 0 };
     }
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::begin() const -> const_iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::begin() const -> const_iterator
     {
         return const_iterator{ *this, 0 };
     }
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::end() -> iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::end() -> iterator
     {
         return iterator{ *this, chunks.size() * ChunkSize };
     }
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::end() const -> const_iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::end() const -> const_iterator
     {
         return const_iterator{ *this, chunks.size() * ChunkSize };
     }
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::cbegin() const -> const_iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::cbegin() const -> const_iterator
     {
         return std::as_const(*this).begin();
     }
 
-    template<typename T, size_t ChunkSize>
-    auto SafeVector<T, ChunkSize>::cend() const -> const_iterator
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
+    auto SafeVector<T, ChunkSize, Mode>::cend() const -> const_iterator
     {
         return std::as_const(*this).end();
     }
 
 
 
-    template<typename T, size_t ChunkSize>
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
     template<bool Constant>
-    SafeVector<T, ChunkSize>::Iterator<Constant>::Iterator(Self& vec, size_type index)
+    SafeVector<T, ChunkSize, Mode>::Iterator<Constant>::Iterator(Self& vec, size_type index)
         :
         self(&vec),
         currentChunk(nullptr),
@@ -515,9 +601,9 @@ namespace trc::util
         }
     }
 
-    template<typename T, size_t ChunkSize>
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
     template<bool Constant>
-    auto SafeVector<T, ChunkSize>::Iterator<Constant>::operator++() -> Iterator&
+    auto SafeVector<T, ChunkSize, Mode>::Iterator<Constant>::operator++() -> Iterator&
     {
         size_type currentChunkIndex = _chunk_index(currentIndex);
 
@@ -552,12 +638,19 @@ namespace trc::util
         return *this;
     }
 
-    template<typename T, size_t ChunkSize>
+    template<typename T, size_t ChunkSize, SafeVectorMode Mode>
     template<bool Constant>
-    auto SafeVector<T, ChunkSize>::Iterator<Constant>::operator++(int) -> Iterator
+    auto SafeVector<T, ChunkSize, Mode>::Iterator<Constant>::operator++(int) -> Iterator
     {
         auto prev = *this;
         ++*this;
         return prev;
     }
+
+
+    /**
+     * @brief A `SafeVector<>` with wait-free lookups
+     */
+    template<typename T, size_t ChunkSize = kSafeVectorDefaultChunkSize>
+    using ReadOptimizedSafeVector = SafeVector<T, ChunkSize, SafeVectorMode::eReadOptimized>;
 } // namespace trc::util
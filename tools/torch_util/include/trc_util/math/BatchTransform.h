@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+/**
+ * Kernels that compute many 4x4 transformation matrices at once.
+ *
+ * The kernels don't depend on a math library. Their element types have the
+ * memory layout of GLM's `mat4`, `vec3`, and `quat`, so arrays of GLM
+ * types can be passed by reinterpreting their storage.
+ *
+ * All kernels take the instruction set to use as an optional last
+ * argument. Levels that the CPU does not support are clamped to the best
+ * supported level. Output arrays may alias input arrays.
+ */
+namespace trc::math
+{
+    /** @brief A column-major 4x4 matrix */
+    using Mat4f = std::array<float, 16>;
+
+    using Vec3f = std::array<float, 3>;
+
+    /** @brief A quaternion with components in the order x, y, z, w */
+    using Quatf = std::array<float, 4>;
+
+    /**
+     * @brief Instruction set extensions that the kernels can use
+     */
+    enum class SimdLevel : uint8_t
+    {
+        eScalar,
+        eSse2,
+        eAvx2,
+    };
+
+    /**
+     * @brief Detect the best instruction set that the CPU supports
+     *
+     * The result is computed once and cached. AVX2 kernels use FMA as well,
+     * so `eAvx2` is reported only if both extensions are available.
+     */
+    auto getSupportedSimdLevel() noexcept -> SimdLevel;
+
+    /**
+     * @brief Compute `out[i] = lhs[i] * rhs[i]`
+     *
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    void multiplyMatrices(std::span<const Mat4f> lhs,
+                          std::span<const Mat4f> rhs,
+                          std::span<Mat4f> out,
+                          SimdLevel level = getSupportedSimdLevel());
+
+    /**
+     * @brief Compute `out[i] = lhs * rhs[i]`
+     *
+     * Composes the transformations of many children with the same parent.
+     *
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    void multiplyMatrices(const Mat4f& lhs,
+                          std::span<const Mat4f> rhs,
+                          std::span<Mat4f> out,
+                          SimdLevel level = getSupportedSimdLevel());
+
+    /**
+     * @brief Convert unit quaternions to rotation matrices
+     *
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    void quatToMatrices(std::span<const Quatf> rotations,
+                        std::span<Mat4f> out,
+                        SimdLevel level = getSupportedSimdLevel());
+
+    /**
+     * @brief Compute `out[i] = translate(t[i]) * rotate(r[i]) * scale(s[i])`
+     *
+     * Writes the composed matrices directly instead of multiplying three
+     * full matrices per element.
+     *
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    void composeTransforms(std::span<const Vec3f> translations,
+                           std::span<const Quatf> rotations,
+                           std::span<const Vec3f> scales,
+                           std::span<Mat4f> out,
+                           SimdLevel level = getSupportedSimdLevel());
+} // namespace trc::math
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "trc_util/math/BatchTransform.h"
+
+/**
+ * Visibility tests of many bounding volumes against a view frustum.
+ *
+ * Uses the element types and instruction set selection of the batch
+ * transform kernels.
+ */
+namespace trc::math
+{
+    /** @brief A plane `(a, b, c, d)` with the equation `ax + by + cz + d = 0` */
+    using Vec4f = std::array<float, 4>;
+
+    /**
+     * @brief The six planes that bound a view volume
+     *
+     * Plane normals point into the frustum and are normalized, so a
+     * plane equation evaluates to the signed distance from the plane.
+     */
+    struct Frustum
+    {
+        /** Left, right, bottom, top, near, far */
+        std::array<Vec4f, 6> planes;
+
+        /**
+         * @brief Extract the planes of a view-projection matrix
+         *
+         * Expects clip-space depth in [0, 1], as used by Vulkan. Planes of
+         * an infinite far plane projection are degenerate and never cull
+         * anything.
+         *
+         * @param const Mat4f& viewProj Transforms world space to clip
+         *                              space.
+         */
+        static auto fromViewProjection(const Mat4f& viewProj) -> Frustum;
+    };
+
+    /**
+     * @brief Test bounding spheres against a frustum
+     *
+     * Spheres are passed in structure-of-arrays layout. Sets `visible[i]`
+     * to 1 if sphere `i` intersects the frustum and to 0 otherwise. The
+     * test is conservative: spheres close to a corner of the frustum may
+     * be reported visible even if they are outside.
+     *
+     * @return size_t The number of visible spheres.
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    auto cullSpheres(const Frustum& frustum,
+                     std::span<const float> centerX,
+                     std::span<const float> centerY,
+                     std::span<const float> centerZ,
+                     std::span<const float> radius,
+                     std::span<uint8_t> visible,
+                     SimdLevel level = getSupportedSimdLevel())
+        -> size_t;
+} // namespace trc::math
@@ -0,0 +1,159 @@
+#include "trc_util/MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+
+namespace trc::util
+{
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        fileHandle = nullptr;
+        throw std::runtime_error("[In MappedFile::MappedFile]: Unable to open file "
+                                 + path.string());
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+        unmap();
+        throw std::runtime_error("[In MappedFile::MappedFile]: Unable to query size of file "
+                                 + path.string());
+    }
+    mappingSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mappingSize == 0) {
+        return;
+    }
+
+    mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle != nullptr) {
+        mapping = static_cast<const std::byte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (mapping == nullptr)
+    {
+        unmap();
+        throw std::runtime_error("[In MappedFile::MappedFile]: Unable to map file "
+                                 + path.string() + " into memory");
+    }
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (mapping != nullptr) UnmapViewOfFile(mapping);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != nullptr) CloseHandle(fileHandle);
+    mapping = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    mappingSize = 0;
+}
+
+#else // if not windows
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("[In MappedFile::MappedFile]: Unable to open file "
+                                 + path.string() + ": " + std::strerror(errno));
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("[In MappedFile::MappedFile]: Unable to query size of file "
+                                 + path.string() + ": " + std::strerror(errno));
+    }
+
+    mappingSize = static_cast<size_t>(fileStat.st_size);
+    if (mappingSize > 0)
+    {
+        void* ptr = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("[In MappedFile::MappedFile]: Unable to map file "
+                                     + path.string() + " into memory: " + std::strerror(errno));
+        }
+        mapping = static_cast<const std::byte*>(ptr);
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    close(fd);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (mapping != nullptr) {
+        munmap(const_cast<std::byte*>(mapping), mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+#endif // if windows
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        std::swap(mapping, other.mapping);
+        std::swap(mappingSize, other.mappingSize);
+#if defined(_WIN32)
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    unmap();
+}
+
+auto MappedFile::data() const noexcept -> const std::byte*
+{
+    return mapping;
+}
+
+auto MappedFile::size() const noexcept -> size_t
+{
+    return mappingSize;
+}
+
+auto MappedFile::span() const noexcept -> std::span<const std::byte>
+{
+    return { mapping, mappingSize };
+}
+
+} // namespace trc::util
@@ -37,4 +37,54 @@ namespace trc::util::internal
 
         return pos;
     }
+
+
+
+    memory_istreambuf::memory_istreambuf(const char* data, size_t size)
+        // std::streambuf's get area uses non-const pointers, but it is
+        // never written to through the read interface.
+        : begin(const_cast<char*>(data)), end(const_cast<char*>(data) + size)
+    {
+        setg(begin, begin, end);
+    }
+
+    auto memory_istreambuf::underflow() -> int_type
+    {
+        return this->gptr() == this->egptr()
+            ? traits_type::eof()
+            : traits_type::to_int_type(*this->gptr());
+    }
+
+    auto memory_istreambuf::showmanyc() -> std::streamsize
+    {
+        const auto avail = this->egptr() - this->gptr();
+        return avail > 0 ? avail : -1;
+    }
+
+    auto memory_istreambuf::seekoff(
+        off_type off,
+        std::ios_base::seekdir dir,
+        std::ios_base::openmode which) -> pos_type
+    {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+
+        off_type base{ 0 };
+        if (dir == std::ios_base::cur) base = this->gptr() - begin;
+        else if (dir == std::ios_base::end) base = end - begin;
+
+        return seekpos(pos_type(base + off), which);
+    }
+
+    auto memory_istreambuf::seekpos(pos_type pos, std::ios_base::openmode which) -> pos_type
+    {
+        const off_type off = pos;
+        if (!(which & std::ios_base::in) || off < 0 || off > end - begin) {
+            return pos_type(off_type(-1));
+        }
+
+        setg(begin, begin + off, end);
+        return pos;
+    }
 } // namespace trc::util::internal
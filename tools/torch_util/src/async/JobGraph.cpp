@@ -0,0 +1,233 @@
+#include "trc_util/async/JobGraph.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+
+
+trc::async::JobGraph::ExecutionState::ExecutionState(const size_t numJobs)
+    :
+    remainingDependencies(std::make_unique<std::atomic<uint32_t>[]>(numJobs))
+{
+    readyJobs.reserve(numJobs);
+}
+
+auto trc::async::JobGraph::addJob(Job job) -> JobID
+{
+    const JobID id = static_cast<JobID>(nodes.size());
+    nodes.push_back(Node{ .job=std::move(job), .successors={}, .numDependencies=0 });
+    modified = true;
+
+    return id;
+}
+
+auto trc::async::JobGraph::addJob(Job job, std::initializer_list<JobID> dependencies) -> JobID
+{
+    for (const JobID dep : dependencies) {
+        checkID(dep, "addJob");
+    }
+
+    const JobID id = addJob(std::move(job));
+    for (const JobID dep : dependencies) {
+        addDependency(id, dep);
+    }
+
+    return id;
+}
+
+auto trc::async::JobGraph::addContinuation(JobID job, Job continuation) -> JobID
+{
+    checkID(job, "addContinuation");
+    return addJob(std::move(continuation), { job });
+}
+
+void trc::async::JobGraph::addDependency(JobID job, JobID dependency)
+{
+    checkID(job, "addDependency");
+    checkID(dependency, "addDependency");
+
+    nodes[dependency].successors.push_back(job);
+    ++nodes[job].numDependencies;
+    modified = true;
+}
+
+auto trc::async::JobGraph::size() const -> size_t
+{
+    return nodes.size();
+}
+
+void trc::async::JobGraph::clear()
+{
+    nodes.clear();
+    modified = true;
+}
+
+void trc::async::JobGraph::execute()
+{
+    prepare();
+    for (const JobID id : order) {
+        nodes[id].job();
+    }
+}
+
+void trc::async::JobGraph::execute(ThreadPool& pool)
+{
+    if (pool.getThreadCount() == 0)
+    {
+        execute();
+        return;
+    }
+
+    prepare();
+    if (nodes.empty()) {
+        return;
+    }
+
+    auto& s = *state;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        s.remainingDependencies[i].store(nodes[i].numDependencies, std::memory_order_relaxed);
+    }
+    s.remainingJobs.store(nodes.size(), std::memory_order_relaxed);
+    s.failed.store(false, std::memory_order_relaxed);
+    s.error = nullptr;
+    s.pool = &pool;
+
+    // Make all roots but the first ready, which runs on the calling thread
+    for (size_t i = 1; i < roots.size(); ++i) {
+        pushReadyJob(s, roots[i]);
+    }
+    runJob(s, roots.front());
+
+    // Only help with our own jobs. Running other pending tasks here could
+    // block the caller on unrelated work. A job only becomes ready before
+    // the count of remaining jobs drops, so waiting on the count does not
+    // miss ready jobs.
+    for (size_t remaining; (remaining = s.remainingJobs.load(std::memory_order_acquire)) > 0;)
+    {
+        if (const JobID id = popReadyJob(s); id != kNoJob) {
+            runJob(s, id);
+        }
+        else {
+            s.remainingJobs.wait(remaining, std::memory_order_acquire);
+        }
+    }
+
+    if (s.error) {
+        std::rethrow_exception(s.error);
+    }
+}
+
+void trc::async::JobGraph::checkID(JobID id, const char* method) const
+{
+    if (id >= nodes.size())
+    {
+        throw std::out_of_range("[In JobGraph::" + std::string(method) + "]: Job ID "
+                                + std::to_string(id) + " does not exist in the graph.");
+    }
+}
+
+void trc::async::JobGraph::prepare()
+{
+    if (!modified) {
+        return;
+    }
+
+    // Sort topologically with Kahn's algorithm
+    std::vector<uint32_t> numDependencies(nodes.size());
+    order.clear();
+    roots.clear();
+    for (JobID id = 0; id < nodes.size(); ++id)
+    {
+        numDependencies[id] = nodes[id].numDependencies;
+        if (numDependencies[id] == 0)
+        {
+            roots.push_back(id);
+            order.push_back(id);
+        }
+    }
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        for (const JobID succ : nodes[order[i]].successors)
+        {
+            if (--numDependencies[succ] == 0) {
+                order.push_back(succ);
+            }
+        }
+    }
+
+    if (order.size() != nodes.size()) {
+        throw std::logic_error("[In JobGraph::execute]: The job graph contains a dependency cycle.");
+    }
+
+    state = std::make_shared<ExecutionState>(nodes.size());
+    modified = false;
+}
+
+void trc::async::JobGraph::runJob(ExecutionState& s, JobID id)
+{
+    while (id != kNoJob)
+    {
+        Node& node = nodes[id];
+        if (!s.failed.load(std::memory_order_relaxed))
+        {
+            try {
+                node.job();
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(s.errorLock);
+                if (!s.error) s.error = std::current_exception();
+                s.failed = true;
+            }
+        }
+
+        // Continue with one of the unblocked successors on this thread
+        JobID next{ kNoJob };
+        for (const JobID succ : node.successors)
+        {
+            if (s.remainingDependencies[succ].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                if (next == kNoJob) {
+                    next = succ;
+                }
+                else {
+                    pushReadyJob(s, succ);
+                }
+            }
+        }
+
+        // Must be the last access to the graph if no successor remains:
+        // the executing thread may return as soon as the count is zero.
+        // Helper tasks keep `s` alive.
+        s.remainingJobs.fetch_sub(1, std::memory_order_acq_rel);
+        s.remainingJobs.notify_all();
+        id = next;
+    }
+}
+
+void trc::async::JobGraph::pushReadyJob(ExecutionState& s, JobID id)
+{
+    {
+        std::scoped_lock lock(s.readyJobsLock);
+        assert(s.readyJobs.size() < s.readyJobs.capacity());
+        s.readyJobs.push_back(id);
+    }
+    s.pool->execute([this, st = state]{
+        if (const JobID id = popReadyJob(*st); id != kNoJob) {
+            runJob(*st, id);
+        }
+    });
+}
+
+auto trc::async::JobGraph::popReadyJob(ExecutionState& s) -> JobID
+{
+    std::scoped_lock lock(s.readyJobsLock);
+    if (s.readyJobs.empty()) {
+        return kNoJob;
+    }
+    const JobID id = s.readyJobs.back();
+    s.readyJobs.pop_back();
+    return id;
+}
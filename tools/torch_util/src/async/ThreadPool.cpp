@@ -1,8 +1,30 @@
 #include "trc_util/async/ThreadPool.h"
 
 #include <cassert>
-#include <ranges>
-#include <algorithm>
+#include <optional>
+
+
+
+namespace
+{
+    /**
+     * Identifies the pool and queue of the worker thread that executes
+     * the calling code.
+     */
+    struct WorkerIdentity
+    {
+        const trc::async::ThreadPool* pool{ nullptr };
+        uint32_t queueIndex{ 0 };
+    };
+
+    thread_local WorkerIdentity currentWorker;
+
+    /** Number of times an idle worker polls for work before it sleeps */
+    constexpr uint32_t kIdleSpinCount{ 64 };
+
+    /** Capacity of a work queue when the first task is pushed */
+    constexpr size_t kInitialQueueCapacity{ 64 };
+} // anonymous namespace
 
 
 
@@ -13,37 +35,175 @@ trc::async::ThreadPool::ThreadPool()
 
 trc::async::ThreadPool::ThreadPool(const uint32_t numThreads)
 {
+    queues.reserve(numThreads);
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+
     workers.reserve(numThreads);
-    for (uint32_t i = 0; i < numThreads; ++i)
-    {
-        workers.emplace_back([this]{
-            while (true)
-            {
-                auto [work, terminate] = workQueue.wait_pop();
-                if (terminate) break;
-                work();
-            }
-        });
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back([this, i]{ workerLoop(i); });
     }
 }
 
 trc::async::ThreadPool::~ThreadPool()
 {
-    for (size_t i = 0; i < workers.size(); ++i) {
-        workQueue.push(Work{ .work=[]{}, .terminateThread=true });
+    {
+        std::scoped_lock lock(sleepMutex);
+        stopRequested = true;
     }
+    sleepCvar.notify_all();
+
     for (auto& t : workers) {
         t.join();
     }
 
-    assert(workQueue.empty());
+    assert(numPending == 0);
+}
+
+auto trc::async::ThreadPool::getThreadCount() const -> uint32_t
+{
+    return static_cast<uint32_t>(workers.size());
 }
 
-void trc::async::ThreadPool::execute(std::function<void()> work)
+void trc::async::ThreadPool::push(Task task)
 {
     if (workers.empty()) {
         throw std::invalid_argument("A thread pool with 0 threads cannot execute work!");
     }
 
-    workQueue.push(Work{ .work=std::move(work), .terminateThread=false });
+    // Keep nested work local to the submitting worker
+    const uint32_t index = currentWorker.pool == this
+        ? currentWorker.queueIndex
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    numPending.fetch_add(1);
+    {
+        auto& queue = *queues[index];
+        std::scoped_lock lock(queue.mutex);
+        queue.pushBack(std::move(task));
+    }
+
+    if (numSleeping.load() > 0)
+    {
+        // Acquire the mutex so that the notification can't happen between
+        // a sleeping worker's predicate check and its wait.
+        { std::scoped_lock lock(sleepMutex); }
+        sleepCvar.notify_one();
+    }
+}
+
+bool trc::async::ThreadPool::runPendingTask()
+{
+    if (numPending.load() == 0) {
+        return false;
+    }
+
+    const size_t numQueues = queues.size();
+    const bool isWorker = currentWorker.pool == this;
+    const size_t first = isWorker ? currentWorker.queueIndex
+                                  : nextQueue.load(std::memory_order_relaxed) % numQueues;
+
+    std::optional<Task> task;
+    for (size_t i = 0; i < numQueues && !task; ++i)
+    {
+        const size_t index = (first + i) % numQueues;
+        auto& queue = *queues[index];
+        std::scoped_lock lock(queue.mutex);
+        if (queue.empty()) {
+            continue;
+        }
+
+        // Workers process their own queue in LIFO order for locality and
+        // steal the oldest tasks from other queues.
+        if (isWorker && index == currentWorker.queueIndex) {
+            task = queue.popBack();
+        }
+        else {
+            task = queue.popFront();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    numPending.fetch_sub(1);
+    (*task)();
+    return true;
+}
+
+void trc::async::ThreadPool::workerLoop(const uint32_t index)
+{
+    currentWorker = { .pool=this, .queueIndex=index };
+
+    while (true)
+    {
+        if (runPendingTask()) {
+            continue;
+        }
+
+        // Poll for a short while before going to sleep
+        for (uint32_t i = 0; i < kIdleSpinCount && numPending.load() == 0; ++i) {
+            std::this_thread::yield();
+        }
+        if (numPending.load() > 0) {
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex);
+        ++numSleeping;
+        sleepCvar.wait(lock, [this]{ return numPending.load() > 0 || stopRequested.load(); });
+        --numSleeping;
+
+        if (stopRequested && numPending.load() == 0) {
+            break;
+        }
+    }
+}
+
+
+
+bool trc::async::ThreadPool::WorkQueue::empty() const
+{
+    return size == 0;
+}
+
+void trc::async::ThreadPool::WorkQueue::pushBack(Task task)
+{
+    if (size == ring.size()) {
+        grow();
+    }
+    ring[(head + size) % ring.size()] = std::move(task);
+    ++size;
+}
+
+auto trc::async::ThreadPool::WorkQueue::popBack() -> Task
+{
+    assert(size > 0);
+    --size;
+    Task& slot = ring[(head + size) % ring.size()];
+    Task task = std::move(slot);
+    slot = nullptr;
+    return task;
+}
+
+auto trc::async::ThreadPool::WorkQueue::popFront() -> Task
+{
+    assert(size > 0);
+    Task task = std::move(ring[head]);
+    ring[head] = nullptr;
+    head = (head + 1) % ring.size();
+    --size;
+    return task;
+}
+
+void trc::async::ThreadPool::WorkQueue::grow()
+{
+    std::vector<Task> newRing(std::max(kInitialQueueCapacity, ring.size() * 2));
+    for (size_t i = 0; i < size; ++i) {
+        newRing[i] = std::move(ring[(head + i) % ring.size()]);
+    }
+    ring = std::move(newRing);
+    head = 0;
 }
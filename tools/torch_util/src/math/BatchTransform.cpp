@@ -0,0 +1,500 @@
+#include "trc_util/math/BatchTransform.h"
+
+#include <algorithm>
+
+#include "trc_util/Assert.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define TRC_BATCH_TRANSFORM_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define TRC_TARGET_AVX2
+    #else
+        #define TRC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+
+
+namespace trc::math
+{
+
+namespace
+{
+    /////////////////////
+    //  Scalar kernels //
+    /////////////////////
+
+    inline void mulScalar(const float* a, const float* b, float* out)
+    {
+        float res[16];
+        for (int c = 0; c < 4; ++c)
+        {
+            for (int r = 0; r < 4; ++r)
+            {
+                res[c * 4 + r] = a[r]      * b[c * 4]
+                               + a[4 + r]  * b[c * 4 + 1]
+                               + a[8 + r]  * b[c * 4 + 2]
+                               + a[12 + r] * b[c * 4 + 3];
+            }
+        }
+        std::copy_n(res, 16, out);
+    }
+
+    inline void composeScalar(const float* t, const float* q, const float* s, float* out)
+    {
+        const float x = q[0], y = q[1], z = q[2], w = q[3];
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float wx = w * x, wy = w * y, wz = w * z;
+
+        const float res[16]{
+            (1.0f - 2.0f * (yy + zz)) * s[0], 2.0f * (xy + wz) * s[0], 2.0f * (xz - wy) * s[0], 0.0f,
+            2.0f * (xy - wz) * s[1], (1.0f - 2.0f * (xx + zz)) * s[1], 2.0f * (yz + wx) * s[1], 0.0f,
+            2.0f * (xz + wy) * s[2], 2.0f * (yz - wx) * s[2], (1.0f - 2.0f * (xx + yy)) * s[2], 0.0f,
+            t[0], t[1], t[2], 1.0f,
+        };
+        std::copy_n(res, 16, out);
+    }
+
+    constexpr float kZero[3]{ 0.0f, 0.0f, 0.0f };
+    constexpr float kOne[3]{ 1.0f, 1.0f, 1.0f };
+
+#ifdef TRC_BATCH_TRANSFORM_X86
+
+    ///////////////////
+    //  SSE kernels  //
+    ///////////////////
+
+    /**
+     * Multiply a matrix held in four column registers with a matrix in
+     * memory and store the result
+     */
+    inline void mulSse(__m128 a0, __m128 a1, __m128 a2, __m128 a3, const float* b, float* out)
+    {
+        __m128 res[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            const float* col = b + c * 4;
+            res[c] = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(col[0])), _mm_mul_ps(a1, _mm_set1_ps(col[1]))),
+                _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(col[2])), _mm_mul_ps(a3, _mm_set1_ps(col[3])))
+            );
+        }
+        for (int c = 0; c < 4; ++c) {
+            _mm_storeu_ps(out + c * 4, res[c]);
+        }
+    }
+
+    /**
+     * Split four consecutive 3-vectors into one register per component
+     */
+    inline void loadVec3x4(const float* v, __m128& x, __m128& y, __m128& z)
+    {
+        const __m128 a0 = _mm_loadu_ps(v);      // x0 y0 z0 x1
+        const __m128 a1 = _mm_loadu_ps(v + 4);  // y1 z1 x2 y2
+        const __m128 a2 = _mm_loadu_ps(v + 8);  // z2 x3 y3 z3
+
+        const __m128 p = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 1, 3, 0));  // x0 x1 z1 x2
+        const __m128 q = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 1, 3, 0));  // y1 y2 x3 y3
+
+        const __m128 xs = _mm_shuffle_ps(p, q, _MM_SHUFFLE(2, 2, 3, 3));   // x2 x2 x3 x3
+        x = _mm_shuffle_ps(p, xs, _MM_SHUFFLE(2, 0, 1, 0));
+
+        const __m128 ys = _mm_shuffle_ps(a0, q, _MM_SHUFFLE(0, 0, 1, 1));  // y0 y0 y1 y1
+        y = _mm_shuffle_ps(ys, q, _MM_SHUFFLE(3, 1, 2, 0));
+
+        const __m128 zs = _mm_shuffle_ps(a0, p, _MM_SHUFFLE(2, 2, 2, 2));  // z0 z0 z1 z1
+        z = _mm_shuffle_ps(zs, a2, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    /**
+     * Store one column of four matrices, given one register per row
+     */
+    inline void storeColumnX4(__m128 r0, __m128 r1, __m128 r2, __m128 r3, float* out, int column)
+    {
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(out + column,      r0);
+        _mm_storeu_ps(out + column + 16, r1);
+        _mm_storeu_ps(out + column + 32, r2);
+        _mm_storeu_ps(out + column + 48, r3);
+    }
+
+    /**
+     * Compose the four TRS transformations starting at index `i`. Without
+     * translation and scale, the result is the rotation matrix.
+     */
+    template<bool kTrs>
+    inline void composeSse(const float* t, const float* q, const float* s, float* out, size_t i)
+    {
+        q += i * 4;
+        out += i * 16;
+        __m128 x = _mm_loadu_ps(q);
+        __m128 y = _mm_loadu_ps(q + 4);
+        __m128 z = _mm_loadu_ps(q + 8);
+        __m128 w = _mm_loadu_ps(q + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 x2 = _mm_mul_ps(x, two), y2 = _mm_mul_ps(y, two), z2 = _mm_mul_ps(z, two);
+        const __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+        const __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+        const __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+
+        __m128 c0[3]{
+            _mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy)
+        };
+        __m128 c1[3]{
+            _mm_sub_ps(xy, wz), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_add_ps(yz, wx)
+        };
+        __m128 c2[3]{
+            _mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy))
+        };
+        __m128 tx = zero, ty = zero, tz = zero;
+        if constexpr (kTrs)
+        {
+            __m128 sx, sy, sz;
+            loadVec3x4(s + i * 3, sx, sy, sz);
+            for (int r = 0; r < 3; ++r)
+            {
+                c0[r] = _mm_mul_ps(c0[r], sx);
+                c1[r] = _mm_mul_ps(c1[r], sy);
+                c2[r] = _mm_mul_ps(c2[r], sz);
+            }
+            loadVec3x4(t + i * 3, tx, ty, tz);
+        }
+
+        storeColumnX4(c0[0], c0[1], c0[2], zero, out, 0);
+        storeColumnX4(c1[0], c1[1], c1[2], zero, out, 4);
+        storeColumnX4(c2[0], c2[1], c2[2], zero, out, 8);
+        storeColumnX4(tx, ty, tz, one, out, 12);
+    }
+
+    ////////////////////
+    //  AVX2 kernels  //
+    ////////////////////
+
+    /**
+     * Multiply a matrix held in four registers, each containing one column
+     * twice, with a matrix in memory and store the result
+     */
+    TRC_TARGET_AVX2
+    inline void mulAvx2(__m256 a0, __m256 a1, __m256 a2, __m256 a3, const float* b, float* out)
+    {
+        __m256 res[2];
+        for (int c = 0; c < 2; ++c)
+        {
+            // Columns 2c and 2c + 1
+            const __m256 cols = _mm256_loadu_ps(b + c * 8);
+            __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(cols, cols, 0x00));
+            r = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(cols, cols, 0x55), r);
+            r = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(cols, cols, 0xaa), r);
+            res[c] = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(cols, cols, 0xff), r);
+        }
+        _mm256_storeu_ps(out, res[0]);
+        _mm256_storeu_ps(out + 8, res[1]);
+    }
+
+    TRC_TARGET_AVX2
+    inline auto combine(__m128 lo, __m128 hi) -> __m256
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    TRC_TARGET_AVX2
+    inline void loadColumnsAvx2(const float* a, __m256& a0, __m256& a1, __m256& a2, __m256& a3)
+    {
+        const __m128 c0 = _mm_loadu_ps(a), c1 = _mm_loadu_ps(a + 4);
+        const __m128 c2 = _mm_loadu_ps(a + 8), c3 = _mm_loadu_ps(a + 12);
+        a0 = combine(c0, c0);
+        a1 = combine(c1, c1);
+        a2 = combine(c2, c2);
+        a3 = combine(c3, c3);
+    }
+
+    /**
+     * Compose the eight TRS transformations starting at index `i`. Loads
+     * and stores go through the 128-bit transposes; the arithmetic is done
+     * at full width.
+     */
+    template<bool kTrs>
+    TRC_TARGET_AVX2
+    inline void composeAvx2(const float* t, const float* q, const float* s, float* out, size_t i)
+    {
+        q += i * 4;
+        out += i * 16;
+        __m128 xl = _mm_loadu_ps(q),      yl = _mm_loadu_ps(q + 4);
+        __m128 zl = _mm_loadu_ps(q + 8),  wl = _mm_loadu_ps(q + 12);
+        __m128 xh = _mm_loadu_ps(q + 16), yh = _mm_loadu_ps(q + 20);
+        __m128 zh = _mm_loadu_ps(q + 24), wh = _mm_loadu_ps(q + 28);
+        _MM_TRANSPOSE4_PS(xl, yl, zl, wl);
+        _MM_TRANSPOSE4_PS(xh, yh, zh, wh);
+        const __m256 x = combine(xl, xh), y = combine(yl, yh);
+        const __m256 z = combine(zl, zh), w = combine(wl, wh);
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+        const __m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+        const __m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+        const __m256 wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);
+
+        __m256 c[3][3]{
+            { _mm256_sub_ps(one, _mm256_add_ps(yy, zz)), _mm256_add_ps(xy, wz), _mm256_sub_ps(xz, wy) },
+            { _mm256_sub_ps(xy, wz), _mm256_sub_ps(one, _mm256_add_ps(xx, zz)), _mm256_add_ps(yz, wx) },
+            { _mm256_add_ps(xz, wy), _mm256_sub_ps(yz, wx), _mm256_sub_ps(one, _mm256_add_ps(xx, yy)) },
+        };
+        __m128 tl[3]{ _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+        __m128 th[3]{ _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+        if constexpr (kTrs)
+        {
+            __m128 sl[3], sh[3];
+            s += i * 3;
+            loadVec3x4(s, sl[0], sl[1], sl[2]);
+            loadVec3x4(s + 12, sh[0], sh[1], sh[2]);
+            for (int col = 0; col < 3; ++col)
+            {
+                const __m256 scale = combine(sl[col], sh[col]);
+                for (int r = 0; r < 3; ++r) {
+                    c[col][r] = _mm256_mul_ps(c[col][r], scale);
+                }
+            }
+            t += i * 3;
+            loadVec3x4(t, tl[0], tl[1], tl[2]);
+            loadVec3x4(t + 12, th[0], th[1], th[2]);
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        for (int col = 0; col < 3; ++col)
+        {
+            storeColumnX4(_mm256_castps256_ps128(c[col][0]),
+                          _mm256_castps256_ps128(c[col][1]),
+                          _mm256_castps256_ps128(c[col][2]),
+                          zero, out, col * 4);
+            storeColumnX4(_mm256_extractf128_ps(c[col][0], 1),
+                          _mm256_extractf128_ps(c[col][1], 1),
+                          _mm256_extractf128_ps(c[col][2], 1),
+                          zero, out + 64, col * 4);
+        }
+        storeColumnX4(tl[0], tl[1], tl[2], _mm_set1_ps(1.0f), out, 12);
+        storeColumnX4(th[0], th[1], th[2], _mm_set1_ps(1.0f), out + 64, 12);
+    }
+
+    // The loops live in separate functions so that the compiler may use
+    // AVX2 encodings for all of their instructions.
+
+    TRC_TARGET_AVX2
+    void multiplyAvx2(const float* lhs, const float* rhs, float* out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            __m256 a0, a1, a2, a3;
+            loadColumnsAvx2(lhs + i * 16, a0, a1, a2, a3);
+            mulAvx2(a0, a1, a2, a3, rhs + i * 16, out + i * 16);
+        }
+    }
+
+    TRC_TARGET_AVX2
+    void multiplyBroadcastAvx2(const float* lhs, const float* rhs, float* out, size_t count)
+    {
+        __m256 a0, a1, a2, a3;
+        loadColumnsAvx2(lhs, a0, a1, a2, a3);
+        for (size_t i = 0; i < count; ++i) {
+            mulAvx2(a0, a1, a2, a3, rhs + i * 16, out + i * 16);
+        }
+    }
+
+    template<bool kTrs>
+    TRC_TARGET_AVX2
+    auto composeLoopAvx2(const float* t, const float* q, const float* s, float* out, size_t count)
+        -> size_t
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            composeAvx2<kTrs>(t, q, s, out, i);
+        }
+        return i;
+    }
+
+#endif // TRC_BATCH_TRANSFORM_X86
+
+    auto detectSimdLevel() noexcept -> SimdLevel
+    {
+#ifdef TRC_BATCH_TRANSFORM_X86
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        // The OS must save the upper halves of the YMM registers
+        const bool ymmEnabled = osxsave && (_xgetbv(0) & 0x6) == 0x6;
+        if (avx2 && fma && ymmEnabled) {
+            return SimdLevel::eAvx2;
+        }
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::eAvx2;
+        }
+    #endif
+        return SimdLevel::eSse2;  // Part of the x86-64 baseline
+#else
+        return SimdLevel::eScalar;
+#endif
+    }
+
+    auto clampLevel(SimdLevel level) noexcept -> SimdLevel
+    {
+        return std::min(level, getSupportedSimdLevel());
+    }
+
+    inline auto data(std::span<const Mat4f> m) -> const float* {
+        return m.empty() ? nullptr : m.front().data();
+    }
+
+    inline auto data(std::span<Mat4f> m) -> float* {
+        return m.empty() ? nullptr : m.front().data();
+    }
+
+    /**
+     * Shared implementation of quatToMatrices and composeTransforms
+     */
+    template<bool kTrs>
+    void compose(const float* t, const float* q, const float* s, float* out, size_t count, SimdLevel level)
+    {
+        size_t i = 0;
+#ifdef TRC_BATCH_TRANSFORM_X86
+        if (level == SimdLevel::eAvx2) {
+            i = composeLoopAvx2<kTrs>(t, q, s, out, count);
+        }
+        if (level >= SimdLevel::eSse2)
+        {
+            for (; i + 4 <= count; i += 4) {
+                composeSse<kTrs>(t, q, s, out, i);
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if constexpr (kTrs) {
+                composeScalar(t + i * 3, q + i * 4, s + i * 3, out + i * 16);
+            }
+            else {
+                composeScalar(kZero, q + i * 4, kOne, out + i * 16);
+            }
+        }
+    }
+} // anonymous namespace
+
+
+
+auto getSupportedSimdLevel() noexcept -> SimdLevel
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+void multiplyMatrices(
+    std::span<const Mat4f> lhs,
+    std::span<const Mat4f> rhs,
+    std::span<Mat4f> out,
+    SimdLevel level)
+{
+    assert_arg(lhs.size() == rhs.size() && rhs.size() == out.size());
+
+    const float* a = data(lhs);
+    const float* b = data(rhs);
+    float* o = data(out);
+    switch (clampLevel(level))
+    {
+#ifdef TRC_BATCH_TRANSFORM_X86
+    case SimdLevel::eAvx2:
+        multiplyAvx2(a, b, o, out.size());
+        break;
+    case SimdLevel::eSse2:
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            const float* m = a + i * 16;
+            mulSse(_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12),
+                   b + i * 16, o + i * 16);
+        }
+        break;
+#endif
+    default:
+        for (size_t i = 0; i < out.size(); ++i) {
+            mulScalar(a + i * 16, b + i * 16, o + i * 16);
+        }
+        break;
+    }
+}
+
+void multiplyMatrices(
+    const Mat4f& lhs,
+    std::span<const Mat4f> rhs,
+    std::span<Mat4f> out,
+    SimdLevel level)
+{
+    assert_arg(rhs.size() == out.size());
+
+    // `lhs` may be an element of `out`
+    const Mat4f a = lhs;
+    const float* b = data(rhs);
+    float* o = data(out);
+    switch (clampLevel(level))
+    {
+#ifdef TRC_BATCH_TRANSFORM_X86
+    case SimdLevel::eAvx2:
+        multiplyBroadcastAvx2(a.data(), b, o, out.size());
+        break;
+    case SimdLevel::eSse2:
+    {
+        const __m128 a0 = _mm_loadu_ps(a.data());
+        const __m128 a1 = _mm_loadu_ps(a.data() + 4);
+        const __m128 a2 = _mm_loadu_ps(a.data() + 8);
+        const __m128 a3 = _mm_loadu_ps(a.data() + 12);
+        for (size_t i = 0; i < out.size(); ++i) {
+            mulSse(a0, a1, a2, a3, b + i * 16, o + i * 16);
+        }
+        break;
+    }
+#endif
+    default:
+        for (size_t i = 0; i < out.size(); ++i) {
+            mulScalar(a.data(), b + i * 16, o + i * 16);
+        }
+        break;
+    }
+}
+
+void quatToMatrices(
+    std::span<const Quatf> rotations,
+    std::span<Mat4f> out,
+    SimdLevel level)
+{
+    assert_arg(rotations.size() == out.size());
+    if (out.empty()) return;
+
+    compose<false>(nullptr, rotations.front().data(), nullptr, data(out), out.size(), clampLevel(level));
+}
+
+void composeTransforms(
+    std::span<const Vec3f> translations,
+    std::span<const Quatf> rotations,
+    std::span<const Vec3f> scales,
+    std::span<Mat4f> out,
+    SimdLevel level)
+{
+    assert_arg(translations.size() == out.size()
+               && rotations.size() == out.size()
+               && scales.size() == out.size());
+    if (out.empty()) return;
+
+    compose<true>(translations.front().data(), rotations.front().data(), scales.front().data(),
+                  data(out), out.size(), clampLevel(level));
+}
+
+} // namespace trc::math
@@ -0,0 +1,191 @@
+#include "trc_util/math/FrustumCulling.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "trc_util/Assert.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define TRC_FRUSTUM_CULLING_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #define TRC_TARGET_AVX2
+    #else
+        #define TRC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+
+
+namespace trc::math
+{
+
+namespace
+{
+    struct SphereArrays
+    {
+        const float* x;
+        const float* y;
+        const float* z;
+        const float* r;
+        uint8_t* visible;
+    };
+
+    inline auto cullScalar(const Frustum& f, const SphereArrays& s, size_t i) -> bool
+    {
+        bool inside = true;
+        for (const auto& [a, b, c, d] : f.planes) {
+            inside &= a * s.x[i] + b * s.y[i] + c * s.z[i] + d >= -s.r[i];
+        }
+        s.visible[i] = inside;
+        return inside;
+    }
+
+#ifdef TRC_FRUSTUM_CULLING_X86
+
+    /**
+     * Test the four spheres starting at index `i`
+     *
+     * @return int A bit mask of the visible spheres
+     */
+    inline auto cullSse(const Frustum& f, const SphereArrays& s, size_t i) -> int
+    {
+        const __m128 x = _mm_loadu_ps(s.x + i);
+        const __m128 y = _mm_loadu_ps(s.y + i);
+        const __m128 z = _mm_loadu_ps(s.z + i);
+        const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(s.r + i));
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& [a, b, c, d] : f.planes)
+        {
+            const __m128 dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(a)), _mm_mul_ps(y, _mm_set1_ps(b))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(c)), _mm_set1_ps(d))
+            );
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negR));
+        }
+        return _mm_movemask_ps(inside);
+    }
+
+    /**
+     * Write one byte per bit of a visibility mask
+     *
+     * @return size_t The number of visible spheres
+     */
+    inline auto storeMask(int mask, uint8_t* out, int count) -> size_t
+    {
+        for (int k = 0; k < count; ++k) {
+            out[k] = (mask >> k) & 1;
+        }
+        return static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+
+    /** Returns the number of visible spheres in the processed range */
+    TRC_TARGET_AVX2
+    auto cullLoopAvx2(const Frustum& f, const SphereArrays& s, size_t count, size_t& i) -> size_t
+    {
+        __m256 planes[6][4];
+        for (int p = 0; p < 6; ++p)
+        {
+            for (int k = 0; k < 4; ++k) {
+                planes[p][k] = _mm256_set1_ps(f.planes[p][k]);
+            }
+        }
+
+        size_t numVisible = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(s.x + i);
+            const __m256 y = _mm256_loadu_ps(s.y + i);
+            const __m256 z = _mm256_loadu_ps(s.z + i);
+            const __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(s.r + i));
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const auto& [a, b, c, d] : planes)
+            {
+                __m256 dist = _mm256_fmadd_ps(x, a, d);
+                dist = _mm256_fmadd_ps(y, b, dist);
+                dist = _mm256_fmadd_ps(z, c, dist);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+            }
+            numVisible += storeMask(_mm256_movemask_ps(inside), s.visible + i, 8);
+        }
+        return numVisible;
+    }
+
+#endif // TRC_FRUSTUM_CULLING_X86
+} // anonymous namespace
+
+
+
+auto Frustum::fromViewProjection(const Mat4f& m) -> Frustum
+{
+    auto row = [&m](int r) -> Vec4f {
+        return { m[r], m[4 + r], m[8 + r], m[12 + r] };
+    };
+    auto add = [](const Vec4f& a, const Vec4f& b, float sign) -> Vec4f {
+        return { a[0] + sign * b[0], a[1] + sign * b[1], a[2] + sign * b[2], a[3] + sign * b[3] };
+    };
+
+    const Vec4f r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    Frustum res{ .planes={
+        add(r3, r0, 1.0f),   // -w <= x
+        add(r3, r0, -1.0f),  //  x <= w
+        add(r3, r1, 1.0f),   // -w <= y
+        add(r3, r1, -1.0f),  //  y <= w
+        r2,                  //  0 <= z
+        add(r3, r2, -1.0f),  //  z <= w
+    }};
+
+    for (auto& plane : res.planes)
+    {
+        const float len = std::hypot(plane[0], plane[1], plane[2]);
+        if (len > 0.0f) {
+            for (float& f : plane) f /= len;
+        }
+    }
+
+    return res;
+}
+
+auto cullSpheres(
+    const Frustum& frustum,
+    std::span<const float> centerX,
+    std::span<const float> centerY,
+    std::span<const float> centerZ,
+    std::span<const float> radius,
+    std::span<uint8_t> visible,
+    SimdLevel level)
+    -> size_t
+{
+    assert_arg(centerX.size() == visible.size()
+               && centerY.size() == visible.size()
+               && centerZ.size() == visible.size()
+               && radius.size() == visible.size());
+
+    const SphereArrays s{ centerX.data(), centerY.data(), centerZ.data(), radius.data(), visible.data() };
+    const size_t count = visible.size();
+    level = std::min(level, getSupportedSimdLevel());
+
+    size_t i = 0;
+    size_t numVisible = 0;
+#ifdef TRC_FRUSTUM_CULLING_X86
+    if (level == SimdLevel::eAvx2) {
+        numVisible += cullLoopAvx2(frustum, s, count, i);
+    }
+    if (level >= SimdLevel::eSse2)
+    {
+        for (; i + 4 <= count; i += 4) {
+            numVisible += storeMask(cullSse(frustum, s, i), s.visible + i, 4);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        numVisible += cullScalar(frustum, s, i);
+    }
+
+    return numVisible;
+}
+
+} // namespace trc::math